@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_util
+ * @{
+ *
+ * @file
+ * @brief       Fixed-size memory pool API
+ *
+ * @details     A memarray hands out the elements of a static array. Released
+ *              elements are kept in a free list that is linked through their
+ *              first `sizeof(void *)` bytes, so both allocating and freeing
+ *              take constant time, regardless of how many elements are in use.
+ *              Elements that were never handed out are taken in order, which
+ *              allows the pool to be initialized statically with
+ *              @ref MEMARRAY_INIT.
+ *
+ *              The content of a free element is undefined, except behind its
+ *              first `sizeof(void *)` bytes, which are left untouched. Users
+ *              that still scan the backing array must put the field telling
+ *              used and free elements apart behind those.
+ *
+ *              memarray_alloc() and memarray_free() do no locking, users
+ *              synchronize them like any other access to their own data.
+ *              memarray_alloc_irqsafe() and memarray_free_irqsafe() can be
+ *              used from interrupt context.
+ */
+
+#ifndef MEMARRAY_H
+#define MEMARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Memory pool of fixed-size elements
+ */
+typedef struct {
+    void *free_data;    /**< released elements */
+    uint8_t *data;      /**< backing array */
+    size_t size;        /**< size of an element in bytes */
+    unsigned num;       /**< number of elements */
+    unsigned next;      /**< elements from this index on were never used */
+    unsigned used;      /**< number of elements in use */
+    unsigned peak;      /**< highest number of elements in use at once */
+} memarray_t;
+
+/**
+ * @brief   Static initializer for a pool over all elements of @p array
+ *
+ * @param[in] array     array of elements, at least `sizeof(void *)` large
+ * @param[in] num       number of elements in @p array
+ */
+#define MEMARRAY_INIT(array, num)   { NULL, (uint8_t *)(array), \
+                                      sizeof((array)[0]), (num), 0, 0, 0 }
+
+/**
+ * @brief   Initialize a pool
+ *
+ * @param[out] mem      pool to initialize
+ * @param[in] data      backing array of @p num elements
+ * @param[in] size      size of an element, at least `sizeof(void *)`
+ * @param[in] num       number of elements in @p data
+ */
+void memarray_init(memarray_t *mem, void *data, size_t size, unsigned num);
+
+/**
+ * @brief   Allocate an element
+ *
+ * @param[in,out] mem   pool to allocate from
+ *
+ * @return  the element, its content is undefined
+ * @return  NULL, if all elements are in use
+ */
+void *memarray_alloc(memarray_t *mem);
+
+/**
+ * @brief   Return an element to its pool
+ *
+ * @param[in,out] mem   pool @p ptr was allocated from
+ * @param[in] ptr       element to free, must not be NULL
+ */
+void memarray_free(memarray_t *mem, void *ptr);
+
+/**
+ * @brief   Allocate an element with interrupts disabled
+ *
+ * @param[in,out] mem   pool to allocate from
+ *
+ * @return  the element, its content is undefined
+ * @return  NULL, if all elements are in use
+ */
+void *memarray_alloc_irqsafe(memarray_t *mem);
+
+/**
+ * @brief   Return an element to its pool with interrupts disabled
+ *
+ * @param[in,out] mem   pool @p ptr was allocated from
+ * @param[in] ptr       element to free, must not be NULL
+ */
+void memarray_free_irqsafe(memarray_t *mem, void *ptr);
+
+/**
+ * @brief   Get the index of an element in the backing array
+ *
+ * @param[in] mem       pool of @p ptr
+ * @param[in] ptr       element of @p mem
+ *
+ * @return  index of @p ptr
+ */
+static inline unsigned memarray_idx(const memarray_t *mem, const void *ptr)
+{
+    return ((const uint8_t *)ptr - mem->data) / mem->size;
+}
+
+/**
+ * @brief   Get the number of elements that can still be allocated
+ *
+ * @param[in] mem       pool
+ *
+ * @return  number of free elements
+ */
+static inline unsigned memarray_available(const memarray_t *mem)
+{
+    return mem->num - mem->used;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMARRAY_H */
+/** @} */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Fixed-size memory pool implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "memarray.h"
+
+/* elements need not be aligned for a pointer, so the link is copied */
+static inline void *_link(const void *elem)
+{
+    void *next;
+
+    memcpy(&next, elem, sizeof(next));
+    return next;
+}
+
+void memarray_init(memarray_t *mem, void *data, size_t size, unsigned num)
+{
+    assert(size >= sizeof(void *));
+    mem->free_data = NULL;
+    mem->data = data;
+    mem->size = size;
+    mem->num = num;
+    mem->next = 0;
+    mem->used = 0;
+    mem->peak = 0;
+}
+
+void *memarray_alloc(memarray_t *mem)
+{
+    void *res = mem->free_data;
+
+    if (res != NULL) {
+        mem->free_data = _link(res);
+    }
+    else if (mem->next < mem->num) {
+        res = &mem->data[mem->next++ * mem->size];
+    }
+    else {
+        return NULL;
+    }
+    if (++mem->used > mem->peak) {
+        mem->peak = mem->used;
+    }
+    return res;
+}
+
+void memarray_free(memarray_t *mem, void *ptr)
+{
+    assert(((uint8_t *)ptr >= mem->data) &&
+           (memarray_idx(mem, ptr) < mem->next) &&
+           ((((uint8_t *)ptr - mem->data) % mem->size) == 0));
+    memcpy(ptr, &mem->free_data, sizeof(mem->free_data));
+    mem->free_data = ptr;
+    mem->used--;
+}
+
+void *memarray_alloc_irqsafe(memarray_t *mem)
+{
+    unsigned state = irq_disable();
+    void *res = memarray_alloc(mem);
+
+    irq_restore(state);
+    return res;
+}
+
+void memarray_free_irqsafe(memarray_t *mem, void *ptr)
+{
+    unsigned state = irq_disable();
+
+    memarray_free(mem, ptr);
+    irq_restore(state);
+}
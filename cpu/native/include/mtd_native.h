@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_native MTD on a native file
+ * @ingroup     drivers_mtd
+ * @brief       MTD device backed by a file of the host system
+ *
+ * The file is created and extended to the size of the device as needed, new
+ * space is erased (0xff). With @ref mtd_native_nor_driver, the device behaves
+ * like NOR flash: writes can only clear bits and data is only rewritten after
+ * an erase.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the native MTD device
+ */
+#ifndef MTD_NATIVE_H
+#define MTD_NATIVE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Native MTD device descriptor
+ */
+typedef struct {
+    mtd_dev_t base;             /**< MTD device, geometry set by the user */
+    const char *fname;          /**< file backing the device */
+    int fd;                     /**< file descriptor, set by mtd_init() */
+    uint32_t reads;             /**< number of reads */
+    uint32_t writes;            /**< number of writes */
+    uint32_t erases;            /**< number of erases */
+} mtd_native_t;
+
+/**
+ * @brief   Driver for a device that overwrites data in place
+ */
+extern const mtd_desc_t mtd_native_driver;
+
+/**
+ * @brief   Driver for a device with NOR flash semantics
+ */
+extern const mtd_desc_t mtd_native_nor_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_NATIVE_H */
+/** @} */
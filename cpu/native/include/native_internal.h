@@ -126,6 +126,7 @@ extern const char* (*real_gai_strerror)(int errcode);
 extern FILE* (*real_fopen)(const char *path, const char *mode);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+extern off_t (*real_lseek)(int fd, off_t offset, int whence);
 
 #ifdef __MACH__
 #else
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_native
+ * @{
+ *
+ * @file
+ * @brief       MTD device backed by a file of the host system
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "native_internal.h"
+#include "mtd_native.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* bytes processed per system call */
+#define CHUNK_SIZE      (256U)
+
+/* reads or writes size bytes at addr */
+static int _rw(mtd_native_t *dev, void *buf, uint32_t addr, uint32_t size,
+               int write)
+{
+    uint8_t *ptr = buf;
+    int res = 0;
+
+    _native_syscall_enter();
+    if (real_lseek(dev->fd, addr, SEEK_SET) != (off_t)addr) {
+        res = -EIO;
+    }
+    while ((res == 0) && (size > 0)) {
+        ssize_t n = write ? real_write(dev->fd, ptr, size)
+                          : real_read(dev->fd, ptr, size);
+        if (n <= 0) {
+            res = -EIO;
+            break;
+        }
+        ptr += n;
+        size -= n;
+    }
+    _native_syscall_leave();
+    return res;
+}
+
+/* erases size bytes at addr */
+static int _fill(mtd_native_t *dev, uint32_t addr, uint32_t size)
+{
+    uint8_t buf[CHUNK_SIZE];
+    int res = 0;
+
+    memset(buf, 0xff, sizeof(buf));
+    while ((res == 0) && (size > 0)) {
+        uint32_t len = (size < sizeof(buf)) ? size : sizeof(buf);
+
+        res = _rw(dev, buf, addr, len, 1);
+        addr += len;
+        size -= len;
+    }
+    return res;
+}
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_native_t *dev = (mtd_native_t *)mtd;
+    off_t size;
+
+    _native_syscall_enter();
+    dev->fd = real_open(dev->fname, O_RDWR | O_CREAT, 0644);
+    size = (dev->fd < 0) ? -1 : real_lseek(dev->fd, 0, SEEK_END);
+    _native_syscall_leave();
+    if (size < 0) {
+        DEBUG("mtd_native: can't open %s\n", dev->fname);
+        return -EIO;
+    }
+    dev->reads = 0;
+    dev->writes = 0;
+    dev->erases = 0;
+    if ((uint32_t)size < mtd_size(mtd)) {
+        return _fill(dev, size, mtd_size(mtd) - size);
+    }
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size)
+{
+    mtd_native_t *dev = (mtd_native_t *)mtd;
+
+    dev->reads++;
+    return _rw(dev, buf, addr, size, 0);
+}
+
+static int _write(mtd_dev_t *mtd, const void *buf, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_native_t *dev = (mtd_native_t *)mtd;
+
+    dev->writes++;
+    return _rw(dev, (void *)buf, addr, size, 1);
+}
+
+static int _write_nor(mtd_dev_t *mtd, const void *buf, uint32_t addr,
+                      uint32_t size)
+{
+    mtd_native_t *dev = (mtd_native_t *)mtd;
+    const uint8_t *src = buf;
+    uint8_t tmp[CHUNK_SIZE];
+    int res = 0;
+
+    dev->writes++;
+    /* programming only clears bits */
+    while ((res == 0) && (size > 0)) {
+        uint32_t len = (size < sizeof(tmp)) ? size : sizeof(tmp);
+
+        res = _rw(dev, tmp, addr, len, 0);
+        for (uint32_t i = 0; i < len; i++) {
+            tmp[i] &= src[i];
+        }
+        if (res == 0) {
+            res = _rw(dev, tmp, addr, len, 1);
+        }
+        src += len;
+        addr += len;
+        size -= len;
+    }
+    return res;
+}
+
+static int _erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    mtd_native_t *dev = (mtd_native_t *)mtd;
+
+    dev->erases += size / mtd_sector_size(mtd);
+    return _fill(dev, addr, size);
+}
+
+const mtd_desc_t mtd_native_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .flush = NULL,
+    .flags = 0,
+};
+
+const mtd_desc_t mtd_native_nor_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write_nor,
+    .erase = _erase,
+    .flush = NULL,
+    .flags = MTD_DRIVER_FLAG_ERASE,
+};
@@ -185,6 +185,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
 int gnrc_netdev2_cc110x_init(gnrc_netdev2_t *gnrc_netdev2, netdev2_t *dev)
 {
     gnrc_netdev2->send = _send;
+    gnrc_netdev2->send_batch = NULL;
     gnrc_netdev2->recv = _recv;
     gnrc_netdev2->dev = dev;
 
@@ -858,6 +858,19 @@ int lis3dh_set_int1(lis3dh_t *dev, const uint8_t mode);
  */
 int lis3dh_get_fifo_level(lis3dh_t *dev);
 
+/**
+ * @brief Read the oldest acceleration data from the FIFO
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[out] acc_data     Accelerometer data output buffer
+ * @param[in]  max          Maximum number of elements to read
+ *
+ * @return                  number of elements read on success
+ * @return                  -1 if the FIFO is disabled
+ */
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned max);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd Memory Technology Device
+ * @ingroup     drivers_storage
+ * @brief       Generic interface for block storage devices
+ *
+ * A memory technology device (MTD) is divided into sectors, the unit of
+ * erase, and each sector into pages, the unit of write. Drivers exist for
+ * internal flash (@ref drivers_mtd_flashpage), NVRAM (@ref drivers_mtd_nvram),
+ * and SD cards (@ref drivers_mtd_sdcard). On native, a file can back an MTD.
+ *
+ * Devices are accessed in whole pages. The write-back cache of
+ * @ref drivers_mtd_cache offers byte-wise access on top of any device and
+ * merges writes to the same sector into a single erase and program.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for MTD devices
+ */
+
+#ifndef MTD_H
+#define MTD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Programming can only clear bits, erasing sets them
+ *
+ * Data can only be rewritten after erasing its sector, as on NOR flash.
+ * Devices without this flag overwrite data in place.
+ */
+#define MTD_DRIVER_FLAG_ERASE       (0x01)
+
+/**
+ * @brief   MTD driver interface, see @ref mtd_desc
+ */
+typedef struct mtd_desc mtd_desc_t;
+
+/**
+ * @brief   MTD device descriptor
+ *
+ * Drivers embed this structure as first member of their device descriptor.
+ */
+typedef struct {
+    const mtd_desc_t *driver;   /**< driver of the device */
+    uint32_t sector_count;      /**< number of sectors */
+    uint32_t pages_per_sector;  /**< number of pages per sector */
+    uint32_t page_size;         /**< size of a page in bytes */
+} mtd_dev_t;
+
+/**
+ * @brief   MTD driver interface
+ *
+ * All functions return 0 on success or a negative errno value on error.
+ * Addresses and sizes are checked by the mtd_* functions before the driver
+ * is called.
+ */
+struct mtd_desc {
+    /**
+     * @brief   Initializes the device, and fills in its geometry if needed
+     */
+    int (*init)(mtd_dev_t *dev);
+
+    /**
+     * @brief   Reads @p size bytes from @p addr into @p buf
+     */
+    int (*read)(mtd_dev_t *dev, void *buf, uint32_t addr, uint32_t size);
+
+    /**
+     * @brief   Writes @p size bytes from @p buf to @p addr
+     */
+    int (*write)(mtd_dev_t *dev, const void *buf, uint32_t addr,
+                 uint32_t size);
+
+    /**
+     * @brief   Erases the sectors of @p size bytes starting at @p addr
+     *
+     * NULL if the device can't erase.
+     */
+    int (*erase)(mtd_dev_t *dev, uint32_t addr, uint32_t size);
+
+    /**
+     * @brief   Writes all buffered data to the storage
+     *
+     * NULL if the driver doesn't buffer writes.
+     */
+    int (*flush)(mtd_dev_t *dev);
+
+    uint8_t flags;              /**< MTD_DRIVER_FLAG_* */
+};
+
+/**
+ * @brief   Initializes a device
+ *
+ * @param[in] mtd   the device
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int mtd_init(mtd_dev_t *mtd);
+
+/**
+ * @brief   Reads from a device
+ *
+ * @param[in]  mtd      the device
+ * @param[out] buf      buffer of at least @p size bytes
+ * @param[in]  addr     address to read from, a multiple of the page size
+ * @param[in]  size     number of bytes, a multiple of the page size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p addr or @p size are not page aligned
+ * @return  -EOVERFLOW if the range exceeds the device
+ * @return  -EIO on other errors
+ */
+int mtd_read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size);
+
+/**
+ * @brief   Writes to a device
+ *
+ * On devices with MTD_DRIVER_FLAG_ERASE, the range needs to be erased first.
+ *
+ * @param[in] mtd       the device
+ * @param[in] buf       data to write
+ * @param[in] addr      address to write to, a multiple of the page size
+ * @param[in] size      number of bytes, a multiple of the page size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p addr or @p size are not page aligned
+ * @return  -EOVERFLOW if the range exceeds the device
+ * @return  -EIO on other errors
+ */
+int mtd_write(mtd_dev_t *mtd, const void *buf, uint32_t addr, uint32_t size);
+
+/**
+ * @brief   Erases sectors of a device
+ *
+ * @param[in] mtd       the device
+ * @param[in] addr      address of the first sector
+ * @param[in] size      number of bytes, a multiple of the sector size
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p addr or @p size are not sector aligned
+ * @return  -EOVERFLOW if the range exceeds the device
+ * @return  -ENOTSUP if the device can't erase
+ * @return  -EIO on other errors
+ */
+int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
+
+/**
+ * @brief   Writes all data buffered by a device to the storage
+ *
+ * @param[in] mtd       the device
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int mtd_flush(mtd_dev_t *mtd);
+
+/**
+ * @brief   Returns the size of a sector of a device in bytes
+ */
+static inline uint32_t mtd_sector_size(const mtd_dev_t *mtd)
+{
+    return mtd->pages_per_sector * mtd->page_size;
+}
+
+/**
+ * @brief   Returns the size of a device in bytes
+ */
+static inline uint32_t mtd_size(const mtd_dev_t *mtd)
+{
+    return mtd->sector_count * mtd_sector_size(mtd);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_H */
+/** @} */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache MTD write-back cache
+ * @ingroup     drivers_mtd
+ * @brief       RAM write-back cache for any MTD device
+ *
+ * The cache is itself an MTD device with a page size of one byte and the
+ * sectors of the cached device. It keeps whole sectors in RAM and tracks
+ * which of their pages were modified. Sectors are written back when they are
+ * evicted, least recently used first, or on mtd_flush().
+ *
+ * On devices with MTD_DRIVER_FLAG_ERASE, all writes to a sector are merged
+ * into a single erase and program of the sector. Other devices get one write
+ * per run of consecutive modified pages.
+ *
+ * Reads of whole pages not in the cache bypass it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the MTD write-back cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A cached sector
+ */
+typedef struct {
+    uint32_t sector;            /**< cached sector, UINT32_MAX if unused */
+    uint32_t dirty;             /**< bitmap of modified chunks of pages */
+    uint32_t used;              /**< time of the last access */
+} mtd_cache_line_t;
+
+/**
+ * @brief   MTD write-back cache
+ *
+ * Fill in all members but `chunk` and `clock` before calling mtd_init(),
+ * e.g.:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static uint8_t buf[2 * SECTOR_SIZE];
+ * static mtd_cache_line_t lines[2];
+ * static mtd_cache_t cache = {
+ *     .base = { .driver = &mtd_cache_driver },
+ *     .parent = &dev.base,
+ *     .buf = buf,
+ *     .lines = lines,
+ *     .lines_numof = 2,
+ * };
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+typedef struct {
+    mtd_dev_t base;             /**< MTD device of the cache */
+    mtd_dev_t *parent;          /**< cached device */
+    uint8_t *buf;               /**< data, `lines_numof` sectors of the parent */
+    mtd_cache_line_t *lines;    /**< cache lines */
+    unsigned lines_numof;       /**< number of cache lines */
+    uint32_t chunk;             /**< bytes per bit of mtd_cache_line_t::dirty */
+    uint32_t clock;             /**< access counter */
+} mtd_cache_t;
+
+/**
+ * @brief   MTD driver of the cache
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_flashpage MTD on internal flash
+ * @ingroup     drivers_mtd
+ * @brief       MTD device on a range of pages of the internal flash
+ *
+ * Each flash page is one sector of one page. Writing a page erases it, so
+ * pages can be rewritten without erasing them first.
+ *
+ * @note    Some CPUs need the data written to flash to be word aligned.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the internal flash MTD device
+ */
+#ifndef MTD_FLASHPAGE_H
+#define MTD_FLASHPAGE_H
+
+#include "mtd.h"
+#include "periph/flashpage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Internal flash MTD device descriptor
+ */
+typedef struct {
+    mtd_dev_t base;             /**< MTD device */
+    unsigned first_page;        /**< first flash page of the device */
+} mtd_flashpage_t;
+
+/**
+ * @brief   Initializer for a device on @p numof flash pages from @p first
+ */
+#define MTD_FLASHPAGE_INIT(first, numof)                \
+    {                                                   \
+        .base = {                                       \
+            .driver = &mtd_flashpage_driver,            \
+            .sector_count = (numof),                    \
+            .pages_per_sector = 1,                      \
+            .page_size = FLASHPAGE_SIZE,                \
+        },                                              \
+        .first_page = (first),                          \
+    }
+
+/**
+ * @brief   Driver for the internal flash
+ */
+extern const mtd_desc_t mtd_flashpage_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_FLASHPAGE_H */
+/** @} */
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_nvram MTD on NVRAM
+ * @ingroup     drivers_mtd
+ * @brief       MTD device on any @ref drivers_nvram device, e.g. nvram_spi
+ *
+ * NVRAM overwrites data in place and can't erase. The page and sector size
+ * are free to choose and only set the granularity of access.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the NVRAM MTD device
+ */
+#ifndef MTD_NVRAM_H
+#define MTD_NVRAM_H
+
+#include "mtd.h"
+#include "nvram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   NVRAM MTD device descriptor
+ *
+ * The number of sectors is set by mtd_init() from the size of the NVRAM.
+ */
+typedef struct {
+    mtd_dev_t base;             /**< MTD device */
+    nvram_t *nvram;             /**< initialized NVRAM device */
+} mtd_nvram_t;
+
+/**
+ * @brief   Driver for NVRAM
+ */
+extern const mtd_desc_t mtd_nvram_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_NVRAM_H */
+/** @} */
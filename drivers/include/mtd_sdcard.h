@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_sdcard MTD on SD cards
+ * @ingroup     drivers_mtd
+ * @brief       MTD device on an SD card attached via @ref drivers_sdcard_spi
+ *
+ * Pages are the card's blocks of 512 bytes. The card overwrites data in
+ * place, sectors only set the unit of @ref drivers_mtd_cache, whose
+ * write-backs become multiple block writes.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the SD card MTD device
+ */
+#ifndef MTD_SDCARD_H
+#define MTD_SDCARD_H
+
+#include "mtd.h"
+#include "sdcard_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of blocks per sector
+ */
+#ifndef MTD_SDCARD_PAGES_PER_SECTOR
+#define MTD_SDCARD_PAGES_PER_SECTOR     (8)
+#endif
+
+/**
+ * @brief   SD card MTD device descriptor
+ *
+ * The geometry is set by mtd_init().
+ */
+typedef struct {
+    mtd_dev_t base;                     /**< MTD device */
+    sdcard_spi_t *card;                 /**< the card */
+    const sdcard_spi_params_t *params;  /**< parameters to initialize the
+                                             card with, NULL if it is
+                                             initialized already */
+} mtd_sdcard_t;
+
+/**
+ * @brief   Driver for SD cards
+ */
+extern const mtd_desc_t mtd_sdcard_driver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_SDCARD_H */
+/** @} */
@@ -35,6 +35,16 @@
  *
  * ![RX event example](riot-netdev-rx.svg)
  *
+ * Devices that can hold several frames may offer to handle them in batches:
+ * - If the upper layer enables @ref NETOPT_RX_BATCH, step 4 fires
+ *   @ref NETDEV2_EVENT_RX_PENDING only once for all received frames, and the
+ *   upper layer fetches frames with
+ *   @ref netdev2_driver_t::recv "netdev->driver->recv()" as long as
+ *   `recv(dev, NULL, 0, NULL)` reports a size greater than 0 for the next
+ *   frame.
+ * - @ref netdev2_driver_t::send_batch "netdev->driver->send_batch()" takes
+ *   several frames to send in one call.
+ *
  * @file
  * @brief       Definitions low-level network driver interface
  *
@@ -79,6 +89,8 @@ typedef enum {
     NETDEV2_EVENT_TX_MEDIUM_BUSY,   /**< couldn't transfer packet */
     NETDEV2_EVENT_LINK_UP,          /**< link established */
     NETDEV2_EVENT_LINK_DOWN,        /**< link gone */
+    NETDEV2_EVENT_RX_PENDING,       /**< received packets wait to be fetched,
+                                     *   see @ref NETOPT_RX_BATCH */
     /* expand this list if needed */
 } netdev2_event_t;
 
@@ -92,6 +104,14 @@ struct netdev2_radio_rx_info {
     uint8_t lqi;        /**< LQI of a received packet */
 };
 
+/**
+ * @brief   Frame for @ref netdev2_driver_t::send_batch
+ */
+typedef struct {
+    const struct iovec *vector;     /**< io vector array of the frame */
+    unsigned count;                 /**< nr of entries in vector */
+} netdev2_frame_t;
+
 /**
  * @brief   Forward declaration for netdev2 struct
  */
@@ -154,6 +174,8 @@ typedef struct netdev2_driver {
      *
      * If buf == NULL and len == 0, returns the packet size without dropping it.
      * If buf == NULL and len > 0, drops the packet and returns the packet size.
+     * If @ref NETOPT_RX_BATCH is enabled and no packet is left,
+     * returns 0.
      *
      * @param[in]   dev     network device descriptor
      * @param[out]  buf     buffer to write into or NULL
@@ -224,6 +246,27 @@ typedef struct netdev2_driver {
      */
     int (*set)(netdev2_t *dev, netopt_t opt,
                void *value, size_t value_len);
+
+    /**
+     * @brief   Send several frames
+     *
+     * Optional, NULL if the device sends only one frame at a time. The frames
+     * are sent in the given order.
+     *
+     * @pre `(dev != NULL) && (frames != NULL) && (num > 0)`
+     *
+     * @param[in] dev       network device descriptor
+     * @param[in] frames    frames to send
+     * @param[in] num       nr of entries in frames
+     *
+     * @return number of frames sent
+     * @return -ENOTSUP, if the device can not send several frames right now,
+     *         the caller then sends them one by one with
+     *         @ref netdev2_driver_t::send
+     * @return `< 0` on other errors
+     */
+    int (*send_batch)(netdev2_t *dev, const netdev2_frame_t *frames,
+                      unsigned num);
 } netdev2_driver_t;
 
 #ifdef __cplusplus
@@ -130,6 +130,25 @@ typedef int(*saul_read_t)(void *dev, phydat_t *res);
  */
 typedef int(*saul_write_t)(void *dev, phydat_t *data);
 
+/**
+ * @brief   Read all values buffered by a device
+ *
+ * Devices with a hardware FIFO can implement this to hand out all buffered
+ * readings with one call, oldest first. Each reading holds as many values as
+ * a single call to the device's @ref saul_read_t would return.
+ *
+ * @param[in] dev       device descriptor of the target device
+ * @param[out] res      readings from the device
+ * @param[in] max       maximum number of readings to write to @p res
+ * @param[out] dim      number of values per reading [1-3]
+ *
+ * @return  number of readings written to @p res, 0 if none are buffered
+ * @return  -ENOTSUP if the device does not support this operation
+ * @return  -ECANCELED on other errors
+ */
+typedef int(*saul_read_multi_t)(void *dev, phydat_t *res, unsigned max,
+                                uint8_t *dim);
+
 /**
  * @brief   Definition of the RIOT actuator/sensor interface
  */
@@ -137,6 +156,7 @@ typedef struct {
     saul_read_t read;       /**< read function pointer */
     saul_write_t write;     /**< write function pointer */
     uint8_t type;           /**< device class the device belongs to */
+    saul_read_multi_t read_multi;   /**< read of buffered values, optional */
 } saul_driver_t;
 
 /**
@@ -27,12 +27,21 @@ extern "C" {
 
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "kernel_types.h"
+#include "sema.h"
 #include "stdbool.h"
 
 #define SD_HC_BLOCK_SIZE      (512)  /**< size of a single block on SDHC cards */
 #define SDCARD_SPI_INIT_ERROR (-1)   /**< returned on failed init */
 #define SDCARD_SPI_OK         (0)    /**< returned on successful init */
 
+/**
+ * @brief   Number of blocks buffered by a write-behind queue
+ */
+#ifndef SDCARD_SPI_WB_BLOCKS
+#define SDCARD_SPI_WB_BLOCKS  (8)
+#endif
+
 #define SD_SIZE_OF_OID 2 /**< OID (OEM/application ID field in CID reg) */
 #define SD_SIZE_OF_PNM 5 /**< PNM (product name field in CID reg) */
 
@@ -264,6 +273,69 @@ int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, char *data, int b
  */
 uint64_t sdcard_spi_get_capacity(sdcard_spi_t *card);
 
+/**
+ * @brief   Write-behind queue for sdcard_spi
+ *
+ * Blocks written to the queue are copied to a ring buffer and written to the
+ * card by a dedicated thread, so the writer does not block while the card is
+ * busy. Queued blocks with consecutive addresses are written with a single
+ * multi-block write.
+ */
+typedef struct {
+    sdcard_spi_t *card;                                 /**< card to write to */
+    char buf[SDCARD_SPI_WB_BLOCKS][SD_HC_BLOCK_SIZE];   /**< queued blocks */
+    int addr[SDCARD_SPI_WB_BLOCKS];                     /**< their addresses */
+    unsigned head;                                      /**< next slot to fill */
+    unsigned tail;                                      /**< next slot to write */
+    sema_t free;                                        /**< number of free slots */
+    sema_t queued;                                      /**< number of queued slots */
+    sd_rw_response_t state;                             /**< first error since last flush */
+    kernel_pid_t pid;                                   /**< writer thread */
+} sdcard_spi_wb_t;
+
+/**
+ * @brief                 Starts a write-behind queue for an initialized card.
+ *
+ * @param[out] wb         Queue to initialize
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] stack       Stack for the writer thread
+ * @param[in] stacksize   Size of @p stack
+ * @param[in] priority    Priority of the writer thread
+ *
+ * @return                PID of the writer thread
+ * @return                negative value on error creating the thread
+ */
+kernel_pid_t sdcard_spi_wb_init(sdcard_spi_wb_t *wb, sdcard_spi_t *card, char *stack,
+                                int stacksize, char priority);
+
+/**
+ * @brief                 Queues blocks for writing.
+ *
+ * Blocks only while the queue is full. Errors while writing are reported by
+ * the next call of sdcard_spi_wb_flush(). Blocks read with
+ * sdcard_spi_read_blocks() are only up to date after a flush.
+ *
+ * @note                  Only one thread may write to a queue.
+ *
+ * @param[in] wb          Write-behind queue
+ * @param[in] blockaddr   Block address to write to (see sdcard_spi_write_blocks())
+ * @param[in] data        Data of @p nblocks blocks of SD_HC_BLOCK_SIZE bytes
+ * @param[in] nblocks     Number of blocks to write
+ *
+ * @return                number of queued blocks
+ */
+int sdcard_spi_wb_write(sdcard_spi_wb_t *wb, int blockaddr, const char *data, int nblocks);
+
+/**
+ * @brief                 Waits until all queued blocks are written.
+ *
+ * @param[in] wb          Write-behind queue
+ *
+ * @return                SD_RW_OK if all blocks since the last flush were written
+ * @return                the state of the first failed write otherwise
+ */
+sd_rw_response_t sdcard_spi_wb_flush(sdcard_spi_wb_t *wb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -215,6 +215,32 @@ int lis3dh_get_fifo_level(lis3dh_t *dev)
     return level;
 }
 
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned max)
+{
+    uint8_t reg[2];
+    unsigned level;
+
+    /* FIFO_CTRL_REG and FIFO_SRC_REG are adjacent, read both at once */
+    lis3dh_read_regs(dev, LIS3DH_REG_FIFO_CTRL_REG, sizeof(reg), reg);
+    if ((reg[0] & LIS3DH_FIFO_CTRL_REG_FM_MASK) == 0) {
+        return -1;
+    }
+    level = (reg[1] & LIS3DH_FIFO_SRC_REG_FSS_MASK) >> LIS3DH_FIFO_SRC_REG_FSS_SHIFT;
+    if (reg[1] & LIS3DH_FIFO_SRC_REG_OVRN_FIFO_MASK) {
+        /* all 32 slots are filled */
+        level = LIS3DH_FIFO_SRC_REG_FSS_MASK + 1;
+    }
+    if (level > max) {
+        level = max;
+    }
+    /* every read of the output registers pops one element */
+    for (unsigned i = 0; i < level; i++) {
+        lis3dh_read_xyz(dev, &acc_data[i]);
+    }
+    return level;
+}
+
 
 /**
  * @brief Read sequential registers from the LIS3DH.
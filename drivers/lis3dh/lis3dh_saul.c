@@ -45,6 +45,31 @@ static int read_acc(void *dev, phydat_t *res)
     return 3;
 }
 
+static int read_acc_fifo(void *dev, phydat_t *res, unsigned max, uint8_t *dim)
+{
+    lis3dh_data_t xyz[8];
+    int n;
+
+    if (max > sizeof(xyz) / sizeof(xyz[0])) {
+        max = sizeof(xyz) / sizeof(xyz[0]);
+    }
+    n = lis3dh_read_fifo((lis3dh_t *)dev, xyz, max);
+    if (n < 0) {
+        /* FIFO disabled, use read_acc instead */
+        return -ENOTSUP;
+    }
+    for (int i = 0; i < n; i++) {
+        res[i].val[0] = xyz[i].acc_x;
+        res[i].val[1] = xyz[i].acc_y;
+        res[i].val[2] = xyz[i].acc_z;
+        res[i].scale = -3;
+        res[i].unit = UNIT_G;
+    }
+    *dim = 3;
+
+    return n;
+}
+
 static int write(void *dev, phydat_t *state)
 {
     (void) dev;
@@ -56,4 +81,5 @@ const saul_driver_t lis3dh_saul_driver = {
     .read = read_acc,
     .write = write,
     .type = SAUL_SENSE_ACCEL,
+    .read_multi = read_acc_fifo,
 };
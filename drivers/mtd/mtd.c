@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd
+ * @{
+ *
+ * @file
+ * @brief       Common functions of MTD devices
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "mtd.h"
+
+/* checks that [addr, addr + size) lies within the device and is aligned */
+static int _check(const mtd_dev_t *mtd, uint32_t addr, uint32_t size,
+                  uint32_t align)
+{
+    if (((addr % align) != 0) || ((size % align) != 0)) {
+        return -EINVAL;
+    }
+    if ((addr > mtd_size(mtd)) || (size > mtd_size(mtd) - addr)) {
+        return -EOVERFLOW;
+    }
+    return 0;
+}
+
+int mtd_init(mtd_dev_t *mtd)
+{
+    if (mtd->driver->init == NULL) {
+        return 0;
+    }
+    return mtd->driver->init(mtd);
+}
+
+int mtd_read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size)
+{
+    int res = _check(mtd, addr, size, mtd->page_size);
+
+    if ((res < 0) || (size == 0)) {
+        return res;
+    }
+    return mtd->driver->read(mtd, buf, addr, size);
+}
+
+int mtd_write(mtd_dev_t *mtd, const void *buf, uint32_t addr, uint32_t size)
+{
+    int res = _check(mtd, addr, size, mtd->page_size);
+
+    if ((res < 0) || (size == 0)) {
+        return res;
+    }
+    return mtd->driver->write(mtd, buf, addr, size);
+}
+
+int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    int res;
+
+    if (mtd->driver->erase == NULL) {
+        return -ENOTSUP;
+    }
+    res = _check(mtd, addr, size, mtd_sector_size(mtd));
+    if ((res < 0) || (size == 0)) {
+        return res;
+    }
+    return mtd->driver->erase(mtd, addr, size);
+}
+
+int mtd_flush(mtd_dev_t *mtd)
+{
+    if (mtd->driver->flush == NULL) {
+        return 0;
+    }
+    return mtd->driver->flush(mtd);
+}
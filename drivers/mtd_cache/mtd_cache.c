@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       MTD write-back cache implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _UNUSED     (UINT32_MAX)
+
+static inline uint8_t *_data(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    return cache->buf + (line - cache->lines) * mtd_sector_size(cache->parent);
+}
+
+static inline uint32_t _min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static int _flush_line(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    mtd_dev_t *parent = cache->parent;
+    uint32_t sector_size = mtd_sector_size(parent);
+    uint32_t addr = line->sector * sector_size;
+    uint8_t *data = _data(cache, line);
+    int res = 0;
+
+    if (line->dirty == 0) {
+        return 0;
+    }
+    DEBUG("mtd_cache: write back sector %lu (dirty 0x%08lx)\n",
+          (unsigned long)line->sector, (unsigned long)line->dirty);
+    if (parent->driver->flags & MTD_DRIVER_FLAG_ERASE) {
+        /* a single erase and program for all writes to this sector */
+        res = mtd_erase(parent, addr, sector_size);
+        if (res == 0) {
+            res = mtd_write(parent, data, addr, sector_size);
+        }
+    }
+    else {
+        unsigned chunks = (sector_size + cache->chunk - 1) / cache->chunk;
+
+        for (unsigned i = 0; (i < chunks) && (res == 0);) {
+            unsigned j = i;
+
+            while ((j < chunks) && (line->dirty & (1UL << j))) {
+                j++;
+            }
+            if (j > i) {
+                uint32_t start = i * cache->chunk;
+                uint32_t end = _min(j * cache->chunk, sector_size);
+
+                res = mtd_write(parent, data + start, addr + start, end - start);
+                i = j;
+            }
+            else {
+                i++;
+            }
+        }
+    }
+    if (res == 0) {
+        line->dirty = 0;
+    }
+    return res;
+}
+
+static mtd_cache_line_t *_find(mtd_cache_t *cache, uint32_t sector)
+{
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        if (cache->lines[i].sector == sector) {
+            return &cache->lines[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns the line caching sector, replacing the least recently used line on
+ * a miss. The sector is read from the parent if fill is set.
+ */
+static mtd_cache_line_t *_get(mtd_cache_t *cache, uint32_t sector, int fill,
+                              int *res)
+{
+    mtd_cache_line_t *line = _find(cache, sector);
+
+    if (line == NULL) {
+        uint32_t sector_size = mtd_sector_size(cache->parent);
+
+        line = &cache->lines[0];
+        for (unsigned i = 1; i < cache->lines_numof; i++) {
+            if ((line->sector != _UNUSED) &&
+                ((cache->lines[i].sector == _UNUSED) ||
+                 (cache->lines[i].used < line->used))) {
+                line = &cache->lines[i];
+            }
+        }
+        if ((line->sector != _UNUSED) && ((*res = _flush_line(cache, line)) < 0)) {
+            return NULL;
+        }
+        line->sector = _UNUSED;
+        if (fill && ((*res = mtd_read(cache->parent, _data(cache, line),
+                                      sector * sector_size, sector_size)) < 0)) {
+            return NULL;
+        }
+        line->sector = sector;
+    }
+    line->used = ++cache->clock;
+    return line;
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    mtd_dev_t *parent = cache->parent;
+    int res = mtd_init(parent);
+
+    if (res < 0) {
+        return res;
+    }
+    dev->sector_count = parent->sector_count;
+    dev->pages_per_sector = mtd_sector_size(parent);
+    dev->page_size = 1;
+    /* one dirty bit per page, or per group of pages for more than 32 pages */
+    cache->chunk = ((parent->pages_per_sector + 31) / 32) * parent->page_size;
+    cache->clock = 0;
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        cache->lines[i].sector = _UNUSED;
+        cache->lines[i].dirty = 0;
+        cache->lines[i].used = 0;
+    }
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buf, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t sector_size = mtd_sector_size(dev);
+    uint32_t page_size = cache->parent->page_size;
+    uint8_t *dst = buf;
+    int res = 0;
+
+    while (size > 0) {
+        uint32_t sector = addr / sector_size;
+        uint32_t off = addr % sector_size;
+        uint32_t len = _min(sector_size - off, size);
+        mtd_cache_line_t *line = _find(cache, sector);
+
+        if ((line == NULL) && ((off % page_size) == 0) && ((len % page_size) == 0)) {
+            res = mtd_read(cache->parent, dst, addr, len);
+        }
+        else if ((line != NULL) || ((line = _get(cache, sector, 1, &res)) != NULL)) {
+            line->used = ++cache->clock;
+            memcpy(dst, _data(cache, line) + off, len);
+        }
+        if (res < 0) {
+            return res;
+        }
+        dst += len;
+        addr += len;
+        size -= len;
+    }
+    return 0;
+}
+
+static int _write(mtd_dev_t *dev, const void *buf, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t sector_size = mtd_sector_size(dev);
+    const uint8_t *src = buf;
+    int res = 0;
+
+    while (size > 0) {
+        uint32_t sector = addr / sector_size;
+        uint32_t off = addr % sector_size;
+        uint32_t len = _min(sector_size - off, size);
+        /* no need to read sectors that are overwritten completely */
+        mtd_cache_line_t *line = _get(cache, sector, (len != sector_size), &res);
+
+        if (line == NULL) {
+            return res;
+        }
+        memcpy(_data(cache, line) + off, src, len);
+        for (uint32_t i = off / cache->chunk; i <= (off + len - 1) / cache->chunk; i++) {
+            line->dirty |= (1UL << i);
+        }
+        src += len;
+        addr += len;
+        size -= len;
+    }
+    return 0;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t sector_size = mtd_sector_size(dev);
+
+    if (cache->parent->driver->erase == NULL) {
+        return -ENOTSUP;
+    }
+    for (uint32_t s = addr / sector_size; s < (addr + size) / sector_size; s++) {
+        mtd_cache_line_t *line = _find(cache, s);
+
+        if (line != NULL) {
+            line->sector = _UNUSED;
+            line->dirty = 0;
+        }
+    }
+    return mtd_erase(cache->parent, addr, size);
+}
+
+static int _flush(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    /* write back in ascending order of sectors */
+    while (1) {
+        mtd_cache_line_t *next = NULL;
+
+        for (unsigned i = 0; i < cache->lines_numof; i++) {
+            mtd_cache_line_t *line = &cache->lines[i];
+
+            if (line->dirty && ((next == NULL) || (line->sector < next->sector))) {
+                next = line;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        int res = _flush_line(cache, next);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_flush(cache->parent);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .flush = _flush,
+    .flags = 0,
+};
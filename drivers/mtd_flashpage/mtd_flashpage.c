@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_flashpage
+ * @{
+ *
+ * @file
+ * @brief       MTD device on the internal flash
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mtd_flashpage.h"
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_flashpage_t *dev = (mtd_flashpage_t *)mtd;
+
+    if (dev->first_page + mtd->sector_count > FLASHPAGE_NUMOF) {
+        return -EOVERFLOW;
+    }
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size)
+{
+    mtd_flashpage_t *dev = (mtd_flashpage_t *)mtd;
+
+    /* the flash is memory mapped */
+    memcpy(buf, (uint8_t *)flashpage_addr(dev->first_page) + addr, size);
+    return 0;
+}
+
+static int _write(mtd_dev_t *mtd, const void *buf, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_flashpage_t *dev = (mtd_flashpage_t *)mtd;
+    const uint8_t *src = buf;
+
+    for (uint32_t i = 0; i < size / FLASHPAGE_SIZE; i++) {
+        int page = dev->first_page + (addr / FLASHPAGE_SIZE) + i;
+
+        if (flashpage_write_and_verify(page, (void *)&src[i * FLASHPAGE_SIZE])
+            != FLASHPAGE_OK) {
+            return -EIO;
+        }
+    }
+    return 0;
+}
+
+static int _erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    mtd_flashpage_t *dev = (mtd_flashpage_t *)mtd;
+
+    for (uint32_t i = 0; i < size / FLASHPAGE_SIZE; i++) {
+        flashpage_write(dev->first_page + (addr / FLASHPAGE_SIZE) + i, NULL);
+    }
+    return 0;
+}
+
+const mtd_desc_t mtd_flashpage_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .flush = NULL,
+    .flags = 0,
+};
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_nvram
+ * @{
+ *
+ * @file
+ * @brief       MTD device on NVRAM
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "mtd_nvram.h"
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_nvram_t *dev = (mtd_nvram_t *)mtd;
+
+    if (mtd_sector_size(mtd) == 0) {
+        return -EINVAL;
+    }
+    mtd->sector_count = dev->nvram->size / mtd_sector_size(mtd);
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size)
+{
+    nvram_t *nvram = ((mtd_nvram_t *)mtd)->nvram;
+
+    if (nvram->read(nvram, buf, addr, size) != (int)size) {
+        return -EIO;
+    }
+    return 0;
+}
+
+static int _write(mtd_dev_t *mtd, const void *buf, uint32_t addr,
+                  uint32_t size)
+{
+    nvram_t *nvram = ((mtd_nvram_t *)mtd)->nvram;
+
+    if (nvram->write(nvram, buf, addr, size) != (int)size) {
+        return -EIO;
+    }
+    return 0;
+}
+
+const mtd_desc_t mtd_nvram_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = NULL,
+    .flush = NULL,
+    .flags = 0,
+};
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_sdcard
+ * @{
+ *
+ * @file
+ * @brief       MTD device on SD cards
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "mtd_sdcard.h"
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_sdcard_t *dev = (mtd_sdcard_t *)mtd;
+
+    if ((dev->params != NULL) &&
+        (sdcard_spi_init(dev->card, dev->params) != SDCARD_SPI_OK)) {
+        return -EIO;
+    }
+    mtd->page_size = SD_HC_BLOCK_SIZE;
+    mtd->pages_per_sector = MTD_SDCARD_PAGES_PER_SECTOR;
+    mtd->sector_count = sdcard_spi_get_capacity(dev->card) / mtd_sector_size(mtd);
+    return 0;
+}
+
+static int _read(mtd_dev_t *mtd, void *buf, uint32_t addr, uint32_t size)
+{
+    mtd_sdcard_t *dev = (mtd_sdcard_t *)mtd;
+    int blocks = size / SD_HC_BLOCK_SIZE;
+    sd_rw_response_t state;
+
+    if (sdcard_spi_read_blocks(dev->card, addr / SD_HC_BLOCK_SIZE, buf,
+                               SD_HC_BLOCK_SIZE, blocks, &state) != blocks) {
+        return -EIO;
+    }
+    return 0;
+}
+
+static int _write(mtd_dev_t *mtd, const void *buf, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_sdcard_t *dev = (mtd_sdcard_t *)mtd;
+    int blocks = size / SD_HC_BLOCK_SIZE;
+    sd_rw_response_t state;
+
+    if (sdcard_spi_write_blocks(dev->card, addr / SD_HC_BLOCK_SIZE, (char *)buf,
+                                SD_HC_BLOCK_SIZE, blocks, &state) != blocks) {
+        return -EIO;
+    }
+    return 0;
+}
+
+const mtd_desc_t mtd_sdcard_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = NULL,
+    .flush = NULL,
+    .flags = 0,
+};
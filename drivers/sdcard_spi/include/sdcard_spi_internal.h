@@ -97,6 +97,8 @@ extern "C" {
 #define SD_CMD_17 17 /* Reads a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_18 18 /* Continuously transfers data blocks from card to host
                         until interrupted by a STOP_TRANSMISSION command */
+#define SD_CMD_23 23 /* Sent as ACMD23 sets the number of blocks to pre-erase
+                        before the next multiple block write */
 #define SD_CMD_24 24 /* Writes a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_25 25 /* Continuously writes blocks of data until 'Stop Tran'token is sent */
 #define SD_CMD_41 41 /* Reserved (used for ACMD41) */
@@ -111,6 +113,7 @@ extern "C" {
 #define SD_ACMD_41_ARG_HC 0x40000000
 #define SD_CMD_59_ARG_EN  0x00000001
 #define SD_CMD_59_ARG_DIS 0x00000000
+#define SD_ACMD_23_ARG_MASK 0x007FFFFF
 
 /* see sd spec. 7.3.3 Control Tokens */
 #define SD_DATA_TOKEN_CMD_17_18_24 0xFE
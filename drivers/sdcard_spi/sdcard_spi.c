@@ -24,6 +24,7 @@
 #include "sdcard_spi_params.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
+#include "checksum/crc16_ccitt.h"
 #include "xtimer.h"
 
 #include <stdio.h>
@@ -59,7 +60,43 @@ static inline int _sw_spi_rxtx_byte(sdcard_spi_t *card, char out, char *in);
 static inline int _hw_spi_rxtx_byte(sdcard_spi_t *card, char out, char *in);
 
 /* function pointer to switch to hw spi mode after init sequence */
-static int (*_dyn_spi_rxtx_byte)(sdcard_spi_t *card, char out, char *in);
+static int (*_dyn_spi_rxtx_byte)(sdcard_spi_t *card, char out, char *in) = &_hw_spi_rxtx_byte;
+
+/* CRC-7 of each byte value, shifted left by one as transmitted */
+static const uint8_t _crc_7_table[256] = {
+    0x00, 0x12, 0x24, 0x36, 0x48, 0x5a, 0x6c, 0x7e,
+    0x90, 0x82, 0xb4, 0xa6, 0xd8, 0xca, 0xfc, 0xee,
+    0x32, 0x20, 0x16, 0x04, 0x7a, 0x68, 0x5e, 0x4c,
+    0xa2, 0xb0, 0x86, 0x94, 0xea, 0xf8, 0xce, 0xdc,
+    0x64, 0x76, 0x40, 0x52, 0x2c, 0x3e, 0x08, 0x1a,
+    0xf4, 0xe6, 0xd0, 0xc2, 0xbc, 0xae, 0x98, 0x8a,
+    0x56, 0x44, 0x72, 0x60, 0x1e, 0x0c, 0x3a, 0x28,
+    0xc6, 0xd4, 0xe2, 0xf0, 0x8e, 0x9c, 0xaa, 0xb8,
+    0xc8, 0xda, 0xec, 0xfe, 0x80, 0x92, 0xa4, 0xb6,
+    0x58, 0x4a, 0x7c, 0x6e, 0x10, 0x02, 0x34, 0x26,
+    0xfa, 0xe8, 0xde, 0xcc, 0xb2, 0xa0, 0x96, 0x84,
+    0x6a, 0x78, 0x4e, 0x5c, 0x22, 0x30, 0x06, 0x14,
+    0xac, 0xbe, 0x88, 0x9a, 0xe4, 0xf6, 0xc0, 0xd2,
+    0x3c, 0x2e, 0x18, 0x0a, 0x74, 0x66, 0x50, 0x42,
+    0x9e, 0x8c, 0xba, 0xa8, 0xd6, 0xc4, 0xf2, 0xe0,
+    0x0e, 0x1c, 0x2a, 0x38, 0x46, 0x54, 0x62, 0x70,
+    0x82, 0x90, 0xa6, 0xb4, 0xca, 0xd8, 0xee, 0xfc,
+    0x12, 0x00, 0x36, 0x24, 0x5a, 0x48, 0x7e, 0x6c,
+    0xb0, 0xa2, 0x94, 0x86, 0xf8, 0xea, 0xdc, 0xce,
+    0x20, 0x32, 0x04, 0x16, 0x68, 0x7a, 0x4c, 0x5e,
+    0xe6, 0xf4, 0xc2, 0xd0, 0xae, 0xbc, 0x8a, 0x98,
+    0x76, 0x64, 0x52, 0x40, 0x3e, 0x2c, 0x1a, 0x08,
+    0xd4, 0xc6, 0xf0, 0xe2, 0x9c, 0x8e, 0xb8, 0xaa,
+    0x44, 0x56, 0x60, 0x72, 0x0c, 0x1e, 0x28, 0x3a,
+    0x4a, 0x58, 0x6e, 0x7c, 0x02, 0x10, 0x26, 0x34,
+    0xda, 0xc8, 0xfe, 0xec, 0x92, 0x80, 0xb6, 0xa4,
+    0x78, 0x6a, 0x5c, 0x4e, 0x30, 0x22, 0x14, 0x06,
+    0xe8, 0xfa, 0xcc, 0xde, 0xa0, 0xb2, 0x84, 0x96,
+    0x2e, 0x3c, 0x0a, 0x18, 0x66, 0x74, 0x42, 0x50,
+    0xbe, 0xac, 0x9a, 0x88, 0xf6, 0xe4, 0xd2, 0xc0,
+    0x1c, 0x0e, 0x38, 0x2a, 0x54, 0x46, 0x70, 0x62,
+    0x8c, 0x9e, 0xa8, 0xba, 0xc4, 0xd6, 0xe0, 0xf2
+};
 
 int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params)
 {
@@ -374,7 +411,7 @@ static inline bool _wait_for_not_busy(sdcard_spi_t *card, int32_t max_retries)
 
     do {
         if (_dyn_spi_rxtx_byte(card, SD_CARD_DUMMY_BYTE, &read_byte) == 1) {
-            if (read_byte == 0xFF) {
+            if ((uint8_t)read_byte == 0xFF) {
                 DEBUG("_wait_for_not_busy: [OK]\n");
                 return true;
             }
@@ -396,33 +433,18 @@ static inline bool _wait_for_not_busy(sdcard_spi_t *card, int32_t max_retries)
 
 static char _crc_7(const char *data, int n)
 {
-    char crc = 0;
+    uint8_t crc = 0;
 
     for (int i = 0; i < n; i++) {
-        char d = data[i];
-        for (int j = 0; j < 8; j++) {
-            crc <<= 1;
-            if ((d & 0x80) ^ (crc & 0x80)) {
-                crc ^= 0x09;
-            }
-            d <<= 1;
-        }
+        crc = _crc_7_table[crc ^ (uint8_t)data[i]];
     }
-    return (crc << 1) | 1;
+    return crc | 1;
 }
 
 static uint16_t _crc_16(const char *data, size_t n)
 {
-    uint16_t crc = 0;
-
-    for (size_t i = 0; i < n; i++) {
-        crc = (uint8_t)(crc >> 8) | (crc << 8);
-        crc ^= data[i];
-        crc ^= (uint8_t)(crc & 0xFF) >> 4;
-        crc ^= crc << 12;
-        crc ^= (crc & 0xFF) << 5;
-    }
-    return crc;
+    /* the SD data CRC is CRC-CCITT with a start value of 0 */
+    return crc16_ccitt_update(0, (const unsigned char *)data, n);
 }
 
 char sdcard_spi_send_cmd(sdcard_spi_t *card, char sd_cmd_idx, uint32_t argument, int32_t max_retry)
@@ -582,6 +604,22 @@ static inline int _transfer_bytes(sdcard_spi_t *card, char *out, char *in, unsig
     unsigned trans_bytes = 0;
     char in_temp;
 
+    /* in hw mode, hand whole buffers to the SPI driver so it can use DMA or a
+       tight loop instead of one call per byte */
+    if (_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) {
+        if (out != NULL) {
+            spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, out, in, length);
+            return length;
+        }
+        if (in != NULL) {
+            /* spi_transfer_bytes() sends an undefined dummy byte without an
+               output buffer, so send the input buffer filled with 0xFF */
+            memset(in, SD_CARD_DUMMY_BYTE, length);
+            spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, in, in, length);
+            return length;
+        }
+    }
+
     for (trans_bytes = 0; trans_bytes < length; trans_bytes++) {
         if (out != NULL) {
             trans_ret = _dyn_spi_rxtx_byte(card, out[trans_bytes], &in_temp);
@@ -621,7 +659,7 @@ static sd_rw_response_t _read_data_packet(sdcard_spi_t *card, char token, char *
 
         char crc_bytes[2];
         if (_transfer_bytes(card, 0, crc_bytes, sizeof(crc_bytes)) == sizeof(crc_bytes)) {
-            uint16_t data__crc_16 = (crc_bytes[0] << 8) | crc_bytes[1];
+            uint16_t data__crc_16 = ((uint8_t)crc_bytes[0] << 8) | (uint8_t)crc_bytes[1];
 
             if (_crc_16(data, size) == data__crc_16) {
                 DEBUG("_read_data_packet: [OK]\n");
@@ -765,6 +803,12 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, ch
     _select_card_spi(card);
     int written = 0;
 
+    /* tell the card how many blocks follow, so it can pre-erase them (ACMD23).
+       This is only a hint, the write works without it. */
+    if (cmd_idx == SD_CMD_25) {
+        sdcard_spi_send_acmd(card, SD_CMD_23, nbl & SD_ACMD_23_ARG_MASK, 0);
+    }
+
     uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
     char cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRIES);
 
@@ -787,13 +831,16 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, ch
                 *state = write_resu;
                 return written;
             }
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+            written++;
+            /* the card is busy programming the last block while we return:
+               sdcard_spi_send_cmd() waits for it before the next command */
+            if ((cmd_idx == SD_CMD_25) &&
+                !_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
                 DEBUG("_write_blocks: _wait_for_not_busy: [FAILED]\n");
                 _unselect_card_spi(card);
                 *state = SD_RW_TIMEOUT;
                 return written;
             }
-            written++;
         }
 
         /* if this is a multi-block write it is needed to issue a stop command*/
@@ -802,16 +849,12 @@ static inline int _write_blocks(sdcard_spi_t *card, char cmd_idx, int bladdr, ch
                               SD_DATA_TOKEN_CMD_25_STOP);
             DEBUG("_write_blocks: write multi (%d) blocks: [OK]\n", nbl);
 
-            _send_dummy_byte(card); //sd card needs dummy byte before we can wait for not-busy state
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                _unselect_card_spi(card);
-                *state = SD_RW_TIMEOUT;
-            }
+            _send_dummy_byte(card); //sd card needs dummy byte before it signals busy
         }
         else {
             DEBUG("_write_blocks: write single block: [OK]\n");
-            *state = SD_RW_OK;
         }
+        *state = SD_RW_OK;
 
         _unselect_card_spi(card);
         return written;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_sdcard_spi
+ * @{
+ *
+ * @file
+ * @brief       write-behind queue for the sdcard_spi driver.
+ *
+ * @}
+ */
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+#include "sdcard_spi.h"
+#include "thread.h"
+
+#include <string.h>
+
+static void *_wb_thread(void *arg)
+{
+    sdcard_spi_wb_t *wb = arg;
+
+    while (1) {
+        unsigned tail = wb->tail;
+        int n = 1;
+
+        sema_wait(&wb->queued);
+        /* merge following queued blocks with consecutive addresses, up to the
+           end of the ring buffer */
+        while ((tail + n < SDCARD_SPI_WB_BLOCKS) && (sema_try_wait(&wb->queued) == 0)) {
+            if (wb->addr[tail + n] != wb->addr[tail] + n) {
+                sema_post(&wb->queued);
+                break;
+            }
+            n++;
+        }
+
+        sd_rw_response_t state;
+        int written = sdcard_spi_write_blocks(wb->card, wb->addr[tail], wb->buf[tail],
+                                              SD_HC_BLOCK_SIZE, n, &state);
+        if ((written != n) && (wb->state == SD_RW_OK)) {
+            DEBUG("sdcard_spi_wb: writing %d blocks at %d failed (%d)\n",
+                  n, wb->addr[tail], state);
+            wb->state = state;
+        }
+
+        wb->tail = (tail + n) % SDCARD_SPI_WB_BLOCKS;
+        for (int i = 0; i < n; i++) {
+            sema_post(&wb->free);
+        }
+    }
+
+    return NULL;
+}
+
+kernel_pid_t sdcard_spi_wb_init(sdcard_spi_wb_t *wb, sdcard_spi_t *card, char *stack,
+                                int stacksize, char priority)
+{
+    wb->card = card;
+    wb->head = 0;
+    wb->tail = 0;
+    wb->state = SD_RW_OK;
+    sema_create(&wb->free, SDCARD_SPI_WB_BLOCKS);
+    sema_create(&wb->queued, 0);
+    wb->pid = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                            _wb_thread, wb, "sdcard_wb");
+    return wb->pid;
+}
+
+int sdcard_spi_wb_write(sdcard_spi_wb_t *wb, int blockaddr, const char *data, int nblocks)
+{
+    for (int i = 0; i < nblocks; i++) {
+        sema_wait(&wb->free);
+        memcpy(wb->buf[wb->head], &data[i * SD_HC_BLOCK_SIZE], SD_HC_BLOCK_SIZE);
+        wb->addr[wb->head] = blockaddr + i;
+        wb->head = (wb->head + 1) % SDCARD_SPI_WB_BLOCKS;
+        sema_post(&wb->queued);
+    }
+    return nblocks;
+}
+
+sd_rw_response_t sdcard_spi_wb_flush(sdcard_spi_wb_t *wb)
+{
+    /* all slots are free once the writer thread is done */
+    for (int i = 0; i < SDCARD_SPI_WB_BLOCKS; i++) {
+        sema_wait(&wb->free);
+    }
+    for (int i = 0; i < SDCARD_SPI_WB_BLOCKS; i++) {
+        sema_post(&wb->free);
+    }
+
+    sd_rw_response_t state = wb->state;
+    wb->state = SD_RW_OK;
+    return state;
+}
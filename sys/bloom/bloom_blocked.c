@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom
+ * @{
+ *
+ * @file
+ * @brief       Blocked and counting Bloom filter implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "bloom.h"
+#include "hashes.h"
+
+/* strings hashed at once by the _many() functions */
+#define GROUP_SIZE          (8U)
+
+#define COUNTER_MAX         (0xfU)
+
+/* returns the block of a string, and the bits it takes in there */
+static size_t _locate(size_t blocks_numof, unsigned k, const uint8_t *buf,
+                      size_t len, uint32_t *mask)
+{
+    uint64_t hash = fnv1a64_hash(buf, len);
+    uint32_t hi = hash >> 32;
+    /* the low half of FNV is mixed poorly, fold in some of the high half */
+    uint32_t lo = (uint32_t)hash ^ (hi >> 8);
+    /* with only 32 positions, plain double hashing yields too few distinct
+     * patterns, so the step grows each round (enhanced double hashing) */
+    unsigned pos = lo;
+    unsigned step = lo >> 5;
+    uint32_t res = 0;
+
+    for (unsigned i = 0; i < k; i++) {
+        res |= (uint32_t)1 << (pos & (BLOOM_BLOCK_BITS - 1));
+        pos += step;
+        step += i;
+    }
+    *mask = res;
+    /* scale to the number of blocks without a division */
+    return ((uint64_t)hi * blocks_numof) >> 32;
+}
+
+void bloom_blocked_init(bloom_blocked_t *bloom, uint32_t *blocks,
+                        size_t blocks_numof, unsigned k)
+{
+    assert((blocks_numof > 0) && (k > 0) && (k <= BLOOM_BLOCKED_K_MAX));
+    bloom->blocks = blocks;
+    bloom->blocks_numof = blocks_numof;
+    bloom->k = k;
+    bloom_blocked_clear(bloom);
+}
+
+void bloom_blocked_clear(bloom_blocked_t *bloom)
+{
+    memset(bloom->blocks, 0, bloom->blocks_numof * sizeof(bloom->blocks[0]));
+}
+
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len)
+{
+    uint32_t mask;
+    size_t block = _locate(bloom->blocks_numof, bloom->k, buf, len, &mask);
+
+    bloom->blocks[block] |= mask;
+}
+
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len)
+{
+    uint32_t mask;
+    size_t block = _locate(bloom->blocks_numof, bloom->k, buf, len, &mask);
+
+    return (bloom->blocks[block] & mask) == mask;
+}
+
+void bloom_blocked_add_many(bloom_blocked_t *bloom, const uint8_t *const *bufs,
+                            const size_t *lens, unsigned num)
+{
+    size_t block[GROUP_SIZE];
+    uint32_t mask[GROUP_SIZE];
+
+    while (num > 0) {
+        unsigned n = (num < GROUP_SIZE) ? num : GROUP_SIZE;
+
+        for (unsigned i = 0; i < n; i++) {
+            block[i] = _locate(bloom->blocks_numof, bloom->k, bufs[i], lens[i],
+                               &mask[i]);
+        }
+        for (unsigned i = 0; i < n; i++) {
+            bloom->blocks[block[i]] |= mask[i];
+        }
+        bufs += n;
+        lens += n;
+        num -= n;
+    }
+}
+
+unsigned bloom_blocked_check_many(const bloom_blocked_t *bloom,
+                                  const uint8_t *const *bufs,
+                                  const size_t *lens, unsigned num, bool *res)
+{
+    size_t block[GROUP_SIZE];
+    uint32_t mask[GROUP_SIZE];
+    unsigned found = 0;
+
+    while (num > 0) {
+        unsigned n = (num < GROUP_SIZE) ? num : GROUP_SIZE;
+
+        for (unsigned i = 0; i < n; i++) {
+            block[i] = _locate(bloom->blocks_numof, bloom->k, bufs[i], lens[i],
+                               &mask[i]);
+        }
+        for (unsigned i = 0; i < n; i++) {
+            bool in = (bloom->blocks[block[i]] & mask[i]) == mask[i];
+
+            if (res) {
+                *(res++) = in;
+            }
+            found += in;
+        }
+        bufs += n;
+        lens += n;
+        num -= n;
+    }
+    return found;
+}
+
+static inline unsigned _counter(const uint8_t *counters, size_t idx)
+{
+    return (counters[idx >> 1] >> ((idx & 1) * 4)) & COUNTER_MAX;
+}
+
+static inline void _counter_inc(uint8_t *counters, size_t idx)
+{
+    if (_counter(counters, idx) < COUNTER_MAX) {
+        counters[idx >> 1] += 1 << ((idx & 1) * 4);
+    }
+}
+
+/* saturated counters are kept, they may count more strings than known */
+static inline void _counter_dec(uint8_t *counters, size_t idx)
+{
+    if (_counter(counters, idx) < COUNTER_MAX) {
+        counters[idx >> 1] -= 1 << ((idx & 1) * 4);
+    }
+}
+
+static bool _counters_set(const uint8_t *counters, size_t idx, uint32_t mask)
+{
+    for (; mask; idx++, mask >>= 1) {
+        if ((mask & 1) && (_counter(counters, idx) == 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters,
+                         size_t blocks_numof, unsigned k)
+{
+    assert((blocks_numof > 0) && (k > 0) && (k <= BLOOM_BLOCKED_K_MAX));
+    bloom->counters = counters;
+    bloom->blocks_numof = blocks_numof;
+    bloom->k = k;
+    bloom_counting_clear(bloom);
+}
+
+void bloom_counting_clear(bloom_counting_t *bloom)
+{
+    memset(bloom->counters, 0, BLOOM_COUNTING_SIZE(bloom->blocks_numof));
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len)
+{
+    uint32_t mask;
+    size_t base = _locate(bloom->blocks_numof, bloom->k, buf, len, &mask) *
+                  BLOOM_BLOCK_BITS;
+
+    for (size_t idx = base; mask; idx++, mask >>= 1) {
+        if (mask & 1) {
+            _counter_inc(bloom->counters, idx);
+        }
+    }
+}
+
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    uint32_t mask;
+    size_t base = _locate(bloom->blocks_numof, bloom->k, buf, len, &mask) *
+                  BLOOM_BLOCK_BITS;
+
+    return _counters_set(bloom->counters, base, mask);
+}
+
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    uint32_t mask;
+    size_t base = _locate(bloom->blocks_numof, bloom->k, buf, len, &mask) *
+                  BLOOM_BLOCK_BITS;
+
+    if (!_counters_set(bloom->counters, base, mask)) {
+        return -ENOENT;
+    }
+    for (size_t idx = base; mask; idx++, mask >>= 1) {
+        if (mask & 1) {
+            _counter_dec(bloom->counters, idx);
+        }
+    }
+    return 0;
+}
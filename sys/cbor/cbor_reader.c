@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     cbor
+ * @{
+ *
+ * @file
+ * @brief       Cursor based CBOR decoder
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cbor.h"
+
+#define INDEFINITE      (31)
+/* number of items left on a level of indefinite length */
+#define UNTIL_BREAK     (UINT64_MAX)
+
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *data, size_t size)
+{
+    reader->data = data;
+    reader->size = size;
+    reader->pos = 0;
+}
+
+/*
+ * Reads the initial byte and argument of the item at *pos. Returns the major
+ * type, or a negative errno.
+ */
+static inline int _header(const cbor_reader_t *reader, size_t *pos,
+                          uint8_t *info, uint64_t *val)
+{
+    const uint8_t *data = reader->data;
+    size_t p = *pos;
+    uint8_t major;
+
+    if (p >= reader->size) {
+        return -ENODATA;
+    }
+    major = data[p] >> 5;
+    *info = data[p++] & 0x1f;
+    if (*info < 24) {
+        *val = *info;
+    }
+    else if (*info < 28) {
+        unsigned len = 1U << (*info - 24);
+        uint64_t arg = 0;
+
+        if (len > reader->size - p) {
+            return -EBADMSG;
+        }
+        while (len--) {
+            arg = (arg << 8) | data[p++];
+        }
+        *val = arg;
+    }
+    else if ((*info != INDEFINITE) || (major < CBOR_TYPE_BYTES) ||
+             (major == CBOR_TYPE_TAG)) {
+        return -EBADMSG;
+    }
+    else {
+        *val = 0;
+    }
+    *pos = p;
+    return major;
+}
+
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item)
+{
+    size_t pos = reader->pos;
+    int major = _header(reader, &pos, &item->info, &item->val);
+
+    if (major < 0) {
+        return major;
+    }
+    item->type = (cbor_type_t)major;
+    item->indefinite = (item->info == INDEFINITE) &&
+                       (item->type != CBOR_TYPE_SIMPLE);
+    item->data = NULL;
+
+    if (((item->type == CBOR_TYPE_BYTES) || (item->type == CBOR_TYPE_TEXT)) &&
+        !item->indefinite) {
+        if (item->val > reader->size - pos) {
+            return -EBADMSG;
+        }
+        item->data = &reader->data[pos];
+        pos += item->val;
+    }
+    reader->pos = pos;
+    return 0;
+}
+
+int cbor_reader_skip(cbor_reader_t *reader)
+{
+    /* items left to skip on each level of nesting */
+    uint64_t left[CBOR_READER_DEPTH + 1];
+    unsigned depth = 0;
+    size_t pos = reader->pos;
+
+    left[0] = 1;
+    while ((depth > 0) || (left[0] > 0)) {
+        uint64_t val, nested = 0;
+        uint8_t info;
+        int major;
+
+        if (left[depth] == 0) {
+            depth--;
+            continue;
+        }
+        /* only the headers are decoded, strings are stepped over */
+        if ((major = _header(reader, &pos, &info, &val)) < 0) {
+            return major;
+        }
+        if ((major == CBOR_TYPE_SIMPLE) && (info == INDEFINITE)) {
+            if (left[depth] != UNTIL_BREAK) {
+                return -EBADMSG;
+            }
+            depth--;
+            continue;
+        }
+        if (left[depth] != UNTIL_BREAK) {
+            left[depth]--;
+        }
+        switch (major) {
+            case CBOR_TYPE_BYTES:
+            case CBOR_TYPE_TEXT:
+                if (val > reader->size - pos) {
+                    return -EBADMSG;
+                }
+                pos += val;
+                break;
+            case CBOR_TYPE_ARRAY:
+                nested = val;
+                break;
+            case CBOR_TYPE_MAP:
+                /* each item takes at least one byte */
+                if (val > reader->size - pos) {
+                    return -EBADMSG;
+                }
+                nested = 2 * val;
+                break;
+            case CBOR_TYPE_TAG:
+                nested = 1;
+                break;
+            default:
+                break;
+        }
+        if (nested > reader->size - pos) {
+            return -EBADMSG;
+        }
+        if ((info == INDEFINITE) ||
+            ((nested > 0) && (left[depth] == UNTIL_BREAK))) {
+            /* a new level, as the current one can't count the items */
+            if (depth == CBOR_READER_DEPTH) {
+                return -ENOMEM;
+            }
+            left[++depth] = (info == INDEFINITE) ? UNTIL_BREAK : nested;
+        }
+        else {
+            left[depth] += nested;
+        }
+    }
+    reader->pos = pos;
+    return 0;
+}
+
+int cbor_reader_int(cbor_reader_t *reader, int64_t *val)
+{
+    size_t pos = reader->pos;
+    uint8_t info;
+    uint64_t arg;
+    int major = _header(reader, &pos, &info, &arg);
+
+    if (major < 0) {
+        return major;
+    }
+    if ((major > CBOR_TYPE_NEGINT) || (arg > INT64_MAX)) {
+        return -EBADMSG;
+    }
+    *val = (major == CBOR_TYPE_UINT) ? (int64_t)arg : -1 - (int64_t)arg;
+    reader->pos = pos;
+    return 0;
+}
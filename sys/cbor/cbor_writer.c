@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     cbor
+ * @{
+ *
+ * @file
+ * @brief       Streaming CBOR encoder
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "cbor.h"
+
+#define MT_UINT         (0x00)
+#define MT_NEGINT       (0x20)
+#define MT_BYTES        (0x40)
+#define MT_TEXT         (0x60)
+#define MT_ARRAY        (0x80)
+#define MT_MAP          (0xa0)
+#define MT_TAG          (0xc0)
+#define MT_SIMPLE       (0xe0)
+
+#define INDEFINITE      (31)
+#define FALSE           (MT_SIMPLE | 20)
+#define TRUE            (MT_SIMPLE | 21)
+#define FLOAT32         (MT_SIMPLE | 26)
+#define BREAK           (MT_SIMPLE | 31)
+
+/* longest header: initial byte and 64 bit argument */
+#define HDR_MAX         (9U)
+
+void cbor_writer_init(cbor_writer_t *writer, uint8_t *buf, size_t size,
+                      cbor_sink_t sink, void *arg)
+{
+    writer->buf = buf;
+    writer->size = size;
+    writer->pos = 0;
+    writer->flushed = 0;
+    writer->sink = sink;
+    writer->arg = arg;
+    writer->err = (size < HDR_MAX) ? -ENOBUFS : 0;
+}
+
+static int _flush(cbor_writer_t *writer)
+{
+    if (writer->err == 0) {
+        if (writer->sink == NULL) {
+            writer->err = -ENOBUFS;
+        }
+        else if (writer->pos > 0) {
+            writer->err = writer->sink(writer->arg, writer->buf, writer->pos);
+            writer->flushed += writer->pos;
+            writer->pos = 0;
+        }
+    }
+    return writer->err;
+}
+
+/* Makes room for len bytes in the buffer. */
+static int _reserve(cbor_writer_t *writer, size_t len)
+{
+    if (writer->err != 0) {
+        return writer->err;
+    }
+    if (writer->pos + len > writer->size) {
+        return _flush(writer);
+    }
+    return 0;
+}
+
+static int _head(cbor_writer_t *writer, uint8_t major, uint64_t val)
+{
+    unsigned follow = (val < 24) ? 0 : (val <= 0xff) ? 1 : (val <= 0xffff) ? 2 :
+                      (val <= 0xffffffffUL) ? 4 : 8;
+    uint8_t *p;
+
+    if (_reserve(writer, 1 + follow) < 0) {
+        return writer->err;
+    }
+    p = writer->buf + writer->pos;
+    switch (follow) {
+        case 0:
+            *p++ = major | val;
+            break;
+        case 1:
+            *p++ = major | 24;
+            break;
+        case 2:
+            *p++ = major | 25;
+            break;
+        case 4:
+            *p++ = major | 26;
+            break;
+        default:
+            *p++ = major | 27;
+            break;
+    }
+    for (unsigned i = follow; i > 0; i--) {
+        *p++ = val >> (8 * (i - 1));
+    }
+    writer->pos = p - writer->buf;
+    return 0;
+}
+
+static int _byte(cbor_writer_t *writer, uint8_t byte)
+{
+    if (_reserve(writer, 1) < 0) {
+        return writer->err;
+    }
+    writer->buf[writer->pos++] = byte;
+    return 0;
+}
+
+static int _string(cbor_writer_t *writer, uint8_t major, const void *data,
+                   size_t len)
+{
+    if (_head(writer, major, len) < 0) {
+        return writer->err;
+    }
+    if (writer->pos + len <= writer->size) {
+        memcpy(writer->buf + writer->pos, data, len);
+        writer->pos += len;
+    }
+    else if (_flush(writer) == 0) {
+        /* too large to buffer, pass it on as it is */
+        writer->err = writer->sink(writer->arg, data, len);
+        writer->flushed += len;
+    }
+    return writer->err;
+}
+
+int cbor_writer_uint(cbor_writer_t *writer, uint64_t val)
+{
+    return _head(writer, MT_UINT, val);
+}
+
+int cbor_writer_int(cbor_writer_t *writer, int64_t val)
+{
+    if (val < 0) {
+        return _head(writer, MT_NEGINT, -1 - val);
+    }
+    return _head(writer, MT_UINT, val);
+}
+
+int cbor_writer_bytes(cbor_writer_t *writer, const void *data, size_t len)
+{
+    return _string(writer, MT_BYTES, data, len);
+}
+
+int cbor_writer_text(cbor_writer_t *writer, const char *text, size_t len)
+{
+    return _string(writer, MT_TEXT, text, len);
+}
+
+int cbor_writer_array(cbor_writer_t *writer, size_t len)
+{
+    return _head(writer, MT_ARRAY, len);
+}
+
+int cbor_writer_map(cbor_writer_t *writer, size_t len)
+{
+    return _head(writer, MT_MAP, len);
+}
+
+int cbor_writer_array_indefinite(cbor_writer_t *writer)
+{
+    return _byte(writer, MT_ARRAY | INDEFINITE);
+}
+
+int cbor_writer_map_indefinite(cbor_writer_t *writer)
+{
+    return _byte(writer, MT_MAP | INDEFINITE);
+}
+
+int cbor_writer_break(cbor_writer_t *writer)
+{
+    return _byte(writer, BREAK);
+}
+
+int cbor_writer_tag(cbor_writer_t *writer, uint64_t tag)
+{
+    return _head(writer, MT_TAG, tag);
+}
+
+int cbor_writer_bool(cbor_writer_t *writer, bool val)
+{
+    return _byte(writer, val ? TRUE : FALSE);
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_writer_float(cbor_writer_t *writer, float val)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .f = val };
+    uint8_t *p;
+
+    if (_reserve(writer, 5) < 0) {
+        return writer->err;
+    }
+    p = writer->buf + writer->pos;
+    p[0] = FLOAT32;
+    p[1] = bits.u >> 24;
+    p[2] = bits.u >> 16;
+    p[3] = bits.u >> 8;
+    p[4] = bits.u;
+    writer->pos += 5;
+    return 0;
+}
+#endif /* CBOR_NO_FLOAT */
+
+int cbor_writer_flush(cbor_writer_t *writer)
+{
+    if ((writer->sink == NULL) || (writer->err != 0)) {
+        return writer->err;
+    }
+    return _flush(writer);
+}
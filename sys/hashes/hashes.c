@@ -109,3 +109,15 @@ uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len)
     hash += hash << 15;
     return hash;
 }
+
+uint64_t fnv1a64_hash(const uint8_t *buf, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_heap
+ * @{
+ *
+ * @file
+ * @brief       System heap implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "heap.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+extern void *sbrk(int incr);
+
+/* largest pool tlsf_heap_add_pool() accepts */
+#define HEAP_POOL_MAX   ((size_t)1 << TLSF_HEAP_SIZE_LOG2)
+
+static heap_arena_t _shared = { .lock = MUTEX_INIT };
+
+#ifdef MODULE_HEAP_ARENAS
+static heap_arena_t *_arenas;
+static heap_arena_t *_used_by[KERNEL_PID_LAST + 1];
+#endif
+
+/* must be called with the lock of _shared held */
+static int _grow(size_t size)
+{
+    /* pool overhead, plus what aligning the pool may cost */
+    size_t chunk = size + 4 * TLSF_HEAP_ALIGN;
+    void *mem;
+    int res;
+
+    if (size > HEAP_ALLOC_MAX) {
+        return -ENOMEM;
+    }
+    if (chunk < HEAP_CHUNK_SIZE) {
+        chunk = HEAP_CHUNK_SIZE;
+    }
+    if (chunk > HEAP_POOL_MAX) {
+        chunk = HEAP_POOL_MAX;
+    }
+    mem = sbrk(chunk);
+    if (mem == (void *)-1) {
+        return -ENOMEM;
+    }
+    res = tlsf_heap_add_pool(&_shared.heap, mem, chunk);
+    if (res < 0) {
+        /* nothing else takes memory from sbrk(), give the chunk back */
+        sbrk(-(int)chunk);
+        return res;
+    }
+    DEBUG("heap: took %u bytes at %p\n", (unsigned)chunk, mem);
+    return 0;
+}
+
+static heap_arena_t *_owner(const void *ptr)
+{
+#ifdef MODULE_HEAP_ARENAS
+    for (heap_arena_t *arena = _arenas; arena; arena = arena->next) {
+        if (tlsf_heap_contains(&arena->heap, ptr)) {
+            return arena;
+        }
+    }
+#else
+    (void)ptr;
+#endif
+    return &_shared;
+}
+
+void *heap_malloc(size_t size)
+{
+    void *ptr;
+
+#ifdef MODULE_HEAP_ARENAS
+    heap_arena_t *arena = _used_by[thread_getpid()];
+
+    if (arena) {
+        mutex_lock(&arena->lock);
+        ptr = tlsf_heap_alloc(&arena->heap, size);
+        mutex_unlock(&arena->lock);
+        if (ptr) {
+            return ptr;
+        }
+    }
+#endif
+    mutex_lock(&_shared.lock);
+    ptr = tlsf_heap_alloc(&_shared.heap, size);
+    if ((ptr == NULL) && (size > 0) && (_grow(size) == 0)) {
+        ptr = tlsf_heap_alloc(&_shared.heap, size);
+    }
+    mutex_unlock(&_shared.lock);
+    return ptr;
+}
+
+void *heap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr;
+
+    if ((size > 0) && (nmemb > SIZE_MAX / size)) {
+        return NULL;
+    }
+    ptr = heap_malloc(nmemb * size);
+    if (ptr) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void *heap_realloc(void *ptr, size_t size)
+{
+    heap_arena_t *arena;
+    void *res;
+
+    if ((ptr == NULL) || (size == 0)) {
+        heap_free(ptr);
+        return (size == 0) ? NULL : heap_malloc(size);
+    }
+    arena = _owner(ptr);
+    mutex_lock(&arena->lock);
+    res = tlsf_heap_realloc(&arena->heap, ptr, size);
+    mutex_unlock(&arena->lock);
+    if (res == NULL) {
+        /* full, try the other arenas */
+        size_t old = tlsf_heap_size(ptr);
+
+        res = heap_malloc(size);
+        if (res) {
+            memcpy(res, ptr, (old < size) ? old : size);
+            heap_free(ptr);
+        }
+    }
+    return res;
+}
+
+void heap_free(void *ptr)
+{
+    heap_arena_t *arena;
+
+    if (ptr == NULL) {
+        return;
+    }
+    arena = _owner(ptr);
+    mutex_lock(&arena->lock);
+    tlsf_heap_free(&arena->heap, ptr);
+    mutex_unlock(&arena->lock);
+}
+
+static void _print(const char *name, heap_arena_t *arena)
+{
+    tlsf_heap_stats_t stats;
+
+    mutex_lock(&arena->lock);
+    tlsf_heap_stats(&arena->heap, &stats);
+    mutex_unlock(&arena->lock);
+    printf("%-8s %7u %7u %7u %7u %7u %6u %6u %3u%%\n", name,
+           (unsigned)stats.size, (unsigned)stats.used, (unsigned)stats.peak,
+           (unsigned)stats.free, (unsigned)stats.largest, stats.used_blocks,
+           stats.free_blocks, tlsf_heap_fragmentation(&stats));
+}
+
+void heap_stats(void)
+{
+    puts("arena       size    used    peak    free largest   used   free frag");
+    _print("shared", &_shared);
+#ifdef MODULE_HEAP_ARENAS
+    unsigned i = 0;
+
+    for (heap_arena_t *arena = _arenas; arena; arena = arena->next) {
+        char name[12];
+
+        snprintf(name, sizeof(name), "arena%u", i++);
+        _print(name, arena);
+    }
+#endif
+}
+
+#ifdef MODULE_HEAP_ARENAS
+int heap_arena_init(heap_arena_t *arena, void *mem, size_t size)
+{
+    int res;
+
+    tlsf_heap_init(&arena->heap);
+    res = tlsf_heap_add_pool(&arena->heap, mem, size);
+    if (res < 0) {
+        return res;
+    }
+    mutex_init(&arena->lock);
+    mutex_lock(&_shared.lock);
+    arena->next = _arenas;
+    _arenas = arena;
+    mutex_unlock(&_shared.lock);
+    return 0;
+}
+
+void heap_arena_use(kernel_pid_t pid, heap_arena_t *arena)
+{
+    assert(pid_is_valid(pid));
+    _used_by[pid] = arena;
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_heap
+ * @{
+ *
+ * @file
+ * @brief       Replacement of the C library's allocator
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "heap.h"
+
+void *malloc(size_t size)
+{
+    return heap_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    return heap_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    return heap_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+    heap_free(ptr);
+}
+
+#ifdef MODULE_NEWLIB
+#include <reent.h>
+
+/* newlib calls these internally, e.g. from stdio */
+void *_malloc_r(struct _reent *r, size_t size)
+{
+    void *ptr = heap_malloc(size);
+
+    if ((ptr == NULL) && (size > 0)) {
+        r->_errno = ENOMEM;
+    }
+    return ptr;
+}
+
+void *_calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+    void *ptr = heap_calloc(nmemb, size);
+
+    if ((ptr == NULL) && (nmemb > 0) && (size > 0)) {
+        r->_errno = ENOMEM;
+    }
+    return ptr;
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    void *res = heap_realloc(ptr, size);
+
+    if ((res == NULL) && (size > 0)) {
+        r->_errno = ENOMEM;
+    }
+    return res;
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    heap_free(ptr);
+}
+#endif
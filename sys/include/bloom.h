@@ -228,6 +228,198 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @name Blocked Bloom filters
+ *
+ * A blocked filter hashes each string only once, with fnv1a64_hash(). One
+ * half of the hash selects a 32 bit block of the filter, the other half
+ * is split into a start bit and a step, from which the k bits inside the
+ * block are derived by (enhanced) double hashing. Adding and checking a
+ * string thus costs a single hash, one word access and no division,
+ * regardless of k.
+ *
+ * Confining all bits of a string to one block makes the false positive
+ * rate higher than the one of a classic filter of the same size, and
+ * favours a smaller k: with 8 bits per string, k = 4 gives about 4.5%
+ * instead of 2.5% of a classic filter with its optimal k.
+ *
+ * The counting variant keeps a 4 bit counter instead of a bit, so strings
+ * can be removed again. It takes four times the memory. Counters that
+ * reached 15 stay there, as it is unknown how many strings they count.
+ * @{
+ */
+
+/**
+ * @brief Number of bits in a block of a blocked filter
+ */
+#define BLOOM_BLOCK_BITS        (32U)
+
+/**
+ * @brief Maximum number of bits set per string in a blocked filter
+ */
+#define BLOOM_BLOCKED_K_MAX     (16U)
+
+/**
+ * @brief Number of blocks needed for a filter of @p bits bits
+ */
+#define BLOOM_BLOCKS(bits)      (((bits) + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS)
+
+/**
+ * @brief Number of bytes of counters of a counting filter with @p blocks
+ *        blocks
+ */
+#define BLOOM_COUNTING_SIZE(blocks) ((blocks) * (BLOOM_BLOCK_BITS / 2))
+
+/**
+ * @brief Blocked Bloom filter
+ */
+typedef struct {
+    uint32_t *blocks;       /**< the filter */
+    size_t blocks_numof;    /**< number of blocks in the filter */
+    unsigned k;             /**< number of bits set per string */
+} bloom_blocked_t;
+
+/**
+ * @brief Counting blocked Bloom filter
+ */
+typedef struct {
+    uint8_t *counters;      /**< two 4 bit counters per byte */
+    size_t blocks_numof;    /**< number of blocks of counters */
+    unsigned k;             /**< number of counters incremented per string */
+} bloom_counting_t;
+
+/**
+ * @brief Initialize and clear a blocked Bloom filter
+ *
+ * @param bloom             filter to initialize
+ * @param blocks            memory of the filter
+ * @param blocks_numof      number of elements in @p blocks
+ * @param k                 number of bits to set per string, 1 to
+ *                          @ref BLOOM_BLOCKED_K_MAX
+ */
+void bloom_blocked_init(bloom_blocked_t *bloom, uint32_t *blocks,
+                        size_t blocks_numof, unsigned k);
+
+/**
+ * @brief Remove all strings from a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ */
+void bloom_blocked_clear(bloom_blocked_t *bloom);
+
+/**
+ * @brief Add a string to a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a string is in a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len);
+
+/**
+ * @brief Add several strings to a blocked Bloom filter
+ *
+ * The strings are hashed in groups before the filter is touched, which
+ * keeps the hashing loop free of memory accesses to the filter.
+ *
+ * @param bloom  Bloom filter
+ * @param bufs   strings to add
+ * @param lens   lengths of the strings in @p bufs
+ * @param num    number of strings
+ */
+void bloom_blocked_add_many(bloom_blocked_t *bloom, const uint8_t *const *bufs,
+                            const size_t *lens, unsigned num);
+
+/**
+ * @brief Determine which of several strings are in a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param bufs   strings to check
+ * @param lens   lengths of the strings in @p bufs
+ * @param num    number of strings
+ * @param[out] res  result of bloom_blocked_check() for each string, may be
+ *                  NULL
+ *
+ * @return       number of strings that may be in the filter
+ */
+unsigned bloom_blocked_check_many(const bloom_blocked_t *bloom,
+                                  const uint8_t *const *bufs,
+                                  const size_t *lens, unsigned num, bool *res);
+
+/**
+ * @brief Initialize and clear a counting Bloom filter
+ *
+ * @param bloom             filter to initialize
+ * @param counters          memory of the filter, of
+ *                          BLOOM_COUNTING_SIZE(@p blocks_numof) bytes
+ * @param blocks_numof      number of blocks of counters
+ * @param k                 number of counters to increment per string, 1
+ *                          to @ref BLOOM_BLOCKED_K_MAX
+ */
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters,
+                         size_t blocks_numof, unsigned k);
+
+/**
+ * @brief Remove all strings from a counting Bloom filter
+ *
+ * @param bloom  Bloom filter
+ */
+void bloom_counting_clear(bloom_counting_t *bloom);
+
+/**
+ * @brief Add a string to a counting Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a string is in a counting Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+
+/**
+ * @brief Remove a string from a counting Bloom filter
+ *
+ * Only strings that were added before may be removed, removing any other
+ * string that happens to pass bloom_counting_check() causes false
+ * negatives.
+ *
+ * @param bloom  Bloom filter
+ * @param buf    string to remove
+ * @param len    the length of the string @p buf
+ *
+ * @return       0 on success
+ * @return       -ENOENT if the string is not in the filter, the filter is
+ *               left untouched then
+ */
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -653,6 +653,362 @@ bool cbor_at_break(const cbor_stream_t *stream, size_t offset);
  */
 bool cbor_at_end(const cbor_stream_t *stream, size_t offset);
 
+/**
+ * @name    Streaming encoder
+ *
+ * The writer encodes into a small buffer and hands the buffer to a sink
+ * whenever the next item doesn't fit, e.g. to send it over a socket or as a
+ * CoAP block. Payloads of byte and text strings larger than the free space
+ * are passed to the sink directly instead of being copied.
+ *
+ * Basic usage:
+ * @code
+ * static int sink(void *arg, const uint8_t *data, size_t len)
+ * {
+ *     return (sock_udp_send(arg, data, len, NULL) < 0) ? -EIO : 0;
+ * }
+ *
+ * uint8_t buf[64];
+ * cbor_writer_t writer;
+ * cbor_writer_init(&writer, buf, sizeof(buf), sink, &sock);
+ * cbor_writer_array(&writer, 2);
+ * cbor_writer_int(&writer, 5);
+ * cbor_writer_text(&writer, "five", 4);
+ * if (cbor_writer_flush(&writer) < 0) {
+ *     <an item failed to encode or the sink returned an error>
+ * }
+ * @endcode
+ *
+ * Errors are sticky: after the first error, all functions return it without
+ * writing anything.
+ * @{
+ */
+
+/**
+ * @brief   Sink of a writer
+ *
+ * @param[in] arg   argument given to cbor_writer_init()
+ * @param[in] data  encoded data
+ * @param[in] len   length of @p data
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+typedef int (*cbor_sink_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Streaming encoder
+ */
+typedef struct {
+    uint8_t *buf;               /**< buffer, at least 9 bytes */
+    size_t size;                /**< size of the buffer */
+    size_t pos;                 /**< bytes in the buffer */
+    size_t flushed;             /**< bytes passed to the sink */
+    cbor_sink_t sink;           /**< sink, NULL to only fill the buffer */
+    void *arg;                  /**< argument of the sink */
+    int err;                    /**< first error */
+} cbor_writer_t;
+
+/**
+ * @brief   Initializes a writer
+ *
+ * @param[out] writer   the writer
+ * @param[in]  buf      buffer for the encoded data, at least 9 bytes
+ * @param[in]  size     size of @p buf
+ * @param[in]  sink     sink for the encoded data, NULL to encode into @p buf
+ *                      only
+ * @param[in]  arg      argument of @p sink
+ */
+void cbor_writer_init(cbor_writer_t *writer, uint8_t *buf, size_t size,
+                      cbor_sink_t sink, void *arg);
+
+/**
+ * @brief   Encodes an unsigned integer
+ *
+ * @param[in] writer    the writer
+ * @param[in] val       the value
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS if there is no sink and the buffer is full
+ * @return  other negative errno returned by the sink
+ */
+int cbor_writer_uint(cbor_writer_t *writer, uint64_t val);
+
+/**
+ * @brief   Encodes a signed integer
+ *
+ * @param[in] writer    the writer
+ * @param[in] val       the value
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_int(cbor_writer_t *writer, int64_t val);
+
+/**
+ * @brief   Encodes a byte string
+ *
+ * @param[in] writer    the writer
+ * @param[in] data      the bytes
+ * @param[in] len       length of @p data
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_bytes(cbor_writer_t *writer, const void *data, size_t len);
+
+/**
+ * @brief   Encodes a text string
+ *
+ * @param[in] writer    the writer
+ * @param[in] text      UTF-8 string
+ * @param[in] len       length of @p text in bytes
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_text(cbor_writer_t *writer, const char *text, size_t len);
+
+/**
+ * @brief   Encodes the header of an array of @p len items
+ *
+ * @param[in] writer    the writer
+ * @param[in] len       number of items that follow
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_array(cbor_writer_t *writer, size_t len);
+
+/**
+ * @brief   Encodes the header of a map of @p len pairs
+ *
+ * @param[in] writer    the writer
+ * @param[in] len       number of key/value pairs that follow
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_map(cbor_writer_t *writer, size_t len);
+
+/**
+ * @brief   Encodes the header of an array of indefinite length
+ *
+ * End the array with cbor_writer_break().
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_array_indefinite(cbor_writer_t *writer);
+
+/**
+ * @brief   Encodes the header of a map of indefinite length
+ *
+ * End the map with cbor_writer_break().
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_map_indefinite(cbor_writer_t *writer);
+
+/**
+ * @brief   Ends an array or map of indefinite length
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_break(cbor_writer_t *writer);
+
+/**
+ * @brief   Encodes a tag for the next item
+ *
+ * @param[in] writer    the writer
+ * @param[in] tag       the tag
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_tag(cbor_writer_t *writer, uint64_t tag);
+
+/**
+ * @brief   Encodes a boolean
+ *
+ * @param[in] writer    the writer
+ * @param[in] val       the value
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_bool(cbor_writer_t *writer, bool val);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief   Encodes a single precision floating point value
+ *
+ * @param[in] writer    the writer
+ * @param[in] val       the value
+ *
+ * @return  see cbor_writer_uint()
+ */
+int cbor_writer_float(cbor_writer_t *writer, float val);
+#endif /* CBOR_NO_FLOAT */
+
+/**
+ * @brief   Passes the buffered data to the sink
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  0 on success, also if there is no sink
+ * @return  the first error of the writer
+ */
+int cbor_writer_flush(cbor_writer_t *writer);
+
+/**
+ * @brief   Returns the number of bytes encoded so far
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  bytes passed to the sink and in the buffer
+ */
+static inline size_t cbor_writer_len(const cbor_writer_t *writer)
+{
+    return writer->flushed + writer->pos;
+}
+/** @} */
+
+/**
+ * @name    Cursor based decoder
+ *
+ * The reader walks through encoded data item by item without copying.
+ * cbor_reader_next() decodes the header of the next item; for arrays and
+ * maps, the cursor then points to their first item. cbor_reader_skip() steps
+ * over the next item including all items nested in it, without decoding
+ * their values.
+ *
+ * Basic usage:
+ * @code
+ * cbor_reader_t reader;
+ * cbor_item_t item;
+ * cbor_reader_init(&reader, data, len);
+ * cbor_reader_next(&reader, &item);       // map header, item.val pairs
+ * for (uint64_t i = 0; i < item.val; i++) {
+ *     int64_t key;
+ *     cbor_reader_int(&reader, &key);
+ *     if (key != 3) {
+ *         cbor_reader_skip(&reader);      // skip the value
+ *         continue;
+ *     }
+ *     <read the value of key 3>
+ * }
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief   Maximum nesting of indefinite length items cbor_reader_skip() can
+ *          step over
+ */
+#ifndef CBOR_READER_DEPTH
+#define CBOR_READER_DEPTH       (8U)
+#endif
+
+/**
+ * @brief   Major types of CBOR items
+ */
+typedef enum {
+    CBOR_TYPE_UINT = 0,         /**< unsigned integer */
+    CBOR_TYPE_NEGINT,           /**< negative integer, -1 - val */
+    CBOR_TYPE_BYTES,            /**< byte string */
+    CBOR_TYPE_TEXT,             /**< text string */
+    CBOR_TYPE_ARRAY,            /**< array */
+    CBOR_TYPE_MAP,              /**< map */
+    CBOR_TYPE_TAG,              /**< tag of the next item */
+    CBOR_TYPE_SIMPLE,           /**< simple value, float or break */
+} cbor_type_t;
+
+/**
+ * @brief   Decoded item header
+ */
+typedef struct {
+    cbor_type_t type;           /**< major type */
+    uint8_t info;               /**< additional information of the header */
+    bool indefinite;            /**< item of indefinite length */
+    uint64_t val;               /**< value, length, number of items or pairs,
+                                     tag, or the bits of a simple value or
+                                     float */
+    const uint8_t *data;        /**< content of a definite length string */
+} cbor_item_t;
+
+/**
+ * @brief   Cursor over encoded data
+ */
+typedef struct {
+    const uint8_t *data;        /**< encoded data */
+    size_t size;                /**< length of the data */
+    size_t pos;                 /**< offset of the next item */
+} cbor_reader_t;
+
+/**
+ * @brief   Initializes a reader
+ *
+ * @param[out] reader   the reader
+ * @param[in]  data     encoded data
+ * @param[in]  size     length of @p data
+ */
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *data, size_t size);
+
+/**
+ * @brief   Decodes the next item header and advances the cursor
+ *
+ * The cursor moves past the content of definite length strings, and into
+ * arrays, maps and tags. A break is returned as CBOR_TYPE_SIMPLE with an
+ * @p info of 31.
+ *
+ * @param[in]  reader   the reader
+ * @param[out] item     the item
+ *
+ * @return  0 on success
+ * @return  -ENODATA at the end of the data
+ * @return  -EBADMSG on malformed data
+ */
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item);
+
+/**
+ * @brief   Steps over the next item and all items nested in it
+ *
+ * Each nested header is looked at once, values are not decoded.
+ *
+ * @param[in] reader    the reader
+ *
+ * @return  0 on success
+ * @return  -ENODATA at the end of the data
+ * @return  -EBADMSG on malformed data
+ * @return  -ENOMEM if indefinite length items are nested deeper than
+ *          CBOR_READER_DEPTH
+ */
+int cbor_reader_skip(cbor_reader_t *reader);
+
+/**
+ * @brief   Decodes an integer
+ *
+ * @param[in]  reader   the reader
+ * @param[out] val      the value
+ *
+ * @return  0 on success
+ * @return  -ENODATA at the end of the data
+ * @return  -EBADMSG if the next item is no integer or out of range
+ */
+int cbor_reader_int(cbor_reader_t *reader, int64_t *val);
+
+/**
+ * @brief   Whether the cursor is at the end of the data
+ *
+ * @param[in] reader    the reader
+ *
+ * @return  true at the end of the data
+ */
+static inline bool cbor_reader_at_end(const cbor_reader_t *reader)
+{
+    return reader->pos >= reader->size;
+}
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
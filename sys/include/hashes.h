@@ -155,6 +155,20 @@ uint32_t rotating_hash(const uint8_t *buf, size_t len);
  */
 uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len);
 
+/**
+ * @brief Fowler–Noll–Vo 1a, 64 bit variant
+ *
+ * The standard FNV-1a with the 64 bit offset basis and prime. The upper
+ * bits of the result are mixed better than the lower ones, users needing
+ * several independent values from a single hash should derive them from
+ * both halves.
+ *
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @return 64 bit sized hash
+ */
+uint64_t fnv1a64_hash(const uint8_t *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
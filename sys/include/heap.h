@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_heap System heap
+ * @ingroup     sys
+ * @brief       malloc() and friends backed by a @ref sys_tlsf_heap
+ *
+ * With this module, malloc(), calloc(), realloc() and free() allocate from
+ * a TLSF heap instead of the C library's allocator. Freed memory is merged
+ * with its neighbours right away, and the time taken by each call does not
+ * depend on the state of the heap. The heap takes memory from `sbrk()` in
+ * chunks of at least @ref HEAP_CHUNK_SIZE bytes as needed.
+ *
+ * A single allocation must fit into one pool of the TLSF heap, so
+ * allocations larger than @ref HEAP_ALLOC_MAX fail, even if there is
+ * enough memory. Raise @ref TLSF_HEAP_SIZE_LOG2 for larger allocations.
+ *
+ * With the pseudo module `heap_arenas`, threads can be given private
+ * arenas with heap_arena_use(). A thread allocates from its arena, and
+ * falls back to the shared heap only if its arena is exhausted. Each arena
+ * has its own lock, so threads using different arenas never wait for each
+ * other, and memory churn of one thread doesn't fragment the memory of
+ * the others. Memory can be freed from any thread.
+ *
+ * heap_stats() prints the usage and fragmentation of all arenas, it is
+ * available as the `heap` shell command.
+ *
+ * On `native`, the host's allocator stays in place. The heap_malloc()
+ * family of functions uses this module there.
+ *
+ * @note    The functions must not be called from interrupt context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       System heap interface
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stddef.h>
+
+#include "kernel_types.h"
+#include "mutex.h"
+#include "tlsf_heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Minimum amount of memory the shared heap takes from `sbrk()` at
+ *          once
+ */
+#ifndef HEAP_CHUNK_SIZE
+#define HEAP_CHUNK_SIZE     (1024U)
+#endif
+
+/**
+ * @brief   Largest size in bytes malloc() can allocate
+ *
+ * A pool of 2^@ref TLSF_HEAP_SIZE_LOG2 bytes, i.e. 64 KiB by default, less
+ * the overhead of the pool and its alignment
+ */
+#define HEAP_ALLOC_MAX      (((size_t)1 << TLSF_HEAP_SIZE_LOG2) - \
+                             4 * TLSF_HEAP_ALIGN)
+
+/**
+ * @brief   Heap with its own lock
+ */
+typedef struct heap_arena {
+    struct heap_arena *next;    /**< next registered arena */
+    tlsf_heap_t heap;           /**< memory of the arena */
+    mutex_t lock;               /**< serializes access to @p heap */
+} heap_arena_t;
+
+/**
+ * @brief   Allocate memory
+ *
+ * @param[in] size      number of bytes to allocate
+ *
+ * @return  allocated memory
+ * @return  NULL if @p size is 0 or there is not enough memory
+ */
+void *heap_malloc(size_t size);
+
+/**
+ * @brief   Allocate zeroed memory for an array
+ *
+ * @param[in] nmemb     number of elements
+ * @param[in] size      size of an element
+ *
+ * @return  allocated memory
+ * @return  NULL if there is not enough memory, or the size overflows
+ */
+void *heap_calloc(size_t nmemb, size_t size);
+
+/**
+ * @brief   Resize memory
+ *
+ * @param[in] ptr       memory to resize, may be NULL
+ * @param[in] size      new size
+ *
+ * @return  resized memory
+ * @return  NULL if @p size is 0 or there is not enough memory, in which
+ *          case @p ptr is left untouched
+ */
+void *heap_realloc(void *ptr, size_t size);
+
+/**
+ * @brief   Free memory
+ *
+ * @param[in] ptr       memory to free, may be NULL
+ */
+void heap_free(void *ptr);
+
+/**
+ * @brief   Print usage and fragmentation of the heap
+ */
+void heap_stats(void);
+
+#if defined(MODULE_HEAP_ARENAS) || defined(DOXYGEN)
+/**
+ * @brief   Initialize and register an arena
+ *
+ * @param[out] arena    arena to initialize
+ * @param[in] mem       memory of the arena
+ * @param[in] size      size of @p mem in bytes
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p size isn't supported by @ref sys_tlsf_heap
+ */
+int heap_arena_init(heap_arena_t *arena, void *mem, size_t size);
+
+/**
+ * @brief   Let a thread allocate from an arena
+ *
+ * @param[in] pid       thread
+ * @param[in] arena     arena to use, NULL for the shared heap
+ */
+void heap_arena_use(kernel_pid_t pid, heap_arena_t *arena);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_H */
+/** @} */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_kvs Key/value store
+ * @ingroup     sys
+ * @brief       Log-structured key/value store on flash
+ *
+ * The store appends records to a log on an @ref drivers_mtd device, e.g.
+ * internal flash via @ref drivers_mtd_flashpage. Updating a key writes a new
+ * record, deleting it writes a tombstone; nothing is rewritten in place.
+ *
+ * The log consists of segments, one per sector of the device, used in a
+ * circle. Each record is protected by a CRC16, so records torn by a power
+ * loss are detected and ignored. On initialization, the log is scanned from
+ * the oldest to the newest segment to rebuild an index in RAM that maps the
+ * hash of each key to its newest record.
+ *
+ * When the log runs out of free segments, the oldest segment is compacted:
+ * its records that are still current are copied to the head of the log, and
+ * the segment is erased. One segment is always kept free for this. To keep
+ * kvs_set() from stalling on compaction, call kvs_compact() from a low
+ * priority thread.
+ *
+ * Records are buffered in RAM up to a page of the device. Data is only
+ * guaranteed to survive a power loss after kvs_sync().
+ *
+ * @{
+ *
+ * @file
+ * @brief       Key/value store interface
+ */
+
+#ifndef KVS_H
+#define KVS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum length of a key
+ */
+#ifndef KVS_KEY_MAX
+#define KVS_KEY_MAX             (32U)
+#endif
+
+/**
+ * @brief   kvs_compact() compacts while no more segments than this are free
+ */
+#ifndef KVS_COMPACT_THRESHOLD
+#define KVS_COMPACT_THRESHOLD   (2U)
+#endif
+
+/**
+ * @brief   Index entry
+ */
+typedef struct {
+    uint32_t hash;              /**< hash of the key */
+    uint32_t addr;              /**< address of the newest record, 0 if unused */
+} kvs_entry_t;
+
+/**
+ * @brief   Statistics
+ */
+typedef struct {
+    uint32_t user_bytes;        /**< bytes of keys and values written */
+    uint32_t flash_bytes;       /**< bytes programmed to the device */
+    uint32_t erases;            /**< number of erased sectors */
+    uint32_t compactions;       /**< number of compacted segments */
+} kvs_stats_t;
+
+/**
+ * @brief   Key/value store
+ */
+typedef struct {
+    mtd_dev_t *dev;             /**< device of the log */
+    uint8_t *wbuf;              /**< page being written */
+    uint8_t *rbuf;              /**< page last read */
+    kvs_entry_t *index;         /**< index of the keys */
+    unsigned index_size;        /**< number of index entries */
+    unsigned count;             /**< number of keys */
+    uint32_t head;              /**< segment being written */
+    uint32_t tail;              /**< oldest segment */
+    uint32_t used;              /**< number of segments in use */
+    uint32_t seq;               /**< sequence number of the head */
+    uint32_t pos;               /**< address of the next record */
+    uint32_t synced;            /**< value of `pos` on the last sync */
+    uint32_t wpage;             /**< page in `wbuf` */
+    uint32_t rpage;             /**< page in `rbuf` */
+    kvs_stats_t stats;          /**< statistics */
+    mutex_t lock;               /**< serializes access */
+} kvs_t;
+
+/**
+ * @brief   Initializes a store and rebuilds its index
+ *
+ * Initializes @p dev, and erases all sectors of @p dev that are neither
+ * part of the log nor blank.
+ *
+ * @param[out] kvs          the store
+ * @param[in]  dev          device to use, with at least three sectors
+ * @param[in]  buf          buffer of two pages of @p dev
+ * @param[in]  index        index entries, at least one more than keys
+ * @param[in]  index_size   number of index entries, a power of two
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p dev has less than three sectors
+ * @return  -ENOMEM if @p index is too small for the keys in the log
+ * @return  other negative errno on errors of @p dev
+ */
+int kvs_init(kvs_t *kvs, mtd_dev_t *dev, uint8_t *buf, kvs_entry_t *index,
+             unsigned index_size);
+
+/**
+ * @brief   Reads the value of a key
+ *
+ * @param[in]  kvs      the store
+ * @param[in]  key      the key
+ * @param[out] buf      buffer for the value
+ * @param[in]  len      size of @p buf, longer values are truncated
+ *
+ * @return  length of the value
+ * @return  -ENOENT if @p key isn't in the store
+ * @return  -EINVAL if @p key is empty or too long
+ * @return  other negative errno on errors of the device
+ */
+int kvs_get(kvs_t *kvs, const char *key, void *buf, size_t len);
+
+/**
+ * @brief   Sets the value of a key
+ *
+ * @param[in] kvs       the store
+ * @param[in] key       the key
+ * @param[in] val       the value
+ * @param[in] len       length of @p val
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p key is empty or too long, or the record doesn't
+ *          fit into a sector
+ * @return  -ENOMEM if the index is full
+ * @return  -ENOSPC if the device is full
+ * @return  other negative errno on errors of the device
+ */
+int kvs_set(kvs_t *kvs, const char *key, const void *val, size_t len);
+
+/**
+ * @brief   Deletes a key
+ *
+ * @param[in] kvs       the store
+ * @param[in] key       the key
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p key isn't in the store
+ * @return  -EINVAL if @p key is empty or too long
+ * @return  -ENOSPC if the device is full
+ * @return  other negative errno on errors of the device
+ */
+int kvs_delete(kvs_t *kvs, const char *key);
+
+/**
+ * @brief   Writes all buffered records to the device
+ *
+ * @param[in] kvs       the store
+ *
+ * @return  0 on success
+ * @return  negative errno on errors of the device
+ */
+int kvs_sync(kvs_t *kvs);
+
+/**
+ * @brief   Compacts the oldest segment if few segments are free
+ *
+ * @see KVS_COMPACT_THRESHOLD
+ *
+ * @param[in] kvs       the store
+ *
+ * @return  1 if a segment was compacted
+ * @return  0 if there was nothing to do
+ * @return  negative errno on errors of the device
+ */
+int kvs_compact(kvs_t *kvs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KVS_H */
+/** @} */
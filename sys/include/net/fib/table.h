@@ -133,6 +133,11 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** generation of the single hop entries, incremented whenever one is
+    *   added, updated or removed. Users that keep results of a lookup
+    *   compare it to tell if they are still valid.
+    */
+    unsigned gen;
 } fib_table_t;
 
 #ifdef __cplusplus
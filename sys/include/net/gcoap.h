@@ -35,8 +35,19 @@
  * structs. Use gcoap_register_listener() at application startup to pass in
  * these resources, wrapped in a gcoap_listener_t.
  *
+ * At registration, gcoap adds the resources to an index sorted by path, so
+ * the resource for a request is found by binary search over all listeners.
+ * The index holds up to GCOAP_RESOURCES_MAX resources. If more resources are
+ * registered, gcoap falls back to a linear search of all listeners.
+ *
+ * A request for a registered path with a method the resource does not
+ * accept is answered with 4.05 (Method Not Allowed), and a request for an
+ * unknown path with 4.04 (Not Found).
+ *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
- * lists all of the registered paths.
+ * lists all of the registered paths. With GCOAP_WKC_CACHE_SIZE set, the list
+ * is written once to a cache, and rewritten only after a listener is
+ * registered.
  *
  * ### Creating a response ###
  *
@@ -130,6 +141,60 @@
  * times out. We track the response with an entry in the
  * `_coap_state.open_reqs` array.
  *
+ * ## Block-wise Transfer ##
+ *
+ * gcoap supports the Block1 and Block2 options from RFC 7959, so a resource
+ * may be larger than a single PDU buffer. gcoap never buffers a full
+ * resource. Instead, the application provides a streaming callback that
+ * produces (gcoap_block_read_t) or consumes (gcoap_block_write_t) one block
+ * at a time directly in the PDU buffer.
+ *
+ * ### Server ###
+ *
+ * Within a resource callback, use gcoap_block2_respond() to answer a GET
+ * with the block requested by the client, or gcoap_block1_receive() to
+ * accept one block of a PUT/POST body. Both functions read the request's
+ * block option, call the streaming callback for the block's offset, and
+ * write the full response. Use gcoap_get_block1() and gcoap_get_block2()
+ * to read the options directly.
+ *
+ * ### Client ###
+ *
+ * Fill in a gcoap_block_xfer_t and call gcoap_block_xfer_start(). gcoap
+ * requests one block after another from its own thread, passing each block
+ * to the transfer's callback, and executes the transfer's response handler
+ * once when the transfer completes, fails or times out.
+ *
+ * Alternatively, write block options into a request directly with
+ * gcoap_finish_block().
+ *
+ * ## Observe Server ##
+ *
+ * gcoap supports RFC 7641 Observe for resources on the server. A GET request
+ * with an Observe option value of 0 registers the requesting endpoint as an
+ * observer of the resource, and a value of 1 deregisters it. Registrations
+ * are tracked per resource, up to GCOAP_OBS_RESOURCES_MAX resources and
+ * GCOAP_OBS_OBSERVERS_MAX observers in total.
+ *
+ * When the state of a resource changes, call gcoap_obs_notify(). gcoap
+ * executes the resource's callback once in its own thread to write the
+ * representation, and then sends the same PDU to each observer, only
+ * rewriting the message header, token and Observe sequence number.
+ * Notifications for a resource are sent at most once per
+ * GCOAP_OBS_NOTIFY_INTERVAL; further calls within the interval are combined
+ * into a single notification with the latest representation.
+ *
+ * Notifications may be non-confirmable or confirmable. gcoap does not
+ * retransmit a confirmable notification. Instead, it removes an observer
+ * that does not acknowledge GCOAP_OBS_CON_FAIL_MAX confirmable
+ * notifications in a row, or that resets a notification.
+ *
+ * ### Parsing ###
+ *
+ * nanocoap rejects a PDU with an unrecognized critical option, which
+ * includes Block1 and Block2. gcoap_parse() extracts and removes these
+ * options from a received PDU before it is parsed by nanocoap.
+ *
  * @{
  *
  * @file
@@ -141,6 +206,9 @@
 #ifndef GCOAP_H
 #define GCOAP_H
 
+#include <stdbool.h>
+
+#include "mutex.h"
 #include "net/sock/udp.h"
 #include "nanocoap.h"
 #include "xtimer.h"
@@ -158,22 +226,51 @@ extern "C" {
 #endif
 
 /** @brief Size of the buffer used to build a CoAP request or response. */
+#ifndef GCOAP_PDU_BUF_SIZE
 #define GCOAP_PDU_BUF_SIZE  (128)
+#endif
 
 /**
  * @brief Size of the buffer used to write options, other than Uri-Path, in a
  *        request.
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and one Block1 or Block2 option. Block-wise
+ * transfers with large block numbers, or with Size1/Size2 options, need a
+ * larger buffer; gcoap_finish_block() fails otherwise. The buffer is reserved
+ * from the payload space of every request.
  */
+#ifndef GCOAP_REQ_OPTIONS_BUF
 #define GCOAP_REQ_OPTIONS_BUF  (8)
+#endif
 
 /**
  * @brief Size of the buffer used to write options in a response.
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and one Block1 or Block2 option, like
+ * GCOAP_REQ_OPTIONS_BUF. The buffer is reserved from the payload space of
+ * every response.
  */
+#ifndef GCOAP_RESP_OPTIONS_BUF
 #define GCOAP_RESP_OPTIONS_BUF  (8)
+#endif
+
+/**
+ * @brief Maximum number of resources in the index used to find the resource
+ *        for a request, including gcoap's own resources
+ */
+#ifndef GCOAP_RESOURCES_MAX
+#define GCOAP_RESOURCES_MAX     (16)
+#endif
+
+/**
+ * @brief Size of the cache for the `/.well-known/core` link format list
+ *
+ * 0 disables the cache; the list then is written to the response for every
+ * request. Links that do not fit in the cache are not listed.
+ */
+#ifndef GCOAP_WKC_CACHE_SIZE
+#define GCOAP_WKC_CACHE_SIZE    (0)
+#endif
 
 /** @brief Maximum number of requests awaiting a response */
 #define GCOAP_REQ_WAITING_MAX   (2)
@@ -203,6 +300,78 @@ extern "C" {
 #define GCOAP_MEMO_ERR      (4)  /**< Error processing response packet */
 /** @} */
 
+/**
+ * @name Block-wise transfer options and codes, from RFC 7959
+ * @{
+ */
+#define GCOAP_OPT_BLOCK2        (23)    /**< Block2 option number */
+#define GCOAP_OPT_BLOCK1        (27)    /**< Block1 option number */
+#define GCOAP_OPT_SIZE2         (28)    /**< Size2 option number */
+#define GCOAP_OPT_SIZE1         (60)    /**< Size1 option number */
+
+#define GCOAP_CODE_CONTINUE     ((2 << 5) | 31) /**< 2.31 Continue */
+#define GCOAP_CODE_REQUEST_ENTITY_INCOMPLETE ((4 << 5) | 8)
+                                        /**< 4.08 Request Entity Incomplete */
+/** @} */
+
+/** @brief 4.05 Method Not Allowed, for a known path with another method */
+#define GCOAP_CODE_METHOD_NOT_ALLOWED   ((4 << 5) | 5)
+
+/**
+ * @name Flags for the options present in a gcoap_blockopts_t
+ * @{
+ */
+#define GCOAP_BLOCKOPT_BLOCK1   (0x01)  /**< Block1 option present */
+#define GCOAP_BLOCKOPT_BLOCK2   (0x02)  /**< Block2 option present */
+#define GCOAP_BLOCKOPT_SIZE1    (0x04)  /**< Size1 option present */
+#define GCOAP_BLOCKOPT_SIZE2    (0x08)  /**< Size2 option present */
+/** @} */
+
+/**
+ * @brief Largest block size exponent (SZX) used by gcoap
+ *
+ * Block size is 2^(SZX + 4) bytes. gcoap reduces the exponent further if a
+ * block would not fit in the PDU buffer.
+ */
+#ifndef GCOAP_BLOCK_SZX_MAX
+#define GCOAP_BLOCK_SZX_MAX     (6)
+#endif
+
+/**
+ * @name Observe (RFC 7641) parameters
+ * @{
+ */
+/** @brief Observe option number */
+#define GCOAP_OPT_OBSERVE       (6)
+
+/** @brief Maximum number of resources that may be observed at a time */
+#ifndef GCOAP_OBS_RESOURCES_MAX
+#define GCOAP_OBS_RESOURCES_MAX (2)
+#endif
+
+/** @brief Maximum number of observers, over all resources */
+#ifndef GCOAP_OBS_OBSERVERS_MAX
+#define GCOAP_OBS_OBSERVERS_MAX (2)
+#endif
+
+/**
+ * @brief Minimum time in usec between notifications for a resource
+ *
+ * Set to 0 to disable rate limiting.
+ */
+#ifndef GCOAP_OBS_NOTIFY_INTERVAL
+#define GCOAP_OBS_NOTIFY_INTERVAL   (100U * US_PER_MS)
+#endif
+
+/**
+ * @brief Number of confirmable notifications in a row an observer may leave
+ *        unacknowledged before it is removed
+ */
+#ifndef GCOAP_OBS_CON_FAIL_MAX
+#define GCOAP_OBS_CON_FAIL_MAX  (3)
+#endif
+/** @} */
+
 /** @brief Time in usec that the event loop waits for an incoming CoAP message */
 #define GCOAP_RECV_TIMEOUT   (1 * US_PER_SEC)
 
@@ -229,8 +398,7 @@ extern "C" {
  * @brief  A modular collection of resources for a server
  */
 typedef struct gcoap_listener {
-    coap_resource_t *resources;   /**< First element in the array of resources;
-                                       must order alphabetically */
+    coap_resource_t *resources;   /**< First element in the array of resources */
     size_t resources_len;         /**< Length of array */
     struct gcoap_listener *next;  /**< Next listener in list */
 } gcoap_listener_t;
@@ -243,6 +411,81 @@ typedef struct gcoap_listener {
  */
 typedef void (*gcoap_resp_handler_t)(unsigned req_state, coap_pkt_t* pdu);
 
+/**
+ * @brief  Value of a Block1 or Block2 option
+ */
+typedef struct {
+    uint32_t blknum;    /**< Block number */
+    uint8_t szx;        /**< Size exponent; block size is 2^(szx + 4) bytes */
+    uint8_t more;       /**< 1 if more blocks follow, otherwise 0 */
+} gcoap_block_t;
+
+/**
+ * @brief  Block-wise transfer options of a PDU
+ */
+typedef struct {
+    gcoap_block_t block1;   /**< Block1 option */
+    gcoap_block_t block2;   /**< Block2 option */
+    uint32_t size1;         /**< Size1 option */
+    uint32_t size2;         /**< Size2 option */
+    uint8_t flags;          /**< Options present, GCOAP_BLOCKOPT... flags */
+} gcoap_blockopts_t;
+
+/**
+ * @brief  Streaming callback to produce one block of a resource
+ *
+ * @param[in] arg       Application context
+ * @param[in] offset    Offset of the block within the resource
+ * @param[out] buf      Buffer to write the block
+ * @param[in] len       Block size; write at most this many bytes
+ * @param[out] more     Set to 1 if the resource continues after this block
+ *
+ * @return  number of bytes written
+ * @return  < 0 on error
+ */
+typedef ssize_t (*gcoap_block_read_t)(void *arg, size_t offset, uint8_t *buf,
+                                      size_t len, int *more);
+
+/**
+ * @brief  Streaming callback to consume one block of a resource
+ *
+ * @param[in] arg       Application context
+ * @param[in] offset    Offset of the block within the resource
+ * @param[in] buf       Block contents
+ * @param[in] len       Length of the block contents
+ * @param[in] more      1 if more blocks follow, 0 for the final block
+ *
+ * @return  0 on success
+ * @return  -ESPIPE if @p offset is not the one expected next; the server
+ *          then responds 4.08 (Request Entity Incomplete)
+ * @return  < 0 on other errors; aborts the transfer
+ */
+typedef int (*gcoap_block_write_t)(void *arg, size_t offset, const uint8_t *buf,
+                                   size_t len, int more);
+
+/**
+ * @brief  Client side state of a block-wise transfer
+ *
+ * Application allocates and initializes the public attributes, and must not
+ * modify the structure until the response handler is executed.
+ */
+typedef struct {
+    sock_udp_ep_t remote;               /**< Server endpoint */
+    char *path;                         /**< Resource path */
+    unsigned code;                      /**< Request code; GET downloads the
+                                             resource, PUT/POST uploads it */
+    unsigned format;                    /**< Content-Format of an upload */
+    gcoap_block_read_t reader;          /**< Produces upload blocks */
+    gcoap_block_write_t writer;         /**< Consumes download blocks */
+    void *arg;                          /**< Context for reader/writer */
+    gcoap_resp_handler_t resp_handler;  /**< Executed once when the transfer
+                                             completes, fails or times out */
+    uint32_t blknum;                    /**< Current block number */
+    uint8_t szx;                        /**< Current block size exponent */
+    uint8_t more;                       /**< Upload continues after current
+                                             block */
+} gcoap_block_xfer_t;
+
 /**
  * @brief  Memo to handle a response for a request
  */
@@ -251,20 +494,72 @@ typedef struct {
     uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
                                         /**< Stores a copy of the request header */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
+    gcoap_block_xfer_t *xfer;           /**< Block-wise transfer for the
+                                             request, if any */
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
 } gcoap_request_memo_t;
 
+/**
+ * @brief  Memo for an observer of a resource
+ */
+typedef struct gcoap_observe_memo {
+    sock_udp_ep_t remote;               /**< Observer endpoint; unused if
+                                             family is AF_UNSPEC */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Token of the registration */
+    uint8_t token_len;                  /**< Length of the token */
+    uint8_t unacked;                    /**< Confirmable notifications not
+                                             acknowledged in a row */
+    uint16_t msg_id;                    /**< Message ID of the last
+                                             confirmable notification */
+    struct gcoap_observe_memo *next;    /**< Next observer of the resource */
+} gcoap_observe_memo_t;
+
+/**
+ * @brief  Registration entry for an observed resource
+ */
+typedef struct {
+    const coap_resource_t *resource;    /**< Observed resource; entry unused
+                                             if NULL */
+    gcoap_observe_memo_t *observers;    /**< List of observers */
+    uint32_t seq;                       /**< Last Observe sequence number */
+    uint32_t last_notify;               /**< Time of last notification, in
+                                             usec */
+    uint8_t pending;                    /**< Notification requested, and
+                                             whether confirmable */
+} gcoap_obs_resource_t;
+
 /**
  * @brief  Container for the state of gcoap itself
  */
 typedef struct {
     gcoap_listener_t *listeners;       /**< List of registered listeners */
+    const coap_resource_t *resources[GCOAP_RESOURCES_MAX];
+                                       /**< Index of registered resources,
+                                            sorted by path */
+    size_t resources_len;              /**< Number of resources in index */
+    bool resources_overflow;           /**< Not all registered resources fit
+                                            in the index */
+#if GCOAP_WKC_CACHE_SIZE
+    char wkc_cache[GCOAP_WKC_CACHE_SIZE];
+                                       /**< Cached /.well-known/core payload */
+    size_t wkc_len;                    /**< Length of the cached payload */
+    bool wkc_valid;                    /**< Cached payload is up to date */
+#endif
     gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
                                        /**< Storage for open requests; if first
                                             byte of an entry is zero, the entry
                                             is available */
     uint16_t last_message_id;          /**< Last message ID used */
+    uint32_t observe_value;            /**< Observe option of the last PDU
+                                            read by gcoap_parse(), or
+                                            UINT32_MAX if none */
+    gcoap_obs_resource_t obs_resources[GCOAP_OBS_RESOURCES_MAX];
+                                       /**< Observed resources */
+    gcoap_observe_memo_t observers[GCOAP_OBS_OBSERVERS_MAX];
+                                       /**< Storage for observers */
+    mutex_t lock;                      /**< Protects the observe state that
+                                            gcoap_obs_notify() accesses */
 } gcoap_state_t;
 
 /**
@@ -285,6 +580,56 @@ kernel_pid_t gcoap_init(void);
  */
 void gcoap_register_listener(gcoap_listener_t *listener);
 
+/**
+ * @brief  Parses a received CoAP PDU, including block-wise transfer options.
+ *
+ * Parses the PDU with coap_parse(), which does not know the Block1, Block2,
+ * Size1 and Size2 options. The options stay in the buffer, so
+ * gcoap_get_block1() and gcoap_get_block2() read them from the PDU.
+ *
+ * @param[out] pdu  Metadata for the PDU
+ * @param[in] buf   Buffer containing the PDU
+ * @param[in] len   Length of the PDU in the buffer; the header and options
+ *                  must fit in GCOAP_PDU_BUF_SIZE
+ *
+ * @return 0 on success
+ * @return < 0 on error
+ */
+int gcoap_parse(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+/**
+ * @brief  Reads the Block1 option of a PDU.
+ *
+ * @param[in] pdu       PDU read by gcoap_parse()
+ * @param[out] block    Block1 value
+ *
+ * @return 1 if the option is present
+ * @return 0 if not present; @p block then is block 0 with no more blocks
+ */
+int gcoap_get_block1(coap_pkt_t *pdu, gcoap_block_t *block);
+
+/**
+ * @brief  Reads the Block2 option of a PDU.
+ *
+ * @param[in] pdu       PDU read by gcoap_parse()
+ * @param[out] block    Block2 value
+ *
+ * @return 1 if the option is present
+ * @return 0 if not present; @p block then is block 0 with no more blocks
+ */
+int gcoap_get_block2(coap_pkt_t *pdu, gcoap_block_t *block);
+
+/**
+ * @brief   Finds the registered resource for a request.
+ *
+ * @param[in] path      Resource path
+ * @param[in] method    Request method code, e.g. COAP_METHOD_GET
+ *
+ * @return  resource for @p path that accepts @p method
+ * @return  NULL if not found
+ */
+const coap_resource_t *gcoap_find_resource(const char *path, unsigned method);
+
 /**
  * @brief  Initializes a CoAP request PDU on a buffer.
  *
@@ -316,6 +661,24 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
  */
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format);
 
+/**
+ * @brief  Finishes formatting a CoAP PDU, including block-wise transfer
+ *         options.
+ *
+ * Like gcoap_finish(), but also writes the options flagged in @p opts.
+ *
+ * @param[in] pdu Request metadata
+ * @param[in] payload_len Length of the payload, or 0 if none
+ * @param[in] format Format code for the payload; use COAP_FORMAT_NONE if not
+ *                   specified
+ * @param[in] opts Block options to write; may be NULL
+ *
+ * @return size of the PDU
+ * @return < 0 on error
+ */
+ssize_t gcoap_finish_block(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           const gcoap_blockopts_t *opts);
+
 /**
  *  @brief Writes a complete CoAP request PDU when there is not a payload.
  *
@@ -402,6 +765,80 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 : -1;
 }
 
+/**
+ * @brief  Writes a response with the block of a resource requested by the
+ *         Block2 option of a request.
+ *
+ * Use from a resource callback. If the request has no Block2 option, writes
+ * the first block. The block size is reduced to fit in the buffer if needed.
+ *
+ * @param[in] pdu Request/Response metadata
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] format Content-Format of the resource
+ * @param[in] reader Produces the requested block
+ * @param[in] arg Context for @p reader
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error
+ */
+ssize_t gcoap_block2_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned format, gcoap_block_read_t reader,
+                             void *arg);
+
+/**
+ * @brief  Passes the block of a request body to a streaming callback, and
+ *         writes the response to acknowledge it.
+ *
+ * Use from a resource callback. Responds 2.31 (Continue) if more blocks
+ * follow, otherwise 2.04 (Changed), with the Block1 option echoed. A request
+ * without a Block1 option is handled as a single, final block. Responds 4.08
+ * (Request Entity Incomplete) if @p writer rejects the block as out of
+ * order.
+ *
+ * @param[in] pdu Request/Response metadata
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] writer Consumes the block
+ * @param[in] arg Context for @p writer
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error
+ */
+ssize_t gcoap_block1_receive(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             gcoap_block_write_t writer, void *arg);
+
+/**
+ * @brief  Starts a client block-wise transfer.
+ *
+ * Sends the request for the first block. gcoap sends the requests for
+ * subsequent blocks from its own thread.
+ *
+ * @param[in] xfer Transfer state; blknum and szx are initialized here
+ *
+ * @return length of the first request
+ * @return 0 if cannot send
+ */
+size_t gcoap_block_xfer_start(gcoap_block_xfer_t *xfer);
+
+/**
+ * @brief  Notifies the observers of a resource that its state has changed.
+ *
+ * gcoap writes the notification from its own thread with the resource's
+ * callback, and sends it to all observers. May be called from any thread,
+ * including the resource's callback, but not from interrupt context.
+ * Calls within GCOAP_OBS_NOTIFY_INTERVAL of the previous notification are
+ * combined into the next notification.
+ *
+ * @param[in] resource Resource to notify, as registered with
+ *                     gcoap_register_listener()
+ * @param[in] type     COAP_TYPE_NON or COAP_TYPE_CON
+ *
+ * @return number of observers of the resource
+ * @return 0 if the resource is not observed; nothing to send
+ */
+int gcoap_obs_notify(const coap_resource_t *resource, unsigned type);
+
 /**
  * @brief Provides important operational statistics.
  *
@@ -68,6 +68,28 @@ extern "C" {
 #define GNRC_IPV6_MSG_QUEUE_SIZE    (8U)
 #endif
 
+/**
+ * @brief   Number of destinations a router keeps the next hop of, so
+ *          forwarded packets skip the next hop determination.
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_IPV6_FWD_CACHE_SIZE
+#define GNRC_IPV6_FWD_CACHE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Time in microseconds a next hop is kept in the forwarding cache.
+ *
+ * @details Entries are also dropped whenever the neighbor cache, the FIB or
+ *          the addresses of the interfaces change. This timeout only bounds
+ *          how long an expired FIB entry, which the FIB notices on its next
+ *          lookup only, can still be used.
+ */
+#ifndef GNRC_IPV6_FWD_CACHE_TIMEOUT
+#define GNRC_IPV6_FWD_CACHE_TIMEOUT (1U * US_PER_SEC)
+#endif
+
 /**
  * @brief   The PID to the IPv6 thread.
  *
@@ -134,6 +156,20 @@ kernel_pid_t gnrc_ipv6_init(void);
  */
 void gnrc_ipv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt, uint8_t nh);
 
+/**
+ * @brief   Sends a packet as if it was handed to the IPv6 thread with
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND.
+ *
+ * @internal
+ *
+ * **Do not use outside this module or its submodules!!!**
+ * Must be called from the IPv6 thread, e.g. to send packets that waited for
+ * address resolution without passing them through its message queue again.
+ *
+ * @param[in] pkt   The packet to send. It is released by this function.
+ */
+void gnrc_ipv6_send(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Get the IPv6 header from a given list of @ref gnrc_pktsnip_t
  *
@@ -119,9 +119,15 @@ extern "C" {
  *              RFC 4861, section 5.1
  *          </a>.
  */
-typedef struct {
+typedef struct gnrc_ipv6_nc {
 #ifdef MODULE_GNRC_NDP_NODE
     gnrc_pktqueue_t *pkts;                      /**< Packets waiting for address resolution */
+    uint32_t res_start;                         /**< Start of the address resolution */
+    /**
+     * @brief Next neighbor solicitation of the address resolution, 0 if none
+     *        is scheduled (see gnrc_ndp_node_res_schedule())
+     */
+    uint32_t res_deadline;
 #endif
     ipv6_addr_t ipv6_addr;                      /**< IPv6 address of the neighbor */
     uint8_t l2_addr[GNRC_IPV6_NC_L2_ADDR_MAX];  /**< Link layer address of the neighbor */
@@ -156,10 +162,21 @@ typedef struct {
 #endif
 
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
-    xtimer_t type_timeout;                  /**< Timer for type transmissions */
-    msg_t type_timeout_msg;                 /**< msg_t for gnrc_ipv6_nc_t::type_timeout */
     eui64_t eui64;                          /**< the unique EUI-64 of the neighbor (might be
                                              *   different from L2 address, if l2_addr_len == 2) */
+    /**
+     * @brief   Links of the address registration table
+     *
+     * @see     gnrc_sixlowpan_nd_router_reg_add()
+     * @{
+     */
+    struct gnrc_ipv6_nc *reg_next_addr;     /**< next entry in the address bucket */
+    struct gnrc_ipv6_nc *reg_next_eui64;    /**< next entry in the EUI-64 bucket */
+    struct gnrc_ipv6_nc *reg_next_timer;    /**< next entry in the timer wheel slot */
+    struct gnrc_ipv6_nc *reg_prev_timer;    /**< previous entry in the timer wheel slot */
+    uint16_t reg_slot;                      /**< timer wheel slot plus 1, 0 if not registered */
+    uint16_t reg_rounds;                    /**< turns of the timer wheel until expiry */
+    /** @} */
 #endif
 
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
@@ -168,6 +185,18 @@ typedef struct {
      */
 } gnrc_ipv6_nc_t;
 
+/**
+ * @brief   Generation of the neighbor cache
+ *
+ * @details Incremented whenever an entry is added or removed, or the flags
+ *          or link-layer address of an entry change. Users that keep results
+ *          derived from the neighbor cache compare it to tell if they are
+ *          still valid. Only the functions of the neighbor cache change it,
+ *          so entries must be modified with gnrc_ipv6_nc_set_flags() and
+ *          gnrc_ipv6_nc_set_l2_addr().
+ */
+extern unsigned gnrc_ipv6_nc_gen;
+
 /**
  * @brief   Initializes neighbor cache
  */
@@ -199,6 +228,28 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
  */
 void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
 
+/**
+ * @brief   Changes flags of a neighbor cache entry
+ *
+ * @param[in,out] entry     A neighbor cache entry
+ * @param[in] mask          The flags to change, e.g.
+ *                          @ref GNRC_IPV6_NC_STATE_MASK
+ * @param[in] flags         The new value of the flags in @p mask
+ */
+void gnrc_ipv6_nc_set_flags(gnrc_ipv6_nc_t *entry, uint8_t mask, uint8_t flags);
+
+/**
+ * @brief   Changes the link-layer address of a neighbor cache entry
+ *
+ * @param[in,out] entry     A neighbor cache entry
+ * @param[in] iface         PID to the interface where the neighbor is
+ * @param[in] l2_addr       Link layer address of the neighbor
+ * @param[in] l2_addr_len   Length of @p l2_addr, must be lesser than or equal
+ *                          to GNRC_IPV6_L2_ADDR_MAX
+ */
+void gnrc_ipv6_nc_set_l2_addr(gnrc_ipv6_nc_t *entry, kernel_pid_t iface,
+                              const void *l2_addr, size_t l2_addr_len);
+
 /**
  * @brief   Searches for any neighbor cache entry fitting the @p ipv6_addr.
  *
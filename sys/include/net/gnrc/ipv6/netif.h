@@ -58,6 +58,18 @@ extern "C" {
 #define GNRC_IPV6_NETIF_ADDR_NUMOF  (6 + GNRC_IPV6_NETIF_RPL_ADDR + GNRC_IPV6_NETIF_RTR_ADDR)
 #endif
 
+/**
+ * @brief   Number of hash buckets of the index over the addresses of all
+ *          interfaces
+ *
+ * The index lets gnrc_ipv6_netif_find_by_addr() and
+ * gnrc_ipv6_netif_find_addr() look up an address without locking the
+ * interfaces. Must be a power of 2.
+ */
+#ifndef GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS
+#define GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS    (16U)
+#endif
+
 /**
  * @brief   Default MTU
  *
@@ -122,6 +134,12 @@ extern "C" {
 #define GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST      (0x00)  /**< unicast address */
 #define GNRC_IPV6_NETIF_ADDR_FLAGS_NON_UNICAST  (0x01)  /**< non-unicast address */
 
+/**
+ * @brief   The multicast address was added by gnrc_ipv6_netif_join() and is
+ *          removed again when its last user left it.
+ */
+#define GNRC_IPV6_NETIF_ADDR_FLAGS_JOINED       (0x02)
+
 /**
  * @brief   A prefix information option that propagates the prefix of this
  *          address should set the autonomous flag.
@@ -237,6 +255,11 @@ typedef struct {
     ipv6_addr_t addr;       /**< The address data */
     uint8_t flags;          /**< flags */
     uint8_t prefix_len;     /**< length of the prefix of the address */
+    /**
+     * @brief   Number of users that joined the multicast address with
+     *          gnrc_ipv6_netif_join() and did not leave it yet.
+     */
+    uint8_t users;
     /**
      * @{
      * @name    Neigbour discovery variables for prefixes
@@ -454,9 +477,43 @@ void gnrc_ipv6_netif_remove_addr(kernel_pid_t pid, ipv6_addr_t *addr);
  */
 void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid);
 
+/**
+ * @brief   Joins a multicast group on an interface.
+ *
+ * Unlike gnrc_ipv6_netif_add_addr(), joins are counted, so several users
+ * (e.g. sockets) can join and leave the same group independently. A group
+ * that was added with gnrc_ipv6_netif_add_addr(), e.g. the all-nodes
+ * address, stays on the interface when all of its users left.
+ *
+ * @param[in] pid       The PID to the interface.
+ * @param[in] group     A multicast address.
+ *
+ * @return  0, on success.
+ * @return  -EINVAL, if @p group is no multicast address.
+ * @return  -ENOENT, if @p pid is no interface.
+ * @return  -ENOMEM, if there is no space left for another address on the
+ *          interface.
+ * @return  -EOVERFLOW, if the group has too many users already.
+ */
+int gnrc_ipv6_netif_join(kernel_pid_t pid, const ipv6_addr_t *group);
+
+/**
+ * @brief   Leaves a multicast group joined with gnrc_ipv6_netif_join().
+ *
+ * @param[in] pid       The PID to the interface.
+ * @param[in] group     A multicast address.
+ *
+ * @return  0, on success.
+ * @return  -ENOENT, if @p group was not joined on the interface.
+ */
+int gnrc_ipv6_netif_leave(kernel_pid_t pid, const ipv6_addr_t *group);
+
 /**
  * @brief   Searches for an address on all interfaces.
  *
+ * The address is looked up in a hash index without taking the mutexes of
+ * the interfaces, unless addresses are being changed concurrently.
+ *
  * @param[out] out  The reference to the address on the interface.
  * @param[in] addr  The address you want to search for.
  *
@@ -468,6 +525,9 @@ kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *
 /**
  * @brief   Searches for an address on an interface.
  *
+ * Like gnrc_ipv6_netif_find_by_addr(), this doesn't take the mutex of the
+ * interface as long as no addresses are being changed concurrently.
+ *
  * @param[in] pid   The PID to the interface.
  * @param[in] addr  The address you want to search for.
  *
@@ -477,6 +537,17 @@ kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *
  */
 ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr);
 
+/**
+ * @brief   Gets the generation of the addresses of all interfaces.
+ *
+ * The generation changes whenever an address is added to or removed from
+ * any interface, so users can tell if a result derived from the addresses
+ * (e.g. a next hop selected by prefix) may be outdated.
+ *
+ * @return  The current generation.
+ */
+unsigned gnrc_ipv6_netif_addr_gen(void);
+
 /**
  * @brief   Searches for the first address matching a prefix best on all
  *          interfaces.
@@ -59,6 +59,9 @@ extern "C" {
 #define GNRC_NDP_MSG_RTR_SOL_RETRANS            (0x0216)
 /** Message type for neighbor cache state timeouts */
 #define GNRC_NDP_MSG_NC_STATE_TIMEOUT           (0x0217)
+/** Message type for neighbor solicitation retransmissions of address
+ * resolutions, see gnrc_ndp_node_res_schedule() */
+#define GNRC_NDP_MSG_ADDR_RES_RETRANS           (0x0218)
 
 /**
  * @name    Host constants
@@ -20,10 +20,60 @@
 #ifndef GNRC_NDP_NODE_H
 #define GNRC_NDP_NODE_H
 
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/pkt.h"
+#include "xtimer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of packets that may wait for address resolution, shared by
+ *          all neighbors
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_SIZE
+#define GNRC_NDP_NODE_QUEUE_SIZE        (GNRC_IPV6_NC_SIZE * 2)
+#endif
+
+/**
+ * @brief   Number of packets that may wait for the same neighbor
+ *
+ * @details When the queue of a neighbor is full, its oldest packet is dropped
+ *          in favor of the new one.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc4861#section-7.2.2">
+ *          RFC 4861, section 7.2.2
+ *      </a>
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_NBR_SIZE
+#define GNRC_NDP_NODE_QUEUE_NBR_SIZE    (4U)
+#endif
+
+/**
+ * @brief   Neighbor solicitation retransmissions for address resolution that
+ *          are due within this many microseconds are sent together
+ */
+#ifndef GNRC_NDP_NODE_RES_SLACK
+#define GNRC_NDP_NODE_RES_SLACK         (10U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Address resolution statistics
+ */
+typedef struct {
+    uint32_t queued;        /**< packets queued for address resolution */
+    uint32_t sent;          /**< queued packets sent after resolution */
+    uint32_t dropped;       /**< packets dropped while waiting for resolution */
+    uint32_t resolved;      /**< neighbors resolved */
+    uint32_t failed;        /**< neighbors that did not answer */
+    uint32_t res_time_sum;  /**< sum of the resolution times in microseconds */
+    uint32_t res_time_max;  /**< longest resolution time in microseconds */
+} gnrc_ndp_node_stats_t;
+
 /**
  * @brief   Get link-layer address and interface for next hop to destination
  *          IPv6 address.
@@ -45,6 +95,57 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                                            kernel_pid_t iface, ipv6_addr_t *dst,
                                            gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Schedules the next neighbor solicitation of an address resolution
+ *
+ * @details All address resolutions share one timer, retransmissions due
+ *          within @ref GNRC_NDP_NODE_RES_SLACK of each other are handled by
+ *          one @ref GNRC_NDP_MSG_ADDR_RES_RETRANS message to the IPv6 thread.
+ *
+ * @internal
+ *
+ * @param[in] nc_entry  A neighbor cache entry in state
+ *                      @ref GNRC_IPV6_NC_STATE_INCOMPLETE.
+ * @param[in] delay     Delay of the retransmission in microseconds.
+ */
+void gnrc_ndp_node_res_schedule(gnrc_ipv6_nc_t *nc_entry, uint32_t delay);
+
+/**
+ * @brief   Handles a @ref GNRC_NDP_MSG_ADDR_RES_RETRANS message
+ *
+ * @details Retransmits the neighbor solicitations of all address resolutions
+ *          that are due, and gives up on those that ran out of probes.
+ *
+ * @internal
+ */
+void gnrc_ndp_node_res_timeout(void);
+
+/**
+ * @brief   Sends the packets that waited for a neighbor, once its link-layer
+ *          address is known
+ *
+ * @internal
+ *
+ * @param[in] nc_entry  A neighbor cache entry.
+ */
+void gnrc_ndp_node_send_queued(gnrc_ipv6_nc_t *nc_entry);
+
+/**
+ * @brief   Drops the packets that wait for a neighbor
+ *
+ * @internal
+ *
+ * @param[in] nc_entry  A neighbor cache entry.
+ */
+void gnrc_ndp_node_drop_queued(gnrc_ipv6_nc_t *nc_entry);
+
+/**
+ * @brief   Get the address resolution statistics
+ *
+ * @return  The statistics, may be reset by the caller.
+ */
+gnrc_ndp_node_stats_t *gnrc_ndp_node_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
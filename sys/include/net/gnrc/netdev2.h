@@ -38,6 +38,7 @@
 #include "net/gnrc/mac/types.h"
 #include "net/ieee802154.h"
 #include "net/gnrc/mac/mac.h"
+#include "net/netstats/neighbor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +51,25 @@ extern "C" {
 #define GNRC_NETDEV2_MAC_PRIO   (THREAD_PRIORITY_MAIN - 5)
 #endif
 
+/**
+ * @brief   Maximum number of frames fetched at once after
+ *          @ref NETDEV2_EVENT_RX_PENDING
+ *
+ * Further frames are fetched after the messages that arrived in the
+ * meantime were handled.
+ */
+#ifndef GNRC_NETDEV2_RX_BATCH
+#define GNRC_NETDEV2_RX_BATCH   (8U)
+#endif
+
+/**
+ * @brief   Maximum number of queued packets handed to
+ *          @ref gnrc_netdev2_t::send_batch at once
+ */
+#ifndef GNRC_NETDEV2_TX_BATCH
+#define GNRC_NETDEV2_TX_BATCH   (4U)
+#endif
+
 /**
  * @brief   Type for @ref msg_t if device fired an event
  */
@@ -83,6 +103,19 @@ typedef struct gnrc_netdev2 {
      */
     int (*send)(struct gnrc_netdev2 *dev, gnrc_pktsnip_t *snip);
 
+    /**
+     * @brief Send several pktsnips using this device
+     *
+     * Optional, NULL if the device does not support
+     * @ref netdev2_driver_t::send_batch. Packets that were queued for the
+     * device are handed over in batches of up to
+     * @ref GNRC_NETDEV2_TX_BATCH. The function releases all of them.
+     * With `netstats_neighbor`, a batch counts as one transmission to the
+     * neighbor of its last packet.
+     */
+    int (*send_batch)(struct gnrc_netdev2 *dev, gnrc_pktsnip_t **snips,
+                      unsigned num);
+
     /**
      * @brief Receive a pktsnip from this device
      *
@@ -102,6 +135,18 @@ typedef struct gnrc_netdev2 {
      */
     kernel_pid_t pid;
 
+#if defined(MODULE_NETSTATS_NEIGHBOR) || defined(DOXYGEN)
+    /**
+     * @brief neighbor of the unicast frame handed to the device, NULL if
+     *        none
+     *
+     * Set before the frame is handed to the device and cleared by the next
+     * TX event, which may arrive from the device's isr() after send()
+     * returned.
+     */
+    netstats_nb_t *tx_nb;
+#endif
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
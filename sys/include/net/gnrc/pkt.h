@@ -115,6 +115,11 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#ifdef MODULE_NETSTATS_LATENCY
+    uint32_t lat_time;              /**< time of the last latency stamp in µs */
+    uint8_t lat_stage;              /**< stage of the last latency stamp,
+                                     *   see @ref net_netstats_latency */
+#endif
 } gnrc_pktsnip_t;
 
 /**
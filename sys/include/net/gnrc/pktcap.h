@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktcap Capture Network Packets
+ * @ingroup     net_gnrc
+ * @brief       Records sent and received packets in RAM for later export
+ *              in pcapng format
+ *
+ * Other than @ref net_gnrc_pktdump, which prints every packet while it is
+ * handled, this module only copies the first bytes of a packet, together
+ * with a timestamp and its direction, into a ring buffer. The copy is taken
+ * by @ref net_gnrc_netdev2 right after a packet was received and right
+ * before it is handed to the device. The ring is drained later with
+ * gnrc_pktcap_export(), which writes a pcapng section to any output. The
+ * `pktcap` shell command prints it in hex, which `xxd -r -p` turns back into
+ * a file for Wireshark.
+ *
+ * The captured data starts after the link layer header, so it is the
+ * network layer packet as it goes over the link. The exported capture has
+ * one interface per link type that occurs in it:
+ *
+ * - IPv6 packets are raw IP (`LINKTYPE_RAW`).
+ * - 6LoWPAN frames are Wireshark's exported PDUs
+ *   (`LINKTYPE_WIRESHARK_UPPER_PDU`), which name the 6LoWPAN dissector.
+ * - Packets of any other type are `LINKTYPE_USER0`, for which a dissector
+ *   can be chosen in Wireshark.
+ *
+ * Packets of some types can be left out with gnrc_pktcap_set_filter().
+ *
+ * If the ring is full, new packets are dropped from the capture and counted.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet capture interface
+ */
+
+#ifndef GNRC_PKTCAP_H
+#define GNRC_PKTCAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the capture ring in bytes
+ *
+ * @note    Must be a power of 2
+ */
+#ifndef GNRC_PKTCAP_BUFSIZE
+#define GNRC_PKTCAP_BUFSIZE     (2048U)
+#endif
+
+#if (GNRC_PKTCAP_BUFSIZE & (GNRC_PKTCAP_BUFSIZE - 1)) != 0
+#error "GNRC_PKTCAP_BUFSIZE must be a power of 2"
+#endif
+
+/**
+ * @brief   Default and maximum number of bytes captured per packet
+ */
+#ifndef GNRC_PKTCAP_SNAPLEN
+#define GNRC_PKTCAP_SNAPLEN     (96U)
+#endif
+
+/**
+ * @brief   Filter bit of a @ref gnrc_nettype_t for gnrc_pktcap_set_filter()
+ */
+#define GNRC_PKTCAP_NETTYPE(type)   (1UL << (type))
+
+/**
+ * @brief   Filter that lets packets of all types pass
+ */
+#define GNRC_PKTCAP_NETTYPE_ALL     (UINT32_MAX)
+
+/**
+ * @brief   Capture statistics
+ */
+typedef struct {
+    uint32_t captured;          /**< packets put into the ring */
+    uint32_t dropped;           /**< packets dropped, because the ring was full */
+} gnrc_pktcap_stats_t;
+
+/**
+ * @brief   Output for gnrc_pktcap_export()
+ *
+ * @param[in] arg   argument given to gnrc_pktcap_export()
+ * @param[in] data  next bytes of the capture
+ * @param[in] len   number of bytes in @p data
+ *
+ * @return  0 on success
+ * @return  negative number to stop the export
+ */
+typedef int (*gnrc_pktcap_write_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Starts or stops the capture
+ *
+ * @param[in] on    true to start, false to stop
+ */
+void gnrc_pktcap_enable(bool on);
+
+/**
+ * @brief   Checks if the capture runs
+ *
+ * @return  true, if packets are captured
+ */
+bool gnrc_pktcap_enabled(void);
+
+/**
+ * @brief   Sets the number of bytes captured per packet
+ *
+ * @param[in] snaplen   number of bytes, capped at @ref GNRC_PKTCAP_SNAPLEN
+ */
+void gnrc_pktcap_set_snaplen(uint16_t snaplen);
+
+/**
+ * @brief   Sets the types of packets to capture
+ *
+ * @param[in] nettypes  bitwise or of @ref GNRC_PKTCAP_NETTYPE() of the
+ *                      types, @ref GNRC_PKTCAP_NETTYPE_ALL by default
+ */
+void gnrc_pktcap_set_filter(uint32_t nettypes);
+
+/**
+ * @brief   Captures a received packet
+ *
+ * @param[in] pkt   packet as received by @ref gnrc_netdev2_t::recv
+ */
+void gnrc_pktcap_rx(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Captures a packet to be sent
+ *
+ * @param[in] pkt   packet starting with its @ref gnrc_netif_hdr_t
+ */
+void gnrc_pktcap_tx(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Drains the capture ring as a pcapng section
+ *
+ * The section contains the packets that were captured until the call, and
+ * an interface for each of their link types. Sections of subsequent calls can be concatenated to a
+ * single pcapng file. Packets that were captured during the export are left
+ * for the next call.
+ *
+ * @pre     Not called by more than one thread at a time
+ *
+ * @param[in] write     output of the section
+ * @param[in] arg       argument for @p write
+ *
+ * @return  number of exported packets
+ * @return  negative number returned by @p write, if it failed
+ */
+int gnrc_pktcap_export(gnrc_pktcap_write_t write, void *arg);
+
+/**
+ * @brief   Gets the capture statistics
+ *
+ * @return  the statistics since the start of the system
+ */
+const gnrc_pktcap_stats_t *gnrc_pktcap_get_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_PKTCAP_H */
+/** @} */
@@ -29,6 +29,20 @@
  *   USEMODULE += auto_init_gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - MRHOF with the ETX metric as default objective function
+ *   (@ref net_gnrc_rpl_mrhof)
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_mrhof
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * - Source routing from the root in Non-Storing Mode
+ *   (@ref net_gnrc_rpl_srh_root), with
+ *   `CFLAGS += -DGNRC_RPL_DEFAULT_MOP=GNRC_RPL_MOP_NON_STORING_MODE` on all
+ *   nodes
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_srh_root
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * Auto-Initialization
  * -------------------
  *
@@ -198,12 +212,32 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @brief   Default Objective Code Point
+ *
+ * MRHOF (1) if the module `gnrc_rpl_mrhof` is used, OF0 (0) otherwise.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_DEFAULT_OCP (1)
+#else
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+#endif
+
+/**
+ * @brief   Type of the ETX routing metric
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-6.1">
+ *          RFC 6551, section 6.1
+ *      </a>
+ */
+#define GNRC_RPL_METRIC_ETX (7)
 
 /**
  * @brief   Default Instance ID
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof RPL Minimum Rank with Hysteresis OF
+ * @ingroup     net_gnrc_rpl
+ * @brief       Objective function that selects parents by the ETX of the
+ *              path to the root
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ *
+ * The ETX of the link to a parent is taken from @ref net_netstats_neighbor.
+ * The path cost through a parent is the parent's rank plus the link's ETX,
+ * scaled so an ETX of 1 increases the rank by the instance's
+ * MinHopRankIncrease. The preferred parent only changes if another parent
+ * offers a path cheaper by at least
+ * @ref GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ *
+ * The rank is advertised without a metric container.
+ * @{
+ *
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function
+ */
+#ifndef GNRC_RPL_MRHOF_H
+#define GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective code point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (0x1)
+
+/**
+ * @brief   Fixed point divisor of link ETX values, see
+ *          @ref NETSTATS_NB_ETX_DIVISOR
+ */
+#define GNRC_RPL_MRHOF_ETX_DIVISOR              (128U)
+
+/**
+ * @brief   Maximum ETX of the link to a parent, in units of
+ *          1/@ref GNRC_RPL_MRHOF_ETX_DIVISOR
+ *
+ * Parents behind worse links are not selected.
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+
+/**
+ * @brief   Difference in path cost, in units of
+ *          1/@ref GNRC_RPL_MRHOF_ETX_DIVISOR ETX, at which the preferred
+ *          parent is changed
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+
+/**
+ * @brief   ETX assumed for the link to a parent until the link layer has
+ *          sent frames to it, in units of 1/@ref GNRC_RPL_MRHOF_ETX_DIVISOR
+ */
+#ifndef GNRC_RPL_MRHOF_DEFAULT_LINK_METRIC
+#define GNRC_RPL_MRHOF_DEFAULT_LINK_METRIC      (256U)
+#endif
+
+/**
+ * @brief   Return the address of the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_RPL_MRHOF_H */
+/** @} */
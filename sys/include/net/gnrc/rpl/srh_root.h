@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_srh_root RPL non-storing root
+ * @ingroup     net_gnrc_rpl
+ * @brief       Downward source routing for the root of a non-storing DODAG
+ *
+ * In non-storing mode every node reports its DODAG parent to the root via
+ * the Transit Information option of its DAO. The root keeps these parent
+ * pointers in an array-indexed graph, walks it from the destination up to the
+ * root to compute a source route, and inserts a compressed RPL source routing
+ * header into packets it originates.
+ *
+ * Source routes are cached per destination until the topology changes.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6554">
+ *          RFC 6554
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the RPL non-storing root
+ */
+#ifndef GNRC_RPL_SRH_ROOT_H
+#define GNRC_RPL_SRH_ROOT_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of nodes in the DODAG known to the root
+ */
+#ifndef GNRC_RPL_SRH_ROOT_NODES_NUMOF
+#define GNRC_RPL_SRH_ROOT_NODES_NUMOF       (32)
+#endif
+
+/**
+ * @brief   Number of hash buckets of the address index
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef GNRC_RPL_SRH_ROOT_BUCKETS
+#define GNRC_RPL_SRH_ROOT_BUCKETS           (32)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route, including the
+ *          destination
+ */
+#ifndef GNRC_RPL_SRH_ROOT_MAX_DEPTH
+#define GNRC_RPL_SRH_ROOT_MAX_DEPTH         (16)
+#endif
+
+/**
+ * @brief   Number of cached source routes
+ */
+#ifndef GNRC_RPL_SRH_ROOT_CACHE_SIZE
+#define GNRC_RPL_SRH_ROOT_CACHE_SIZE        (4)
+#endif
+
+/**
+ * @brief   Adds or refreshes the parent pointer of a node
+ *
+ * @param[in] target    address of the node
+ * @param[in] parent    address of the node's DODAG parent, NULL if the
+ *                      parent is the root itself
+ * @param[in] expires   time in seconds at which the entry expires, in the time
+ *                      base used for gnrc_rpl_srh_root_expire()
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if there is no space left for @p target or @p parent
+ */
+int gnrc_rpl_srh_root_update(const ipv6_addr_t *target,
+                             const ipv6_addr_t *parent, uint32_t expires);
+
+/**
+ * @brief   Removes a node
+ *
+ * Children of the node stay in the table but have no route until they
+ * report a new parent.
+ *
+ * @param[in] target    address of the node
+ */
+void gnrc_rpl_srh_root_remove(const ipv6_addr_t *target);
+
+/**
+ * @brief   Removes all nodes whose entries expired
+ *
+ * @param[in] now   current time in seconds
+ */
+void gnrc_rpl_srh_root_expire(uint32_t now);
+
+/**
+ * @brief   Removes all nodes
+ */
+void gnrc_rpl_srh_root_reset(void);
+
+/**
+ * @brief   Computes the source route to a node
+ *
+ * @param[in] dst       address of the node
+ * @param[out] path     the hops from the root's child down to @p dst
+ * @param[in] max       maximum number of hops in @p path
+ *
+ * @return  number of hops in @p path, @p dst being the last one
+ * @return  -ENOENT if there is no route to @p dst
+ * @return  -ENOSPC if the route is longer than @p max
+ */
+int gnrc_rpl_srh_root_get_path(const ipv6_addr_t *dst, ipv6_addr_t *path,
+                               unsigned max);
+
+/**
+ * @brief   Builds a compressed source routing header for a packet to @p dst
+ *
+ * The header's next header field is left for the caller to set.
+ *
+ * @param[in] dst       destination of the packet
+ * @param[in] payload   payload of the routing header
+ * @param[out] first    first hop, i.e. the new IPv6 destination of the packet
+ *
+ * @return  the routing header, its `next` pointing to @p payload
+ * @return  NULL, if @p dst is a child of the root, no route is known, or the
+ *          packet buffer is full
+ */
+gnrc_pktsnip_t *gnrc_rpl_srh_root_build(const ipv6_addr_t *dst,
+                                        gnrc_pktsnip_t *payload,
+                                        ipv6_addr_t *first);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_RPL_SRH_ROOT_H */
+/** @} */
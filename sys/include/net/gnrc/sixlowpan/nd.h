@@ -62,6 +62,8 @@ extern "C" {
 
 /**
  * @brief   Message type for address registration timeout
+ *
+ * @see     gnrc_sixlowpan_nd_router_reg_tick()
  */
 #define GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT    (0x0224)
 
@@ -23,8 +23,11 @@
 #include <stdbool.h>
 
 #include "bitfield.h"
+#include "net/eui64.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +54,36 @@ extern "C" {
         (GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF * GNRC_NETIF_NUMOF)
 #endif
 
+/**
+ * @brief   Number of hash buckets of the address registration table, for both
+ *          addresses and EUI-64s
+ *
+ * Must be a power of 2.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS    (32U)
+#endif
+
+/**
+ * @brief   Number of slots of the timer wheel expiring address registrations
+ *
+ * Registrations with a lifetime longer than the wheel turn once per slot
+ * wait for more turns. Must be a power of 2.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL      (64U)
+#endif
+
+/**
+ * @brief   Time in microseconds the timer wheel takes for one slot
+ *
+ * Registration lifetimes are counted in minutes, so there is little use in
+ * a finer resolution except for tests.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK       (60U * US_PER_SEC)
+#endif
+
 /**
  * @brief   Representation for prefixes coming from a router
  */
@@ -125,6 +158,84 @@ static inline void gnrc_sixlowpan_nd_router_set_router(gnrc_ipv6_netif_t *netif,
  */
 void gnrc_sixlowpan_nd_router_set_rtr_adv(gnrc_ipv6_netif_t *netif, bool enable);
 
+/**
+ * @brief   Registers a neighbor cache entry in the address registration table
+ *          or refreshes its registration
+ *
+ * @details The table indexes the registered entries by address and by EUI-64
+ *          and removes them from the neighbor cache when their lifetime ran
+ *          out. All registrations share one timer, which posts
+ *          @ref GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT to the IPv6 thread every
+ *          @ref GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK while the table is not
+ *          empty. A registration expires no earlier than @p ltime minutes
+ *          and less than two ticks later.
+ *
+ * @note    The table is not locked. It is changed by the IPv6 thread only, so
+ *          the functions of the table must be called by the IPv6 thread or
+ *          while it can not run.
+ *
+ * @param[in] nc_entry  A neighbor cache entry. Must not be NULL.
+ * @param[in] eui64     The EUI-64 of the registering node.
+ * @param[in] ltime     Registration lifetime in minutes. Must not be 0.
+ */
+void gnrc_sixlowpan_nd_router_reg_add(gnrc_ipv6_nc_t *nc_entry, const eui64_t *eui64,
+                                      uint16_t ltime);
+
+/**
+ * @brief   Removes a neighbor cache entry from the address registration table
+ *
+ * @details Called when the entry is removed from the neighbor cache, does
+ *          nothing if @p nc_entry is not registered.
+ *
+ * @param[in] nc_entry  A neighbor cache entry. Must not be NULL.
+ */
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_ipv6_nc_t *nc_entry);
+
+/**
+ * @brief   Looks up a registered address
+ *
+ * @note    See @ref gnrc_sixlowpan_nd_router_reg_add() for calls from
+ *          other threads than the IPv6 thread.
+ *
+ * @param[in] iface     The interface of the registration. May be
+ *                      @ref KERNEL_PID_UNDEF for any interface.
+ * @param[in] addr      A registered address.
+ *
+ * @return  The neighbor cache entry of @p addr.
+ * @return  NULL, if @p addr is not registered.
+ */
+gnrc_ipv6_nc_t *gnrc_sixlowpan_nd_router_reg_get(kernel_pid_t iface, const ipv6_addr_t *addr);
+
+/**
+ * @brief   Iterates over the addresses a node registered
+ *
+ * @param[in] eui64     The EUI-64 of the node.
+ * @param[in] prev      The previous registration of the node, NULL to get the
+ *                      first one.
+ *
+ * @return  The neighbor cache entry of the next registration of @p eui64.
+ * @return  NULL, if there are no more.
+ */
+gnrc_ipv6_nc_t *gnrc_sixlowpan_nd_router_reg_get_by_eui64(const eui64_t *eui64,
+                                                          gnrc_ipv6_nc_t *prev);
+
+/**
+ * @brief   Expires the address registrations whose lifetime ran out
+ *
+ * @details Handles @ref GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT.
+ */
+void gnrc_sixlowpan_nd_router_reg_tick(void);
+
+/**
+ * @brief   Get the number of registered addresses
+ *
+ * @note    See @ref gnrc_sixlowpan_nd_router_reg_add() for calls from
+ *          other threads than the IPv6 thread.
+ *
+ * @return  The number of entries in the address registration table.
+ */
+unsigned gnrc_sixlowpan_nd_router_reg_numof(void);
+
 /**
  * @brief   Get's the border router for this router.
  *
@@ -105,6 +105,20 @@ typedef int (*netdev2_test_send_cb_t)(netdev2_t *dev,
                                       const struct iovec *vector,
                                       int count);
 
+/**
+ * @brief   Callback type to handle batch send command
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] frames    frames to send
+ * @param[in] num       number of entries in frames
+ *
+ * @return  number of frames sent
+ * @return  < 0 on error
+ */
+typedef int (*netdev2_test_send_batch_cb_t)(netdev2_t *dev,
+                                            const netdev2_frame_t *frames,
+                                            unsigned num);
+
 /**
  * @brief   Callback type to handle receive command
  *
@@ -187,6 +201,7 @@ typedef struct {
      * @{
      */
     netdev2_test_send_cb_t send_cb;                 /**< callback to handle send command */
+    netdev2_test_send_batch_cb_t send_batch_cb;     /**< callback to handle batch send command */
     netdev2_test_recv_cb_t recv_cb;                 /**< callback to handle receive command */
     netdev2_test_init_cb_t init_cb;                 /**< callback to handle initialization events */
     netdev2_test_isr_cb_t isr_cb;                   /**< callback to handle ISR events */
@@ -211,6 +226,22 @@ static inline void netdev2_test_set_send_cb(netdev2_test_t *dev,
     mutex_unlock(&dev->mutex);
 }
 
+/**
+ * @brief   override batch send callback
+ *
+ * Without a batch send callback, the device sends frames one by one.
+ *
+ * @param[in] dev           a @ref sys_netdev2_test device
+ * @param[in] send_batch_cb a batch send callback
+ */
+static inline void netdev2_test_set_send_batch_cb(netdev2_test_t *dev,
+                                                  netdev2_test_send_batch_cb_t send_batch_cb)
+{
+    mutex_lock(&dev->mutex);
+    dev->send_batch_cb = send_batch_cb;
+    mutex_unlock(&dev->mutex);
+}
+
 /**
  * @brief   override receive callback
  *
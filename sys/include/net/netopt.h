@@ -240,6 +240,17 @@ typedef enum {
      */
     NETOPT_RF_TESTMODE,
 
+    /**
+     * @brief en/disable @ref NETDEV2_EVENT_RX_PENDING
+     *
+     * If enabled, the device signals received frames with a single
+     * @ref NETDEV2_EVENT_RX_PENDING and the upper layer fetches all of them,
+     * instead of one @ref NETDEV2_EVENT_RX_COMPLETE per frame. The device's
+     * recv() must return 0 for a NULL buffer once no frame is left. Devices
+     * that can not hold more than one frame return -ENOTSUP.
+     */
+    NETOPT_RX_BATCH,
+
     /* add more options if needed */
 
     /**
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_latency Packet latency per layer
+ * @ingroup     net_netstats
+ * @brief       Histograms of the time packets spend between the layers of
+ *              @ref net_gnrc
+ *
+ * Every layer stamps a packet with @ref netstats_lat_stamp() right before it
+ * hands the packet on with @ref net_gnrc_netapi. Received packets are
+ * stamped by @ref net_gnrc_netdev2, 6LoWPAN, IPv6, UDP, and finally by sock
+ * when they are delivered to the application. Sent packets pass the same
+ * stages in the reverse order, from sock to the device.
+ *
+ * The stamp is kept in the last snip of the packet, which is the
+ * @ref gnrc_netif_hdr_t of a received packet and the payload of a packet to
+ * be sent. Both stay with the packet while the headers in front of them are
+ * marked, compressed or replaced. The time since the previous stamp of the
+ * same direction goes into the histogram of the stage, so it includes the
+ * time the packet waited in the message queue of the stage's thread.
+ * Packets that are not stamped at the first stage of their direction, e.g.
+ * packets created by IPv6 itself or 6LoWPAN fragments, are not accounted.
+ *
+ * The histograms have logarithmic buckets. Bucket 0 counts latencies of
+ * less than 1 µs, bucket i > 0 latencies of at least 2^(i - 1) µs and less
+ * than 2^i µs. The last bucket has no upper bound.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definition of per layer packet latency statistics
+ */
+
+#ifndef NETSTATS_LATENCY_H
+#define NETSTATS_LATENCY_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of buckets per histogram
+ *
+ * The default covers latencies up to 65 ms.
+ */
+#ifndef NETSTATS_LAT_BUCKETS
+#define NETSTATS_LAT_BUCKETS    (18U)
+#endif
+
+/**
+ * @brief   Stages of a packet
+ *
+ * The first stage of each direction only starts the measurement.
+ */
+typedef enum {
+    NETSTATS_LAT_NONE = 0,          /**< packet was not stamped */
+    NETSTATS_LAT_RX_NETDEV,         /**< received from the device */
+    NETSTATS_LAT_RX_SIXLOWPAN,      /**< decoded by 6LoWPAN */
+    NETSTATS_LAT_RX_IPV6,           /**< handled by IPv6 */
+    NETSTATS_LAT_RX_UDP,            /**< demultiplexed by UDP */
+    NETSTATS_LAT_RX_SOCK,           /**< delivered to the application */
+    NETSTATS_LAT_TX_SOCK,           /**< sent by the application */
+    NETSTATS_LAT_TX_UDP,            /**< handled by UDP */
+    NETSTATS_LAT_TX_IPV6,           /**< handled by IPv6 */
+    NETSTATS_LAT_TX_SIXLOWPAN,      /**< encoded by 6LoWPAN */
+    NETSTATS_LAT_TX_NETDEV,         /**< handed to the device */
+    NETSTATS_LAT_NUMOF              /**< number of stages */
+} netstats_lat_stage_t;
+
+/**
+ * @brief   Latency histogram of a stage
+ */
+typedef struct {
+    uint32_t count;                 /**< number of samples */
+    uint32_t sum;                   /**< sum of all samples in µs */
+    uint32_t max;                   /**< largest sample in µs */
+    uint32_t buckets[NETSTATS_LAT_BUCKETS]; /**< samples per bucket */
+} netstats_lat_hist_t;
+
+/**
+ * @brief   Stamps a packet at a stage
+ *
+ * Adds the time since the previous stamp to the histogram of @p stage, if
+ * the packet was stamped at an earlier stage of the same direction before.
+ *
+ * @param[in] pkt       packet, must not be NULL
+ * @param[in] stage     stage the packet passes
+ */
+void netstats_lat_stamp(gnrc_pktsnip_t *pkt, netstats_lat_stage_t stage);
+
+/**
+ * @brief   Gets the histogram of a stage
+ *
+ * @param[in] stage     a stage
+ *
+ * @return  the histogram of @p stage
+ */
+const netstats_lat_hist_t *netstats_lat_get(netstats_lat_stage_t stage);
+
+/**
+ * @brief   Estimates a percentile of a histogram
+ *
+ * The value is interpolated linearly within the bucket the percentile falls
+ * into.
+ *
+ * @param[in] hist      a histogram
+ * @param[in] percent   percentile, between 0 and 100
+ *
+ * @return  the percentile in µs
+ * @return  0, if @p hist has no samples
+ */
+uint32_t netstats_lat_percentile(const netstats_lat_hist_t *hist, unsigned percent);
+
+/**
+ * @brief   Clears the histograms of all stages
+ */
+void netstats_lat_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETSTATS_LATENCY_H */
+/** @} */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Link statistics per neighbor
+ * @ingroup     net_netstats
+ * @brief       Estimates the ETX of the link to each neighbor from the
+ *              outcome of unicast transmissions
+ *
+ * The link layer records the destination of each unicast frame with
+ * @ref netstats_nb_record() and reports the outcome of the transmission
+ * with @ref netstats_nb_update_tx(). Routing protocols read the resulting
+ * expected transmission count (ETX) with @ref netstats_nb_get_etx().
+ *
+ * @ref net_gnrc_netdev2 accounts the next TX event of the device to the
+ * neighbor of the last unicast frame it handed to the device, whether the
+ * driver reports it from within send() or later from its isr().
+ *
+ * The ETX of a link is the exponentially weighted moving average of the
+ * number of frames sent until one was acknowledged. A neighbor that does not
+ * acknowledge @ref NETSTATS_NB_MAX_FAILURES frames in a row is accounted for
+ * with a sample of @ref NETSTATS_NB_ETX_NOACK_PENALTY transmissions, so a
+ * broken link does not keep its old ETX.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definition of per neighbor link statistics
+ */
+
+#ifndef NETSTATS_NEIGHBOR_H
+#define NETSTATS_NEIGHBOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors to keep statistics for
+ *
+ * If the table is full, the least recently used neighbor is replaced.
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE            (8)
+#endif
+
+/**
+ * @brief   Maximum length of a link layer address
+ */
+#define NETSTATS_NB_L2_ADDR_MAX     (8)
+
+/**
+ * @brief   Fixed point divisor of the ETX
+ *
+ * Same as the encoding of the ETX in RPL's metric container
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ */
+#define NETSTATS_NB_ETX_DIVISOR     (128U)
+
+/**
+ * @brief   ETX sample for @ref NETSTATS_NB_MAX_FAILURES consecutive failed
+ *          transmissions, in transmissions
+ */
+#ifndef NETSTATS_NB_ETX_NOACK_PENALTY
+#define NETSTATS_NB_ETX_NOACK_PENALTY   (10U)
+#endif
+
+/**
+ * @brief   Weight of the old ETX in the moving average, in percent
+ */
+#ifndef NETSTATS_NB_ETX_ALPHA
+#define NETSTATS_NB_ETX_ALPHA       (90U)
+#endif
+
+/**
+ * @brief   Number of consecutive failed transmissions after which the
+ *          failures are accounted for in the ETX
+ */
+#ifndef NETSTATS_NB_MAX_FAILURES
+#define NETSTATS_NB_MAX_FAILURES    (4U)
+#endif
+
+/**
+ * @name    Outcome of a transmission
+ * @{
+ */
+#define NETSTATS_NB_SUCCESS         (0)     /**< frame was acknowledged */
+#define NETSTATS_NB_NOACK           (1)     /**< frame was not acknowledged */
+#define NETSTATS_NB_BUSY            (2)     /**< medium was busy, frame was
+                                             *   not sent */
+/** @} */
+
+/**
+ * @brief   Statistics of the link to a neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[NETSTATS_NB_L2_ADDR_MAX];   /**< link layer address of
+                                                 *   the neighbor */
+    uint8_t l2_addr_len;    /**< length of netstats_nb_t::l2_addr, 0 if the
+                             *   entry is unused */
+    kernel_pid_t iface;     /**< interface the neighbor is reachable on */
+    uint16_t etx;           /**< ETX in units of 1/@ref NETSTATS_NB_ETX_DIVISOR,
+                             *   0 before the first sample */
+    uint8_t failures;       /**< failed transmissions since last success */
+    uint16_t last_use;      /**< time of last use, for replacement */
+    uint32_t tx_count;      /**< frames sent to the neighbor */
+    uint32_t tx_failed;     /**< frames not acknowledged by the neighbor */
+} netstats_nb_t;
+
+/**
+ * @brief   Records the neighbor a unicast frame is sent to
+ *
+ * Adds the neighbor to the table if needed.
+ *
+ * @param[in] iface         interface the frame is sent on
+ * @param[in] l2_addr       link layer destination of the frame
+ * @param[in] l2_addr_len   length of @p l2_addr
+ *
+ * @return  entry for the neighbor, to pass to netstats_nb_update_tx() when
+ *          the transmission finished
+ * @return  NULL, if @p l2_addr_len is 0 or too long
+ */
+netstats_nb_t *netstats_nb_record(kernel_pid_t iface, const uint8_t *l2_addr,
+                                  size_t l2_addr_len);
+
+/**
+ * @brief   Updates the statistics of a neighbor with the outcome of a
+ *          transmission
+ *
+ * @param[in] nb        entry returned by netstats_nb_record(), may be NULL
+ * @param[in] result    outcome of the transmission, one of
+ *                      @ref NETSTATS_NB_SUCCESS, @ref NETSTATS_NB_NOACK, and
+ *                      @ref NETSTATS_NB_BUSY
+ */
+void netstats_nb_update_tx(netstats_nb_t *nb, unsigned result);
+
+/**
+ * @brief   Gets the ETX of the link to a neighbor
+ *
+ * @param[in] iface         interface the neighbor is reachable on
+ * @param[in] l2_addr       link layer address of the neighbor
+ * @param[in] l2_addr_len   length of @p l2_addr
+ *
+ * @return  ETX in units of 1/@ref NETSTATS_NB_ETX_DIVISOR
+ * @return  0, if there is no estimate for the neighbor yet
+ */
+uint16_t netstats_nb_get_etx(kernel_pid_t iface, const uint8_t *l2_addr,
+                             size_t l2_addr_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETSTATS_NEIGHBOR_H */
+/** @} */
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_sampler SAUL sampler
+ * @ingroup     sys_saul_reg
+ * @brief       Batch sampling of SAUL devices into a ring of timestamped
+ *              readings
+ *
+ * A sampler reads a fixed set of devices, looked up once in the SAUL
+ * registry, with one call to saul_sampler_read(). The readings are stored,
+ * together with the time of the call, in a ring buffer provided by the user,
+ * from which they are taken with saul_sampler_get(). Devices whose driver
+ * implements @ref saul_driver_t::read_multi hand out all buffered readings
+ * at once.
+ *
+ * The ring is written by the sampling thread only and may be read from
+ * another thread. If it is full, new readings are dropped and counted in
+ * @ref saul_sampler_t::lost.
+ *
+ * A scheduler runs any number of samplers periodically from a single xtimer.
+ * The timer sends a message to the sampling thread, which passes it to
+ * saul_sched_handle():
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * saul_sched_init(&sched, thread_getpid());
+ * saul_sched_add(&sched, &sampler, 10 * US_PER_MS);
+ * while (1) {
+ *     msg_receive(&msg);
+ *     saul_sched_handle(&sched, &msg);
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler interface
+ */
+
+#ifndef SAUL_SAMPLER_H
+#define SAUL_SAMPLER_H
+
+#include <stdint.h>
+
+#include "cib.h"
+#include "msg.h"
+#include "phydat.h"
+#include "saul_reg.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type of the scheduler's timer
+ */
+#define SAUL_SCHED_MSG_TYPE     (0x0c00)
+
+/**
+ * @brief   Maximum number of readings taken from a device's FIFO at once
+ */
+#ifndef SAUL_SAMPLER_FIFO_MAX
+#define SAUL_SAMPLER_FIFO_MAX   (8U)
+#endif
+
+/**
+ * @brief   Timestamped reading of a device
+ */
+typedef struct {
+    uint32_t time;              /**< time of the reading in microseconds */
+    phydat_t data;              /**< values read */
+    uint8_t dev;                /**< index of the device in the sampler */
+    uint8_t dim;                /**< number of values in @p data */
+} saul_sample_t;
+
+/**
+ * @brief   Set of devices that is read at once
+ */
+typedef struct saul_sampler {
+    struct saul_sampler *next;  /**< next sampler of the scheduler */
+    saul_reg_t *const *devs;    /**< devices to read */
+    unsigned numof;             /**< number of devices */
+    saul_sample_t *ring;        /**< buffer for the readings */
+    cib_t cib;                  /**< read and write position in @p ring */
+    uint32_t period;            /**< sampling period in microseconds */
+    uint32_t deadline;          /**< time of the next scheduled reading */
+    uint32_t lost;              /**< readings dropped as the ring was full */
+    uint32_t errors;            /**< failed reads */
+} saul_sampler_t;
+
+/**
+ * @brief   Scheduler of periodic samplers
+ */
+typedef struct {
+    saul_sampler_t *samplers;   /**< scheduled samplers */
+    xtimer_t timer;             /**< timer of the next deadline */
+    msg_t msg;                  /**< message sent by @p timer */
+    kernel_pid_t pid;           /**< sampling thread */
+} saul_sched_t;
+
+/**
+ * @brief   Initialize a sampler
+ *
+ * @param[out] sampler  sampler to initialize
+ * @param[in] devs      devices to read, must stay valid
+ * @param[in] numof     number of devices, at most 256
+ * @param[in] ring      buffer for the readings
+ * @param[in] size      number of readings @p ring can hold, must be a power
+ *                      of 2
+ */
+void saul_sampler_init(saul_sampler_t *sampler, saul_reg_t *const *devs,
+                       unsigned numof, saul_sample_t *ring, unsigned size);
+
+/**
+ * @brief   Read all devices of a sampler
+ *
+ * All readings of one call share the same timestamp.
+ *
+ * @param[in,out] sampler   sampler to read
+ *
+ * @return  number of readings stored in the ring
+ */
+int saul_sampler_read(saul_sampler_t *sampler);
+
+/**
+ * @brief   Take the oldest readings from the ring of a sampler
+ *
+ * @param[in,out] sampler   sampler to take the readings from
+ * @param[out] samples      readings
+ * @param[in] max           maximum number of readings to take
+ *
+ * @return  number of readings written to @p samples
+ */
+unsigned saul_sampler_get(saul_sampler_t *sampler, saul_sample_t *samples,
+                          unsigned max);
+
+/**
+ * @brief   Number of readings waiting in the ring of a sampler
+ *
+ * @param[in] sampler   sampler to check
+ *
+ * @return  number of readings
+ */
+static inline unsigned saul_sampler_avail(const saul_sampler_t *sampler)
+{
+    return cib_avail(&sampler->cib);
+}
+
+/**
+ * @brief   Initialize a scheduler
+ *
+ * @param[out] sched    scheduler to initialize
+ * @param[in] pid       thread that receives the timer messages
+ */
+void saul_sched_init(saul_sched_t *sched, kernel_pid_t pid);
+
+/**
+ * @brief   Run a sampler periodically, starting one period from now
+ *
+ * Call this from the sampling thread, or before it handles the first
+ * message.
+ *
+ * @param[in,out] sched     scheduler
+ * @param[in,out] sampler   sampler to run
+ * @param[in] period        period in microseconds
+ */
+void saul_sched_add(saul_sched_t *sched, saul_sampler_t *sampler,
+                    uint32_t period);
+
+/**
+ * @brief   Stop running a sampler
+ *
+ * Call this from the sampling thread.
+ *
+ * @param[in,out] sched     scheduler
+ * @param[in,out] sampler   sampler to stop
+ */
+void saul_sched_remove(saul_sched_t *sched, saul_sampler_t *sampler);
+
+/**
+ * @brief   Handle a message received by the sampling thread
+ *
+ * Runs all samplers that are due and sets the timer to the next deadline.
+ * Deadlines that were missed entirely are skipped.
+ *
+ * @param[in,out] sched     scheduler
+ * @param[in] msg           received message
+ *
+ * @return  number of samplers run
+ * @return  -EINVAL if @p msg is not from the timer of @p sched
+ */
+int saul_sched_handle(saul_sched_t *sched, const msg_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_SAMPLER_H */
+/** @} */
@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_schema Schema based serialization
+ * @ingroup     sys
+ * @brief       Compile time generated CBOR and UBJSON codecs for structs
+ *
+ * A schema lists the fields of a struct in a macro, each with its name and
+ * one of the following kinds:
+ *
+ * | kind                 | C type            | CBOR          | UBJSON        |
+ * |:-------------------- |:----------------- |:------------- |:------------- |
+ * | `SCHEMA_BOOL`        | `bool`            | simple value  | `T` / `F`     |
+ * | `SCHEMA_U8`          | `uint8_t`         | 8 bit int     | `U`           |
+ * | `SCHEMA_I8`          | `int8_t`          | 8 bit int     | `i`           |
+ * | `SCHEMA_U16`         | `uint16_t`        | 16 bit int    | `l`           |
+ * | `SCHEMA_I16`         | `int16_t`         | 16 bit int    | `I`           |
+ * | `SCHEMA_U32`         | `uint32_t`        | 32 bit int    | `L`           |
+ * | `SCHEMA_I32`         | `int32_t`         | 32 bit int    | `l`           |
+ * | `SCHEMA_FLOAT`       | `float`           | float32       | `d`           |
+ * | `SCHEMA_BYTES(n)`    | `uint8_t[n]`      | byte string   | `[$U#U` array |
+ *
+ * SCHEMA_DEFINE() then generates encoders and decoders for the struct,
+ * which write and read a map (object) with the field names as keys:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * typedef struct {
+ *     uint32_t time;
+ *     int16_t temp;
+ *     uint8_t id[8];
+ * } sample_t;
+ *
+ * #define SAMPLE_FIELDS(FIELD)        \
+ *     FIELD(time, SCHEMA_U32)         \
+ *     FIELD(temp, SCHEMA_I16)         \
+ *     FIELD(id, SCHEMA_BYTES(8))
+ *
+ * SCHEMA_DEFINE(sample, sample_t, SAMPLE_FIELDS)
+ *
+ * uint8_t buf[SCHEMA_CBOR_SIZE(SAMPLE_FIELDS)];
+ * size_t len = sample_cbor_encode(&sample, buf, sizeof(buf));
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Every value is encoded with the width of its C type, so the layout of the
+ * document is fixed: all headers and keys are constants, and the encoder is
+ * straight-line code without any type dispatch. The output is regular CBOR
+ * or UBJSON, but the decoders only accept exactly this layout. Use @ref cbor
+ * or @ref sys_ubjson for documents from other sources.
+ *
+ * Field names are limited to 23 characters, and a schema to 23 fields.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Schema based serialization interface
+ */
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the CBOR encoding of a schema
+ *
+ * @param[in] fields    macro listing the fields
+ */
+#define SCHEMA_CBOR_SIZE(fields)    (1 fields(_SCHEMA_CBOR_FIELD_SIZE))
+
+/**
+ * @brief   Size of the UBJSON encoding of a schema
+ *
+ * @param[in] fields    macro listing the fields
+ */
+#define SCHEMA_UBJSON_SIZE(fields)  (4 fields(_SCHEMA_UBJSON_FIELD_SIZE))
+
+/**
+ * @brief   Number of fields of a schema
+ *
+ * @param[in] fields    macro listing the fields
+ */
+#define SCHEMA_FIELDS(fields)       (0 fields(_SCHEMA_COUNT))
+
+/**
+ * @brief   Declares the functions generated by SCHEMA_DEFINE()
+ *
+ * @param[in] prefix    prefix of the function names
+ * @param[in] type      struct type
+ */
+#define SCHEMA_DECLARE(prefix, type) \
+    size_t prefix ## _cbor_encode(const type *s, uint8_t *buf, size_t len); \
+    int prefix ## _cbor_decode(type *s, const uint8_t *buf, size_t len); \
+    size_t prefix ## _ubjson_encode(const type *s, uint8_t *buf, size_t len); \
+    int prefix ## _ubjson_decode(type *s, const uint8_t *buf, size_t len)
+
+/**
+ * @brief   Generates the encoders and decoders of a schema
+ *
+ * - `size_t <prefix>_cbor_encode(const type *s, uint8_t *buf, size_t len)`
+ *   and `<prefix>_ubjson_encode()` write @p s to @p buf and return the
+ *   number of bytes written, or 0 if @p len is less than
+ *   SCHEMA_CBOR_SIZE() or SCHEMA_UBJSON_SIZE() respectively.
+ * - `int <prefix>_cbor_decode(type *s, const uint8_t *buf, size_t len)` and
+ *   `<prefix>_ubjson_decode()` read @p s from @p buf and return the number
+ *   of bytes read, or -EBADMSG if @p buf doesn't hold an encoding of the
+ *   schema. On error, the contents of @p s are undefined.
+ *
+ * @param[in] prefix    prefix of the function names
+ * @param[in] type      struct type
+ * @param[in] fields    macro listing the fields
+ */
+#define SCHEMA_DEFINE(prefix, type, fields) \
+    size_t prefix ## _cbor_encode(const type *s, uint8_t *buf, size_t len) \
+    { \
+        uint8_t *p = buf; \
+        _SCHEMA_CHECK(SCHEMA_FIELDS(fields) < 24); \
+        if (len < SCHEMA_CBOR_SIZE(fields)) { \
+            return 0; \
+        } \
+        *p++ = _SCHEMA_CBOR_MAP | SCHEMA_FIELDS(fields); \
+        fields(_SCHEMA_CBOR_ENCODE) \
+        return p - buf; \
+    } \
+    int prefix ## _cbor_decode(type *s, const uint8_t *buf, size_t len) \
+    { \
+        const uint8_t *p = buf; \
+        bool ok; \
+        if (len < SCHEMA_CBOR_SIZE(fields)) { \
+            return -EBADMSG; \
+        } \
+        ok = (*p++ == (_SCHEMA_CBOR_MAP | SCHEMA_FIELDS(fields))); \
+        fields(_SCHEMA_CBOR_DECODE) \
+        return ok ? (int)(p - buf) : -EBADMSG; \
+    } \
+    size_t prefix ## _ubjson_encode(const type *s, uint8_t *buf, size_t len) \
+    { \
+        uint8_t *p = buf; \
+        if (len < SCHEMA_UBJSON_SIZE(fields)) { \
+            return 0; \
+        } \
+        p = _schema_ubjson_put_count(p, '{', SCHEMA_FIELDS(fields)); \
+        fields(_SCHEMA_UBJSON_ENCODE) \
+        return p - buf; \
+    } \
+    int prefix ## _ubjson_decode(type *s, const uint8_t *buf, size_t len) \
+    { \
+        const uint8_t *p = buf; \
+        bool ok; \
+        if (len < SCHEMA_UBJSON_SIZE(fields)) { \
+            return -EBADMSG; \
+        } \
+        ok = _schema_ubjson_get_count(p, '{', SCHEMA_FIELDS(fields)); \
+        p += 4; \
+        fields(_SCHEMA_UBJSON_DECODE) \
+        return ok ? (int)(p - buf) : -EBADMSG; \
+    }
+
+/**
+ * @cond INTERNAL
+ *
+ * Each kind maps to a class, which selects the helpers below, and to the
+ * width of its C type.
+ */
+#define _SCHEMA_CLASS_SCHEMA_BOOL       boolean
+#define _SCHEMA_CLASS_SCHEMA_U8         uint
+#define _SCHEMA_CLASS_SCHEMA_I8         int
+#define _SCHEMA_CLASS_SCHEMA_U16        uint
+#define _SCHEMA_CLASS_SCHEMA_I16        int
+#define _SCHEMA_CLASS_SCHEMA_U32        uint
+#define _SCHEMA_CLASS_SCHEMA_I32        int
+#define _SCHEMA_CLASS_SCHEMA_FLOAT      float
+#define _SCHEMA_CLASS_SCHEMA_BYTES(n)   bytes
+
+#define _SCHEMA_WIDTH_SCHEMA_BOOL       (1)
+#define _SCHEMA_WIDTH_SCHEMA_U8         (1)
+#define _SCHEMA_WIDTH_SCHEMA_I8         (1)
+#define _SCHEMA_WIDTH_SCHEMA_U16        (2)
+#define _SCHEMA_WIDTH_SCHEMA_I16        (2)
+#define _SCHEMA_WIDTH_SCHEMA_U32        (4)
+#define _SCHEMA_WIDTH_SCHEMA_I32        (4)
+#define _SCHEMA_WIDTH_SCHEMA_FLOAT      (4)
+/* byte strings have a one byte length, checked by the encoders */
+#define _SCHEMA_WIDTH_SCHEMA_BYTES(n)   (n)
+
+#define _SCHEMA_CAT(a, b)               _SCHEMA_CAT2(a, b)
+#define _SCHEMA_CAT2(a, b)              a ## b
+#define _SCHEMA_CLASS(kind)             _SCHEMA_CLASS_ ## kind
+#define _SCHEMA_WIDTH(kind)             _SCHEMA_WIDTH_ ## kind
+#define _SCHEMA_CALL(op, kind)          _SCHEMA_CAT(op, _SCHEMA_CLASS(kind))
+
+/* fails to compile if cond is false */
+#define _SCHEMA_CHECK(cond)             (void)sizeof(char[(cond) ? 1 : -1])
+#define _SCHEMA_KEY_LEN(name)           (sizeof(#name) - 1)
+#define _SCHEMA_COUNT(name, kind)       + 1
+
+/* encoded size of the values of each class */
+#define _SCHEMA_CBOR_LEN_boolean(w)     (1)
+#define _SCHEMA_CBOR_LEN_uint(w)        (1 + (w))
+#define _SCHEMA_CBOR_LEN_int(w)         (1 + (w))
+#define _SCHEMA_CBOR_LEN_float(w)       (5)
+#define _SCHEMA_CBOR_LEN_bytes(w)       (((w) < 24 ? 1 : 2) + (w))
+
+#define _SCHEMA_UBJSON_LEN_boolean(w)   (1)
+#define _SCHEMA_UBJSON_LEN_uint(w)      ((w) == 1 ? 2 : (w) == 2 ? 5 : 9)
+#define _SCHEMA_UBJSON_LEN_int(w)       (1 + (w))
+#define _SCHEMA_UBJSON_LEN_float(w)     (5)
+#define _SCHEMA_UBJSON_LEN_bytes(w)     (6 + (w))
+
+#define _SCHEMA_CBOR_LEN(kind) \
+    _SCHEMA_CALL(_SCHEMA_CBOR_LEN_, kind)(_SCHEMA_WIDTH(kind))
+#define _SCHEMA_UBJSON_LEN(kind) \
+    _SCHEMA_CALL(_SCHEMA_UBJSON_LEN_, kind)(_SCHEMA_WIDTH(kind))
+
+/* key header and key, followed by the value */
+#define _SCHEMA_CBOR_FIELD_SIZE(name, kind) \
+    + 1 + _SCHEMA_KEY_LEN(name) + _SCHEMA_CBOR_LEN(kind)
+#define _SCHEMA_UBJSON_FIELD_SIZE(name, kind) \
+    + 2 + _SCHEMA_KEY_LEN(name) + _SCHEMA_UBJSON_LEN(kind)
+
+#define _SCHEMA_CBOR_MAP                (0xa0)
+#define _SCHEMA_CBOR_TEXT               (0x60)
+#define _SCHEMA_CBOR_BYTES              (0x40)
+#define _SCHEMA_CBOR_NEG                (0x20)
+#define _SCHEMA_CBOR_FALSE              (0xf4)
+#define _SCHEMA_CBOR_FLOAT32            (0xfa)
+
+#define _SCHEMA_CBOR_ENCODE(name, kind) \
+    _SCHEMA_CHECK(sizeof(s->name) == _SCHEMA_WIDTH(kind)); \
+    _SCHEMA_CHECK(_SCHEMA_KEY_LEN(name) < 24); \
+    _SCHEMA_CHECK(_SCHEMA_WIDTH(kind) <= 255); \
+    *p++ = _SCHEMA_CBOR_TEXT | _SCHEMA_KEY_LEN(name); \
+    memcpy(p, #name, _SCHEMA_KEY_LEN(name)); \
+    p += _SCHEMA_KEY_LEN(name); \
+    p = _SCHEMA_CALL(_schema_cbor_put_, kind)(p, s->name, _SCHEMA_WIDTH(kind));
+
+#define _SCHEMA_CBOR_DECODE(name, kind) \
+    ok &= (*p++ == (_SCHEMA_CBOR_TEXT | _SCHEMA_KEY_LEN(name))); \
+    ok &= (memcmp(p, #name, _SCHEMA_KEY_LEN(name)) == 0); \
+    p += _SCHEMA_KEY_LEN(name); \
+    _SCHEMA_CALL(_SCHEMA_CBOR_GET_, kind)(p, s->name, _SCHEMA_WIDTH(kind), ok); \
+    p += _SCHEMA_CBOR_LEN(kind);
+
+#define _SCHEMA_UBJSON_ENCODE(name, kind) \
+    _SCHEMA_CHECK(sizeof(s->name) == _SCHEMA_WIDTH(kind)); \
+    _SCHEMA_CHECK(_SCHEMA_KEY_LEN(name) < 24); \
+    _SCHEMA_CHECK(_SCHEMA_WIDTH(kind) <= 255); \
+    *p++ = 'U'; \
+    *p++ = _SCHEMA_KEY_LEN(name); \
+    memcpy(p, #name, _SCHEMA_KEY_LEN(name)); \
+    p += _SCHEMA_KEY_LEN(name); \
+    p = _SCHEMA_CALL(_schema_ubjson_put_, kind)(p, s->name, _SCHEMA_WIDTH(kind));
+
+#define _SCHEMA_UBJSON_DECODE(name, kind) \
+    ok &= (p[0] == 'U') && (p[1] == _SCHEMA_KEY_LEN(name)); \
+    p += 2; \
+    ok &= (memcmp(p, #name, _SCHEMA_KEY_LEN(name)) == 0); \
+    p += _SCHEMA_KEY_LEN(name); \
+    _SCHEMA_CALL(_SCHEMA_UBJSON_GET_, kind)(p, s->name, _SCHEMA_WIDTH(kind), ok); \
+    p += _SCHEMA_UBJSON_LEN(kind);
+
+#define _SCHEMA_CBOR_GET_boolean(p, dst, w, ok) \
+    (dst) = _schema_cbor_get_boolean(p, &ok)
+#define _SCHEMA_CBOR_GET_uint(p, dst, w, ok) \
+    (dst) = _schema_cbor_get_uint(p, w, &ok)
+#define _SCHEMA_CBOR_GET_int(p, dst, w, ok) \
+    (dst) = _schema_cbor_get_int(p, w, &ok)
+#define _SCHEMA_CBOR_GET_float(p, dst, w, ok) \
+    (dst) = _schema_cbor_get_float(p, &ok)
+#define _SCHEMA_CBOR_GET_bytes(p, dst, w, ok) \
+    _schema_cbor_get_bytes(p, dst, w, &ok)
+
+#define _SCHEMA_UBJSON_GET_boolean(p, dst, w, ok) \
+    (dst) = _schema_ubjson_get_boolean(p, &ok)
+#define _SCHEMA_UBJSON_GET_uint(p, dst, w, ok) \
+    (dst) = _schema_ubjson_get_uint(p, w, &ok)
+#define _SCHEMA_UBJSON_GET_int(p, dst, w, ok) \
+    (dst) = _schema_ubjson_get_int(p, w, &ok)
+#define _SCHEMA_UBJSON_GET_float(p, dst, w, ok) \
+    (dst) = _schema_ubjson_get_float(p, &ok)
+#define _SCHEMA_UBJSON_GET_bytes(p, dst, w, ok) \
+    _schema_ubjson_get_bytes(p, dst, w, &ok)
+
+/* All widths below are constants, so the loops and branches fold away. */
+
+static inline uint8_t *_schema_put_be(uint8_t *p, uint32_t val, unsigned width)
+{
+    while (width--) {
+        *p++ = val >> (8 * width);
+    }
+    return p;
+}
+
+static inline uint32_t _schema_get_be(const uint8_t *p, unsigned width)
+{
+    uint32_t val = 0;
+
+    while (width--) {
+        val = (val << 8) | *p++;
+    }
+    return val;
+}
+
+static inline uint32_t _schema_float_bits(float val)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .f = val };
+
+    return bits.u;
+}
+
+static inline float _schema_bits_float(uint32_t val)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = { .u = val };
+
+    return bits.f;
+}
+
+/* additional info of an integer header with a width bytes long argument */
+static inline uint8_t _schema_cbor_int_info(unsigned width)
+{
+    return 24 + (width >> 1);
+}
+
+static inline uint8_t *_schema_cbor_put_boolean(uint8_t *p, bool val,
+                                                unsigned width)
+{
+    (void)width;
+    *p++ = _SCHEMA_CBOR_FALSE + val;
+    return p;
+}
+
+static inline uint8_t *_schema_cbor_put_uint(uint8_t *p, uint32_t val,
+                                             unsigned width)
+{
+    *p++ = _schema_cbor_int_info(width);
+    return _schema_put_be(p, val, width);
+}
+
+static inline uint8_t *_schema_cbor_put_int(uint8_t *p, int32_t val,
+                                            unsigned width)
+{
+    /* all ones for negative values, which are encoded as -1 - val */
+    uint32_t neg = -(uint32_t)(val < 0);
+
+    *p++ = _schema_cbor_int_info(width) | (neg & _SCHEMA_CBOR_NEG);
+    return _schema_put_be(p, (uint32_t)val ^ neg, width);
+}
+
+static inline uint8_t *_schema_cbor_put_float(uint8_t *p, float val,
+                                              unsigned width)
+{
+    (void)width;
+    *p++ = _SCHEMA_CBOR_FLOAT32;
+    return _schema_put_be(p, _schema_float_bits(val), 4);
+}
+
+static inline uint8_t *_schema_cbor_put_bytes(uint8_t *p, const uint8_t *val,
+                                              unsigned width)
+{
+    if (width < 24) {
+        *p++ = _SCHEMA_CBOR_BYTES | width;
+    }
+    else {
+        *p++ = _SCHEMA_CBOR_BYTES | 24;
+        *p++ = width;
+    }
+    memcpy(p, val, width);
+    return p + width;
+}
+
+static inline bool _schema_cbor_get_boolean(const uint8_t *p, bool *ok)
+{
+    *ok &= ((p[0] & 0xfe) == _SCHEMA_CBOR_FALSE);
+    return p[0] & 1;
+}
+
+static inline uint32_t _schema_cbor_get_uint(const uint8_t *p, unsigned width,
+                                             bool *ok)
+{
+    *ok &= (p[0] == _schema_cbor_int_info(width));
+    return _schema_get_be(p + 1, width);
+}
+
+static inline int32_t _schema_cbor_get_int(const uint8_t *p, unsigned width,
+                                           bool *ok)
+{
+    uint32_t neg = -(uint32_t)((p[0] & _SCHEMA_CBOR_NEG) != 0);
+    uint32_t val = _schema_get_be(p + 1, width);
+
+    *ok &= ((p[0] & ~_SCHEMA_CBOR_NEG) == _schema_cbor_int_info(width)) &&
+           ((val >> (8 * width - 1)) == 0);
+    return (int32_t)(val ^ neg);
+}
+
+static inline float _schema_cbor_get_float(const uint8_t *p, bool *ok)
+{
+    *ok &= (p[0] == _SCHEMA_CBOR_FLOAT32);
+    return _schema_bits_float(_schema_get_be(p + 1, 4));
+}
+
+static inline void _schema_cbor_get_bytes(const uint8_t *p, uint8_t *val,
+                                          unsigned width, bool *ok)
+{
+    if (width < 24) {
+        *ok &= (*p++ == (_SCHEMA_CBOR_BYTES | width));
+    }
+    else {
+        *ok &= (p[0] == (_SCHEMA_CBOR_BYTES | 24)) && (p[1] == width);
+        p += 2;
+    }
+    memcpy(val, p, width);
+}
+
+/* header of a container with a count, as in '{' '#' 'U' count */
+static inline uint8_t *_schema_ubjson_put_count(uint8_t *p, uint8_t start,
+                                                uint8_t count)
+{
+    *p++ = start;
+    *p++ = '#';
+    *p++ = 'U';
+    *p++ = count;
+    return p;
+}
+
+static inline bool _schema_ubjson_get_count(const uint8_t *p, uint8_t start,
+                                            uint8_t count)
+{
+    return (p[0] == start) && (p[1] == '#') && (p[2] == 'U') && (p[3] == count);
+}
+
+/* UBJSON has no unsigned types except uint8, so wider values are widened */
+static inline uint8_t _schema_ubjson_uint_marker(unsigned width)
+{
+    return (width == 1) ? 'U' : (width == 2) ? 'l' : 'L';
+}
+
+static inline uint8_t _schema_ubjson_int_marker(unsigned width)
+{
+    return (width == 1) ? 'i' : (width == 2) ? 'I' : 'l';
+}
+
+static inline uint8_t *_schema_ubjson_put_boolean(uint8_t *p, bool val,
+                                                  unsigned width)
+{
+    (void)width;
+    *p++ = val ? 'T' : 'F';
+    return p;
+}
+
+static inline uint8_t *_schema_ubjson_put_uint(uint8_t *p, uint32_t val,
+                                               unsigned width)
+{
+    *p++ = _schema_ubjson_uint_marker(width);
+    if (width == 2) {
+        p = _schema_put_be(p, 0, 2);
+    }
+    else if (width == 4) {
+        p = _schema_put_be(p, 0, 4);
+    }
+    return _schema_put_be(p, val, width);
+}
+
+static inline uint8_t *_schema_ubjson_put_int(uint8_t *p, int32_t val,
+                                              unsigned width)
+{
+    *p++ = _schema_ubjson_int_marker(width);
+    return _schema_put_be(p, (uint32_t)val, width);
+}
+
+static inline uint8_t *_schema_ubjson_put_float(uint8_t *p, float val,
+                                                unsigned width)
+{
+    (void)width;
+    *p++ = 'd';
+    return _schema_put_be(p, _schema_float_bits(val), 4);
+}
+
+static inline uint8_t *_schema_ubjson_put_bytes(uint8_t *p, const uint8_t *val,
+                                                unsigned width)
+{
+    /* strongly typed array of uint8 */
+    *p++ = '[';
+    *p++ = '$';
+    *p++ = 'U';
+    *p++ = '#';
+    *p++ = 'U';
+    *p++ = width;
+    memcpy(p, val, width);
+    return p + width;
+}
+
+static inline bool _schema_ubjson_get_boolean(const uint8_t *p, bool *ok)
+{
+    *ok &= ((p[0] == 'T') || (p[0] == 'F'));
+    return p[0] == 'T';
+}
+
+static inline uint32_t _schema_ubjson_get_uint(const uint8_t *p,
+                                               unsigned width, bool *ok)
+{
+    *ok &= (p[0] == _schema_ubjson_uint_marker(width));
+    if (width == 1) {
+        return p[1];
+    }
+    /* the upper half of the wider encoding must be zero */
+    *ok &= (_schema_get_be(p + 1, width) == 0);
+    return _schema_get_be(p + 1 + width, width);
+}
+
+static inline int32_t _schema_ubjson_get_int(const uint8_t *p, unsigned width,
+                                             bool *ok)
+{
+    uint32_t val = _schema_get_be(p + 1, width);
+
+    *ok &= (p[0] == _schema_ubjson_int_marker(width));
+    if (width < 4) {
+        /* sign extend */
+        uint32_t sign = 1UL << (8 * width - 1);
+        val = (val ^ sign) - sign;
+    }
+    return (int32_t)val;
+}
+
+static inline float _schema_ubjson_get_float(const uint8_t *p, bool *ok)
+{
+    *ok &= (p[0] == 'd');
+    return _schema_bits_float(_schema_get_be(p + 1, 4));
+}
+
+static inline void _schema_ubjson_get_bytes(const uint8_t *p, uint8_t *val,
+                                            unsigned width, bool *ok)
+{
+    *ok &= (p[0] == '[') && (p[1] == '$') && (p[2] == 'U') &&
+           (p[3] == '#') && (p[4] == 'U') && (p[5] == width);
+    memcpy(val, p + 6, width);
+}
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEMA_H */
+/** @} */
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_tlsf_heap TLSF heap
+ * @ingroup     sys
+ * @brief       Two-level segregated fit allocator with independent heaps
+ *
+ * Allocations and frees take constant time: free blocks are kept in lists
+ * by size class, and a two-level bitmap finds a non-empty list large enough
+ * for a request with two find-first-set operations. Neighbouring free blocks
+ * are merged immediately, which keeps fragmentation low for long-running
+ * applications.
+ *
+ * Unlike the `tlsf` package, every heap is a separate @ref tlsf_heap_t, so
+ * several heaps can be used side by side. A heap is not thread-safe on its
+ * own, see @ref sys_heap for a locked system heap built on top of it.
+ *
+ * Each allocation costs @ref TLSF_HEAP_ALIGN bytes of overhead, and every
+ * pool added to a heap costs three times that.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TLSF heap interface
+ */
+
+#ifndef TLSF_HEAP_H
+#define TLSF_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Log2 of the number of second level lists per first level class
+ */
+#ifndef TLSF_HEAP_SL_LOG2
+#define TLSF_HEAP_SL_LOG2       (3U)
+#endif
+
+/**
+ * @brief   Log2 of the largest supported block size
+ *
+ * Limits the size of a single pool. The size of @ref tlsf_heap_t grows by
+ * 2^@ref TLSF_HEAP_SL_LOG2 pointers per step.
+ */
+#ifndef TLSF_HEAP_SIZE_LOG2
+#define TLSF_HEAP_SIZE_LOG2     (16U)
+#endif
+
+/**
+ * @brief   Alignment of all allocations
+ */
+#define TLSF_HEAP_ALIGN         (2 * sizeof(void *))
+
+/**
+ * @brief   Number of second level lists per first level class
+ */
+#define TLSF_HEAP_SL_COUNT      (1U << TLSF_HEAP_SL_LOG2)
+
+/**
+ * @brief   Number of first level classes
+ */
+#define TLSF_HEAP_FL_COUNT      (TLSF_HEAP_SIZE_LOG2 - TLSF_HEAP_SL_LOG2 - \
+                                 ((TLSF_HEAP_ALIGN == 16) ? 4 : 3) + 2)
+
+/**
+ * @brief   Header of a block, opaque
+ */
+typedef struct tlsf_block tlsf_block_t;
+
+/**
+ * @brief   Header of a pool, opaque
+ */
+typedef struct tlsf_pool tlsf_pool_t;
+
+/**
+ * @brief   A heap
+ */
+typedef struct {
+    unsigned fl_bitmap;                 /**< non-empty first level classes */
+    unsigned sl_bitmap[TLSF_HEAP_FL_COUNT]; /**< non-empty second level lists */
+    tlsf_block_t *blocks[TLSF_HEAP_FL_COUNT][TLSF_HEAP_SL_COUNT]; /**< free lists */
+    tlsf_pool_t *pools;                 /**< memory added to the heap */
+    size_t used;                        /**< bytes allocated */
+    size_t peak;                        /**< highest value of @p used */
+} tlsf_heap_t;
+
+/**
+ * @brief   Statistics of a heap
+ */
+typedef struct {
+    size_t size;            /**< bytes of all pools */
+    size_t used;            /**< bytes allocated, including the overhead */
+    size_t peak;            /**< highest value of @p used */
+    size_t free;            /**< bytes in free blocks */
+    size_t largest;         /**< bytes in the largest free block */
+    unsigned used_blocks;   /**< number of allocations */
+    unsigned free_blocks;   /**< number of free blocks */
+} tlsf_heap_stats_t;
+
+/**
+ * @brief   Callback for tlsf_heap_walk()
+ *
+ * @param[in] ptr       start of the block as returned by the allocator
+ * @param[in] size      usable size of the block
+ * @param[in] used      1 if the block is allocated, 0 if it is free
+ * @param[in] arg       argument given to tlsf_heap_walk()
+ */
+typedef void (*tlsf_heap_walker_t)(void *ptr, size_t size, int used, void *arg);
+
+/**
+ * @brief   Initialize an empty heap
+ *
+ * @param[out] heap     heap to initialize
+ */
+void tlsf_heap_init(tlsf_heap_t *heap);
+
+/**
+ * @brief   Add memory to a heap
+ *
+ * @param[in,out] heap  heap to add the memory to
+ * @param[in] mem       start of the memory, will be aligned
+ * @param[in] size      size of the memory in bytes
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p size is too small, or larger than
+ *          2^@ref TLSF_HEAP_SIZE_LOG2
+ */
+int tlsf_heap_add_pool(tlsf_heap_t *heap, void *mem, size_t size);
+
+/**
+ * @brief   Allocate memory from a heap
+ *
+ * @param[in,out] heap  heap to allocate from
+ * @param[in] size      number of bytes to allocate
+ *
+ * @return  memory aligned to @ref TLSF_HEAP_ALIGN
+ * @return  NULL if @p size is 0 or no block large enough is free
+ */
+void *tlsf_heap_alloc(tlsf_heap_t *heap, size_t size);
+
+/**
+ * @brief   Resize an allocation of a heap
+ *
+ * The block is resized in place if possible, otherwise its contents are
+ * moved to a new block of @p heap.
+ *
+ * @param[in,out] heap  heap @p ptr was allocated from
+ * @param[in] ptr       allocation to resize, may be NULL
+ * @param[in] size      new size
+ *
+ * @return  the resized allocation
+ * @return  NULL if @p size is 0, or no block large enough is free. In the
+ *          latter case, @p ptr is left untouched.
+ */
+void *tlsf_heap_realloc(tlsf_heap_t *heap, void *ptr, size_t size);
+
+/**
+ * @brief   Return memory to a heap
+ *
+ * @param[in,out] heap  heap @p ptr was allocated from
+ * @param[in] ptr       allocation to free, may be NULL
+ */
+void tlsf_heap_free(tlsf_heap_t *heap, void *ptr);
+
+/**
+ * @brief   Check if memory belongs to one of the pools of a heap
+ *
+ * @param[in] heap      heap to check
+ * @param[in] ptr       memory to look up
+ *
+ * @return  1 if @p ptr lies within a pool of @p heap, 0 otherwise
+ */
+int tlsf_heap_contains(const tlsf_heap_t *heap, const void *ptr);
+
+/**
+ * @brief   Usable size of an allocation
+ *
+ * @param[in] ptr       allocation
+ *
+ * @return  size of the allocation, at least as large as requested
+ */
+size_t tlsf_heap_size(const void *ptr);
+
+/**
+ * @brief   Call a function for every block of a heap
+ *
+ * @param[in] heap      heap to walk
+ * @param[in] walker    function to call
+ * @param[in] arg       argument for @p walker
+ */
+void tlsf_heap_walk(const tlsf_heap_t *heap, tlsf_heap_walker_t walker,
+                    void *arg);
+
+/**
+ * @brief   Collect statistics of a heap
+ *
+ * Walks all blocks of the heap.
+ *
+ * @param[in] heap      heap to examine
+ * @param[out] stats    statistics
+ */
+void tlsf_heap_stats(const tlsf_heap_t *heap, tlsf_heap_stats_t *stats);
+
+/**
+ * @brief   Fragmentation of the free memory of a heap
+ *
+ * @param[in] stats     statistics of the heap
+ *
+ * @return  share of free memory outside of the largest free block in
+ *          percent
+ */
+static inline unsigned tlsf_heap_fragmentation(const tlsf_heap_stats_t *stats)
+{
+    if (stats->free == 0) {
+        return 0;
+    }
+    return 100 - (unsigned)(((uint64_t)stats->largest * 100) / stats->free);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TLSF_HEAP_H */
+/** @} */
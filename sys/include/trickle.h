@@ -29,9 +29,21 @@
  extern "C" {
 #endif
 
+#include <stdbool.h>
+
 #include "xtimer.h"
 #include "thread.h"
 
+/**
+ * @brief   Granularity of the @ref trickle_mux_t "Trickle multiplexer" in ms
+ *
+ * @details Events of instances that fall into the same tick are handled in one
+ *          wakeup, at most one tick late.
+ */
+#ifndef TRICKLE_MUX_TICK
+#define TRICKLE_MUX_TICK    (8U)
+#endif
+
 /** @brief a generic callback function with arguments that is called by trickle periodically */
 typedef struct {
     void (*func)(void *);       /**< a generic callback function pointer */
@@ -59,6 +71,49 @@ typedef struct {
                                          for a callback */
 } trickle_t;
 
+/**
+ * @brief   A trickle instance scheduled by a @ref trickle_mux_t
+ *
+ * @details Set trickle_mux_inst_t::callback before starting the instance.
+ */
+typedef struct {
+    uint8_t k;                      /**< redundancy constant */
+    uint8_t Imax;                   /**< maximum interval size, described as doublings */
+    uint16_t c;                     /**< counter */
+    uint32_t Imin;                  /**< minimum interval size in ms */
+    uint32_t I;                     /**< current interval size in ms */
+    uint32_t t;                     /**< time of the callback within the current interval in ms */
+    uint32_t start;                 /**< start of the current interval in ms */
+    uint32_t rand;                  /**< state of the instance's pseudo-random number generator */
+    uint16_t pos;                   /**< position in the deadline heap plus 1, 0 if stopped */
+    bool called;                    /**< callback of the current interval is done */
+    trickle_callback_t callback;    /**< the callback function and parameter that trickle is calling
+                                         in each interval */
+} trickle_mux_inst_t;
+
+/**
+ * @brief   Schedules many trickle instances with a single timer
+ *
+ * @details The instances are kept in a heap sorted by their next deadline and
+ *          the timer is only set again when the earliest deadline changes.
+ *          When it expires, a message of the configured type is sent to the
+ *          target thread, which then calls trickle_mux_handle(). All functions
+ *          on a multiplexer and its instances must be called from that thread.
+ */
+typedef struct {
+    trickle_mux_inst_t **heap;      /**< the deadline heap */
+    unsigned size;                  /**< maximum number of instances */
+    unsigned numof;                 /**< number of running instances */
+    kernel_pid_t pid;               /**< pid of the target thread */
+    bool armed;                     /**< the timer is set */
+    uint32_t due;                   /**< time the timer is set for in ms */
+    msg_t msg;                      /**< the msg_t to send on expiry */
+    xtimer_t timer;                 /**< xtimer to send trickle_mux_t::msg */
+    uint32_t wakeups;               /**< number of calls to trickle_mux_handle() */
+    uint32_t timer_ops;             /**< number of times the timer was set or removed */
+    uint32_t callbacks;             /**< number of callbacks called */
+} trickle_mux_t;
+
 /**
  * @brief resets the trickle timer
  *
@@ -108,6 +163,72 @@ void trickle_interval(trickle_t *trickle);
  */
 void trickle_callback(trickle_t *trickle);
 
+/**
+ * @brief   Initializes a trickle multiplexer
+ *
+ * @param[out] mux      the multiplexer
+ * @param[in] heap      space for the deadline heap
+ * @param[in] size      number of instances @p heap has space for
+ * @param[in] pid       target thread
+ * @param[in] msg_type  msg_t.type for timer messages
+ */
+void trickle_mux_init(trickle_mux_t *mux, trickle_mux_inst_t **heap, unsigned size,
+                      kernel_pid_t pid, uint16_t msg_type);
+
+/**
+ * @brief   Starts a trickle instance on a multiplexer
+ *
+ * @param[in] mux       the multiplexer
+ * @param[in] inst      the instance, must not be running
+ * @param[in] Imin      minimum interval in ms
+ * @param[in] Imax      maximum interval, described as doublings of @p Imin
+ * @param[in] k         redundancy constant
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p Imin is 0 or the maximum interval exceeds
+ *          INT32_MAX ms
+ * @return  -ENOMEM, if @p mux already schedules its maximum number of instances
+ */
+int trickle_mux_start(trickle_mux_t *mux, trickle_mux_inst_t *inst, uint32_t Imin,
+                      uint8_t Imax, uint8_t k);
+
+/**
+ * @brief   Stops a trickle instance
+ *
+ * @param[in] mux       the multiplexer
+ * @param[in] inst      the instance, may already be stopped
+ */
+void trickle_mux_stop(trickle_mux_t *mux, trickle_mux_inst_t *inst);
+
+/**
+ * @brief   Resets the interval of a running trickle instance to its minimum
+ *          (RFC 6206, section 4.2, step 6)
+ *
+ * @param[in] mux       the multiplexer
+ * @param[in] inst      the instance
+ */
+void trickle_mux_reset(trickle_mux_t *mux, trickle_mux_inst_t *inst);
+
+/**
+ * @brief   Increments the counter of a trickle instance by one
+ *
+ * @param[in] inst      the instance
+ */
+static inline void trickle_mux_increment_counter(trickle_mux_inst_t *inst)
+{
+    inst->c++;
+}
+
+/**
+ * @brief   Handles the expiry of the multiplexer's timer
+ *
+ * @details Calls the callbacks and starts the new intervals of all instances
+ *          that are due.
+ *
+ * @param[in] mux       the multiplexer
+ */
+void trickle_mux_handle(trickle_mux_t *mux);
+
 #ifdef __cplusplus
 }
 #endif
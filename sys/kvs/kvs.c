@@ -0,0 +1,747 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_kvs
+ * @{
+ *
+ * @file
+ * @brief       Key/value store implementation
+ *
+ * A segment starts with a header of a magic number and a sequence number,
+ * both little endian, followed by records. A record consists of
+ *
+ *     key length (1) | flags (1) | value length (2) | CRC16 (2) | key | value
+ *
+ * with the CRC over the other fields, key and value. Erased flash reads as
+ * 0xff, so a key length of 0xff marks the end of the data. Devices that
+ * overwrite in place never program a page twice: after a sync, writing
+ * continues on the next page and the rest of the page is skipped as padding.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "hashes.h"
+#include "kvs.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define SEG_MAGIC       (0x3153564bUL)  /* "KVS1" */
+#define SEG_HDR_LEN     (8U)
+#define REC_HDR_LEN     (6U)
+#define FLAG_DELETED    (0x01)
+#define ERASED          (0xff)
+#define NO_PAGE         (UINT32_MAX)
+#define COPY_CHUNK      (32U)
+
+static inline uint32_t _min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline uint32_t _seg_size(const kvs_t *kvs)
+{
+    return mtd_sector_size(kvs->dev);
+}
+
+static inline uint32_t _free(const kvs_t *kvs)
+{
+    return kvs->dev->sector_count - kvs->used;
+}
+
+static inline uint16_t _get16(const uint8_t *buf)
+{
+    return buf[0] | (buf[1] << 8);
+}
+
+static inline void _set16(uint8_t *buf, uint16_t val)
+{
+    buf[0] = val & 0xff;
+    buf[1] = val >> 8;
+}
+
+static inline uint32_t _get32(const uint8_t *buf)
+{
+    return _get16(buf) | ((uint32_t)_get16(buf + 2) << 16);
+}
+
+static inline void _set32(uint8_t *buf, uint32_t val)
+{
+    _set16(buf, val & 0xffff);
+    _set16(buf + 2, val >> 16);
+}
+
+static inline uint32_t _rec_size(const uint8_t *hdr)
+{
+    return REC_HDR_LEN + hdr[0] + _get16(hdr + 2);
+}
+
+static int _read(kvs_t *kvs, uint32_t addr, void *buf, uint32_t len)
+{
+    uint32_t page_size = kvs->dev->page_size;
+    uint8_t *dst = buf;
+
+    while (len > 0) {
+        uint32_t page = addr / page_size;
+        uint32_t off = addr % page_size;
+        uint32_t n = _min(page_size - off, len);
+        const uint8_t *src = kvs->rbuf;
+
+        if (page == kvs->wpage) {
+            src = kvs->wbuf;
+        }
+        else if (page != kvs->rpage) {
+            int res = mtd_read(kvs->dev, kvs->rbuf, page * page_size, page_size);
+            if (res < 0) {
+                kvs->rpage = NO_PAGE;
+                return res;
+            }
+            kvs->rpage = page;
+        }
+        memcpy(dst, src + off, n);
+        dst += n;
+        addr += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static int _program(kvs_t *kvs)
+{
+    uint32_t page_size = kvs->dev->page_size;
+    int res = mtd_write(kvs->dev, kvs->wbuf, kvs->wpage * page_size, page_size);
+
+    if (kvs->rpage == kvs->wpage) {
+        kvs->rpage = NO_PAGE;
+    }
+    if (res == 0) {
+        kvs->stats.flash_bytes += page_size;
+    }
+    return res;
+}
+
+static int _append(kvs_t *kvs, const void *buf, uint32_t len)
+{
+    uint32_t page_size = kvs->dev->page_size;
+    const uint8_t *src = buf;
+
+    while (len > 0) {
+        uint32_t off = kvs->pos % page_size;
+        uint32_t n = _min(page_size - off, len);
+
+        kvs->wpage = kvs->pos / page_size;
+        memcpy(kvs->wbuf + off, src, n);
+        src += n;
+        len -= n;
+        kvs->pos += n;
+        if ((kvs->pos % page_size) == 0) {
+            int res = _program(kvs);
+            if (res < 0) {
+                return res;
+            }
+            memset(kvs->wbuf, ERASED, page_size);
+            kvs->wpage = NO_PAGE;
+            kvs->synced = kvs->pos;
+        }
+    }
+    return 0;
+}
+
+static int _sync(kvs_t *kvs)
+{
+    uint32_t page_size = kvs->dev->page_size;
+    int res;
+
+    if ((kvs->wpage == NO_PAGE) || (kvs->pos == kvs->synced)) {
+        return 0;
+    }
+    if ((res = _program(kvs)) < 0) {
+        return res;
+    }
+    if (!(kvs->dev->driver->flags & MTD_DRIVER_FLAG_ERASE)) {
+        /* don't program this page again, continue on the next one */
+        kvs->pos = (kvs->wpage + 1) * page_size;
+        memset(kvs->wbuf, ERASED, page_size);
+        kvs->wpage = NO_PAGE;
+    }
+    kvs->synced = kvs->pos;
+    return 0;
+}
+
+static int _erase(kvs_t *kvs, uint32_t seg)
+{
+    mtd_dev_t *dev = kvs->dev;
+    uint32_t addr = seg * _seg_size(kvs);
+    int res = 0;
+
+    DEBUG("kvs: erase segment %lu\n", (unsigned long)seg);
+    kvs->stats.erases++;
+    kvs->rpage = NO_PAGE;
+    if (dev->driver->erase) {
+        return mtd_erase(dev, addr, _seg_size(kvs));
+    }
+    /* devices that can't erase are overwritten instead */
+    memset(kvs->rbuf, ERASED, dev->page_size);
+    for (uint32_t i = 0; (i < dev->pages_per_sector) && (res == 0); i++) {
+        res = mtd_write(dev, kvs->rbuf, addr + (i * dev->page_size),
+                        dev->page_size);
+        kvs->stats.flash_bytes += dev->page_size;
+    }
+    return res;
+}
+
+/* Returns 1 if seg has a valid header, and its sequence number. */
+static int _seg_seq(kvs_t *kvs, uint32_t seg, uint32_t *seq)
+{
+    uint8_t hdr[SEG_HDR_LEN];
+    int res = _read(kvs, seg * _seg_size(kvs), hdr, sizeof(hdr));
+
+    if (res < 0) {
+        return res;
+    }
+    *seq = _get32(hdr + 4);
+    return (_get32(hdr) == SEG_MAGIC);
+}
+
+static int _blank(kvs_t *kvs, uint32_t seg)
+{
+    mtd_dev_t *dev = kvs->dev;
+
+    for (uint32_t i = 0; i < dev->pages_per_sector; i++) {
+        uint32_t page = seg * dev->pages_per_sector + i;
+        int res = mtd_read(dev, kvs->rbuf, page * dev->page_size,
+                           dev->page_size);
+
+        kvs->rpage = (res < 0) ? NO_PAGE : page;
+        if (res < 0) {
+            return res;
+        }
+        for (uint32_t j = 0; j < dev->page_size; j++) {
+            if (kvs->rbuf[j] != ERASED) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int _open(kvs_t *kvs)
+{
+    uint8_t hdr[SEG_HDR_LEN];
+
+    if (kvs->used > 0) {
+        kvs->head = (kvs->head + 1) % kvs->dev->sector_count;
+    }
+    else {
+        kvs->tail = kvs->head;
+    }
+    kvs->used++;
+    kvs->pos = kvs->head * _seg_size(kvs);
+    kvs->synced = kvs->pos;
+    memset(kvs->wbuf, ERASED, kvs->dev->page_size);
+    kvs->wpage = NO_PAGE;
+    DEBUG("kvs: open segment %lu\n", (unsigned long)kvs->head);
+    _set32(hdr, SEG_MAGIC);
+    _set32(hdr + 4, ++kvs->seq);
+    return _append(kvs, hdr, sizeof(hdr));
+}
+
+/*
+ * Reads the header of the record at *addr into hdr and checks the record.
+ * Returns 1 for a valid record, 0 at the end of the data in the segment with
+ * *addr set to the end, and -EILSEQ for a corrupt record.
+ */
+static int _next(kvs_t *kvs, uint32_t *addr, uint32_t end, uint8_t *hdr)
+{
+    uint32_t page_size = kvs->dev->page_size;
+    uint8_t buf[COPY_CHUNK];
+    uint16_t crc;
+    int res;
+
+    while (1) {
+        if (*addr + REC_HDR_LEN > end) {
+            *addr = end;
+            return 0;
+        }
+        if ((res = _read(kvs, *addr, hdr, REC_HDR_LEN)) < 0) {
+            return res;
+        }
+        if (hdr[0] != ERASED) {
+            break;
+        }
+        if ((kvs->dev->driver->flags & MTD_DRIVER_FLAG_ERASE) ||
+            ((*addr % page_size) == 0)) {
+            return 0;
+        }
+        /* padding up to the next page */
+        *addr += page_size - (*addr % page_size);
+    }
+
+    uint32_t size = _rec_size(hdr);
+    if ((hdr[0] == 0) || (hdr[0] > KVS_KEY_MAX) || (hdr[1] > FLAG_DELETED) ||
+        (*addr + size > end)) {
+        return -EILSEQ;
+    }
+    crc = crc16_ccitt_calc(hdr, 4);
+    for (uint32_t off = REC_HDR_LEN; off < size; off += sizeof(buf)) {
+        uint32_t n = _min(sizeof(buf), size - off);
+        if ((res = _read(kvs, *addr + off, buf, n)) < 0) {
+            return res;
+        }
+        crc = crc16_ccitt_update(crc, buf, n);
+    }
+    return (crc == _get16(hdr + 4)) ? 1 : -EILSEQ;
+}
+
+/* Returns 1 and the index entry of the key, or 0 if it isn't indexed. */
+static int _find(kvs_t *kvs, const char *key, unsigned klen, uint32_t hash,
+                 kvs_entry_t **entry)
+{
+    unsigned mask = kvs->index_size - 1;
+
+    for (unsigned i = hash & mask; kvs->index[i].addr != 0; i = (i + 1) & mask) {
+        kvs_entry_t *e = &kvs->index[i];
+        uint8_t buf[REC_HDR_LEN + KVS_KEY_MAX];
+        int res;
+
+        if (e->hash != hash) {
+            continue;
+        }
+        if ((res = _read(kvs, e->addr, buf, REC_HDR_LEN + klen)) < 0) {
+            return res;
+        }
+        if ((buf[0] == klen) && (memcmp(buf + REC_HDR_LEN, key, klen) == 0)) {
+            *entry = e;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int _insert(kvs_t *kvs, uint32_t hash, uint32_t addr)
+{
+    unsigned mask = kvs->index_size - 1;
+    unsigned i = hash & mask;
+
+    /* keep an unused entry to terminate lookups */
+    if (kvs->count >= mask) {
+        return -ENOMEM;
+    }
+    while (kvs->index[i].addr != 0) {
+        i = (i + 1) & mask;
+    }
+    kvs->index[i].hash = hash;
+    kvs->index[i].addr = addr;
+    kvs->count++;
+    return 0;
+}
+
+static void _remove(kvs_t *kvs, kvs_entry_t *e)
+{
+    unsigned mask = kvs->index_size - 1;
+    unsigned i = e - kvs->index;
+    unsigned j = i;
+
+    /* move following entries up that would not be found otherwise */
+    while (kvs->index[j = (j + 1) & mask].addr != 0) {
+        unsigned home = kvs->index[j].hash & mask;
+
+        if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+            continue;
+        }
+        kvs->index[i] = kvs->index[j];
+        i = j;
+    }
+    kvs->index[i].addr = 0;
+    kvs->count--;
+}
+
+/* Applies the record at addr to the index. */
+static int _apply(kvs_t *kvs, uint32_t addr, const uint8_t *hdr)
+{
+    char key[KVS_KEY_MAX];
+    kvs_entry_t *e;
+    uint32_t hash;
+    int res;
+
+    if ((res = _read(kvs, addr + REC_HDR_LEN, key, hdr[0])) < 0) {
+        return res;
+    }
+    hash = djb2_hash((uint8_t *)key, hdr[0]);
+    if ((res = _find(kvs, key, hdr[0], hash, &e)) < 0) {
+        return res;
+    }
+    if (hdr[1] & FLAG_DELETED) {
+        if (res) {
+            _remove(kvs, e);
+        }
+        return 0;
+    }
+    if (res) {
+        e->addr = addr;
+        return 0;
+    }
+    return _insert(kvs, hash, addr);
+}
+
+static int _compact(kvs_t *kvs);
+
+/* Makes room for size bytes in the head segment. */
+static int _reserve(kvs_t *kvs, uint32_t size, int compacting)
+{
+    uint32_t seg_size = _seg_size(kvs);
+    unsigned rounds = 0;
+    int res;
+
+    while ((kvs->used == 0) || (kvs->pos + size > (kvs->head + 1) * seg_size)) {
+        if (!compacting && (_free(kvs) < 2)) {
+            /* no progress after compacting all segments: the store is full */
+            if (rounds++ == kvs->dev->sector_count) {
+                return -ENOSPC;
+            }
+            if ((res = _compact(kvs)) < 0) {
+                return res;
+            }
+            continue;
+        }
+        if (_free(kvs) == 0) {
+            return -ENOSPC;
+        }
+        if (((res = _sync(kvs)) < 0) || ((res = _open(kvs)) < 0)) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int _write_rec(kvs_t *kvs, const char *key, unsigned klen,
+                      const void *val, uint16_t vlen, uint8_t flags,
+                      uint32_t *addr)
+{
+    uint8_t hdr[REC_HDR_LEN];
+    uint16_t crc;
+    int res;
+
+    hdr[0] = klen;
+    hdr[1] = flags;
+    _set16(hdr + 2, vlen);
+    crc = crc16_ccitt_calc(hdr, 4);
+    crc = crc16_ccitt_update(crc, (const uint8_t *)key, klen);
+    crc = crc16_ccitt_update(crc, val, vlen);
+    _set16(hdr + 4, crc);
+
+    if ((res = _reserve(kvs, _rec_size(hdr), 0)) < 0) {
+        return res;
+    }
+    *addr = kvs->pos;
+    if (((res = _append(kvs, hdr, sizeof(hdr))) < 0) ||
+        ((res = _append(kvs, key, klen)) < 0) ||
+        ((res = _append(kvs, val, vlen)) < 0)) {
+        return res;
+    }
+    kvs->stats.user_bytes += klen + vlen;
+    return 0;
+}
+
+/* Copies the record of size bytes at addr to the head. */
+static int _copy(kvs_t *kvs, uint32_t addr, uint32_t size, uint32_t *to)
+{
+    uint8_t buf[COPY_CHUNK];
+    int res;
+
+    if ((res = _reserve(kvs, size, 1)) < 0) {
+        return res;
+    }
+    *to = kvs->pos;
+    for (uint32_t off = 0; off < size; off += sizeof(buf)) {
+        uint32_t n = _min(sizeof(buf), size - off);
+
+        if (((res = _read(kvs, addr + off, buf, n)) < 0) ||
+            ((res = _append(kvs, buf, n)) < 0)) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+/* Returns the index entry pointing at the record at addr, if any. */
+static int _live(kvs_t *kvs, uint32_t addr, const uint8_t *hdr,
+                 kvs_entry_t **entry)
+{
+    uint8_t key[KVS_KEY_MAX];
+    unsigned mask = kvs->index_size - 1;
+    int res;
+
+    *entry = NULL;
+    if ((res = _read(kvs, addr + REC_HDR_LEN, key, hdr[0])) < 0) {
+        return res;
+    }
+    for (unsigned i = djb2_hash(key, hdr[0]) & mask; kvs->index[i].addr != 0;
+         i = (i + 1) & mask) {
+        if (kvs->index[i].addr == addr) {
+            *entry = &kvs->index[i];
+            break;
+        }
+    }
+    return 0;
+}
+
+static int _compact(kvs_t *kvs)
+{
+    uint32_t seg = kvs->tail;
+    uint32_t end = (seg + 1) * _seg_size(kvs);
+    uint32_t addr = seg * _seg_size(kvs) + SEG_HDR_LEN;
+    uint8_t hdr[REC_HDR_LEN];
+    int res;
+
+    DEBUG("kvs: compact segment %lu\n", (unsigned long)seg);
+    assert(kvs->tail != kvs->head);
+    while ((res = _next(kvs, &addr, end, hdr)) == 1) {
+        /* tombstones are dropped, there is no older record left to hide */
+        if (!(hdr[1] & FLAG_DELETED)) {
+            kvs_entry_t *e;
+            uint32_t to;
+
+            if ((res = _live(kvs, addr, hdr, &e)) < 0) {
+                return res;
+            }
+            if (e != NULL) {
+                if ((res = _copy(kvs, addr, _rec_size(hdr), &to)) < 0) {
+                    return res;
+                }
+                e->addr = to;
+            }
+        }
+        addr += _rec_size(hdr);
+    }
+    if ((res < 0) && (res != -EILSEQ)) {
+        return res;
+    }
+    /* the copies must be on the device before the originals are erased */
+    if (((res = _sync(kvs)) < 0) || ((res = _erase(kvs, seg)) < 0)) {
+        return res;
+    }
+    kvs->tail = (seg + 1) % kvs->dev->sector_count;
+    kvs->used--;
+    kvs->stats.compactions++;
+    return 0;
+}
+
+static int _mount(kvs_t *kvs)
+{
+    mtd_dev_t *dev = kvs->dev;
+    uint32_t n = dev->sector_count;
+    uint32_t seq, tail_seq;
+    int res;
+
+    /* the head has the highest sequence number */
+    for (uint32_t s = 0; s < n; s++) {
+        if ((res = _seg_seq(kvs, s, &seq)) < 0) {
+            return res;
+        }
+        if (res && ((kvs->used == 0) || (seq > kvs->seq))) {
+            kvs->head = s;
+            kvs->seq = seq;
+            kvs->used = 1;
+        }
+    }
+    /* the log continues backwards with decreasing sequence numbers */
+    kvs->tail = kvs->head;
+    tail_seq = kvs->seq;
+    while ((kvs->used > 0) && (kvs->used < n)) {
+        uint32_t prev = (kvs->tail + n - 1) % n;
+
+        if ((res = _seg_seq(kvs, prev, &seq)) < 0) {
+            return res;
+        }
+        if (!res || (seq != tail_seq - 1)) {
+            break;
+        }
+        kvs->tail = prev;
+        tail_seq = seq;
+        kvs->used++;
+    }
+    /* leftovers of interrupted compactions, or garbage */
+    for (uint32_t i = kvs->used; i < n; i++) {
+        uint32_t s = (kvs->head + 1 + i - kvs->used) % n;
+
+        if (((res = _blank(kvs, s)) < 0) ||
+            ((res == 0) && ((res = _erase(kvs, s)) < 0))) {
+            return res;
+        }
+    }
+
+    for (uint32_t i = 0; i < kvs->used; i++) {
+        uint32_t s = (kvs->tail + i) % n;
+        uint32_t addr = s * _seg_size(kvs) + SEG_HDR_LEN;
+        uint32_t end = (s + 1) * _seg_size(kvs);
+        uint8_t hdr[REC_HDR_LEN];
+
+        while ((res = _next(kvs, &addr, end, hdr)) == 1) {
+            if ((res = _apply(kvs, addr, hdr)) < 0) {
+                return res;
+            }
+            addr += _rec_size(hdr);
+        }
+        if ((res < 0) && (res != -EILSEQ)) {
+            return res;
+        }
+        if (s == kvs->head) {
+            /* after a torn write, continue in a new segment */
+            kvs->pos = (res == -EILSEQ) ? end : addr;
+            if ((kvs->pos % dev->page_size) != 0) {
+                kvs->wpage = kvs->pos / dev->page_size;
+                if ((res = mtd_read(dev, kvs->wbuf, kvs->wpage * dev->page_size,
+                                    dev->page_size)) < 0) {
+                    return res;
+                }
+            }
+        }
+    }
+    kvs->synced = kvs->pos;
+    return 0;
+}
+
+int kvs_init(kvs_t *kvs, mtd_dev_t *dev, uint8_t *buf, kvs_entry_t *index,
+             unsigned index_size)
+{
+    int res;
+
+    assert((index_size > 1) && ((index_size & (index_size - 1)) == 0));
+
+    if ((res = mtd_init(dev)) < 0) {
+        return res;
+    }
+    if (dev->sector_count < 3) {
+        return -EINVAL;
+    }
+    memset(kvs, 0, sizeof(*kvs));
+    mutex_init(&kvs->lock);
+    kvs->dev = dev;
+    kvs->wbuf = buf;
+    kvs->rbuf = buf + dev->page_size;
+    kvs->index = index;
+    kvs->index_size = index_size;
+    kvs->wpage = NO_PAGE;
+    kvs->rpage = NO_PAGE;
+    memset(kvs->wbuf, ERASED, dev->page_size);
+    memset(index, 0, index_size * sizeof(kvs_entry_t));
+
+    return _mount(kvs);
+}
+
+int kvs_get(kvs_t *kvs, const char *key, void *buf, size_t len)
+{
+    unsigned klen = strlen(key);
+    kvs_entry_t *e;
+    uint8_t hdr[REC_HDR_LEN];
+    int res;
+
+    if ((klen == 0) || (klen > KVS_KEY_MAX)) {
+        return -EINVAL;
+    }
+    mutex_lock(&kvs->lock);
+    res = _find(kvs, key, klen, djb2_hash((const uint8_t *)key, klen), &e);
+    if (res == 0) {
+        res = -ENOENT;
+    }
+    if ((res > 0) && ((res = _read(kvs, e->addr, hdr, sizeof(hdr))) == 0)) {
+        uint16_t vlen = _get16(hdr + 2);
+
+        res = _read(kvs, e->addr + REC_HDR_LEN + klen, buf, _min(vlen, len));
+        if (res == 0) {
+            res = vlen;
+        }
+    }
+    mutex_unlock(&kvs->lock);
+    return res;
+}
+
+int kvs_set(kvs_t *kvs, const char *key, const void *val, size_t len)
+{
+    unsigned klen = strlen(key);
+    uint32_t hash = djb2_hash((const uint8_t *)key, klen);
+    kvs_entry_t *e;
+    uint32_t addr;
+    int res;
+
+    if ((klen == 0) || (klen > KVS_KEY_MAX) ||
+        (REC_HDR_LEN + klen + len > _seg_size(kvs) - SEG_HDR_LEN)) {
+        return -EINVAL;
+    }
+    mutex_lock(&kvs->lock);
+    if ((res = _find(kvs, key, klen, hash, &e)) == 0) {
+        e = NULL;
+        if (kvs->count >= kvs->index_size - 1) {
+            res = -ENOMEM;
+        }
+    }
+    if ((res >= 0) &&
+        ((res = _write_rec(kvs, key, klen, val, len, 0, &addr)) == 0)) {
+        if (e != NULL) {
+            e->addr = addr;
+        }
+        else {
+            res = _insert(kvs, hash, addr);
+        }
+    }
+    mutex_unlock(&kvs->lock);
+    return res;
+}
+
+int kvs_delete(kvs_t *kvs, const char *key)
+{
+    unsigned klen = strlen(key);
+    kvs_entry_t *e;
+    uint32_t addr;
+    int res;
+
+    if ((klen == 0) || (klen > KVS_KEY_MAX)) {
+        return -EINVAL;
+    }
+    mutex_lock(&kvs->lock);
+    res = _find(kvs, key, klen, djb2_hash((const uint8_t *)key, klen), &e);
+    if (res == 0) {
+        res = -ENOENT;
+    }
+    if ((res > 0) &&
+        ((res = _write_rec(kvs, key, klen, NULL, 0, FLAG_DELETED, &addr)) == 0)) {
+        _remove(kvs, e);
+    }
+    mutex_unlock(&kvs->lock);
+    return res;
+}
+
+int kvs_sync(kvs_t *kvs)
+{
+    mutex_lock(&kvs->lock);
+    int res = _sync(kvs);
+    mutex_unlock(&kvs->lock);
+    return res;
+}
+
+int kvs_compact(kvs_t *kvs)
+{
+    int res = 0;
+
+    mutex_lock(&kvs->lock);
+    if ((kvs->used > 1) && (_free(kvs) <= KVS_COMPACT_THRESHOLD)) {
+        res = _compact(kvs);
+        if (res == 0) {
+            res = 1;
+        }
+    }
+    mutex_unlock(&kvs->lock);
+    return res;
+}
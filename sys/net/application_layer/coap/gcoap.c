@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include "byteorder.h"
 #include "net/gcoap.h"
 #include "random.h"
 #include "thread.h"
@@ -29,16 +30,64 @@
 /** @brief Stack size for module thread */
 #define GCOAP_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 
+/**
+ * @name Flags for a pending notification
+ * @{
+ */
+#define OBS_PENDING_NON     (0x01)
+#define OBS_PENDING_CON     (0x02)
+/** @} */
+
+/**
+ * @name Result of a search for the resource of a request
+ * @{
+ */
+#define RESOURCE_FOUND          (0)
+#define RESOURCE_WRONG_METHOD   (-1)
+#define RESOURCE_NO_PATH        (-2)
+/** @} */
+
+/** @brief Length of the Observe option written by gcoap; the value is the
+ *         3-byte sequence number */
+#define OBS_OPT_LEN         (4)
+
 /* Internal functions */
 static void *_event_loop(void *arg);
-static void _listen(sock_udp_t *sock);
+static void _listen(sock_udp_t *sock, uint32_t obs_timeout);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
-static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len);
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              const gcoap_blockopts_t *opts);
+static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                                          sock_udp_ep_t *remote);
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           const gcoap_blockopts_t *opts);
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
+static size_t _send_req(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        gcoap_block_xfer_t *xfer);
+static ssize_t _strip_block_opts(uint8_t *buf, size_t len,
+                                 gcoap_blockopts_t *opts, size_t *opts_end,
+                                 uint32_t *observe);
+static size_t _block_xfer_send(gcoap_block_xfer_t *xfer, uint8_t *buf,
+                                                         size_t len);
+static void _block_xfer_step(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu,
+                                                       uint8_t *buf, size_t len);
+static ssize_t _obs_insert_opt(uint8_t *buf, size_t pdu_len, size_t len,
+                                             uint32_t seq);
+static gcoap_obs_resource_t *_obs_register(const coap_resource_t *resource,
+                                           coap_pkt_t *pdu,
+                                           sock_udp_ep_t *remote);
+static void _obs_remove(gcoap_obs_resource_t *entry, sock_udp_ep_t *remote);
+static gcoap_obs_resource_t *_obs_find_resource(const coap_resource_t *resource);
+static void _obs_handle_empty(coap_pkt_t *pdu, sock_udp_ep_t *remote);
+static uint32_t _obs_process(void);
+static void _obs_send(gcoap_obs_resource_t *entry, unsigned type);
+static int _find_resource(const char *path, unsigned method_flag,
+                          const coap_resource_t **resource_ptr);
+static void _index_listener(gcoap_listener_t *listener);
+static size_t _wkc_write(char *buf, size_t len);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -52,7 +101,10 @@ static gcoap_listener_t _default_listener = {
 };
 
 static gcoap_state_t _coap_state = {
-    .listeners   = &_default_listener,
+    .listeners     = &_default_listener,
+    .resources     = { &_default_resources[0] },
+    .resources_len = 1,
+    .lock          = MUTEX_INIT,
 };
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
@@ -96,14 +148,18 @@ static void *_event_loop(void *arg)
             }
         }
 
-        _listen(&_sock);
+        _listen(&_sock, _obs_process());
     }
 
     return 0;
 }
 
-/* Listen for an incoming CoAP message. */
-static void _listen(sock_udp_t *sock)
+/*
+ * Listen for an incoming CoAP message.
+ *
+ * obs_timeout Time until a rate limited notification is due, in usec
+ */
+static void _listen(sock_udp_t *sock, uint32_t obs_timeout)
 {
     coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
@@ -113,9 +169,12 @@ static void _listen(sock_udp_t *sock)
 
     gcoap_op_state(&open_reqs);
 
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
+    uint32_t timeout = open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT;
+    if (obs_timeout < timeout) {
+        timeout = obs_timeout;
+    }
+
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), timeout, &remote);
     if (res <= 0) {
 #if ENABLE_DEBUG
         if (res < 0 && res != -ETIMEDOUT) {
@@ -125,16 +184,22 @@ static void _listen(sock_udp_t *sock)
         return;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    res = gcoap_parse(&pdu, buf, res);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", res);
         /* If a response, can't clear memo, but it will timeout later. */
         return;
     }
 
+    /* incoming empty message; ACK or RST for a notification */
+    if (pdu.hdr->code == 0) {
+        mutex_lock(&_coap_state.lock);
+        _obs_handle_empty(&pdu, &remote);
+        mutex_unlock(&_coap_state.lock);
+    }
     /* incoming request */
-    if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
-        size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf));
+    else if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
+        size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
         if (pdu_len > 0) {
             sock_udp_send(sock, buf, pdu_len, &remote);
         }
@@ -144,8 +209,15 @@ static void _listen(sock_udp_t *sock)
         _find_req_memo(&memo, &pdu, buf, sizeof(buf));
         if (memo) {
             xtimer_remove(&memo->response_timer);
-            memo->resp_handler(memo->state, &pdu);
-            memo->state = GCOAP_MEMO_UNUSED;
+            if (memo->xfer) {
+                /* release memo first, so it is available for the next block */
+                memo->state = GCOAP_MEMO_UNUSED;
+                _block_xfer_step(memo->xfer, &pdu, buf, sizeof(buf));
+            }
+            else {
+                memo->resp_handler(memo->state, &pdu);
+                memo->state = GCOAP_MEMO_UNUSED;
+            }
         }
     }
 }
@@ -155,43 +227,140 @@ static void _listen(sock_udp_t *sock)
  *
  * Caller must finish the PDU and send it.
  */
-static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                                          sock_udp_ep_t *remote)
 {
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    const coap_resource_t *resource;
 
     /* Find path for CoAP msg among listener resources and execute callback. */
-    gcoap_listener_t *listener = _coap_state.listeners;
-    while (listener) {
-        coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
+    int res = _find_resource((char *)&pdu->url[0], method_flag, &resource);
+    if (res == RESOURCE_NO_PATH) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
+    }
+    else if (res == RESOURCE_WRONG_METHOD) {
+        return gcoap_response(pdu, buf, len, GCOAP_CODE_METHOD_NOT_ALLOWED);
+    }
+
+    uint32_t observe = _coap_state.observe_value;
+    if ((observe == 1) && (method_flag == COAP_GET)) {
+        mutex_lock(&_coap_state.lock);
+        _obs_remove(_obs_find_resource(resource), remote);
+        mutex_unlock(&_coap_state.lock);
+    }
+    ssize_t pdu_len = resource->handler(pdu, buf, len);
+    if (pdu_len < 0) {
+        pdu_len = gcoap_response(pdu, buf, len,
+                                 COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else if ((observe == 0) && (method_flag == COAP_GET)
+                && (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS)) {
+        /* A registration response includes the Observe option; without a
+         * registration, it is a plain response. */
+        mutex_lock(&_coap_state.lock);
+        gcoap_obs_resource_t *entry = _obs_register(resource, pdu, remote);
+        if (entry) {
+            ssize_t res = _obs_insert_opt(buf, pdu_len, len, entry->seq);
+            if (res > 0) {
+                pdu_len = res;
             }
-            if (! (resource->methods & method_flag)) {
-                continue;
+            else {
+                _obs_remove(entry, remote);
             }
+        }
+        mutex_unlock(&_coap_state.lock);
+    }
+    return pdu_len;
+}
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
+/*
+ * Finds the resource for a path and method, by binary search in the index of
+ * resources. Searches all listeners if the index is incomplete.
+ *
+ * Returns RESOURCE_FOUND, RESOURCE_WRONG_METHOD if a resource for the path
+ * does not accept the method, or RESOURCE_NO_PATH.
+ */
+static int _find_resource(const char *path, unsigned method_flag,
+                          const coap_resource_t **resource_ptr)
+{
+    const coap_resource_t **resources = _coap_state.resources;
+    int res = RESOURCE_NO_PATH;
+
+    if (_coap_state.resources_overflow) {
+        gcoap_listener_t *listener = _coap_state.listeners;
+        while (listener) {
+            for (size_t i = 0; i < listener->resources_len; i++) {
+                coap_resource_t *resource = &listener->resources[i];
+                if (strcmp(path, resource->path) == 0) {
+                    if (resource->methods & method_flag) {
+                        *resource_ptr = resource;
+                        return RESOURCE_FOUND;
+                    }
+                    res = RESOURCE_WRONG_METHOD;
+                }
             }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
+            listener = listener->next;
+        }
+        return res;
+    }
+
+    /* find first resource with the path */
+    size_t lo = 0, hi = _coap_state.resources_len;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (strcmp(resources[mid]->path, path) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    /* a path may be registered for different methods */
+    for (; lo < _coap_state.resources_len; lo++) {
+        if (strcmp(resources[lo]->path, path) != 0) {
+            break;
+        }
+        if (resources[lo]->methods & method_flag) {
+            *resource_ptr = resources[lo];
+            return RESOURCE_FOUND;
+        }
+        res = RESOURCE_WRONG_METHOD;
+    }
+    return res;
+}
+
+/*
+ * Adds the resources of a listener to the index, after any resources with
+ * the same path, so earlier registrations take precedence.
+ */
+static void _index_listener(gcoap_listener_t *listener)
+{
+    const coap_resource_t **resources = _coap_state.resources;
+
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        const coap_resource_t *resource = &listener->resources[i];
+
+        if (_coap_state.resources_len == GCOAP_RESOURCES_MAX) {
+            DEBUG("gcoap: resource index full; using linear search\n");
+            _coap_state.resources_overflow = true;
+            return;
+        }
+
+        size_t lo = 0, hi = _coap_state.resources_len;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (strcmp(resources[mid]->path, resource->path) <= 0) {
+                lo = mid + 1;
             }
             else {
-                ssize_t pdu_len = resource->handler(pdu, buf, len);
-                if (pdu_len < 0) {
-                    pdu_len = gcoap_response(pdu, buf, len,
-                                             COAP_CODE_INTERNAL_SERVER_ERROR);
-                }
-                return pdu_len;
+                hi = mid;
             }
         }
-        listener = listener->next;
+        memmove(&resources[lo + 1], &resources[lo],
+                (_coap_state.resources_len - lo) * sizeof(resources[0]));
+        resources[lo] = resource;
+        _coap_state.resources_len++;
     }
-    /* resource not found */
-    return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
 }
 
 /*
@@ -199,9 +368,10 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len)
  *
  * Returns the size of the PDU within the buffer, or < 0 on error.
  */
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           const gcoap_blockopts_t *opts)
 {
-    ssize_t hdr_len = _write_options(pdu, buf, len);
+    ssize_t hdr_len = _write_options(pdu, buf, len, opts);
     DEBUG("gcoap: header length: %u\n", hdr_len);
 
     if (hdr_len > 0) {
@@ -289,44 +459,292 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
    /* write header */
     gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
 
+#if GCOAP_WKC_CACHE_SIZE
+    if (!_coap_state.wkc_valid) {
+        _coap_state.wkc_len   = _wkc_write(_coap_state.wkc_cache,
+                                           sizeof(_coap_state.wkc_cache));
+        _coap_state.wkc_valid = true;
+    }
+
+    /* write payload; list only the links that fit */
+    size_t payload_len = _coap_state.wkc_len;
+    if (payload_len > pdu->payload_len) {
+        payload_len = pdu->payload_len;
+        while (payload_len && (_coap_state.wkc_cache[payload_len - 1] != '>')) {
+            payload_len--;
+        }
+    }
+    memcpy(pdu->payload, _coap_state.wkc_cache, payload_len);
+#else
+    size_t payload_len = _wkc_write((char *)pdu->payload, pdu->payload_len);
+#endif
+
+    /* response content */
+    return gcoap_finish(pdu, payload_len, COAP_FORMAT_LINK);
+}
+
+/*
+ * Writes the link format list of registered resources for /.well-known/core
+ * to buf, as far as the links fit in len.
+ *
+ * Returns the length of the list.
+ */
+static size_t _wkc_write(char *buf, size_t len)
+{
+    char *bufpos = buf;
+    char *bufend = buf + len;
+
     /* skip the first listener, gcoap itself */
     gcoap_listener_t *listener = _coap_state.listeners->next;
 
-    /* write payload */
-    uint8_t *bufpos            = pdu->payload;
-
     while (listener) {
         coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
+        for (size_t i = 0; i < listener->resources_len; i++, resource++) {
+            unsigned url_len = strlen(resource->path);
             /* Don't overwrite buffer if paths are too long. */
-            if (bufpos + strlen(resource->path) + 3 > buf + len) {
-               break;
+            if (bufpos + url_len + 3 > bufend) {
+                break;
             }
-            if (i) {
+            if (bufpos != buf) {
                 *bufpos++ = ',';
-                resource++;
             }
             *bufpos++ = '<';
-            unsigned url_len = strlen(resource->path);
             memcpy(bufpos, resource->path, url_len);
             bufpos   += url_len;
             *bufpos++ = '>';
         }
         listener = listener->next;
     }
+    return bufpos - buf;
+}
 
-    /* response content */
-    return gcoap_finish(pdu, bufpos - pdu->payload, COAP_FORMAT_LINK);
+/*
+ * Decodes the extended form of an option delta or length nibble, and advances
+ * pos past the extension bytes.
+ *
+ * Returns the decoded value, or -EBADMSG if malformed.
+ */
+static int _decode_opt_ext(unsigned nibble, uint8_t **pos, uint8_t *end)
+{
+    int val = nibble;
+
+    if (nibble == 13) {
+        if (*pos + 1 > end) {
+            return -EBADMSG;
+        }
+        val = **pos + 13;
+        *pos += 1;
+    }
+    else if (nibble == 14) {
+        if (*pos + 2 > end) {
+            return -EBADMSG;
+        }
+        val = (((*pos)[0] << 8) | (*pos)[1]) + 269;
+        *pos += 2;
+    }
+    else if (nibble == 15) {
+        return -EBADMSG;
+    }
+    return val;
+}
+
+/* Returns the nibble for an option delta or length, or its extension size. */
+static unsigned _opt_ext_nibble(unsigned val)
+{
+    return (val < 13) ? val : ((val < 269) ? 13 : 14);
+}
+
+static unsigned _opt_ext_len(unsigned val)
+{
+    return (val < 13) ? 0 : ((val < 269) ? 1 : 2);
+}
+
+static uint8_t *_encode_opt_ext(uint8_t *pos, unsigned val)
+{
+    if (val >= 269) {
+        val -= 269;
+        *pos++ = val >> 8;
+        *pos++ = val & 0xFF;
+    }
+    else if (val >= 13) {
+        *pos++ = val - 13;
+    }
+    return pos;
+}
+
+/*
+ * Writes an option header at buf, for option number onum following lastonum,
+ * with a value of olen bytes.
+ *
+ * Returns length of the header.
+ */
+static size_t _put_opt_hdr(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                                                             size_t olen)
+{
+    unsigned delta = onum - lastonum;
+    uint8_t *pos   = buf + 1;
+
+    buf[0] = (_opt_ext_nibble(delta) << 4) | _opt_ext_nibble(olen);
+    pos    = _encode_opt_ext(pos, delta);
+    pos    = _encode_opt_ext(pos, olen);
+    return pos - buf;
+}
+
+/* Returns the minimum number of bytes for an unsigned integer option value. */
+static size_t _uint_len(uint32_t value)
+{
+    size_t olen = 0;
+    for (uint32_t tmp = value; tmp; tmp >>= 8) {
+        olen++;
+    }
+    return olen;
+}
+
+/*
+ * Writes an option with an unsigned integer value in the minimum number of
+ * bytes.
+ *
+ * Returns length of the option.
+ */
+static size_t _put_opt_uint(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                                                             uint32_t value)
+{
+    size_t olen    = _uint_len(value);
+    size_t hdr_len = _put_opt_hdr(buf, lastonum, onum, olen);
+    for (size_t i = 0; i < olen; i++) {
+        buf[hdr_len + i] = value >> (8 * (olen - 1 - i));
+    }
+    return hdr_len + olen;
+}
+
+static uint32_t _block2uint(const gcoap_block_t *block)
+{
+    return (block->blknum << 4) | (block->more ? 0x8 : 0) | block->szx;
+}
+
+/*
+ * Extracts block-wise transfer options, and removes them from the buffer by
+ * shifting the remaining options and payload toward the header. Options
+ * after a removed option are re-encoded for the new option delta. Also reads
+ * the Observe option, which is left in place; observe is UINT32_MAX if none.
+ * opts_end is the offset of the payload marker, or len if none, before
+ * removal.
+ *
+ * Returns the new length of the PDU, or < 0 on error.
+ */
+static ssize_t _strip_block_opts(uint8_t *buf, size_t len,
+                                 gcoap_blockopts_t *opts, size_t *opts_end,
+                                 uint32_t *observe)
+{
+    coap_hdr_t *hdr = (coap_hdr_t *)buf;
+    uint8_t *end    = buf + len;
+    uint8_t *pos, *wpos;
+    uint16_t onum = 0, last_kept = 0;
+
+    memset(opts, 0, sizeof(gcoap_blockopts_t));
+    *observe = UINT32_MAX;
+    if (len < sizeof(coap_hdr_t)
+            || len < sizeof(coap_hdr_t) + (hdr->ver_t_tkl & 0xF)) {
+        return -EBADMSG;
+    }
+    pos  = coap_hdr_data_ptr(hdr) + (hdr->ver_t_tkl & 0xF);
+    wpos = pos;
+
+    while (pos < end) {
+        if (*pos == GCOAP_PAYLOAD_MARKER) {
+            break;
+        }
+        uint8_t *opt_start = pos;
+        unsigned nibbles   = *pos++;
+        int delta = _decode_opt_ext(nibbles >> 4, &pos, end);
+        int olen  = _decode_opt_ext(nibbles & 0xF, &pos, end);
+        if ((delta < 0) || (olen < 0) || (pos + olen > end)) {
+            return -EBADMSG;
+        }
+        onum += delta;
+
+        if ((onum == GCOAP_OPT_OBSERVE) && (olen <= 3)) {
+            *observe = 0;
+            for (int i = 0; i < olen; i++) {
+                *observe = (*observe << 8) | pos[i];
+            }
+        }
+
+        if ((onum == GCOAP_OPT_BLOCK1) || (onum == GCOAP_OPT_BLOCK2)
+                || (onum == GCOAP_OPT_SIZE1) || (onum == GCOAP_OPT_SIZE2)) {
+            uint32_t value = 0;
+            if (olen > 4) {
+                return -EBADMSG;
+            }
+            for (int i = 0; i < olen; i++) {
+                value = (value << 8) | pos[i];
+            }
+            gcoap_block_t *block = NULL;
+            switch (onum) {
+                case GCOAP_OPT_BLOCK1:
+                    block = &opts->block1;
+                    opts->flags |= GCOAP_BLOCKOPT_BLOCK1;
+                    break;
+                case GCOAP_OPT_BLOCK2:
+                    block = &opts->block2;
+                    opts->flags |= GCOAP_BLOCKOPT_BLOCK2;
+                    break;
+                case GCOAP_OPT_SIZE1:
+                    opts->size1  = value;
+                    opts->flags |= GCOAP_BLOCKOPT_SIZE1;
+                    break;
+                default:
+                    opts->size2  = value;
+                    opts->flags |= GCOAP_BLOCKOPT_SIZE2;
+                    break;
+            }
+            if (block) {
+                if ((olen > 3) || ((value & 0x7) == 7)) {
+                    return -EBADMSG;    /* SZX 7 is reserved */
+                }
+                block->blknum = value >> 4;
+                block->more   = (value & 0x8) ? 1 : 0;
+                block->szx    = value & 0x7;
+            }
+        }
+        else if (wpos == opt_start) {
+            /* nothing removed yet; leave option in place */
+            wpos      = pos + olen;
+            last_kept = onum;
+        }
+        else {
+            size_t hdr_len = 1 + _opt_ext_len(onum - last_kept)
+                               + _opt_ext_len(olen);
+            if (wpos + hdr_len > pos) {
+                /* re-encoded delta does not fit in removed space */
+                return -ENOSPC;
+            }
+            wpos     += _put_opt_hdr(wpos, last_kept, onum, olen);
+            memmove(wpos, pos, olen);
+            wpos     += olen;
+            last_kept = onum;
+        }
+        pos += olen;
+    }
+
+    *opts_end = pos - buf;
+    /* shift payload marker and payload */
+    if (wpos != pos) {
+        memmove(wpos, pos, end - pos);
+    }
+    return (wpos - buf) + (end - pos);
 }
 
 /*
  * Creates CoAP options and sets payload marker, if any.
  *
- * Returns length of header + options, or -EINVAL on illegal path.
+ * Returns length of header + options, or -EINVAL on illegal path, or -ENOSPC
+ * if block options do not fit in the space reserved for options.
  */
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              const gcoap_blockopts_t *opts)
 {
-    uint8_t last_optnum = 0;
+    uint16_t last_optnum = 0;
     (void)len;
 
     uint8_t *bufpos = buf + coap_get_total_hdr_len(pdu);  /* position for write */
@@ -346,8 +764,50 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     /* Content-Format */
     if (pdu->content_type != COAP_FORMAT_NONE) {
         bufpos += coap_put_option_ct(bufpos, last_optnum, pdu->content_type);
-        /* uncomment when add an option after Content-Format */
-        /* last_optnum = COAP_OPT_CONTENT_FORMAT; */
+        last_optnum = COAP_OPT_CONTENT_FORMAT;
+    }
+
+    /* Block-wise transfer options, in option number order */
+    if (opts) {
+        static const struct {
+            uint16_t onum;
+            uint8_t flag;
+        } block_opts[] = {
+            { GCOAP_OPT_BLOCK2, GCOAP_BLOCKOPT_BLOCK2 },
+            { GCOAP_OPT_BLOCK1, GCOAP_BLOCKOPT_BLOCK1 },
+            { GCOAP_OPT_SIZE2,  GCOAP_BLOCKOPT_SIZE2 },
+            { GCOAP_OPT_SIZE1,  GCOAP_BLOCKOPT_SIZE1 },
+        };
+        for (unsigned i = 0; i < sizeof(block_opts) / sizeof(block_opts[0]); i++) {
+            uint32_t value;
+            if (!(opts->flags & block_opts[i].flag)) {
+                continue;
+            }
+            switch (block_opts[i].onum) {
+                case GCOAP_OPT_BLOCK2:
+                    value = _block2uint(&opts->block2);
+                    break;
+                case GCOAP_OPT_BLOCK1:
+                    value = _block2uint(&opts->block1);
+                    break;
+                case GCOAP_OPT_SIZE2:
+                    value = opts->size2;
+                    break;
+                default:
+                    value = opts->size1;
+                    break;
+            }
+            /* leave room for the payload marker */
+            size_t olen = _uint_len(value);
+            if (bufpos + 1 + _opt_ext_len(block_opts[i].onum - last_optnum)
+                    + _opt_ext_len(olen) + olen + (pdu->payload_len ? 1 : 0)
+                    > pdu->payload) {
+                return -ENOSPC;
+            }
+            bufpos += _put_opt_uint(bufpos, last_optnum, block_opts[i].onum,
+                                                         value);
+            last_optnum = block_opts[i].onum;
+        }
     }
 
     /* write payload marker */
@@ -357,6 +817,295 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     return bufpos - buf;
 }
 
+/* Returns true if the endpoints have the same address and port. */
+static bool _endpoint_match(const sock_udp_ep_t *a, const sock_udp_ep_t *b)
+{
+    return (a->family == b->family) && (a->port == b->port)
+            && (memcmp(&a->addr, &b->addr, sizeof(a->addr)) == 0);
+}
+
+/* Finds the registration entry for an observed resource, or NULL. */
+static gcoap_obs_resource_t *_obs_find_resource(const coap_resource_t *resource)
+{
+    for (int i = 0; i < GCOAP_OBS_RESOURCES_MAX; i++) {
+        if (_coap_state.obs_resources[i].resource == resource) {
+            return &_coap_state.obs_resources[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Registers the requester of pdu as an observer of resource. Replaces the
+ * token of an existing registration from the same endpoint.
+ *
+ * Returns the registration entry for the resource, or NULL if no space.
+ */
+static gcoap_obs_resource_t *_obs_register(const coap_resource_t *resource,
+                                           coap_pkt_t *pdu,
+                                           sock_udp_ep_t *remote)
+{
+    gcoap_obs_resource_t *entry = _obs_find_resource(resource);
+    gcoap_observe_memo_t *observer = NULL;
+
+    if (entry) {
+        for (observer = entry->observers; observer; observer = observer->next) {
+            if (_endpoint_match(&observer->remote, remote)) {
+                break;
+            }
+        }
+    }
+    else {
+        entry = _obs_find_resource(NULL);
+        if (!entry) {
+            DEBUG("gcoap: can't observe resource; no space\n");
+            return NULL;
+        }
+        entry->resource    = resource;
+        entry->observers   = NULL;
+        entry->pending     = 0;
+        /* first notification is not rate limited */
+        entry->last_notify = xtimer_now_usec() - GCOAP_OBS_NOTIFY_INTERVAL;
+    }
+
+    if (!observer) {
+        for (int i = 0; i < GCOAP_OBS_OBSERVERS_MAX; i++) {
+            if (_coap_state.observers[i].remote.family == AF_UNSPEC) {
+                observer = &_coap_state.observers[i];
+                break;
+            }
+        }
+        if (!observer) {
+            DEBUG("gcoap: can't register observer; no space\n");
+            if (!entry->observers) {
+                entry->resource = NULL;
+            }
+            return NULL;
+        }
+        observer->remote = *remote;
+        observer->next   = entry->observers;
+        entry->observers = observer;
+    }
+
+    observer->token_len = coap_get_token_len(pdu);
+    memcpy(observer->token, pdu->token, observer->token_len);
+    observer->unacked   = 0;
+    return entry;
+}
+
+/* Removes the observer at remote from the entry, if any. */
+static void _obs_remove(gcoap_obs_resource_t *entry, sock_udp_ep_t *remote)
+{
+    if (!entry) {
+        return;
+    }
+    for (gcoap_observe_memo_t **prev = &entry->observers; *prev;
+                                       prev = &(*prev)->next) {
+        if (_endpoint_match(&(*prev)->remote, remote)) {
+            gcoap_observe_memo_t *observer = *prev;
+            *prev = observer->next;
+            observer->remote.family = AF_UNSPEC;
+            break;
+        }
+    }
+    if (!entry->observers) {
+        entry->resource = NULL;
+    }
+}
+
+/*
+ * Handles an ACK or RST for a confirmable notification. An ACK clears the
+ * count of unacknowledged notifications; a RST cancels the observation.
+ */
+static void _obs_handle_empty(coap_pkt_t *pdu, sock_udp_ep_t *remote)
+{
+    uint16_t msg_id = pdu->hdr->id;
+
+    for (int i = 0; i < GCOAP_OBS_RESOURCES_MAX; i++) {
+        gcoap_obs_resource_t *entry = &_coap_state.obs_resources[i];
+        if (!entry->resource) {
+            continue;
+        }
+        for (gcoap_observe_memo_t *observer = entry->observers; observer;
+                                   observer = observer->next) {
+            if ((observer->msg_id == msg_id)
+                    && _endpoint_match(&observer->remote, remote)) {
+                if (coap_get_type(pdu) == COAP_TYPE_RST) {
+                    _obs_remove(entry, remote);
+                }
+                else {
+                    observer->unacked = 0;
+                }
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Inserts an Observe option in the PDU in buf, after any options with a
+ * lower number. The value always is written in 3 bytes, the size of the
+ * sequence number. Re-encodes the header of the following option for its new
+ * option delta.
+ *
+ * Returns the new length of the PDU, or < 0 on error.
+ */
+static ssize_t _obs_insert_opt(uint8_t *buf, size_t pdu_len, size_t len,
+                                             uint32_t seq)
+{
+    coap_hdr_t *hdr = (coap_hdr_t *)buf;
+    uint8_t *end    = buf + pdu_len;
+    uint8_t *pos    = coap_hdr_data_ptr(hdr) + (hdr->ver_t_tkl & 0xF);
+    uint8_t *opt_start;
+    uint16_t onum = 0, prev_onum = 0;
+    int olen = 0;
+    size_t old_hdr_len = 0, new_hdr_len = 0;
+
+    /* find first option after Observe */
+    while (1) {
+        opt_start = pos;
+        if ((pos >= end) || (*pos == GCOAP_PAYLOAD_MARKER)) {
+            break;
+        }
+        unsigned nibbles = *pos++;
+        int delta = _decode_opt_ext(nibbles >> 4, &pos, end);
+        olen      = _decode_opt_ext(nibbles & 0xF, &pos, end);
+        if ((delta < 0) || (olen < 0) || (pos + olen > end)) {
+            return -EBADMSG;
+        }
+        if (onum + delta > GCOAP_OPT_OBSERVE) {
+            onum       += delta;
+            old_hdr_len = pos - opt_start;
+            new_hdr_len = 1 + _opt_ext_len(onum - GCOAP_OPT_OBSERVE)
+                            + _opt_ext_len(olen);
+            break;
+        }
+        onum     += delta;
+        prev_onum = onum;
+        pos      += olen;
+    }
+
+    size_t growth = OBS_OPT_LEN + new_hdr_len - old_hdr_len;
+    if (pdu_len + growth > len) {
+        return -ENOSPC;
+    }
+
+    /* move following options and payload, then write new headers */
+    uint8_t *tail = opt_start + old_hdr_len;
+    memmove(tail + growth, tail, end - tail);
+    opt_start += _put_opt_hdr(opt_start, prev_onum, GCOAP_OPT_OBSERVE, 3);
+    opt_start[0] = (seq >> 16) & 0xFF;
+    opt_start[1] = (seq >> 8) & 0xFF;
+    opt_start[2] = seq & 0xFF;
+    if (new_hdr_len) {
+        _put_opt_hdr(opt_start + 3, GCOAP_OPT_OBSERVE, onum, olen);
+    }
+    return pdu_len + growth;
+}
+
+/*
+ * Writes a notification for the resource once, and sends it to each of its
+ * observers. Only the header, token and sequence number are rewritten per
+ * observer.
+ *
+ * The handler writes the notification at an offset of GCOAP_TOKENLEN_MAX, so
+ * the header for any token length fits in front of the options.
+ */
+static void _obs_send(gcoap_obs_resource_t *entry, unsigned type)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[GCOAP_TOKENLEN_MAX] = { 0 };
+    coap_pkt_t pdu;
+
+    /* fake a GET request for the resource, with the maximum token length */
+    pdu.hdr = (coap_hdr_t *)buf;
+    coap_build_hdr(pdu.hdr, COAP_TYPE_NON, token, GCOAP_TOKENLEN_MAX,
+                   COAP_METHOD_GET, 0);
+    pdu.token        = coap_hdr_data_ptr(pdu.hdr);
+    pdu.payload      = buf + GCOAP_HEADER_MAXLEN;
+    pdu.payload_len  = 0;
+    pdu.content_type = COAP_FORMAT_NONE;
+    memset(pdu.url, 0, NANOCOAP_URL_MAX);
+    strncpy((char *)pdu.url, entry->resource->path, NANOCOAP_URL_MAX - 1);
+
+    /* the handler may call gcoap_obs_notify(), so it runs unlocked */
+    ssize_t pdu_len = entry->resource->handler(&pdu, buf, sizeof(buf));
+    if ((pdu_len <= 0) || (coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS)) {
+        DEBUG("gcoap: can't write notification\n");
+        return;
+    }
+    mutex_lock(&_coap_state.lock);
+    entry->seq = (entry->seq + 1) & 0xFFFFFF;
+    pdu_len = _obs_insert_opt(buf, pdu_len, sizeof(buf), entry->seq);
+    if (pdu_len < 0) {
+        DEBUG("gcoap: no space for Observe option\n");
+        mutex_unlock(&_coap_state.lock);
+        return;
+    }
+
+    unsigned code = pdu.hdr->code;
+    gcoap_observe_memo_t *observer = entry->observers;
+    while (observer) {
+        gcoap_observe_memo_t *next = observer->next;
+        uint16_t msg_id = ++_coap_state.last_message_id;
+
+        if (type == COAP_TYPE_CON) {
+            if (observer->unacked >= GCOAP_OBS_CON_FAIL_MAX) {
+                DEBUG("gcoap: removing unresponsive observer\n");
+                _obs_remove(entry, &observer->remote);
+                observer = next;
+                continue;
+            }
+            observer->unacked++;
+            observer->msg_id = byteorder_htons(msg_id).u16;
+        }
+        /* rewrite header and token in front of the shared options */
+        uint8_t *start = buf + (GCOAP_TOKENLEN_MAX - observer->token_len);
+        coap_build_hdr((coap_hdr_t *)start, type, observer->token,
+                       observer->token_len, code, msg_id);
+        sock_udp_send(&_sock, start, pdu_len - (start - buf), &observer->remote);
+        observer = next;
+    }
+    mutex_unlock(&_coap_state.lock);
+}
+
+/*
+ * Sends pending notifications that are not rate limited.
+ *
+ * Returns the time until the next rate limited notification is due, in usec,
+ * or SOCK_NO_TIMEOUT if none.
+ */
+static uint32_t _obs_process(void)
+{
+    uint32_t timeout = SOCK_NO_TIMEOUT;
+    uint32_t now     = xtimer_now_usec();
+
+    for (int i = 0; i < GCOAP_OBS_RESOURCES_MAX; i++) {
+        gcoap_obs_resource_t *entry = &_coap_state.obs_resources[i];
+        if (!entry->resource || !entry->pending) {
+            continue;
+        }
+        uint32_t elapsed = now - entry->last_notify;
+        if (elapsed < GCOAP_OBS_NOTIFY_INTERVAL) {
+            uint32_t wait = GCOAP_OBS_NOTIFY_INTERVAL - elapsed;
+            if (wait < timeout) {
+                timeout = wait;
+            }
+            continue;
+        }
+
+        mutex_lock(&_coap_state.lock);
+        unsigned type  = (entry->pending & OBS_PENDING_CON) ? COAP_TYPE_CON
+                                                             : COAP_TYPE_NON;
+        entry->pending = 0;
+        mutex_unlock(&_coap_state.lock);
+
+        entry->last_notify = now;
+        _obs_send(entry, type);
+    }
+    return timeout;
+}
+
 /*
  * gcoap interface functions
  */
@@ -386,6 +1135,103 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+
+    _index_listener(listener);
+#if GCOAP_WKC_CACHE_SIZE
+    _coap_state.wkc_valid = false;
+#endif
+}
+
+const coap_resource_t *gcoap_find_resource(const char *path, unsigned method)
+{
+    const coap_resource_t *resource;
+
+    if (_find_resource(path, coap_method2flag(method), &resource)
+            == RESOURCE_FOUND) {
+        return resource;
+    }
+    return NULL;
+}
+
+int gcoap_parse(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    uint8_t tmp[GCOAP_PDU_BUF_SIZE];
+    gcoap_blockopts_t opts;
+    size_t copy_len = (len < sizeof(tmp)) ? len : sizeof(tmp);
+    size_t opts_end;
+
+    /* nanocoap rejects block options as unknown critical options, so it
+     * parses a copy of the header and options without them; the PDU in buf
+     * keeps them for gcoap_get_block1() and gcoap_get_block2() */
+    memcpy(tmp, buf, copy_len);
+    ssize_t res = _strip_block_opts(tmp, copy_len, &opts, &opts_end,
+                                    &_coap_state.observe_value);
+    if ((res >= 0) && (opts_end == copy_len) && (copy_len < len)) {
+        res = -ENOSPC;
+    }
+    if (res < 0) {
+        DEBUG("gcoap: block option failure: %d\n", res);
+        return res;
+    }
+    res = coap_parse(pdu, tmp, res - (copy_len - opts_end));
+    if (res < 0) {
+        return res;
+    }
+
+    pdu->hdr         = (coap_hdr_t *)buf;
+    pdu->token       = coap_hdr_data_ptr(pdu->hdr);
+    pdu->payload     = buf + opts_end + ((opts_end < len) ? 1 : 0);
+    pdu->payload_len = len - (pdu->payload - buf);
+    return 0;
+}
+
+/*
+ * Reads the block option onum from the options of pdu, which end at the
+ * payload marker or the payload.
+ *
+ * Returns 1 if present, otherwise 0.
+ */
+static int _get_block(coap_pkt_t *pdu, uint16_t onum, gcoap_block_t *block)
+{
+    uint8_t *pos = coap_hdr_data_ptr(pdu->hdr) + coap_get_token_len(pdu);
+    uint8_t *end = pdu->payload;
+    uint16_t num = 0;
+
+    memset(block, 0, sizeof(gcoap_block_t));
+    while ((pos < end) && (*pos != GCOAP_PAYLOAD_MARKER)) {
+        unsigned nibbles = *pos++;
+        int delta = _decode_opt_ext(nibbles >> 4, &pos, end);
+        int olen  = _decode_opt_ext(nibbles & 0xF, &pos, end);
+        if ((delta < 0) || (olen < 0) || (pos + olen > end)) {
+            return 0;
+        }
+        num += delta;
+        if (num > onum) {
+            break;
+        }
+        if ((num == onum) && (olen <= 3)) {
+            uint32_t value = 0;
+            for (int i = 0; i < olen; i++) {
+                value = (value << 8) | pos[i];
+            }
+            block->blknum = value >> 4;
+            block->more   = (value & 0x8) ? 1 : 0;
+            block->szx    = value & 0x7;
+            return 1;
+        }
+        pos += olen;
+    }
+    return 0;
+}
+
+int gcoap_get_block1(coap_pkt_t *pdu, gcoap_block_t *block)
+{
+    return _get_block(pdu, GCOAP_OPT_BLOCK1, block);
+}
+
+int gcoap_get_block2(coap_pkt_t *pdu, gcoap_block_t *block)
+{
+    return _get_block(pdu, GCOAP_OPT_BLOCK2, block);
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
@@ -427,13 +1273,19 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
 }
 
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format)
+{
+    return gcoap_finish_block(pdu, payload_len, format, NULL);
+}
+
+ssize_t gcoap_finish_block(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           const gcoap_blockopts_t *opts)
 {
     /* reconstruct full PDU buffer length */
     size_t len = pdu->payload_len + (pdu->payload - (uint8_t *)pdu->hdr);
 
     pdu->content_type = format;
     pdu->payload_len  = payload_len;
-    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len);
+    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len, opts);
 }
 
 size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port,
@@ -452,6 +1304,17 @@ size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port
 
 size_t gcoap_req_send2(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
                                                  gcoap_resp_handler_t resp_handler)
+{
+    return _send_req(buf, len, remote, resp_handler, NULL);
+}
+
+/*
+ * Sends a request and tracks the response in a memo; xfer is the block-wise
+ * transfer for the request, or NULL.
+ */
+static size_t _send_req(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                        gcoap_resp_handler_t resp_handler,
+                        gcoap_block_xfer_t *xfer)
 {
     gcoap_request_memo_t *memo = NULL;
     assert(remote != NULL);
@@ -468,6 +1331,7 @@ size_t gcoap_req_send2(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
     if (memo) {
         memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
         memo->resp_handler = resp_handler;
+        memo->xfer         = xfer;
 
         size_t res = sock_udp_send(&_sock, buf, len, remote);
 
@@ -515,6 +1379,241 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     return 0;
 }
 
+/*
+ * Returns the largest size exponent not above szx for a block that fits in
+ * the available payload length.
+ */
+static uint8_t _fit_szx(uint8_t szx, size_t avail)
+{
+    if (szx > GCOAP_BLOCK_SZX_MAX) {
+        szx = GCOAP_BLOCK_SZX_MAX;
+    }
+    while (szx && ((1U << (szx + 4)) > avail)) {
+        szx--;
+    }
+    return szx;
+}
+
+ssize_t gcoap_block2_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned format, gcoap_block_read_t reader,
+                             void *arg)
+{
+    gcoap_blockopts_t opts = { .flags = GCOAP_BLOCKOPT_BLOCK2 };
+    gcoap_block_t req_block;
+    int more = 0;
+
+    if (!gcoap_get_block2(pdu, &req_block)) {
+        req_block.szx = GCOAP_BLOCK_SZX_MAX;
+    }
+    size_t offset = req_block.blknum << (req_block.szx + 4);
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+
+    /* may answer with a smaller block; block number follows from offset */
+    opts.block2.szx    = _fit_szx(req_block.szx, pdu->payload_len);
+    opts.block2.blknum = offset >> (opts.block2.szx + 4);
+    if ((1U << (opts.block2.szx + 4)) > pdu->payload_len) {
+        return -ENOSPC;
+    }
+
+    ssize_t res = reader(arg, offset, pdu->payload, 1U << (opts.block2.szx + 4),
+                                                    &more);
+    if (res < 0) {
+        return res;
+    }
+    opts.block2.more = more ? 1 : 0;
+
+    return gcoap_finish_block(pdu, res, format, &opts);
+}
+
+ssize_t gcoap_block1_receive(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             gcoap_block_write_t writer, void *arg)
+{
+    gcoap_blockopts_t opts = { .flags = GCOAP_BLOCKOPT_BLOCK1 };
+    gcoap_block_t *block   = &opts.block1;
+    int has_block = gcoap_get_block1(pdu, block);
+
+    size_t offset = block->blknum << (block->szx + 4);
+    if (block->more && (pdu->payload_len != (1U << (block->szx + 4)))) {
+        /* only the final block may be shorter than the block size */
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_REQUEST);
+    }
+
+    /* consume the block before the response overwrites the request */
+    int res = writer(arg, offset, pdu->payload, pdu->payload_len, block->more);
+    if (res == -ESPIPE) {
+        return gcoap_response(pdu, buf, len,
+                              GCOAP_CODE_REQUEST_ENTITY_INCOMPLETE);
+    }
+    else if (res < 0) {
+        return res;
+    }
+
+    unsigned code = block->more ? GCOAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+    gcoap_resp_init(pdu, buf, len, code);
+    return gcoap_finish_block(pdu, 0, COAP_FORMAT_NONE,
+                              has_block ? &opts : NULL);
+}
+
+/*
+ * Writes and sends the request for the current block of a transfer.
+ *
+ * Returns length of the request, or 0 if cannot send.
+ */
+static size_t _block_xfer_send(gcoap_block_xfer_t *xfer, uint8_t *buf,
+                                                         size_t len)
+{
+    coap_pkt_t pdu;
+    gcoap_blockopts_t opts;
+    size_t payload_len = 0;
+    unsigned format    = COAP_FORMAT_NONE;
+
+    if (gcoap_req_init(&pdu, buf, len, xfer->code, xfer->path) < 0) {
+        return 0;
+    }
+
+    if (xfer->code == COAP_METHOD_GET) {
+        opts.flags         = GCOAP_BLOCKOPT_BLOCK2;
+        opts.block2.szx    = xfer->szx;
+        opts.block2.blknum = xfer->blknum;
+        opts.block2.more   = 0;
+    }
+    else {
+        int more = 0;
+        size_t offset = xfer->blknum << (xfer->szx + 4);
+
+        /* block size can't change after the first block for a given offset */
+        if ((1U << (xfer->szx + 4)) > pdu.payload_len) {
+            if (xfer->blknum) {
+                return 0;
+            }
+            xfer->szx = _fit_szx(xfer->szx, pdu.payload_len);
+        }
+        ssize_t res = xfer->reader(xfer->arg, offset, pdu.payload,
+                                   1U << (xfer->szx + 4), &more);
+        if (res < 0) {
+            return 0;
+        }
+        payload_len        = res;
+        format             = xfer->format;
+        xfer->more         = more ? 1 : 0;
+        opts.flags         = GCOAP_BLOCKOPT_BLOCK1;
+        opts.block1.szx    = xfer->szx;
+        opts.block1.blknum = xfer->blknum;
+        opts.block1.more   = xfer->more;
+    }
+
+    ssize_t pdu_len = gcoap_finish_block(&pdu, payload_len, format, &opts);
+    if (pdu_len < 0) {
+        return 0;
+    }
+    return _send_req(buf, pdu_len, &xfer->remote, xfer->resp_handler, xfer);
+}
+
+/*
+ * Handles the response for a block of a transfer in the gcoap thread, and
+ * requests the next block, if any. Otherwise executes the response handler
+ * for the transfer.
+ */
+static void _block_xfer_step(gcoap_block_xfer_t *xfer, coap_pkt_t *pdu,
+                                                       uint8_t *buf, size_t len)
+{
+    gcoap_block_t block;
+    unsigned state = GCOAP_MEMO_RESP;
+    int next       = 0;
+
+    /* a failure response ends the transfer */
+    if (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS) {
+        if (xfer->code == COAP_METHOD_GET) {
+            if (!gcoap_get_block2(pdu, &block)) {
+                /* server sent the complete resource */
+                block.szx = xfer->szx;
+            }
+            size_t offset = block.blknum << (block.szx + 4);
+            if (offset != (xfer->blknum << (xfer->szx + 4))) {
+                state = GCOAP_MEMO_ERR;
+            }
+            else if (xfer->writer(xfer->arg, offset, pdu->payload, pdu->payload_len,
+                                                     block.more) < 0) {
+                state = GCOAP_MEMO_ERR;
+            }
+            else if (block.more) {
+                xfer->szx    = block.szx;
+                xfer->blknum = block.blknum + 1;
+                next         = 1;
+            }
+        }
+        else if ((pdu->hdr->code == GCOAP_CODE_CONTINUE) && xfer->more) {
+            size_t next_offset = (xfer->blknum + 1) << (xfer->szx + 4);
+            /* server may ask for a smaller block size */
+            if (gcoap_get_block1(pdu, &block) && (block.szx < xfer->szx)) {
+                xfer->szx = block.szx;
+            }
+            xfer->blknum = next_offset >> (xfer->szx + 4);
+            next         = 1;
+        }
+    }
+
+    if (next) {
+        if (_block_xfer_send(xfer, buf, len) > 0) {
+            return;
+        }
+        DEBUG("gcoap: can't send request for block %u\n",
+              (unsigned)xfer->blknum);
+        /* pdu now is the failed request */
+        pdu->hdr = (coap_hdr_t *)buf;
+        state    = GCOAP_MEMO_ERR;
+    }
+    xfer->resp_handler(state, pdu);
+}
+
+size_t gcoap_block_xfer_start(gcoap_block_xfer_t *xfer)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+
+    assert(xfer->resp_handler != NULL);
+    assert((xfer->code == COAP_METHOD_GET) ? (xfer->writer != NULL)
+                                           : (xfer->reader != NULL));
+    xfer->blknum = 0;
+    xfer->szx    = GCOAP_BLOCK_SZX_MAX;
+    xfer->more   = 0;
+
+    if (xfer->code == COAP_METHOD_GET) {
+        /* largest block that fits in a response buffer */
+        xfer->szx = _fit_szx(xfer->szx, GCOAP_PDU_BUF_SIZE - GCOAP_HEADER_MAXLEN
+                                         - GCOAP_RESP_OPTIONS_BUF);
+    }
+    return _block_xfer_send(xfer, buf, sizeof(buf));
+}
+
+int gcoap_obs_notify(const coap_resource_t *resource, unsigned type)
+{
+    int count = 0;
+
+    /* the gcoap thread adds and removes observers concurrently */
+    mutex_lock(&_coap_state.lock);
+    gcoap_obs_resource_t *entry = _obs_find_resource(resource);
+    if (!entry) {
+        mutex_unlock(&_coap_state.lock);
+        return 0;
+    }
+    for (gcoap_observe_memo_t *observer = entry->observers; observer;
+                               observer = observer->next) {
+        count++;
+    }
+    entry->pending |= (type == COAP_TYPE_CON) ? OBS_PENDING_CON
+                                              : OBS_PENDING_NON;
+    mutex_unlock(&_coap_state.lock);
+
+    /* interrupt sock listening, so gcoap thread sends the notification */
+    msg_t mbox_msg;
+    mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
+    mbox_msg.content.value = 0;
+    mbox_try_put(&_sock.reg.mbox, &mbox_msg);
+
+    return count;
+}
+
 void gcoap_op_state(uint8_t *open_reqs)
 {
     uint8_t count = 0;
@@ -58,6 +58,7 @@ static const char *_netopt_strmap[] = {
     [NETOPT_ENCRYPTION]      = "NETOPT_ENCRYPTION",
     [NETOPT_ENCRYPTION_KEY]  = "NETOPT_ENCRYPTION_KEY",
     [NETOPT_RF_TESTMODE]     = "NETOPT_RF_TESTMODE",
+    [NETOPT_RX_BATCH]        = "NETOPT_RX_BATCH",
     [NETOPT_NUMOF]           = "NETOPT_NUMOF",
 };
 
@@ -30,6 +30,13 @@
 #include "net/gnrc/netdev2.h"
 #include "net/ethernet/hdr.h"
 
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
+#ifdef MODULE_NETSTATS_LATENCY
+#include "net/netstats/latency.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -39,8 +46,56 @@
 
 #define NETDEV2_NETAPI_MSG_QUEUE_SIZE 8
 
+/**
+ * @brief   Type for @ref msg_t if received frames are left after a batch
+ */
+#define NETDEV2_MSG_TYPE_RX_PENDING   0x1235
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Fetches a received frame and passes it on
+ */
+static void _receive(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
+
+    if (pkt == NULL) {
+        return;
+    }
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_RX_NETDEV);
+#endif
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_rx(pkt);
+#endif
+    _pass_on_packet(pkt);
+}
+
+/**
+ * @brief   Fetches up to GNRC_NETDEV2_RX_BATCH received frames and leaves
+ *          the rest for after the messages that are already queued
+ */
+static void _receive_batch(gnrc_netdev2_t *gnrc_netdev2)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    msg_t msg;
+
+    msg.type = NETDEV2_MSG_TYPE_RX_PENDING;
+    msg.content.ptr = gnrc_netdev2;
+    do {
+        for (unsigned i = 0; i < GNRC_NETDEV2_RX_BATCH; i++) {
+            /* recv() of the glue code also fails for a frame it dropped, so
+             * ask the device whether a frame is left */
+            if (dev->driver->recv(dev, NULL, 0, NULL) <= 0) {
+                return;
+            }
+            _receive(gnrc_netdev2);
+        }
+        /* keep on fetching right away if the queue is full */
+    } while (msg_send_to_self(&msg) <= 0);
+}
+
 /**
  * @brief   Function called by the device driver on device events
  *
@@ -64,21 +119,38 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
         DEBUG("gnrc_netdev2: event triggered -> %i\n", event);
         switch(event) {
             case NETDEV2_EVENT_RX_COMPLETE:
-                {
-                    gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
-
-                    if (pkt) {
-                        _pass_on_packet(pkt);
-                    }
-
-                    break;
-                }
-#ifdef MODULE_NETSTATS_L2
+                _receive(gnrc_netdev2);
+                break;
+            case NETDEV2_EVENT_RX_PENDING:
+                _receive_batch(gnrc_netdev2);
+                break;
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV2_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(gnrc_netdev2->tx_nb, NETSTATS_NB_BUSY);
+                gnrc_netdev2->tx_nb = NULL;
+#endif
+                break;
+            case NETDEV2_EVENT_TX_NOACK:
+#ifdef MODULE_NETSTATS_L2
+                dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(gnrc_netdev2->tx_nb, NETSTATS_NB_NOACK);
+                gnrc_netdev2->tx_nb = NULL;
+#endif
                 break;
             case NETDEV2_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(gnrc_netdev2->tx_nb, NETSTATS_NB_SUCCESS);
+                gnrc_netdev2->tx_nb = NULL;
+#endif
                 break;
 #endif
             default:
@@ -87,6 +159,78 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Records the destination of a unicast packet for the link
+ *          statistics of the neighbor
+ *
+ * @return  the neighbor, NULL for broadcast and multicast packets
+ */
+static netstats_nb_t *_record_tx(gnrc_netdev2_t *gnrc_netdev2,
+                                 gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+
+    if ((pkt->type == GNRC_NETTYPE_NETIF) &&
+        !(hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                        GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        return netstats_nb_record(gnrc_netdev2->pid,
+                                  gnrc_netif_hdr_get_dst_addr(hdr),
+                                  hdr->dst_l2addr_len);
+    }
+    return NULL;
+}
+#endif
+
+/**
+ * @brief   Accounts for a packet right before it is handed to the device
+ */
+static void _prepare_send(gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(pkt);
+#endif
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_TX_NETDEV);
+#endif
+}
+
+/**
+ * @brief   Sends a packet together with the packets queued behind it
+ *
+ * @param[in,out] msg   the send message of the packet. Holds the first
+ *                      message that is not a send message on return.
+ *
+ * @return  true, if @p msg holds a message to handle
+ */
+static bool _send_batch(gnrc_netdev2_t *gnrc_netdev2, msg_t *msg)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TX_BATCH];
+    unsigned num = 0;
+    bool pending = false;
+
+    do {
+        pkts[num] = msg->content.ptr;
+        _prepare_send(pkts[num++]);
+        if ((num == GNRC_NETDEV2_TX_BATCH) || (msg_try_receive(msg) != 1)) {
+            break;
+        }
+        pending = (msg->type != GNRC_NETAPI_MSG_TYPE_SND);
+    } while (!pending);
+    DEBUG("gnrc_netdev2: sending %u packets at once\n", num);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    /* the next TX event is accounted to the last packet of the batch */
+    gnrc_netdev2->tx_nb = _record_tx(gnrc_netdev2, pkts[num - 1]);
+    if (gnrc_netdev2->send_batch(gnrc_netdev2, pkts, num) < 0) {
+        gnrc_netdev2->tx_nb = NULL;
+    }
+#else
+    gnrc_netdev2->send_batch(gnrc_netdev2, pkts, num);
+#endif
+    return pending;
+}
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -116,6 +260,8 @@ static void *_gnrc_netdev2_thread(void *args)
     gnrc_netapi_opt_t *opt;
     int res;
     msg_t msg, reply, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
+    netopt_enable_t enable = NETOPT_ENABLE;
+    bool pending = false;
 
     /* setup the MAC layers message queue */
     msg_init_queue(msg_queue, NETDEV2_NETAPI_MSG_QUEUE_SIZE);
@@ -129,21 +275,45 @@ static void *_gnrc_netdev2_thread(void *args)
 
     /* initialize low-level driver */
     dev->driver->init(dev);
+    /* fetch received frames in batches, if the device supports it */
+    dev->driver->set(dev, NETOPT_RX_BATCH, &enable, sizeof(enable));
 
     /* start the event loop */
     while (1) {
-        DEBUG("gnrc_netdev2: waiting for incoming messages\n");
-        msg_receive(&msg);
+        if (!pending) {
+            DEBUG("gnrc_netdev2: waiting for incoming messages\n");
+            msg_receive(&msg);
+        }
+        pending = false;
         /* dispatch NETDEV and NETAPI messages */
         switch (msg.type) {
             case NETDEV2_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
                 dev->driver->isr(dev);
                 break;
+            case NETDEV2_MSG_TYPE_RX_PENDING:
+                _receive_batch(gnrc_netdev2);
+                break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                if (gnrc_netdev2->send_batch != NULL) {
+                    pending = _send_batch(gnrc_netdev2, &msg);
+                    break;
+                }
                 gnrc_pktsnip_t *pkt = msg.content.ptr;
+                _prepare_send(pkt);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                /* most drivers report the outcome from their isr() after
+                 * send() returned, so the neighbor stays in flight until the
+                 * next TX event */
+                gnrc_netdev2->tx_nb = _record_tx(gnrc_netdev2, pkt);
+                if (gnrc_netdev2->send(gnrc_netdev2, pkt) < 0) {
+                    /* no TX event will follow */
+                    gnrc_netdev2->tx_nb = NULL;
+                }
+#else
                 gnrc_netdev2->send(gnrc_netdev2, pkt);
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
                 /* read incoming options */
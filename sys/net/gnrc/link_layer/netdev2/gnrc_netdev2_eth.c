@@ -135,47 +135,57 @@ static inline void _addr_set_multicast(uint8_t *dst, gnrc_pktsnip_t *payload)
     }
 }
 
-static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+/**
+ * @brief   Fills in the Ethernet header of a packet and prepends the io
+ *          vector of the frame to it
+ *
+ * @param[in,out] pkt   the packet, the io vector snip on success
+ * @param[out] hdr      Ethernet header, the first entry of the io vector
+ * @param[out] n        number of entries in the io vector
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+static int _prepare(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t **pkt,
+                    ethernet_hdr_t *hdr, size_t *n)
 {
-    ethernet_hdr_t hdr;
     gnrc_netif_hdr_t *netif_hdr;
     gnrc_pktsnip_t *payload;
-    int res;
 
     netdev2_t *dev = gnrc_netdev2->dev;
 
-    if (pkt == NULL) {
+    if (*pkt == NULL) {
         DEBUG("gnrc_netdev2_eth: pkt was NULL\n");
         return -EINVAL;
     }
 
-    payload = pkt->next;
+    payload = (*pkt)->next;
 
-    if (pkt->type != GNRC_NETTYPE_NETIF) {
+    if ((*pkt)->type != GNRC_NETTYPE_NETIF) {
         DEBUG("gnrc_netdev2_eth: First header was not generic netif header\n");
         return -EBADMSG;
     }
 
     if (payload) {
-        hdr.type = byteorder_htons(gnrc_nettype_to_ethertype(payload->type));
+        hdr->type = byteorder_htons(gnrc_nettype_to_ethertype(payload->type));
     }
     else {
-        hdr.type = byteorder_htons(ETHERTYPE_UNKNOWN);
+        hdr->type = byteorder_htons(ETHERTYPE_UNKNOWN);
     }
 
-    netif_hdr = pkt->data;
+    netif_hdr = (*pkt)->data;
 
     /* set ethernet header */
     if (netif_hdr->src_l2addr_len == ETHERNET_ADDR_LEN) {
-        memcpy(hdr.dst, gnrc_netif_hdr_get_src_addr(netif_hdr),
+        memcpy(hdr->dst, gnrc_netif_hdr_get_src_addr(netif_hdr),
                netif_hdr->src_l2addr_len);
     }
     else {
-        dev->driver->get(dev, NETOPT_ADDRESS, hdr.src, ETHERNET_ADDR_LEN);
+        dev->driver->get(dev, NETOPT_ADDRESS, hdr->src, ETHERNET_ADDR_LEN);
     }
 
     if (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) {
-        _addr_set_broadcast(hdr.dst);
+        _addr_set_broadcast(hdr->dst);
     }
     else if (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST) {
         if (payload == NULL) {
@@ -183,10 +193,10 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
                   "are not yet supported\n");
             return -ENOTSUP;
         }
-        _addr_set_multicast(hdr.dst, payload);
+        _addr_set_multicast(hdr->dst, payload);
     }
     else if (netif_hdr->dst_l2addr_len == ETHERNET_ADDR_LEN) {
-        memcpy(hdr.dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+        memcpy(hdr->dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
                ETHERNET_ADDR_LEN);
     }
     else {
@@ -195,28 +205,41 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
     }
 
     DEBUG("gnrc_netdev2_eth: send to %02x:%02x:%02x:%02x:%02x:%02x\n",
-          hdr.dst[0], hdr.dst[1], hdr.dst[2],
-          hdr.dst[3], hdr.dst[4], hdr.dst[5]);
+          hdr->dst[0], hdr->dst[1], hdr->dst[2],
+          hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
-    size_t n;
-    payload = gnrc_pktbuf_get_iovec(pkt, &n);   /* use payload as temporary
+    payload = gnrc_pktbuf_get_iovec(*pkt, n);   /* use payload as temporary
                                                  * variable */
-    res = -ENOBUFS;
-    if (payload != NULL) {
-        pkt = payload;      /* reassign for later release; vec_snip is prepended to pkt */
-        struct iovec *vector = (struct iovec *)pkt->data;
-        vector[0].iov_base = (char*)&hdr;
-        vector[0].iov_len = sizeof(ethernet_hdr_t);
+    if (payload == NULL) {
+        return -ENOBUFS;
+    }
+    *pkt = payload;     /* reassign for later release; vec_snip is prepended to pkt */
+    struct iovec *vector = (struct iovec *)payload->data;
+    vector[0].iov_base = (char*)hdr;
+    vector[0].iov_len = sizeof(ethernet_hdr_t);
 #ifdef MODULE_NETSTATS_L2
-        if ((netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) ||
-            (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
-            gnrc_netdev2->dev->stats.tx_mcast_count++;
-        }
-        else {
-            gnrc_netdev2->dev->stats.tx_unicast_count++;
-        }
+    if ((netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) ||
+        (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        gnrc_netdev2->dev->stats.tx_mcast_count++;
+    }
+    else {
+        gnrc_netdev2->dev->stats.tx_unicast_count++;
+    }
 #endif
-        res = dev->driver->send(dev, vector, n);
+    return 0;
+}
+
+static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    ethernet_hdr_t hdr;
+    size_t n;
+    int res;
+
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    res = _prepare(gnrc_netdev2, &pkt, &hdr, &n);
+    if (res == 0) {
+        res = dev->driver->send(dev, (struct iovec *)pkt->data, n);
     }
 
     gnrc_pktbuf_release(pkt);
@@ -224,9 +247,56 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
     return res;
 }
 
+static int _send_batch(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t **pkts,
+                       unsigned num)
+{
+    ethernet_hdr_t hdrs[GNRC_NETDEV2_TX_BATCH];
+    netdev2_frame_t frames[GNRC_NETDEV2_TX_BATCH];
+    unsigned ready = 0;
+    int res = 0;
+
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    assert(num <= GNRC_NETDEV2_TX_BATCH);
+    for (unsigned i = 0; i < num; i++) {
+        gnrc_pktsnip_t *pkt = pkts[i];
+        size_t n;
+
+        if (_prepare(gnrc_netdev2, &pkt, &hdrs[ready], &n) < 0) {
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+        pkts[ready] = pkt;  /* keep the io vector snip for release */
+        frames[ready].vector = (struct iovec *)pkt->data;
+        frames[ready].count = n;
+        ready++;
+    }
+
+    if (ready > 0) {
+        res = dev->driver->send_batch(dev, frames, ready);
+    }
+    if (res == -ENOTSUP) {
+        DEBUG("gnrc_netdev2_eth: sending %u frames one by one\n", ready);
+        res = 0;
+        for (unsigned i = 0; i < ready; i++) {
+            if (dev->driver->send(dev, frames[i].vector, frames[i].count) >= 0) {
+                res++;
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < ready; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+
+    return res;
+}
+
 int gnrc_netdev2_eth_init(gnrc_netdev2_t *gnrc_netdev2, netdev2_t *dev)
 {
     gnrc_netdev2->send = _send;
+    gnrc_netdev2->send_batch = (dev->driver->send_batch != NULL) ? _send_batch
+                                                                : NULL;
     gnrc_netdev2->recv = _recv;
     gnrc_netdev2->dev = dev;
 
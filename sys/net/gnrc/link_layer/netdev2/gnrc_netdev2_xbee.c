@@ -177,6 +177,7 @@ void gnrc_netdev2_xbee_init(gnrc_netdev2_t *gnrc_netdev2, xbee_t *dev)
     assert(gnrc_netdev2 && dev);
 
     gnrc_netdev2->send = xbee_adpt_send;
+    gnrc_netdev2->send_batch = NULL;
     gnrc_netdev2->recv = xbee_adpt_recv;
     gnrc_netdev2->dev = (netdev2_t *)dev;
 }
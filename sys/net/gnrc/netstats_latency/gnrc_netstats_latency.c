@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_netstats_latency
+ * @file
+ * @brief       Implementation of per layer packet latency statistics
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "net/netstats/latency.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define LAST_BUCKET     (NETSTATS_LAT_BUCKETS - 1)
+
+/* the stamps are taken by several threads, so the histograms are updated
+ * with interrupts disabled rather than under a mutex, which would add to
+ * the latency it measures */
+static netstats_lat_hist_t _hists[NETSTATS_LAT_NUMOF];
+
+static inline unsigned _bucket(uint32_t us)
+{
+    if (us == 0) {
+        return 0;
+    }
+    /* the last bucket has no upper bound */
+    if ((us >> (LAST_BUCKET - 1)) != 0) {
+        return LAST_BUCKET;
+    }
+    return bitarithm_msb((unsigned)us) + 1;
+}
+
+static inline uint32_t _bucket_min(unsigned bucket)
+{
+    return (bucket == 0) ? 0 : (1UL << (bucket - 1));
+}
+
+void netstats_lat_stamp(gnrc_pktsnip_t *pkt, netstats_lat_stage_t stage)
+{
+    uint32_t now = xtimer_now_usec();
+    netstats_lat_stage_t first;
+
+    assert((stage > NETSTATS_LAT_NONE) && (stage < NETSTATS_LAT_NUMOF));
+    /* the last snip survives all layers */
+    while (pkt->next != NULL) {
+        pkt = pkt->next;
+    }
+    first = (stage <= NETSTATS_LAT_RX_SOCK) ? NETSTATS_LAT_RX_NETDEV
+                                            : NETSTATS_LAT_TX_SOCK;
+    if (stage != first) {
+        netstats_lat_hist_t *hist = &_hists[stage];
+        uint32_t us = now - pkt->lat_time;
+        unsigned state;
+
+        if ((pkt->lat_stage < first) || (pkt->lat_stage >= stage)) {
+            DEBUG("netstats_latency: packet %p not stamped before stage %u\n",
+                  (void *)pkt, (unsigned)stage);
+            return;
+        }
+        state = irq_disable();
+        hist->count++;
+        hist->sum += us;
+        if (us > hist->max) {
+            hist->max = us;
+        }
+        hist->buckets[_bucket(us)]++;
+        irq_restore(state);
+    }
+    pkt->lat_time = now;
+    pkt->lat_stage = stage;
+}
+
+const netstats_lat_hist_t *netstats_lat_get(netstats_lat_stage_t stage)
+{
+    assert(stage < NETSTATS_LAT_NUMOF);
+    return &_hists[stage];
+}
+
+uint32_t netstats_lat_percentile(const netstats_lat_hist_t *hist, unsigned percent)
+{
+    uint32_t rank, seen = 0;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+    /* rank of the sample, counted from 1 */
+    rank = ((uint64_t)hist->count * percent + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (unsigned i = 0; i < NETSTATS_LAT_BUCKETS; i++) {
+        uint32_t min, max, res;
+
+        if ((seen + hist->buckets[i]) < rank) {
+            seen += hist->buckets[i];
+            continue;
+        }
+        min = _bucket_min(i);
+        max = (i == LAST_BUCKET) ? hist->max : _bucket_min(i + 1);
+        if (max < min) {
+            max = min;
+        }
+        res = min + ((uint64_t)(max - min) * (rank - seen)) / hist->buckets[i];
+        return (res < hist->max) ? res : hist->max;
+    }
+    return hist->max;
+}
+
+void netstats_lat_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(_hists, 0, sizeof(_hists));
+    irq_restore(state);
+}
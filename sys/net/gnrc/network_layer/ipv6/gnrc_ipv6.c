@@ -28,6 +28,7 @@
 #include "net/protnum.h"
 #include "thread.h"
 #include "utlist.h"
+#include "xtimer.h"
 
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -36,6 +37,14 @@
 
 #include "net/gnrc/ipv6.h"
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh_root.h"
+#endif
+
+#ifdef MODULE_NETSTATS_LATENCY
+#include "net/netstats/latency.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -97,6 +106,11 @@ kernel_pid_t gnrc_ipv6_init(void)
     return gnrc_ipv6_pid;
 }
 
+void gnrc_ipv6_send(gnrc_pktsnip_t *pkt)
+{
+    _send(pkt, true);
+}
+
 static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
                                   uint8_t nh, bool interested);
 
@@ -289,7 +303,7 @@ static void *_event_loop(void *args)
 #ifdef MODULE_GNRC_NDP
             case GNRC_NDP_MSG_RTR_TIMEOUT:
                 DEBUG("ipv6: Router timeout received\n");
-                ((gnrc_ipv6_nc_t *)msg.content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                gnrc_ipv6_nc_set_flags(msg.content.ptr, GNRC_IPV6_NC_IS_ROUTER, 0);
                 break;
 
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
@@ -310,6 +324,12 @@ static void *_event_loop(void *args)
                 gnrc_ndp_state_timeout(msg.content.ptr);
                 break;
 #endif
+#ifdef MODULE_GNRC_NDP_NODE
+            case GNRC_NDP_MSG_ADDR_RES_RETRANS:
+                DEBUG("ipv6: Address resolution retransmission timer event received\n");
+                gnrc_ndp_node_res_timeout();
+                break;
+#endif
 #ifdef MODULE_GNRC_NDP_ROUTER
             case GNRC_NDP_MSG_RTR_ADV_RETRANS:
                 DEBUG("ipv6: Router advertisement retransmission event received\n");
@@ -348,12 +368,10 @@ static void *_event_loop(void *args)
                 DEBUG("ipv6: border router timeout event received\n");
                 gnrc_sixlowpan_nd_router_abr_remove(msg.content.ptr);
                 break;
-            /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
-             * solved properly */
-            /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
-            /*     DEBUG("ipv6: address registration timeout received\n"); */
-            /*     gnrc_sixlowpan_nd_router_gc_nc(msg.content.ptr); */
-            /*     break; */
+            case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT:
+                DEBUG("ipv6: address registration timeout received\n");
+                gnrc_sixlowpan_nd_router_reg_tick();
+                break;
             case GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY:
                 DEBUG("ipv6: Delayed router advertisement event received\n");
                 gnrc_ipv6_nc_t *nc_entry = msg.content.ptr;
@@ -384,6 +402,9 @@ static void _send_to_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
     if_entry->stats.tx_success++;
     if_entry->stats.tx_bytes += gnrc_pkt_len(pkt->next);
 #endif
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_TX_IPV6);
+#endif
 
 #ifdef MODULE_GNRC_SIXLOWPAN
     if (if_entry->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN) {
@@ -521,6 +542,22 @@ static inline void _send_multicast_over_iface(kernel_pid_t iface, gnrc_pktsnip_t
     _send_to_iface(iface, pkt);
 }
 
+#if (GNRC_NETIF_NUMOF > 1) && defined(MODULE_GNRC_SIXLOWPAN)
+/* 6LoWPAN compresses the IPv6 header and the upper-layer header in place */
+static bool _any_sixlowpan(const kernel_pid_t *ifs, size_t ifnum)
+{
+    for (size_t i = 0; i < ifnum; i++) {
+        gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(ifs[i]);
+
+        if ((if_entry != NULL) &&
+            (if_entry->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN)) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                             gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *payload,
                             bool prep_hdr)
@@ -544,43 +581,90 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
 #if GNRC_NETIF_NUMOF > 1
     /* interface not given: send over all interfaces */
     if (iface == KERNEL_PID_UNDEF) {
-        /* send packet to link layer */
-        gnrc_pktbuf_hold(pkt, ifnum - 1);
+        ipv6_hdr_t *hdr = ipv6->data;
+        /* only the source address and the hop limit depend on the interface,
+         * if neither needs to be filled in all interfaces share the IPv6
+         * header and the payload, and only get their own netif header. This
+         * does not hold if 6LoWPAN compresses the headers of one of them. */
+        bool per_iface = prep_hdr && (ipv6_addr_is_unspecified(&hdr->src) ||
+                                      (hdr->hl == 0));
 
-        for (size_t i = 0; i < ifnum; i++) {
-            if (prep_hdr) {
-                /* need to get second write access (duplication) to fill IPv6
-                 * header interface-local */
-                gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
-                gnrc_pktsnip_t *ptr = tmp->next;
-                ipv6 = tmp;
-
-                if (ipv6 == NULL) {
-                    DEBUG("ipv6: unable to get write access to IPv6 header, "
-                          "for interface %" PRIkernel_pid "\n", ifs[i]);
-                    gnrc_pktbuf_release(pkt);
-                    return;
-                }
+#ifdef MODULE_GNRC_SIXLOWPAN
+        per_iface = per_iface || _any_sixlowpan(ifs, ifnum);
+#endif
+
+        if (!per_iface) {
+            uint8_t flags = 0;
 
-                /* multiple interfaces => possibly different source addresses
-                 * => different checksums => duplication of payload needed */
-                while (ptr != payload->next) {
-                    /* duplicate everything including payload */
-                    tmp->next = gnrc_pktbuf_start_write(ptr);
-                    if (tmp->next == NULL) {
-                        DEBUG("ipv6: unable to get write access to payload, drop it\n");
+            if (prep_hdr && (_fill_ipv6_hdr(KERNEL_PID_UNDEF, ipv6, payload) < 0)) {
+                /* error on filling up header */
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            if (pkt->type == GNRC_NETTYPE_NETIF) {
+                /* keep the flags of the old netif header, as
+                 * _create_netif_hdr() would */
+                flags = ((gnrc_netif_hdr_t *)pkt->data)->flags &
+                        ~(GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST);
+                gnrc_pktbuf_remove_snip(pkt, pkt);
+            }
+
+            /* one reference to the shared IPv6 packet per interface */
+            gnrc_pktbuf_hold(ipv6, ifnum - 1);
+
+            for (size_t i = 0; i < ifnum; i++) {
+                gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+                if (netif == NULL) {
+                    DEBUG("ipv6: error on interface header allocation, dropping packet\n");
+                    /* release the references of the remaining interfaces */
+                    while (i++ < ifnum) {
                         gnrc_pktbuf_release(ipv6);
-                        return;
                     }
-                    tmp = tmp->next;
-                    ptr = ptr->next;
+                    return;
                 }
+                ((gnrc_netif_hdr_t *)netif->data)->flags = flags;
+                netif->next = ipv6;
+                _send_multicast_over_iface(ifs[i], netif);
+            }
+            return;
+        }
+
+        /* send packet to link layer */
+        gnrc_pktbuf_hold(pkt, ifnum - 1);
 
-                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
-                    /* error on filling up header */
+        for (size_t i = 0; i < ifnum; i++) {
+            /* need to get second write access (duplication) to fill IPv6
+             * header interface-local */
+            gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
+            gnrc_pktsnip_t *ptr = tmp->next;
+            ipv6 = tmp;
+
+            if (ipv6 == NULL) {
+                DEBUG("ipv6: unable to get write access to IPv6 header, "
+                      "for interface %" PRIkernel_pid "\n", ifs[i]);
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+
+            /* multiple interfaces => possibly different source addresses
+             * => different checksums => duplication of payload needed */
+            while (ptr != payload->next) {
+                /* duplicate everything including payload */
+                tmp->next = gnrc_pktbuf_start_write(ptr);
+                if (tmp->next == NULL) {
+                    DEBUG("ipv6: unable to get write access to payload, drop it\n");
                     gnrc_pktbuf_release(ipv6);
                     return;
                 }
+                tmp = tmp->next;
+                ptr = ptr->next;
+            }
+
+            if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
+                /* error on filling up header */
+                gnrc_pktbuf_release(ipv6);
+                return;
             }
 
             if ((ipv6 = _create_netif_hdr(NULL, 0, ipv6)) == NULL) {
@@ -746,6 +830,28 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     else {
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+        ipv6_addr_t first_hop;
+        gnrc_pktsnip_t *srh;
+
+        /* source route own packets into a non-storing DODAG */
+        if (prep_hdr &&
+            ((srh = gnrc_rpl_srh_root_build(&hdr->dst, payload, &first_hop)) != NULL)) {
+            ipv6->next = srh;
+            /* checksum is calculated for the final destination */
+            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            ((gnrc_rpl_srh_t *)srh->data)->nh = hdr->nh;
+            hdr->nh = PROTNUM_IPV6_EXT_RH;
+            hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + srh->size);
+            hdr->dst = first_hop;
+            /* header is complete, also if the packet is queued for address
+             * resolution and sent again */
+            prep_hdr = false;
+        }
+#endif
 
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
 
@@ -767,6 +873,150 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     }
 }
 
+#ifdef MODULE_GNRC_IPV6_ROUTER
+/* generations of everything the next hop determination depends on */
+typedef struct {
+    unsigned fib;
+    unsigned nc;
+    unsigned netif;
+} _fwd_gen_t;
+
+/* next hop of a recently forwarded destination */
+typedef struct {
+    ipv6_addr_t dst;
+    _fwd_gen_t gen;
+    uint32_t expires;
+    kernel_pid_t iface;     /* KERNEL_PID_UNDEF if entry is unused */
+    uint8_t l2addr_len;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+} _fwd_entry_t;
+
+static _fwd_entry_t _fwd_cache[GNRC_IPV6_FWD_CACHE_SIZE];
+
+static inline void _fwd_gen(_fwd_gen_t *gen)
+{
+#ifdef MODULE_FIB
+    gen->fib = gnrc_ipv6_fib_table.gen;
+#else
+    gen->fib = 0;
+#endif
+    gen->nc = gnrc_ipv6_nc_gen;
+    gen->netif = gnrc_ipv6_netif_addr_gen();
+}
+
+static inline _fwd_entry_t *_fwd_slot(const ipv6_addr_t *dst)
+{
+    /* destinations mostly differ in the interface identifier */
+    uint32_t h = dst->u32[2].u32 ^ dst->u32[3].u32;
+
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return &_fwd_cache[h & (GNRC_IPV6_FWD_CACHE_SIZE - 1)];
+}
+
+static _fwd_entry_t *_fwd_cache_get(const ipv6_addr_t *dst)
+{
+    _fwd_entry_t *entry = _fwd_slot(dst);
+    _fwd_gen_t gen;
+
+    if ((entry->iface == KERNEL_PID_UNDEF) ||
+        !ipv6_addr_equal(&entry->dst, dst)) {
+        return NULL;
+    }
+    _fwd_gen(&gen);
+    if ((memcmp(&gen, &entry->gen, sizeof(gen)) != 0) ||
+        ((int32_t)(xtimer_now_usec() - entry->expires) >= 0)) {
+        DEBUG("ipv6: forwarding cache entry for %s outdated\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        entry->iface = KERNEL_PID_UNDEF;
+        return NULL;
+    }
+    return entry;
+}
+
+static void _fwd_cache_set(const ipv6_addr_t *dst, const _fwd_gen_t *gen,
+                           kernel_pid_t iface, const uint8_t *l2addr,
+                           uint8_t l2addr_len)
+{
+    _fwd_entry_t *entry = _fwd_slot(dst);
+
+    entry->dst = *dst;
+    entry->gen = *gen;
+    entry->expires = xtimer_now_usec() + GNRC_IPV6_FWD_CACHE_TIMEOUT;
+    entry->iface = iface;
+    entry->l2addr_len = l2addr_len;
+    memcpy(entry->l2addr, l2addr, l2addr_len);
+}
+
+/* Forwards a received packet by turning it around in place: the received
+ * netif header becomes the one to send with and only the hop limit of the
+ * IPv6 header changes. Returns false, if anyone else holds a reference to the
+ * packet or the netif header can't be resized */
+static bool _fwd_in_place(gnrc_pktsnip_t *pkt, ipv6_hdr_t *hdr,
+                          const _fwd_entry_t *fwd)
+{
+    gnrc_pktsnip_t *netif = NULL, *reversed_pkt = NULL;
+    gnrc_netif_hdr_t *netif_hdr;
+
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        if (ptr->users > 1) {
+            return false;
+        }
+        if (ptr->type == GNRC_NETTYPE_NETIF) {
+            netif = ptr;
+        }
+    }
+    /* the netif header of a received packet is its last snip */
+    if ((netif == NULL) || (netif->next != NULL) ||
+        (gnrc_pktbuf_realloc_data(netif, sizeof(gnrc_netif_hdr_t) +
+                                  fwd->l2addr_len) != 0)) {
+        return false;
+    }
+    netif_hdr = netif->data;
+    gnrc_netif_hdr_init(netif_hdr, 0, fwd->l2addr_len);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr, (uint8_t *)fwd->l2addr,
+                                fwd->l2addr_len);
+    hdr->hl--;
+
+    while (pkt != NULL) {
+        gnrc_pktsnip_t *next = pkt->next;
+
+        pkt->next = reversed_pkt;
+        reversed_pkt = pkt;
+        pkt = next;
+    }
+    DEBUG("ipv6: forward packet in place over interface %" PRIkernel_pid "\n",
+          fwd->iface);
+#ifdef MODULE_NETSTATS_IPV6
+    gnrc_ipv6_netif_get_stats(fwd->iface)->tx_unicast_count++;
+#endif
+    _send_to_iface(fwd->iface, reversed_pkt);
+    return true;
+}
+
+/* determines the next hop of a packet to forward and keeps it for the
+ * following packets to the same destination */
+static void _fwd_unicast(gnrc_pktsnip_t *pkt, ipv6_addr_t *dst)
+{
+    uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    kernel_pid_t iface;
+    _fwd_gen_t gen;
+
+    /* taken before, so any change while determining the next hop (e.g. a
+     * neighbor becoming DELAY) leaves an outdated entry */
+    _fwd_gen(&gen);
+    iface = _next_hop_l2addr(l2addr, &l2addr_len, KERNEL_PID_UNDEF, dst, pkt);
+    if (iface == KERNEL_PID_UNDEF) {
+        DEBUG("ipv6: error determining next hop's link layer address\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _fwd_cache_set(dst, &gen, iface, l2addr, l2addr_len);
+    _send_unicast(iface, l2addr, l2addr_len, pkt);
+}
+#endif /* MODULE_GNRC_IPV6_ROUTER */
+
 /* functions for receiving */
 static inline bool _pkt_not_for_me(kernel_pid_t *iface, ipv6_hdr_t *hdr)
 {
@@ -919,24 +1169,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
             return;
         }
         /* TODO: check if receiving interface is router */
-        else if (--(hdr->hl) > 0) {  /* drop packets that *reach* Hop Limit 0 */
+        else if (hdr->hl > 1) {  /* drop packets that *reach* Hop Limit 0 */
             gnrc_pktsnip_t *reversed_pkt = NULL, *ptr = pkt;
+            _fwd_entry_t *fwd = _fwd_cache_get(&hdr->dst);
 
-            DEBUG("ipv6: forward packet to next hop\n");
-
-            /* pkt might not be writable yet, if header was given above */
-            ipv6 = gnrc_pktbuf_start_write(ipv6);
-            if (ipv6 == NULL) {
-                DEBUG("ipv6: unable to get write access to packet: dropping it\n");
-                gnrc_pktbuf_release(pkt);
+            if ((fwd != NULL) && _fwd_in_place(pkt, hdr, fwd)) {
                 return;
             }
-
-            /* remove L2 headers around IPV6 */
-            netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
-            if (netif != NULL) {
-                gnrc_pktbuf_remove_snip(pkt, netif);
-            }
+            DEBUG("ipv6: forward packet to next hop\n");
 
             /* reverse packet snip list order */
             while (ptr != NULL) {
@@ -953,7 +1193,23 @@ static void _receive(gnrc_pktsnip_t *pkt)
                 reversed_pkt = ptr;
                 ptr = next;
             }
-            _send(reversed_pkt, false);
+
+            /* remove L2 headers around IPV6 */
+            netif = gnrc_pktsnip_search_type(reversed_pkt, GNRC_NETTYPE_NETIF);
+            if (netif != NULL) {
+                reversed_pkt = gnrc_pktbuf_remove_snip(reversed_pkt, netif);
+            }
+
+            /* only the copies are writable, pkt might have been shared */
+            ipv6 = gnrc_pktsnip_search_type(reversed_pkt, GNRC_NETTYPE_IPV6);
+            hdr = ipv6->data;
+            hdr->hl--;
+            if (ipv6_addr_is_multicast(&hdr->dst)) {
+                _send(reversed_pkt, false);
+            }
+            else {
+                _fwd_unicast(reversed_pkt, &hdr->dst);
+            }
             return;
         }
         else {
@@ -970,6 +1226,9 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #endif /* MODULE_GNRC_IPV6_ROUTER */
     }
 
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_RX_IPV6);
+#endif
     /* IPv6 internal demuxing (ICMPv6, Extension headers etc.) */
     gnrc_ipv6_demux(iface, first_ext, pkt, hdr->nh);
 }
@@ -15,6 +15,7 @@
 #include <errno.h>
 #include <string.h>
 
+#include "assert.h"
 #include "net/gnrc/ipv6.h"
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nc.h"
@@ -37,6 +38,8 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
 
+unsigned gnrc_ipv6_nc_gen;
+
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
@@ -49,14 +52,10 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
           iface);
 
 #ifdef MODULE_GNRC_NDP_NODE
-    while (entry->pkts != NULL) {
-        gnrc_pktbuf_release(entry->pkts->pkt);
-        entry->pkts->pkt = NULL;
-        gnrc_pktqueue_remove_head(&entry->pkts);
-    }
+    gnrc_ndp_node_drop_queued(entry);
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
-    xtimer_remove(&entry->type_timeout);
+    gnrc_sixlowpan_nd_router_reg_remove(entry);
 
     gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(iface);
 
@@ -76,6 +75,7 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
+    gnrc_ipv6_nc_gen++;
 }
 
 void gnrc_ipv6_nc_init(void)
@@ -127,6 +127,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
                 memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
                 ncache[i].l2_addr_len = l2_addr_len;
                 ncache[i].flags = flags;
+                gnrc_ipv6_nc_gen++;
                 DEBUG(" with flags = 0x%0x\n", flags);
 
             }
@@ -150,6 +151,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
 
 #ifdef MODULE_GNRC_NDP_NODE
     free_entry->pkts = NULL;
+    free_entry->res_deadline = 0;
 #endif
     memcpy(&(free_entry->ipv6_addr), ipv6_addr, sizeof(ipv6_addr_t));
     DEBUG("ipv6_nc: Register %s for interface %" PRIkernel_pid,
@@ -165,6 +167,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     }
 
     free_entry->flags = flags;
+    gnrc_ipv6_nc_gen++;
 
     DEBUG(" with flags = 0x%0x\n", flags);
 
@@ -174,8 +177,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
-    free_entry->type_timeout_msg.type = GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT;
-    free_entry->type_timeout_msg.content.ptr = free_entry;
+    free_entry->reg_slot = 0;
 #endif
 
     free_entry->rtr_timeout_msg.type = GNRC_NDP_MSG_RTR_TIMEOUT;
@@ -197,6 +199,26 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
     _nc_remove(iface, entry);
 }
 
+void gnrc_ipv6_nc_set_flags(gnrc_ipv6_nc_t *entry, uint8_t mask, uint8_t flags)
+{
+    uint8_t new_flags = (entry->flags & ~mask) | (flags & mask);
+
+    if (new_flags != entry->flags) {
+        entry->flags = new_flags;
+        gnrc_ipv6_nc_gen++;
+    }
+}
+
+void gnrc_ipv6_nc_set_l2_addr(gnrc_ipv6_nc_t *entry, kernel_pid_t iface,
+                              const void *l2_addr, size_t l2_addr_len)
+{
+    assert(l2_addr_len <= GNRC_IPV6_NC_L2_ADDR_MAX);
+    entry->iface = iface;
+    entry->l2_addr_len = l2_addr_len;
+    memcpy(entry->l2_addr, l2_addr, l2_addr_len);
+    gnrc_ipv6_nc_gen++;
+}
+
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
 {
     if ((ipv6_addr == NULL) || (ipv6_addr_is_unspecified(ipv6_addr))) {
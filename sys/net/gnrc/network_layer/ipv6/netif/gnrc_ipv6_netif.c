@@ -57,6 +57,149 @@ static gnrc_ipv6_netif_t ipv6_ifs[GNRC_NETIF_NUMOF];
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+/* Index over the addresses of all interfaces, for the receive path.
+ * Every address slot of ipv6_ifs is a node of the index, referenced by its
+ * position in ipv6_ifs plus 1. Writers hold _idx_lock and keep _idx_seq odd
+ * while they change an address or the index. Readers take no lock, but
+ * retry if _idx_seq changed meanwhile. On a single core, a reader seeing
+ * _idx_seq odd has preempted the writer and would wait forever, so it
+ * falls back to the search under the interface's mutex instead. */
+#define IDX_SLOTS       (GNRC_NETIF_NUMOF * GNRC_IPV6_NETIF_ADDR_NUMOF)
+#define IDX_TRIES       (2U)
+
+#if IDX_SLOTS > UINT8_MAX
+#error "gnrc_ipv6_netif: too many addresses for the address index"
+#endif
+#if (GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS & (GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS - 1)) != 0
+#error "gnrc_ipv6_netif: GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS must be a power of 2"
+#endif
+
+/* keeps the compiler from moving accesses to the index across it */
+#define IDX_BARRIER()   __asm__ volatile ("" : : : "memory")
+
+static mutex_t _idx_lock = MUTEX_INIT;
+static volatile unsigned _idx_seq;
+static uint8_t _idx_buckets[GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS];
+static uint8_t _idx_next[IDX_SLOTS];
+
+static inline unsigned _idx_bucket(const ipv6_addr_t *addr)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    /* Fibonacci hashing, the middle bits depend on all of the input */
+    return ((hash * 0x9e3779b1UL) >> 16) & (GNRC_IPV6_NETIF_ADDR_IDX_BUCKETS - 1);
+}
+
+static inline gnrc_ipv6_netif_addr_t *_idx_addr(unsigned ref)
+{
+    return &ipv6_ifs[(ref - 1) / GNRC_IPV6_NETIF_ADDR_NUMOF]
+           .addrs[(ref - 1) % GNRC_IPV6_NETIF_ADDR_NUMOF];
+}
+
+static inline unsigned _idx_ref(gnrc_ipv6_netif_t *entry,
+                                gnrc_ipv6_netif_addr_t *addr)
+{
+    return ((entry - ipv6_ifs) * GNRC_IPV6_NETIF_ADDR_NUMOF) +
+           (addr - entry->addrs) + 1;
+}
+
+static void _idx_begin(void)
+{
+    mutex_lock(&_idx_lock);
+    _idx_seq++;
+    IDX_BARRIER();
+}
+
+static void _idx_end(void)
+{
+    IDX_BARRIER();
+    _idx_seq++;
+    mutex_unlock(&_idx_lock);
+}
+
+/* must be called between _idx_begin() and _idx_end() */
+static void _idx_link(gnrc_ipv6_netif_t *entry, gnrc_ipv6_netif_addr_t *addr)
+{
+    unsigned ref = _idx_ref(entry, addr);
+    uint8_t *bucket = &_idx_buckets[_idx_bucket(&addr->addr)];
+
+    _idx_next[ref - 1] = *bucket;
+    *bucket = ref;
+}
+
+/* must be called between _idx_begin() and _idx_end() */
+static void _idx_unlink(gnrc_ipv6_netif_t *entry, gnrc_ipv6_netif_addr_t *addr)
+{
+    unsigned ref = _idx_ref(entry, addr);
+    uint8_t *link = &_idx_buckets[_idx_bucket(&addr->addr)];
+
+    while (*link != 0) {
+        if (*link == ref) {
+            *link = _idx_next[ref - 1];
+            return;
+        }
+        link = &_idx_next[*link - 1];
+    }
+}
+
+/**
+ * @brief   Look up an address in the index
+ *
+ * @param[in] entry     only consider addresses of this interface, NULL for
+ *                      all interfaces
+ * @param[in] addr      address to look up
+ * @param[out] out      the address found, if it was on several interfaces
+ *                      the one on the first interface in ipv6_ifs
+ * @param[out] pid      the interface of @p out
+ *
+ * @return  true, if the index was read consistently
+ * @return  false, if a writer was interrupted, the caller must search under
+ *          the mutexes of the interfaces then
+ */
+static bool _idx_find(gnrc_ipv6_netif_t *entry, const ipv6_addr_t *addr,
+                      ipv6_addr_t **out, kernel_pid_t *pid)
+{
+    unsigned bucket = _idx_bucket(addr);
+
+    for (unsigned tries = 0; tries < IDX_TRIES; tries++) {
+        unsigned seq = _idx_seq;
+        unsigned res = 0;
+        unsigned steps = 0;
+
+        if (seq & 1) {
+            return false;
+        }
+        IDX_BARRIER();
+        /* a writer may change the chain under our feet, so it is walked for
+         * at most as many steps as there are nodes */
+        for (unsigned ref = _idx_buckets[bucket];
+             (ref != 0) && (steps < IDX_SLOTS);
+             ref = _idx_next[ref - 1], steps++) {
+            if (((entry == NULL) ||
+                 (((ref - 1) / GNRC_IPV6_NETIF_ADDR_NUMOF) ==
+                  (unsigned)(entry - ipv6_ifs))) &&
+                ((res == 0) || (ref < res)) &&
+                ipv6_addr_equal(&_idx_addr(ref)->addr, addr)) {
+                res = ref;
+            }
+        }
+        if (res != 0) {
+            *out = &_idx_addr(res)->addr;
+            *pid = ipv6_ifs[(res - 1) / GNRC_IPV6_NETIF_ADDR_NUMOF].pid;
+        }
+        else {
+            *out = NULL;
+            *pid = KERNEL_PID_UNDEF;
+        }
+        IDX_BARRIER();
+        if (_idx_seq == seq) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr_t *addr,
                                        uint8_t prefix_len, uint8_t flags)
 {
@@ -64,6 +207,8 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
+            /* the stack needs the group now, it stays when all users left */
+            entry->addrs[i].flags &= ~GNRC_IPV6_NETIF_ADDR_FLAGS_JOINED;
             return &(entry->addrs[i].addr);
         }
 
@@ -79,13 +224,17 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
         return NULL;
     }
 
+    _idx_begin();
     memcpy(&(tmp_addr->addr), addr, sizeof(ipv6_addr_t));
+    _idx_link(entry, tmp_addr);
+    _idx_end();
     DEBUG("ipv6 netif: Added %s/%" PRIu8 " to interface %" PRIkernel_pid "\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
           prefix_len, entry->pid);
 
     tmp_addr->prefix_len = prefix_len;
     tmp_addr->flags = flags;
+    tmp_addr->users = 0;
 
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
     if (!ipv6_addr_is_multicast(&(tmp_addr->addr)) &&
@@ -164,7 +313,14 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 static void _reset_addr_from_entry(gnrc_ipv6_netif_t *entry)
 {
     DEBUG("ipv6 netif: Reset IPv6 addresses on interface %" PRIkernel_pid "\n", entry->pid);
+    _idx_begin();
+    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
+        if (!ipv6_addr_is_unspecified(&(entry->addrs[i].addr))) {
+            _idx_unlink(entry, &entry->addrs[i]);
+        }
+    }
     memset(entry->addrs, 0, sizeof(entry->addrs));
+    _idx_end();
 }
 
 static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
@@ -320,8 +476,12 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
             DEBUG("ipv6 netif: Remove %s to interface %" PRIkernel_pid "\n",
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), entry->pid);
+            _idx_begin();
+            _idx_unlink(entry, &entry->addrs[i]);
             ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
+            _idx_end();
             entry->addrs[i].flags = 0;
+            entry->addrs[i].users = 0;
 #ifdef MODULE_GNRC_NDP_ROUTER
             /* Removal of prefixes MAY allow the router to retransmit up to
              * GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF unsolicited RA
@@ -382,8 +542,101 @@ void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid)
     mutex_unlock(&entry->mutex);
 }
 
+static gnrc_ipv6_netif_addr_t *_find_addr(gnrc_ipv6_netif_t *entry,
+                                          const ipv6_addr_t *addr)
+{
+    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
+        if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
+            return &entry->addrs[i];
+        }
+    }
+    return NULL;
+}
+
+int gnrc_ipv6_netif_join(kernel_pid_t pid, const ipv6_addr_t *group)
+{
+    gnrc_ipv6_netif_t *entry = gnrc_ipv6_netif_get(pid);
+    gnrc_ipv6_netif_addr_t *addr;
+    int res = 0;
+
+    if (!ipv6_addr_is_multicast(group)) {
+        return -EINVAL;
+    }
+    if (entry == NULL) {
+        return -ENOENT;
+    }
+
+    mutex_lock(&entry->mutex);
+
+    addr = _find_addr(entry, group);
+    if (addr == NULL) {
+        if (_add_addr_to_entry(entry, group, IPV6_ADDR_BIT_LEN,
+                               GNRC_IPV6_NETIF_ADDR_FLAGS_JOINED) == NULL) {
+            res = -ENOMEM;
+        }
+        else {
+            _find_addr(entry, group)->users = 1;
+        }
+    }
+    else if (addr->users == UINT8_MAX) {
+        res = -EOVERFLOW;
+    }
+    else {
+        addr->users++;
+    }
+
+    mutex_unlock(&entry->mutex);
+
+    return res;
+}
+
+int gnrc_ipv6_netif_leave(kernel_pid_t pid, const ipv6_addr_t *group)
+{
+    gnrc_ipv6_netif_t *entry = gnrc_ipv6_netif_get(pid);
+    gnrc_ipv6_netif_addr_t *addr;
+    int res = 0;
+
+    if (entry == NULL) {
+        return -ENOENT;
+    }
+
+    mutex_lock(&entry->mutex);
+
+    addr = _find_addr(entry, group);
+    if ((addr == NULL) || (addr->users == 0)) {
+        res = -ENOENT;
+    }
+    else if ((--addr->users == 0) &&
+             (addr->flags & GNRC_IPV6_NETIF_ADDR_FLAGS_JOINED)) {
+        DEBUG("ipv6 netif: Leave %s on interface %" PRIkernel_pid "\n",
+              ipv6_addr_to_str(addr_str, group, sizeof(addr_str)), entry->pid);
+        /* groups take no part in router advertisements, so there is nothing
+         * else to do but to remove the address */
+        _idx_begin();
+        _idx_unlink(entry, addr);
+        ipv6_addr_set_unspecified(&addr->addr);
+        _idx_end();
+        addr->flags = 0;
+    }
+
+    mutex_unlock(&entry->mutex);
+
+    return res;
+}
+
 kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *addr)
 {
+    ipv6_addr_t *res;
+    kernel_pid_t pid;
+
+    /* the index doesn't hold the unspecified address of free slots */
+    if (!ipv6_addr_is_unspecified(addr) && _idx_find(NULL, addr, &res, &pid)) {
+        if (out != NULL) {
+            *out = res;
+        }
+        return pid;
+    }
+
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         if (out != NULL) {
             *out = gnrc_ipv6_netif_find_addr(ipv6_ifs[i].pid, addr);
@@ -414,11 +667,18 @@ kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *
 ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr)
 {
     gnrc_ipv6_netif_t *entry = gnrc_ipv6_netif_get(pid);
+    ipv6_addr_t *res;
+    kernel_pid_t res_pid;
 
     if (entry == NULL) {
         return NULL;
     }
 
+    if (!ipv6_addr_is_unspecified(addr) &&
+        _idx_find(entry, addr, &res, &res_pid)) {
+        return res;
+    }
+
     mutex_lock(&entry->mutex);
 
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
@@ -436,6 +696,11 @@ ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr
     return NULL;
 }
 
+unsigned gnrc_ipv6_netif_addr_gen(void)
+{
+    return _idx_seq;
+}
+
 static uint8_t _find_by_prefix_unsafe(ipv6_addr_t **res, gnrc_ipv6_netif_t *iface,
                                       const ipv6_addr_t *addr, uint8_t *only)
 {
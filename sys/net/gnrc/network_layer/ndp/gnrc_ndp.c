@@ -66,8 +66,7 @@ static void _stale_nc(kernel_pid_t iface, ipv6_addr_t *ipaddr, uint8_t *l2addr,
         else if (((uint16_t)l2addr_len != nc_entry->l2_addr_len) ||
                  (memcmp(l2addr, nc_entry->l2_addr, l2addr_len) != 0)) {
             /* if entry exists but l2 address differs: set */
-            nc_entry->l2_addr_len = (uint16_t)l2addr_len;
-            memcpy(nc_entry->l2_addr, l2addr, l2addr_len);
+            gnrc_ipv6_nc_set_l2_addr(nc_entry, nc_entry->iface, l2addr, l2addr_len);
             gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_STALE);
         }
     }
@@ -279,9 +278,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 return;
             }
 
-            nc_entry->iface = iface;
-            nc_entry->l2_addr_len = l2tgt_len;
-            memcpy(nc_entry->l2_addr, l2tgt, l2tgt_len);
+            gnrc_ipv6_nc_set_l2_addr(nc_entry, iface, l2tgt, l2tgt_len);
 
             if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_S) {
                 gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_REACHABLE);
@@ -290,22 +287,12 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_STALE);
             }
 
-            if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) {
-                nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
-            }
-            else {
-                nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
-                /* TODO: update state of neighbor as router in FIB? */
-            }
+            /* TODO: update state of neighbor as router in FIB? */
+            gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_IS_ROUTER,
+                                   (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) ?
+                                   GNRC_IPV6_NC_IS_ROUTER : 0);
 #ifdef MODULE_GNRC_NDP_NODE
-            gnrc_pktqueue_t *queued_pkt;
-            while ((queued_pkt = gnrc_pktqueue_remove_head(&nc_entry->pkts)) != NULL) {
-                if (gnrc_netapi_send(gnrc_ipv6_pid, queued_pkt->pkt) < 1) {
-                    DEBUG("ndp: unable to send queued packet\n");
-                    gnrc_pktbuf_release(queued_pkt->pkt);
-                }
-                queued_pkt->pkt = NULL;
-            }
+            gnrc_ndp_node_send_queued(nc_entry);
 #endif
         }
         else {
@@ -326,9 +313,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             if ((nbr_adv->flags & NDP_NBR_ADV_FLAGS_O) || !l2tgt_changed ||
                 (l2tgt_len == 0)) {
                 if (l2tgt_len != 0) {
-                    nc_entry->iface = iface;
-                    nc_entry->l2_addr_len = l2tgt_len;
-                    memcpy(nc_entry->l2_addr, l2tgt, l2tgt_len);
+                    gnrc_ipv6_nc_set_l2_addr(nc_entry, iface, l2tgt, l2tgt_len);
                 }
 
                 if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_S) {
@@ -338,13 +323,10 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_STALE);
                 }
 
-                if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) {
-                    nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
-                }
-                else {
-                    nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
-                    /* TODO: update state of neighbor as router in FIB? */
-                }
+                /* TODO: update state of neighbor as router in FIB? */
+                gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_IS_ROUTER,
+                                       (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) ?
+                                       GNRC_IPV6_NC_IS_ROUTER : 0);
             }
             else if (l2tgt_changed &&
                      gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_REACHABLE) {
@@ -454,7 +436,7 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
         if (nc_entry != NULL) {
             /* unset isRouter flag
              * (https://tools.ietf.org/html/rfc4861#section-6.2.6) */
-            nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+            gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_IS_ROUTER, 0);
         }
     }
     /* otherwise ignore silently */
@@ -505,10 +487,10 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
         }
     }
     else if ((nc_entry->flags & GNRC_IPV6_NC_IS_ROUTER) && (byteorder_ntohs(rtr_adv->ltime) == 0)) {
-        nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+        gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_IS_ROUTER, 0);
     }
     else {
-        nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
+        gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_IS_ROUTER, GNRC_IPV6_NC_IS_ROUTER);
     }
     /* set router life timer */
     if (rtr_adv->ltime.u16 != 0) {
@@ -629,6 +611,19 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
 #endif
 }
 
+static void _retrans_nbr_sol_later(gnrc_ipv6_nc_t *nc_entry, uint32_t delay)
+{
+#ifdef MODULE_GNRC_NDP_NODE
+    /* address resolutions share one timer */
+    if (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE) {
+        gnrc_ndp_node_res_schedule(nc_entry, delay);
+        return;
+    }
+#endif
+    gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, delay,
+                                          GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
+}
+
 void gnrc_ndp_retrans_nbr_sol(gnrc_ipv6_nc_t *nc_entry)
 {
     if ((gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE) ||
@@ -658,18 +653,18 @@ void gnrc_ndp_retrans_nbr_sol(gnrc_ipv6_nc_t *nc_entry)
                     gnrc_ndp_internal_send_nbr_sol(ifs[i], NULL, &nc_entry->ipv6_addr, &dst);
                 }
 
-                gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, GNRC_NDP_RETRANS_TIMER,
-                                                      GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
+                _retrans_nbr_sol_later(nc_entry, GNRC_NDP_RETRANS_TIMER);
             }
             else {
                 gnrc_ipv6_netif_t *ipv6_iface = gnrc_ipv6_netif_get(nc_entry->iface);
+                uint32_t retrans_timer;
 
                 gnrc_ndp_internal_send_nbr_sol(nc_entry->iface, NULL, &nc_entry->ipv6_addr, &dst);
 
                 mutex_lock(&ipv6_iface->mutex);
-                gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, ipv6_iface->retrans_timer,
-                                                      GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
+                retrans_timer = ipv6_iface->retrans_timer;
                 mutex_unlock(&ipv6_iface->mutex);
+                _retrans_nbr_sol_later(nc_entry, retrans_timer);
             }
         }
         else if (nc_entry->probes_remaining <= 1) {
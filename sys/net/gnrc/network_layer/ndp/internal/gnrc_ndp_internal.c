@@ -93,8 +93,7 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
     gnrc_ipv6_netif_t *ipv6_iface;
     uint32_t t = GNRC_NDP_FIRST_PROBE_DELAY * US_PER_SEC;
 
-    nc_entry->flags &= ~GNRC_IPV6_NC_STATE_MASK;
-    nc_entry->flags |= state;
+    gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_STATE_MASK, state);
 
     DEBUG("ndp internal: set %s state to ",
           ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
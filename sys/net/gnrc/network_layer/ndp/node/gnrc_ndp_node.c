@@ -16,11 +16,15 @@
 #include <stdlib.h>
 
 #include "kernel_types.h"
+#include "memarray.h"
 #include "net/fib.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ndp.h"
+#include "net/gnrc/netapi.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pktqueue.h"
+#include "xtimer.h"
 
 #include "net/gnrc/ndp/internal.h"
 
@@ -33,26 +37,144 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static gnrc_pktqueue_t _pkt_nodes[GNRC_IPV6_NC_SIZE * 2];
+static gnrc_pktqueue_t _pkt_nodes[GNRC_NDP_NODE_QUEUE_SIZE];
+static memarray_t _pkt_pool = MEMARRAY_INIT(_pkt_nodes, GNRC_NDP_NODE_QUEUE_SIZE);
+static gnrc_ndp_node_stats_t _stats;
+
+/* one timer for the retransmissions of all address resolutions */
+static xtimer_t _res_timer;
+static msg_t _res_msg = { .type = GNRC_NDP_MSG_ADDR_RES_RETRANS };
+static uint32_t _res_next;
+static bool _res_armed;
+
+static inline bool _res_pending(const gnrc_ipv6_nc_t *nc_entry)
+{
+    return (nc_entry->res_deadline != 0) &&
+           (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE);
+}
+
+static void _res_arm(uint32_t deadline, uint32_t now)
+{
+    int32_t delay = (int32_t)(deadline - now);
+
+    if (_res_armed && ((int32_t)(deadline - _res_next) >= 0)) {
+        return;     /* an earlier event handles this deadline, too */
+    }
+    _res_next = deadline;
+    _res_armed = true;
+    xtimer_remove(&_res_timer);
+    xtimer_set_msg(&_res_timer, (delay > 0) ? (uint32_t)delay : 0, &_res_msg,
+                   gnrc_ipv6_pid);
+}
 
 /**
- * @brief   Allocates a node for the packet queue.
+ * @brief   Queues a packet until the link-layer address of a neighbor is
+ *          known.
  *
- * @param[in] pkt   Packet to add to the packet queue.
- *
- * @return  A packet queue node.
+ * @param[in] nc_entry  The neighbor.
+ * @param[in] pkt       Packet to queue, may be NULL.
  */
-static gnrc_pktqueue_t *_alloc_pkt_node(gnrc_pktsnip_t *pkt)
+static void _enqueue(gnrc_ipv6_nc_t *nc_entry, gnrc_pktsnip_t *pkt)
 {
-    for (size_t i = 0; i < sizeof(_pkt_nodes) / sizeof(gnrc_pktqueue_t); i++) {
-        if ((_pkt_nodes[i].pkt == NULL) && (_pkt_nodes[i].next == NULL)) {
-            _pkt_nodes[i].pkt = pkt;
+    gnrc_pktqueue_t *pkt_node;
+    unsigned queued = 0;
 
-            return &(_pkt_nodes[i]);
+    if (pkt == NULL) {
+        return;
+    }
+    LL_COUNT(nc_entry->pkts, pkt_node, queued);
+    if (queued >= GNRC_NDP_NODE_QUEUE_NBR_SIZE) {
+        /* replace the oldest packet of the neighbor */
+        pkt_node = gnrc_pktqueue_remove_head(&nc_entry->pkts);
+        gnrc_pktbuf_release(pkt_node->pkt);
+        _stats.dropped++;
+    }
+    else if ((pkt_node = memarray_alloc(&_pkt_pool)) == NULL) {
+        DEBUG("ndp node: could not add packet to packet queue\n");
+        _stats.dropped++;
+        return;
+    }
+    pkt_node->pkt = pkt;
+    /* prevent packet from being released by IPv6 */
+    gnrc_pktbuf_hold(pkt, 1);
+    gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
+    _stats.queued++;
+}
+
+void gnrc_ndp_node_res_schedule(gnrc_ipv6_nc_t *nc_entry, uint32_t delay)
+{
+    uint32_t now = xtimer_now_usec();
+
+    /* 0 marks no retransmission as scheduled */
+    nc_entry->res_deadline = (now + delay) ? (now + delay) : 1;
+    _res_arm(nc_entry->res_deadline, now);
+}
+
+void gnrc_ndp_node_res_timeout(void)
+{
+    uint32_t now = xtimer_now_usec();
+    gnrc_ipv6_nc_t *nc_entry = NULL;
+
+    _res_armed = false;
+    while ((nc_entry = gnrc_ipv6_nc_get_next(nc_entry)) != NULL) {
+        if (_res_pending(nc_entry) &&
+            ((int32_t)(nc_entry->res_deadline - now) <= (int32_t)GNRC_NDP_NODE_RES_SLACK)) {
+            nc_entry->res_deadline = 0;
+            if (nc_entry->probes_remaining <= 1) {
+                _stats.failed++;
+            }
+            /* reschedules the entry or removes it */
+            gnrc_ndp_retrans_nbr_sol(nc_entry);
+        }
+    }
+    /* wait for the earliest of the resolutions left */
+    nc_entry = NULL;
+    while ((nc_entry = gnrc_ipv6_nc_get_next(nc_entry)) != NULL) {
+        if (_res_pending(nc_entry)) {
+            _res_arm(nc_entry->res_deadline, now);
         }
     }
+}
+
+void gnrc_ndp_node_send_queued(gnrc_ipv6_nc_t *nc_entry)
+{
+    gnrc_pktqueue_t *pkt_node;
+
+    if (nc_entry->res_deadline != 0) {
+        uint32_t res_time = xtimer_now_usec() - nc_entry->res_start;
+
+        nc_entry->res_deadline = 0;
+        _stats.resolved++;
+        _stats.res_time_sum += res_time;
+        if (res_time > _stats.res_time_max) {
+            _stats.res_time_max = res_time;
+        }
+    }
+    /* called by the IPv6 thread: a whole queue would overflow its message
+     * queue, so send the packets right away */
+    while ((pkt_node = gnrc_pktqueue_remove_head(&nc_entry->pkts)) != NULL) {
+        gnrc_pktsnip_t *pkt = pkt_node->pkt;
+
+        memarray_free(&_pkt_pool, pkt_node);
+        _stats.sent++;
+        gnrc_ipv6_send(pkt);
+    }
+}
+
+void gnrc_ndp_node_drop_queued(gnrc_ipv6_nc_t *nc_entry)
+{
+    gnrc_pktqueue_t *pkt_node;
 
-    return NULL;
+    while ((pkt_node = gnrc_pktqueue_remove_head(&nc_entry->pkts)) != NULL) {
+        gnrc_pktbuf_release(pkt_node->pkt);
+        _stats.dropped++;
+        memarray_free(&_pkt_pool, pkt_node);
+    }
+}
+
+gnrc_ndp_node_stats_t *gnrc_ndp_node_get_stats(void)
+{
+    return &_stats;
 }
 
 kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
@@ -125,27 +247,22 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
         return gnrc_ipv6_nc_get_l2_addr(l2addr, l2addr_len, nc_entry);
     }
     else if (nc_entry == NULL) {
-        gnrc_pktqueue_t *pkt_node;
         ipv6_addr_t dst_sol;
+        uint32_t retrans_timer = GNRC_NDP_RETRANS_TIMER;
 
         nc_entry = gnrc_ipv6_nc_add(iface, next_hop_ip, NULL, 0,
                                     GNRC_IPV6_NC_STATE_INCOMPLETE << GNRC_IPV6_NC_STATE_POS);
 
         if (nc_entry == NULL) {
             DEBUG("ndp node: could not create neighbor cache entry\n");
+            if (pkt != NULL) {
+                _stats.dropped++;
+            }
             return KERNEL_PID_UNDEF;
         }
 
-        pkt_node = _alloc_pkt_node(pkt);
-
-        if (pkt_node == NULL) {
-            DEBUG("ndp node: could not add packet to packet queue\n");
-        }
-        else {
-            /* prevent packet from being released by IPv6 */
-            gnrc_pktbuf_hold(pkt_node->pkt, 1);
-            gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
-        }
+        nc_entry->res_start = xtimer_now_usec();
+        _enqueue(nc_entry, pkt);
 
         /* address resolution */
         ipv6_addr_set_solicited_nodes(&dst_sol, next_hop_ip);
@@ -157,9 +274,6 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             for (size_t i = 0; i < ifnum; i++) {
                 gnrc_ndp_internal_send_nbr_sol(ifs[i], NULL, next_hop_ip, &dst_sol);
             }
-
-            gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, GNRC_NDP_RETRANS_TIMER,
-                                                  GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
         }
         else {
             gnrc_ipv6_netif_t *ipv6_iface = gnrc_ipv6_netif_get(iface);
@@ -167,10 +281,14 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             gnrc_ndp_internal_send_nbr_sol(iface, NULL, next_hop_ip, &dst_sol);
 
             mutex_lock(&ipv6_iface->mutex);
-            gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, ipv6_iface->retrans_timer,
-                                                  GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
+            retrans_timer = ipv6_iface->retrans_timer;
             mutex_unlock(&ipv6_iface->mutex);
         }
+        gnrc_ndp_node_res_schedule(nc_entry, retrans_timer);
+    }
+    else if (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE) {
+        /* address resolution is already under way */
+        _enqueue(nc_entry, pkt);
     }
 
     return KERNEL_PID_UNDEF;
@@ -16,6 +16,7 @@
 #include <stdbool.h>
 
 #include "rbuf.h"
+#include "memarray.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -43,6 +44,7 @@
 #endif
 
 static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+static memarray_t rbuf_int_mem = MEMARRAY_INIT(rbuf_int, RBUF_INT_SIZE);
 
 static rbuf_t rbuf[RBUF_SIZE];
 
@@ -55,8 +57,6 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
  * ------------------------------------*/
 /* checks whether start and end overlaps, but not identical to, given interval i */
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
 /* update interval buffer of entry */
@@ -196,25 +196,12 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
         ((start != i->start) || (end != i->end)); /* not identical */
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
-
-    return NULL;
-}
-
 static void _rbuf_rem(rbuf_t *entry)
 {
     while (entry->ints != NULL) {
         rbuf_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        memarray_free(&rbuf_int_mem, entry->ints);
         entry->ints = next;
     }
 
@@ -226,7 +213,7 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
     rbuf_int_t *new;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
-    new = _rbuf_int_get_free();
+    new = memarray_alloc(&rbuf_int_mem);
 
     if (new == NULL) {
         DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
@@ -23,6 +23,9 @@
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
+#ifdef MODULE_NETSTATS_LATENCY
+#include "net/netstats/latency.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -163,6 +166,9 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_RX_SIXLOWPAN);
+#endif
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("6lo: No receivers for this packet found\n");
         gnrc_pktbuf_release(pkt);
@@ -264,6 +270,9 @@ static void _send(gnrc_pktsnip_t *pkt)
     if (gnrc_pkt_len(pkt2->next) <= iface->max_frag_size) {
         DEBUG("6lo: Send SND command for %p to %" PRIu16 "\n",
               (void *)pkt2, hdr->if_pid);
+#ifdef MODULE_NETSTATS_LATENCY
+        netstats_lat_stamp(pkt2, NETSTATS_LAT_TX_SIXLOWPAN);
+#endif
         if (gnrc_netapi_send(hdr->if_pid, pkt2) < 1) {
             DEBUG("6lo: unable to send %p over %" PRIu16 "\n", (void *)pkt, hdr->if_pid);
             gnrc_pktbuf_release(pkt2);
@@ -22,6 +22,7 @@
 #include "random.h"
 
 #include "net/gnrc/sixlowpan/nd.h"
+#include "net/gnrc/sixlowpan/nd/router.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -142,7 +143,9 @@ kernel_pid_t gnrc_sixlowpan_nd_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
     /* next hop determination: https://tools.ietf.org/html/rfc6775#section-6.5.4 */
-    nc_entry = gnrc_ipv6_nc_get(iface, dst);
+    if ((nc_entry = gnrc_sixlowpan_nd_router_reg_get(iface, dst)) == NULL) {
+        nc_entry = gnrc_ipv6_nc_get(iface, dst);
+    }
 #ifdef MODULE_FIB
     if ((next_hop != NULL) && (nc_entry == NULL)) {
         nc_entry = gnrc_ipv6_nc_get(fib_iface, dst);
@@ -270,7 +273,14 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
         return 0;
     }
     ipv6_iface = gnrc_ipv6_netif_get(iface);
+#ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
+    /* on a router most addresses asked for are registered ones */
+    if ((nc_entry = gnrc_sixlowpan_nd_router_reg_get(iface, addr)) == NULL) {
+        nc_entry = gnrc_ipv6_nc_get(iface, addr);
+    }
+#else
     nc_entry = gnrc_ipv6_nc_get(iface, addr);
+#endif
     switch (icmpv6_type) {
         case ICMPV6_NBR_ADV:
             if (!(ipv6_iface->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN)) {
@@ -344,21 +354,18 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
             }
             else if (ar_opt->ltime.u16 != 0) {
                 /* TODO: multihop DAD behavior */
-                uint16_t reg_ltime;
                 if (nc_entry == NULL) {
                     if ((nc_entry = gnrc_ipv6_nc_add(iface, &ipv6->src, sl2a, sl2a_len,
                                                      GNRC_IPV6_NC_STATE_STALE)) == NULL) {
                         DEBUG("6lo nd: neighbor cache is full\n");
                         return SIXLOWPAN_ND_STATUS_NC_FULL;
                     }
-                    nc_entry->eui64 = ar_opt->eui64;
                 }
-                nc_entry->flags &= ~GNRC_IPV6_NC_TYPE_MASK;
-                nc_entry->flags |= GNRC_IPV6_NC_TYPE_REGISTERED;
-                reg_ltime = byteorder_ntohs(ar_opt->ltime);
+                gnrc_ipv6_nc_set_flags(nc_entry, GNRC_IPV6_NC_TYPE_MASK,
+                                       GNRC_IPV6_NC_TYPE_REGISTERED);
                 /* TODO: notify routing protocol */
-                xtimer_set_msg(&nc_entry->type_timeout, (reg_ltime * 60 * US_PER_SEC),
-                               &nc_entry->type_timeout_msg, gnrc_ipv6_pid);
+                gnrc_sixlowpan_nd_router_reg_add(nc_entry, &ar_opt->eui64,
+                                                 byteorder_ntohs(ar_opt->ltime));
             }
             break;
 #endif
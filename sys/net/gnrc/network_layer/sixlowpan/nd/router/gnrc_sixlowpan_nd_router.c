@@ -14,6 +14,7 @@
 
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ndp.h"
+#include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/icmpv6.h"
@@ -25,6 +26,194 @@
 static gnrc_sixlowpan_nd_router_abr_t _abrs[GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF];
 static gnrc_sixlowpan_nd_router_prf_t _prefixes[GNRC_SIXLOWPAN_ND_ROUTER_ABR_PRF_NUMOF];
 
+#if (GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS & (GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS - 1)) != 0
+#error "gnrc_sixlowpan_nd_router: GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS must be a power of 2"
+#endif
+#if (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL - 1)) != 0
+#error "gnrc_sixlowpan_nd_router: GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL must be a power of 2"
+#endif
+
+/* Address registration table: the registered neighbor cache entries are
+ * chained into hash buckets by address and by EUI-64, and into the slot of a
+ * timer wheel in which their lifetime runs out. The wheel advances one slot
+ * per tick, only while there are registrations. All of this runs in the IPv6
+ * thread. */
+static gnrc_ipv6_nc_t *_reg_addrs[GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS];
+static gnrc_ipv6_nc_t *_reg_eui64s[GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS];
+static gnrc_ipv6_nc_t *_reg_wheel[GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL];
+static unsigned _reg_now;
+static unsigned _reg_numof;
+static bool _reg_ticking;
+static xtimer_t _reg_timer;
+static msg_t _reg_msg = { .type = GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT };
+
+static inline unsigned _reg_hash(uint32_t hash)
+{
+    /* Fibonacci hashing, the middle bits depend on all of the input */
+    return ((hash * 0x9e3779b1UL) >> 16) & (GNRC_SIXLOWPAN_ND_ROUTER_REG_BUCKETS - 1);
+}
+
+static inline gnrc_ipv6_nc_t **_reg_addr_bucket(const ipv6_addr_t *addr)
+{
+    /* registered addresses mostly differ in their interface identifier */
+    return &_reg_addrs[_reg_hash(addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                                 addr->u32[2].u32 ^ addr->u32[3].u32)];
+}
+
+static inline gnrc_ipv6_nc_t **_reg_eui64_bucket(const eui64_t *eui64)
+{
+    uint64_t u64 = eui64->uint64.u64;
+
+    return &_reg_eui64s[_reg_hash((uint32_t)(u64 ^ (u64 >> 32)))];
+}
+
+static void _reg_unlink(gnrc_ipv6_nc_t **bucket, gnrc_ipv6_nc_t *nc_entry,
+                        size_t next_offset)
+{
+    while (*bucket != NULL) {
+        gnrc_ipv6_nc_t **next = (gnrc_ipv6_nc_t **)((uint8_t *)*bucket + next_offset);
+
+        if (*bucket == nc_entry) {
+            *bucket = *next;
+            return;
+        }
+        bucket = next;
+    }
+}
+
+static void _reg_wheel_remove(gnrc_ipv6_nc_t *nc_entry)
+{
+    if (nc_entry->reg_prev_timer != NULL) {
+        nc_entry->reg_prev_timer->reg_next_timer = nc_entry->reg_next_timer;
+    }
+    else {
+        _reg_wheel[nc_entry->reg_slot - 1] = nc_entry->reg_next_timer;
+    }
+    if (nc_entry->reg_next_timer != NULL) {
+        nc_entry->reg_next_timer->reg_prev_timer = nc_entry->reg_prev_timer;
+    }
+}
+
+static void _reg_wheel_add(gnrc_ipv6_nc_t *nc_entry, uint16_t ltime)
+{
+    /* one more tick, since the current one started already */
+    uint32_t ticks = (((uint64_t)ltime * 60U * US_PER_SEC) +
+                      GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK - 1) /
+                     GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK + 1;
+    unsigned slot = (_reg_now + ticks) & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL - 1);
+
+    nc_entry->reg_slot = slot + 1;
+    nc_entry->reg_rounds = (ticks - 1) / GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL;
+    nc_entry->reg_prev_timer = NULL;
+    nc_entry->reg_next_timer = _reg_wheel[slot];
+    if (_reg_wheel[slot] != NULL) {
+        _reg_wheel[slot]->reg_prev_timer = nc_entry;
+    }
+    _reg_wheel[slot] = nc_entry;
+}
+
+void gnrc_sixlowpan_nd_router_reg_add(gnrc_ipv6_nc_t *nc_entry, const eui64_t *eui64,
+                                      uint16_t ltime)
+{
+    gnrc_ipv6_nc_t **bucket;
+
+    if (nc_entry->reg_slot != 0) {
+        /* refresh: only the lifetime, and maybe the EUI-64, change */
+        _reg_wheel_remove(nc_entry);
+        if (nc_entry->eui64.uint64.u64 != eui64->uint64.u64) {
+            _reg_unlink(_reg_eui64_bucket(&nc_entry->eui64), nc_entry,
+                        offsetof(gnrc_ipv6_nc_t, reg_next_eui64));
+            nc_entry->eui64 = *eui64;
+            bucket = _reg_eui64_bucket(eui64);
+            nc_entry->reg_next_eui64 = *bucket;
+            *bucket = nc_entry;
+        }
+        _reg_wheel_add(nc_entry, ltime);
+        return;
+    }
+    nc_entry->eui64 = *eui64;
+    bucket = _reg_addr_bucket(&nc_entry->ipv6_addr);
+    nc_entry->reg_next_addr = *bucket;
+    *bucket = nc_entry;
+    bucket = _reg_eui64_bucket(eui64);
+    nc_entry->reg_next_eui64 = *bucket;
+    *bucket = nc_entry;
+    _reg_wheel_add(nc_entry, ltime);
+    if (_reg_numof++ == 0 && !_reg_ticking) {
+        _reg_ticking = true;
+        xtimer_set_msg(&_reg_timer, GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK, &_reg_msg,
+                       gnrc_ipv6_pid);
+    }
+}
+
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_ipv6_nc_t *nc_entry)
+{
+    if (nc_entry->reg_slot == 0) {
+        return;
+    }
+    _reg_wheel_remove(nc_entry);
+    _reg_unlink(_reg_addr_bucket(&nc_entry->ipv6_addr), nc_entry,
+                offsetof(gnrc_ipv6_nc_t, reg_next_addr));
+    _reg_unlink(_reg_eui64_bucket(&nc_entry->eui64), nc_entry,
+                offsetof(gnrc_ipv6_nc_t, reg_next_eui64));
+    nc_entry->reg_slot = 0;
+    _reg_numof--;
+}
+
+gnrc_ipv6_nc_t *gnrc_sixlowpan_nd_router_reg_get(kernel_pid_t iface, const ipv6_addr_t *addr)
+{
+    for (gnrc_ipv6_nc_t *nc_entry = *_reg_addr_bucket(addr); nc_entry != NULL;
+         nc_entry = nc_entry->reg_next_addr) {
+        if (((iface == KERNEL_PID_UNDEF) || (iface == nc_entry->iface)) &&
+            ipv6_addr_equal(&nc_entry->ipv6_addr, addr)) {
+            return nc_entry;
+        }
+    }
+    return NULL;
+}
+
+gnrc_ipv6_nc_t *gnrc_sixlowpan_nd_router_reg_get_by_eui64(const eui64_t *eui64,
+                                                          gnrc_ipv6_nc_t *prev)
+{
+    gnrc_ipv6_nc_t *nc_entry = (prev == NULL) ? *_reg_eui64_bucket(eui64) :
+                               prev->reg_next_eui64;
+
+    for (; nc_entry != NULL; nc_entry = nc_entry->reg_next_eui64) {
+        if (nc_entry->eui64.uint64.u64 == eui64->uint64.u64) {
+            return nc_entry;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_nd_router_reg_tick(void)
+{
+    gnrc_ipv6_nc_t *nc_entry, *next;
+
+    _reg_now = (_reg_now + 1) & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL - 1);
+    for (nc_entry = _reg_wheel[_reg_now]; nc_entry != NULL; nc_entry = next) {
+        next = nc_entry->reg_next_timer;
+        if (nc_entry->reg_rounds > 0) {
+            nc_entry->reg_rounds--;
+            continue;
+        }
+        gnrc_sixlowpan_nd_router_reg_remove(nc_entry);
+        gnrc_sixlowpan_nd_router_gc_nc(nc_entry);
+    }
+    if (_reg_numof > 0) {
+        xtimer_set_msg(&_reg_timer, GNRC_SIXLOWPAN_ND_ROUTER_REG_TICK, &_reg_msg,
+                       gnrc_ipv6_pid);
+    }
+    else {
+        _reg_ticking = false;
+    }
+}
+
+unsigned gnrc_sixlowpan_nd_router_reg_numof(void)
+{
+    return _reg_numof;
+}
+
 static gnrc_sixlowpan_nd_router_abr_t *_get_abr(ipv6_addr_t *addr)
 {
     gnrc_sixlowpan_nd_router_abr_t *abr = NULL;
@@ -78,6 +78,10 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+#ifdef MODULE_NETSTATS_LATENCY
+    pkt->lat_time = 0;
+    pkt->lat_stage = 0;
+#endif
 }
 
 void gnrc_pktbuf_init(void)
@@ -262,6 +266,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
         if (new != NULL) {
             pkt->users--;
+#ifdef MODULE_NETSTATS_LATENCY
+            new->lat_time = pkt->lat_time;
+            new->lat_stage = pkt->lat_stage;
+#endif
         }
         mutex_unlock(&_mutex);
         return new;
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktcap
+ * @{
+ *
+ * @file
+ * @brief       Packet capture ring and its pcapng export
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktcap.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define PCAPNG_SHB              (0x0a0d0d0aUL)  /**< section header block */
+#define PCAPNG_IDB              (0x00000001UL)  /**< interface description block */
+#define PCAPNG_EPB              (0x00000006UL)  /**< enhanced packet block */
+#define PCAPNG_BYTE_ORDER       (0x1a2b3c4dUL)
+#define PCAPNG_OPT_EPB_FLAGS    (2U)
+
+/* directions as in the epb_flags option */
+#define DIR_RX                  (0x1U)
+#define DIR_TX                  (0x2U)
+
+#define PAD4(len)               (((len) + 3U) & ~3U)
+
+/* link types, see http://www.tcpdump.org/linktypes.html */
+#define LINKTYPE_RAW            (101U)
+#define LINKTYPE_USER0          (147U)
+#define LINKTYPE_UPPER_PDU      (252U)  /* Wireshark's exported PDU */
+
+/* interfaces of an exported section, one per link type */
+enum {
+    IF_RAW = 0,                 /* IPv6 */
+    IF_SIXLOWPAN,               /* 6LoWPAN as exported PDU */
+    IF_OTHER,                   /* everything else */
+    IF_NUMOF
+};
+
+/* all blocks are written in host byte order, the byte order magic tells
+ * readers which one that is */
+typedef struct {
+    uint32_t type;
+    uint32_t len;
+    uint32_t byte_order;
+    uint16_t major;
+    uint16_t minor;
+    uint32_t section_len[2];
+    uint32_t len_end;
+} _shb_t;
+
+typedef struct {
+    uint32_t type;
+    uint32_t len;
+    uint16_t linktype;
+    uint16_t reserved;
+    uint32_t snaplen;
+    uint32_t len_end;
+} _idb_t;
+
+typedef struct {
+    uint32_t type;
+    uint32_t len;
+    uint32_t if_id;
+    uint32_t ts_high;
+    uint32_t ts_low;
+    uint32_t caplen;
+    uint32_t len_orig;
+} _epb_t;
+
+typedef struct {
+    uint16_t flags_code;
+    uint16_t flags_len;
+    uint32_t flags;
+    uint32_t end_of_opts;
+    uint32_t len_end;
+} _epb_tail_t;
+
+/* header of a packet in the ring, followed by the captured bytes padded to a
+ * multiple of 4 */
+typedef struct {
+    uint64_t time;
+    uint16_t len;
+    uint16_t caplen;
+    uint8_t dir;
+    uint8_t type;
+    uint8_t reserved[2];
+} _rec_t;
+
+static const uint8_t _zero[3];
+static const uint16_t _linktypes[IF_NUMOF] = {
+    LINKTYPE_RAW, LINKTYPE_UPPER_PDU, LINKTYPE_USER0
+};
+/* exported PDU tags in front of each 6LoWPAN packet: the name of the
+ * dissector, padded to a multiple of 4, and the end of the tags */
+static const uint8_t _sixlowpan_tags[] = {
+    0x00, 0x0c, 0x00, 0x08, '6', 'l', 'o', 'w', 'p', 'a', 'n', 0x00,
+    0x00, 0x00, 0x00, 0x00
+};
+static uint8_t _ring[GNRC_PKTCAP_BUFSIZE];
+/* free-running positions of the producers and the consumer */
+static unsigned _head, _tail;
+static mutex_t _lock = MUTEX_INIT;
+static bool _on;
+static uint16_t _snaplen = GNRC_PKTCAP_SNAPLEN;
+static uint32_t _filter = GNRC_PKTCAP_NETTYPE_ALL;
+static gnrc_pktcap_stats_t _stats;
+
+static void _put(unsigned pos, const void *data, size_t len)
+{
+    unsigned off = pos & (GNRC_PKTCAP_BUFSIZE - 1);
+    size_t part = GNRC_PKTCAP_BUFSIZE - off;
+
+    if (part > len) {
+        part = len;
+    }
+    memcpy(&_ring[off], data, part);
+    memcpy(_ring, (const uint8_t *)data + part, len - part);
+}
+
+static void _get(unsigned pos, void *data, size_t len)
+{
+    unsigned off = pos & (GNRC_PKTCAP_BUFSIZE - 1);
+    size_t part = GNRC_PKTCAP_BUFSIZE - off;
+
+    if (part > len) {
+        part = len;
+    }
+    memcpy(data, &_ring[off], part);
+    memcpy((uint8_t *)data + part, _ring, len - part);
+}
+
+static int _write_ring(gnrc_pktcap_write_t write, void *arg, unsigned pos, size_t len)
+{
+    unsigned off = pos & (GNRC_PKTCAP_BUFSIZE - 1);
+    size_t part = GNRC_PKTCAP_BUFSIZE - off;
+    int res;
+
+    if (part >= len) {
+        return write(arg, &_ring[off], len);
+    }
+    if ((res = write(arg, &_ring[off], part)) < 0) {
+        return res;
+    }
+    return write(arg, _ring, len - part);
+}
+
+/* copies the first bytes of the packet, which may span several snips, if
+ * the ring has room for them */
+static void _capture(gnrc_pktsnip_t *pkt, size_t len, uint8_t dir,
+                     gnrc_nettype_t type)
+{
+    _rec_t rec;
+    unsigned pos;
+    size_t left;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.time = xtimer_now_usec64();
+    rec.len = len;
+    rec.caplen = (len < _snaplen) ? len : _snaplen;
+    rec.dir = dir;
+    rec.type = type;
+
+    mutex_lock(&_lock);
+    if ((GNRC_PKTCAP_BUFSIZE - (_head - _tail)) < (sizeof(rec) + PAD4(rec.caplen))) {
+        _stats.dropped++;
+        mutex_unlock(&_lock);
+        return;
+    }
+    pos = _head;
+    _put(pos, &rec, sizeof(rec));
+    pos += sizeof(rec);
+    for (left = rec.caplen; (pkt != NULL) && (left > 0); pkt = pkt->next) {
+        size_t part = (pkt->size < left) ? pkt->size : left;
+
+        _put(pos, pkt->data, part);
+        pos += part;
+        left -= part;
+    }
+    _put(pos, _zero, PAD4(rec.caplen) - rec.caplen);
+    _head += sizeof(rec) + PAD4(rec.caplen);
+    _stats.captured++;
+    mutex_unlock(&_lock);
+}
+
+void gnrc_pktcap_enable(bool on)
+{
+    _on = on;
+}
+
+bool gnrc_pktcap_enabled(void)
+{
+    return _on;
+}
+
+void gnrc_pktcap_set_snaplen(uint16_t snaplen)
+{
+    _snaplen = (snaplen < GNRC_PKTCAP_SNAPLEN) ? snaplen : GNRC_PKTCAP_SNAPLEN;
+}
+
+void gnrc_pktcap_set_filter(uint32_t nettypes)
+{
+    _filter = nettypes;
+}
+
+void gnrc_pktcap_rx(gnrc_pktsnip_t *pkt)
+{
+    /* the first snip is the payload, the link layer header and the netif
+     * header follow */
+    if (!_on || (pkt->type < 0) || !(_filter & GNRC_PKTCAP_NETTYPE(pkt->type))) {
+        return;
+    }
+    _capture(pkt, pkt->size, DIR_RX, pkt->type);
+}
+
+void gnrc_pktcap_tx(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *payload = pkt->next;
+
+    if (!_on || (pkt->type != GNRC_NETTYPE_NETIF) || (payload == NULL) ||
+        (payload->type < 0) || !(_filter & GNRC_PKTCAP_NETTYPE(payload->type))) {
+        return;
+    }
+    _capture(payload, gnrc_pkt_len(payload), DIR_TX, payload->type);
+}
+
+static unsigned _iface(uint8_t type)
+{
+    switch (type) {
+#ifdef MODULE_GNRC_IPV6
+        case GNRC_NETTYPE_IPV6:
+            return IF_RAW;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN
+        case GNRC_NETTYPE_SIXLOWPAN:
+            return IF_SIXLOWPAN;
+#endif
+        default:
+            return IF_OTHER;
+    }
+}
+
+int gnrc_pktcap_export(gnrc_pktcap_write_t write, void *arg)
+{
+    _shb_t shb = {
+        .type = PCAPNG_SHB, .len = sizeof(_shb_t), .byte_order = PCAPNG_BYTE_ORDER,
+        .major = 1, .minor = 0, .section_len = { UINT32_MAX, UINT32_MAX },
+        .len_end = sizeof(_shb_t)
+    };
+    _idb_t idb = {
+        .type = PCAPNG_IDB, .len = sizeof(_idb_t), .len_end = sizeof(_idb_t)
+    };
+    _epb_tail_t tail = {
+        .flags_code = PCAPNG_OPT_EPB_FLAGS, .flags_len = sizeof(tail.flags)
+    };
+    /* interface IDs are given in the order the link types first occur */
+    int if_ids[IF_NUMOF] = { -1, -1, -1 };
+    unsigned head, pos = _tail, if_num = 0;
+    int res, num = 0;
+
+    if ((res = write(arg, (uint8_t *)&shb, sizeof(shb))) < 0) {
+        return res;
+    }
+    mutex_lock(&_lock);
+    head = _head;
+    mutex_unlock(&_lock);
+
+    while (pos != head) {
+        _epb_t epb;
+        _rec_t rec;
+        unsigned padded, iface, prefix;
+
+        _get(pos, &rec, sizeof(rec));
+        padded = PAD4(rec.caplen);
+        iface = _iface(rec.type);
+        prefix = (iface == IF_SIXLOWPAN) ? sizeof(_sixlowpan_tags) : 0;
+        if (if_ids[iface] < 0) {
+            idb.linktype = _linktypes[iface];
+            idb.snaplen = _snaplen + prefix;
+            if ((res = write(arg, (uint8_t *)&idb, sizeof(idb))) < 0) {
+                return res;
+            }
+            if_ids[iface] = if_num++;
+        }
+        epb.type = PCAPNG_EPB;
+        epb.len = sizeof(epb) + prefix + padded + sizeof(tail);
+        epb.if_id = if_ids[iface];
+        epb.ts_high = rec.time >> 32;
+        epb.ts_low = rec.time & UINT32_MAX;
+        epb.caplen = prefix + rec.caplen;
+        epb.len_orig = prefix + rec.len;
+        tail.flags = rec.dir;
+        tail.len_end = epb.len;
+        if (((res = write(arg, (uint8_t *)&epb, sizeof(epb))) < 0) ||
+            ((prefix > 0) && ((res = write(arg, _sixlowpan_tags, prefix)) < 0)) ||
+            ((res = _write_ring(write, arg, pos + sizeof(rec), padded)) < 0) ||
+            ((res = write(arg, (uint8_t *)&tail, sizeof(tail))) < 0)) {
+            return res;
+        }
+        pos += sizeof(rec) + padded;
+        num++;
+        /* make room for new packets right away */
+        mutex_lock(&_lock);
+        _tail = pos;
+        mutex_unlock(&_lock);
+    }
+    DEBUG("gnrc_pktcap: exported %d packets\n", num);
+    return num;
+}
+
+const gnrc_pktcap_stats_t *gnrc_pktcap_get_stats(void)
+{
+    return &_stats;
+}
@@ -21,6 +21,9 @@
 #include "mutex.h"
 
 #include "net/gnrc/rpl.h"
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh_root.h"
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -119,6 +122,10 @@ gnrc_rpl_instance_t *gnrc_rpl_root_init(uint8_t instance_id, ipv6_addr_t *dodag_
 #ifndef GNRC_RPL_WITHOUT_PIO
     dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+    /* routes of a previous DODAG are void */
+    gnrc_rpl_srh_root_reset();
+#endif
 
     trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_INTERVAL,
                   GNRC_RPL_MSG_TYPE_TRICKLE_CALLBACK, (1 << dodag->dio_min),
@@ -295,6 +302,10 @@ void _update_lifetime(void)
         }
     }
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+    gnrc_rpl_srh_root_expire((uint32_t)(xtimer_now_usec64() / US_PER_SEC));
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
     gnrc_rpl_p2p_update();
 #endif
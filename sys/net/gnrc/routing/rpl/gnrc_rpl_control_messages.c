@@ -32,6 +32,10 @@
 #include "gnrc_rpl_internal/validation.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+#include "net/gnrc/rpl/srh_root.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -306,6 +310,26 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+static void _srh_root_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                             gnrc_rpl_opt_transit_t *transit)
+{
+    ipv6_addr_t *parent = (ipv6_addr_t *) (transit + 1);
+
+    if (transit->path_lifetime == 0) {
+        gnrc_rpl_srh_root_remove(&target->target);
+        return;
+    }
+    /* children of the root have no parent in the source route graph */
+    if (gnrc_ipv6_netif_find_by_addr(NULL, parent) != KERNEL_PID_UNDEF) {
+        parent = NULL;
+    }
+    gnrc_rpl_srh_root_update(&target->target, parent,
+                             (uint32_t)(xtimer_now_usec64() / US_PER_SEC) +
+                             (transit->path_lifetime * dodag->lifetime_unit));
+}
+#endif
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -434,6 +458,12 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                                       0x0 : FIB_FLAG_RPL_ROUTE),
                                      (transit->path_lifetime *
                                       dodag->lifetime_unit * MS_PER_SEC));
+#ifdef MODULE_GNRC_RPL_SRH_ROOT
+                    if ((inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+                        (dodag->node_status == GNRC_RPL_ROOT_NODE)) {
+                        _srh_root_update(dodag, first_target, transit);
+                    }
+#endif
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
                 }
@@ -676,11 +706,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent) ? sizeof(ipv6_addr_t) : 0;
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -694,6 +726,11 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent) {
+        /* non-storing mode: the parent address follows the option */
+        transit->length += sizeof(ipv6_addr_t);
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
@@ -718,13 +755,10 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
 #endif
 
-    if (destination == NULL) {
-        if (dodag->parents == NULL) {
-            DEBUG("RPL: dodag has no preferred parent\n");
-            return;
-        }
-
-        destination = &(dodag->parents->addr);
+    if (((destination == NULL) || (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE)) &&
+        (dodag->parents == NULL)) {
+        DEBUG("RPL: dodag has no preferred parent\n");
+        return;
     }
 
     gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
@@ -739,6 +773,19 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         return;
     }
 
+    ipv6_addr_t parent_addr, *parent = NULL;
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        /* DAOs go to the root and carry the parent's address in the
+         * DODAG prefix, assuming the parent's IID matches its link-local */
+        memcpy(&parent_addr.u8[0], &me->u8[0], sizeof(network_uint64_t));
+        memcpy(&parent_addr.u8[8], &dodag->parents->addr.u8[8], sizeof(network_uint64_t));
+        parent = &parent_addr;
+        destination = &dodag->dodag_id;
+    }
+    else if (destination == NULL) {
+        destination = &(dodag->parents->addr);
+    }
+
     mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
 
     /* add external and RPL FIB entries */
@@ -749,7 +796,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                 ptr = &tmp;
                 if (!ext_processed) {
                     DEBUG("RPL: Send DAO - building external transit\n");
-                    if ((tmp = _dao_transit_build(NULL, lifetime, true)) == NULL) {
+                    if ((tmp = _dao_transit_build(NULL, lifetime, true, parent)) == NULL) {
                         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                         mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                         return;
@@ -761,7 +808,8 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                 ptr = &pkt;
                 if (!int_processed) {
                     DEBUG("RPL: Send DAO - building internal transit\n");
-                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
+                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false,
+                                                             parent)) == NULL) {
                         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
                         mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                         return;
@@ -19,6 +19,9 @@
 #include "net/af.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/ieee802154.h"
+#include "net/netstats/neighbor.h"
 #include "net/gnrc/rpl/dodag.h"
 #include "net/gnrc/rpl/structs.h"
 #include "utlist.h"
@@ -36,7 +39,8 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag);
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *parent);
 static void _rpl_trickle_send_dio(void *args);
 
 static void _rpl_trickle_send_dio(void *args)
@@ -262,6 +266,47 @@ void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Update the link metric of a parent with the ETX estimated by the
+ *          link layer
+ *
+ * The link layer address of the parent is taken from the neighbor cache. If
+ * there is no entry, it is derived from the interface identifier of the
+ * parent's link-local address, as on IEEE 802.15.4 links.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Pointer to the parent
+ */
+static void _update_link_metric(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
+{
+    gnrc_ipv6_nc_t *nc_entry = gnrc_ipv6_nc_get(dodag->iface, &parent->addr);
+    uint8_t l2_addr[IEEE802154_LONG_ADDRESS_LEN];
+    const uint8_t *l2_addr_ptr = l2_addr;
+    size_t l2_addr_len;
+
+    if ((nc_entry != NULL) && (nc_entry->l2_addr_len > 0)) {
+        l2_addr_ptr = nc_entry->l2_addr;
+        l2_addr_len = nc_entry->l2_addr_len;
+    }
+    else if ((parent->addr.u32[2].u32 == byteorder_htonl(0x000000ff).u32) &&
+             (parent->addr.u16[6].u16 == byteorder_htons(0xfe00).u16)) {
+        /* IID from short address */
+        memcpy(l2_addr, &parent->addr.u8[14], IEEE802154_SHORT_ADDRESS_LEN);
+        l2_addr_len = IEEE802154_SHORT_ADDRESS_LEN;
+    }
+    else {
+        /* IID from EUI-64 */
+        memcpy(l2_addr, &parent->addr.u8[8], IEEE802154_LONG_ADDRESS_LEN);
+        l2_addr[0] ^= 0x02;
+        l2_addr_len = IEEE802154_LONG_ADDRESS_LEN;
+    }
+
+    parent->link_metric = netstats_nb_get_etx(dodag->iface, l2_addr_ptr, l2_addr_len);
+    parent->link_metric_type = GNRC_RPL_METRIC_ETX;
+}
+#endif
+
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 {
     /* update Parent lifetime */
@@ -270,6 +315,9 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
         parent->lifetime = (now / US_PER_SEC) + (dodag->default_lifetime * dodag->lifetime_unit);
 #ifdef MODULE_GNRC_RPL_P2P
         if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+        _update_link_metric(dodag, parent);
 #endif
         if (parent == dodag->parents) {
             fib_add_entry(&gnrc_ipv6_fib_table,
@@ -287,20 +335,51 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 #endif
     }
 
-    if (_gnrc_rpl_find_preferred_parent(dodag) == NULL) {
+    if (_gnrc_rpl_find_preferred_parent(dodag, parent) == NULL) {
         gnrc_rpl_local_repair(dodag);
     }
 }
 
 /**
- * @brief   Find the parent with the lowest rank and update the DODAG's preferred parent
+ * @brief   Insert a parent into the candidates, i.e. behind the preferred
+ *          parent, in the order of the objective function
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Parent to insert, not in the list of parents
+ */
+static void _parent_insert(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
+{
+    gnrc_rpl_parent_t *prev = dodag->parents;
+
+    if (prev == NULL) {
+        LL_PREPEND(dodag->parents, parent);
+        return;
+    }
+
+    while (prev->next &&
+           (dodag->instance->of->which_parent(prev->next, parent) == prev->next)) {
+        prev = prev->next;
+    }
+    parent->next = prev->next;
+    prev->next = parent;
+}
+
+/**
+ * @brief   Update the DODAG's preferred parent after a parent changed
+ *
+ * The parents of a DODAG are ordered: the preferred parent is first, the
+ * candidates follow in the order of the objective function. Only the
+ * changed parent is moved, and only the first candidate can replace the
+ * preferred parent.
  *
  * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Parent that changed, NULL if a parent was removed
  *
  * @return  Pointer to the preferred parent, on success.
  * @return  NULL, otherwise.
  */
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag)
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *parent)
 {
     gnrc_rpl_parent_t *old_best = dodag->parents;
     gnrc_rpl_parent_t *new_best = old_best;
@@ -311,23 +390,37 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
-    LL_FOREACH(dodag->parents, elt) {
-        new_best = dodag->instance->of->which_parent(new_best, elt);
+    /* reposition the changed parent among the candidates */
+    if ((parent != NULL) && (parent != old_best)) {
+        LL_DELETE(dodag->parents, parent);
+        _parent_insert(dodag, parent);
     }
 
-    if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
+    if (old_best->next) {
+        new_best = dodag->instance->of->which_parent(old_best, old_best->next);
+    }
+
+    /* OF0's rank calculation overflows for a parent with infinite rank */
+    if ((new_best->rank == GNRC_RPL_INFINITE_RANK) ||
+        (dodag->instance->of->calc_rank(new_best, 0) == GNRC_RPL_INFINITE_RANK)) {
         return NULL;
     }
 
     if (new_best != old_best) {
         LL_DELETE(dodag->parents, new_best);
+        LL_DELETE(dodag->parents, old_best);
         LL_PREPEND(dodag->parents, new_best);
+        _parent_insert(dodag, old_best);
         /* no-path DAOs only for the storing mode */
         if ((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
             (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) {
             gnrc_rpl_send_DAO(dodag->instance, &old_best->addr, 0);
             gnrc_rpl_delay_dao(dodag);
         }
+        /* the root learns the new parent from the next DAO */
+        else if (dodag->instance->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+            gnrc_rpl_delay_dao(dodag);
+        }
 
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
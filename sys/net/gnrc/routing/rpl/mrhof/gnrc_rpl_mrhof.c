@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl_mrhof
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF with the ETX metric.
+ * @}
+ */
+
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/gnrc/rpl/structs.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+/* Converts an ETX value to rank units of the parent's instance */
+static inline uint32_t _etx2rank(gnrc_rpl_parent_t *parent, uint32_t etx)
+{
+    return (etx * parent->dodag->instance->min_hop_rank_inc) /
+           GNRC_RPL_MRHOF_ETX_DIVISOR;
+}
+
+/*
+ * Returns the rank increase for the link to a parent, or
+ * GNRC_RPL_INFINITE_RANK if the link is too bad
+ */
+static uint32_t _link_cost(gnrc_rpl_parent_t *parent)
+{
+    uint32_t etx = parent->link_metric;
+
+    if (etx == 0) {
+        etx = GNRC_RPL_MRHOF_DEFAULT_LINK_METRIC;
+    }
+    if (etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    /* a link needs at least one transmission */
+    if (etx < GNRC_RPL_MRHOF_ETX_DIVISOR) {
+        etx = GNRC_RPL_MRHOF_ETX_DIVISOR;
+    }
+    return _etx2rank(parent, etx);
+}
+
+/* Returns base_rank increased by the link cost of a parent */
+static uint16_t _add_link_cost(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    if (base_rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    uint32_t cost = base_rank + _link_cost(parent);
+
+    if (cost >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    return cost;
+}
+
+/* Returns the cost of the path to the root through a parent, in rank units */
+static inline uint16_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    return _add_link_cost(parent, parent->rank);
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void) dodag;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    if (parent == NULL) {
+        if ((base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE) < base_rank) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        return base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    return _add_link_cost(parent, base_rank);
+}
+
+/*
+ * Returns the parent with the cheaper path. The preferred parent is only
+ * replaced if the other path is cheaper by the switch threshold.
+ */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t c1 = _path_cost(p1);
+    uint32_t c2 = _path_cost(p2);
+    gnrc_rpl_parent_t *preferred = p1->dodag->parents;
+    uint32_t threshold = _etx2rank(p1, GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD);
+
+    if (p1 == preferred) {
+        return ((c2 + threshold) < c1) ? p2 : p1;
+    }
+    else if (p2 == preferred) {
+        return ((c1 + threshold) < c2) ? p1 : p2;
+    }
+    return (c1 <= c2) ? p1 : p2;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
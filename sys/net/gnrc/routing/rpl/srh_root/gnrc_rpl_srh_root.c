@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/srh_root.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+#if (GNRC_RPL_SRH_ROOT_BUCKETS & (GNRC_RPL_SRH_ROOT_BUCKETS - 1))
+#error "GNRC_RPL_SRH_ROOT_BUCKETS must be a power of two"
+#endif
+
+#define _NONE           (UINT16_MAX)        /**< no node */
+#define _ROOT           (UINT16_MAX - 1)    /**< parent is the root */
+#define _MAX_CMPR       (15U)               /**< maximum CmprI/CmprE value */
+
+typedef struct {
+    ipv6_addr_t addr;
+    uint32_t expires;
+    uint16_t parent;        /**< index of the parent, _ROOT, or _NONE */
+    uint16_t next;          /**< next node in the same hash bucket */
+    uint8_t used;
+} _node_t;
+
+typedef struct {
+    uint16_t node;          /**< destination, _NONE if the entry is empty */
+    uint8_t len;
+    uint16_t hops[GNRC_RPL_SRH_ROOT_MAX_DEPTH]; /**< first hop first */
+} _path_t;
+
+static _node_t _nodes[GNRC_RPL_SRH_ROOT_NODES_NUMOF];
+static uint16_t _buckets[GNRC_RPL_SRH_ROOT_BUCKETS];
+static _path_t _cache[GNRC_RPL_SRH_ROOT_CACHE_SIZE];
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _initialized;
+
+static void _init(void)
+{
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_buckets, 0xff, sizeof(_buckets));
+    memset(_cache, 0xff, sizeof(_cache));
+    _initialized = 1;
+}
+
+static inline unsigned _hash(const ipv6_addr_t *addr)
+{
+    /* within a DODAG, addresses mostly differ in their interface identifier */
+    uint32_t h = addr->u32[2].u32 ^ (addr->u32[3].u32 * 2654435761U);
+
+    return (h ^ (h >> 16)) & (GNRC_RPL_SRH_ROOT_BUCKETS - 1);
+}
+
+static uint16_t _find(const ipv6_addr_t *addr)
+{
+    uint16_t i = _buckets[_hash(addr)];
+
+    while ((i != _NONE) && !ipv6_addr_equal(&_nodes[i].addr, addr)) {
+        i = _nodes[i].next;
+    }
+    return i;
+}
+
+static uint16_t _add(const ipv6_addr_t *addr, uint32_t expires)
+{
+    for (uint16_t i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+        if (!_nodes[i].used) {
+            unsigned b = _hash(addr);
+
+            _nodes[i].addr = *addr;
+            _nodes[i].expires = expires;
+            _nodes[i].parent = _NONE;
+            _nodes[i].next = _buckets[b];
+            _nodes[i].used = 1;
+            _buckets[b] = i;
+            return i;
+        }
+    }
+    return _NONE;
+}
+
+static inline void _invalidate_cache(void)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_ROOT_CACHE_SIZE; i++) {
+        _cache[i].node = _NONE;
+    }
+}
+
+static void _remove(uint16_t idx)
+{
+    uint16_t *ptr = &_buckets[_hash(&_nodes[idx].addr)];
+
+    while (*ptr != idx) {
+        ptr = &_nodes[*ptr].next;
+    }
+    *ptr = _nodes[idx].next;
+    _nodes[idx].used = 0;
+    /* orphan the children */
+    for (uint16_t i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+        if (_nodes[i].used && (_nodes[i].parent == idx)) {
+            _nodes[i].parent = _NONE;
+        }
+    }
+    _invalidate_cache();
+}
+
+/*
+ * Looks up the path to dst, walking the parent pointers on a cache miss.
+ * Returns the cache entry holding the path, or NULL with *res set to the
+ * error code.
+ */
+static _path_t *_get_path(const ipv6_addr_t *dst, int *res)
+{
+    uint16_t idx = _find(dst);
+    uint16_t hops[GNRC_RPL_SRH_ROOT_MAX_DEPTH];
+    _path_t *path;
+    unsigned len = 0;
+
+    if (idx == _NONE) {
+        *res = -ENOENT;
+        return NULL;
+    }
+    path = &_cache[idx % GNRC_RPL_SRH_ROOT_CACHE_SIZE];
+    if (path->node == idx) {
+        return path;
+    }
+    /* walk up to the root; a loop ends at the depth limit */
+    for (uint16_t i = idx; i != _ROOT; i = _nodes[i].parent) {
+        if (i == _NONE) {
+            *res = -ENOENT;
+            return NULL;
+        }
+        if (len == GNRC_RPL_SRH_ROOT_MAX_DEPTH) {
+            *res = -ENOSPC;
+            return NULL;
+        }
+        hops[len++] = i;
+    }
+    for (unsigned i = 0; i < len; i++) {
+        path->hops[i] = hops[len - i - 1];
+    }
+    path->len = len;
+    path->node = idx;
+    return path;
+}
+
+/* number of leading octets a and b have in common, at most _MAX_CMPR */
+static inline unsigned _common(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    unsigned octets = ipv6_addr_match_prefix(a, b) / 8;
+
+    return (octets > _MAX_CMPR) ? _MAX_CMPR : octets;
+}
+
+int gnrc_rpl_srh_root_update(const ipv6_addr_t *target,
+                             const ipv6_addr_t *parent, uint32_t expires)
+{
+    uint16_t idx, pidx = _ROOT;
+
+    mutex_lock(&_mutex);
+    if (!_initialized) {
+        _init();
+    }
+    if (parent != NULL) {
+        if (((pidx = _find(parent)) == _NONE) &&
+            ((pidx = _add(parent, expires)) == _NONE)) {
+            mutex_unlock(&_mutex);
+            return -ENOMEM;
+        }
+    }
+    if ((idx = _find(target)) == _NONE) {
+        if ((idx = _add(target, expires)) == _NONE) {
+            mutex_unlock(&_mutex);
+            return -ENOMEM;
+        }
+    }
+    _nodes[idx].expires = expires;
+    if (_nodes[idx].parent != pidx) {
+        DEBUG("RPL SRH root: parent of %s changed\n",
+              ipv6_addr_to_str(addr_str, target, sizeof(addr_str)));
+        _nodes[idx].parent = pidx;
+        _invalidate_cache();
+    }
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_rpl_srh_root_remove(const ipv6_addr_t *target)
+{
+    uint16_t idx;
+
+    mutex_lock(&_mutex);
+    if (_initialized && ((idx = _find(target)) != _NONE)) {
+        _remove(idx);
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_srh_root_expire(uint32_t now)
+{
+    mutex_lock(&_mutex);
+    if (_initialized) {
+        for (uint16_t i = 0; i < GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+            if (_nodes[i].used && ((int32_t)(_nodes[i].expires - now) <= 0)) {
+                _remove(i);
+            }
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_srh_root_reset(void)
+{
+    mutex_lock(&_mutex);
+    _init();
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_srh_root_get_path(const ipv6_addr_t *dst, ipv6_addr_t *path,
+                               unsigned max)
+{
+    _path_t *p;
+    int res = -ENOENT;
+
+    mutex_lock(&_mutex);
+    if (_initialized && ((p = _get_path(dst, &res)) != NULL)) {
+        if (p->len > max) {
+            res = -ENOSPC;
+        }
+        else {
+            for (unsigned i = 0; i < p->len; i++) {
+                path[i] = _nodes[p->hops[i]].addr;
+            }
+            res = p->len;
+        }
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+gnrc_pktsnip_t *gnrc_rpl_srh_root_build(const ipv6_addr_t *dst,
+                                        gnrc_pktsnip_t *payload,
+                                        ipv6_addr_t *first)
+{
+    gnrc_pktsnip_t *snip = NULL;
+    gnrc_rpl_srh_t *srh;
+    _path_t *p;
+    int res;
+
+    mutex_lock(&_mutex);
+    if (!_initialized || ((p = _get_path(dst, &res)) == NULL) || (p->len < 2)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+
+    /* Each hop fills the elided prefix from the current destination, i.e.
+     * from the address preceding it on the path. */
+    unsigned n = p->len - 1;    /* addresses in the routing header */
+    const ipv6_addr_t *last = &_nodes[p->hops[n]].addr;
+    unsigned cmpre = _common(last, &_nodes[p->hops[n - 1]].addr);
+    unsigned cmpri = (n > 1) ? _MAX_CMPR : cmpre;
+
+    for (unsigned i = 1; i < n; i++) {
+        unsigned c = _common(&_nodes[p->hops[i]].addr,
+                             &_nodes[p->hops[i - 1]].addr);
+        if (c < cmpri) {
+            cmpri = c;
+        }
+    }
+
+    size_t size = sizeof(gnrc_rpl_srh_t) + ((n - 1) * (16 - cmpri)) +
+                  (16 - cmpre);
+    unsigned pad = (8 - (size & 0x7)) & 0x7;
+
+    if ((snip = gnrc_pktbuf_add(payload, NULL, size + pad,
+                                GNRC_NETTYPE_IPV6_EXT)) == NULL) {
+        DEBUG("RPL SRH root: no space left in packet buffer\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    srh = snip->data;
+    srh->nh = 0;
+    srh->len = ((size + pad) / 8) - 1;
+    srh->type = GNRC_RPL_SRH_TYPE;
+    srh->seg_left = n;
+    srh->compr = (cmpri << 4) | cmpre;
+    srh->pad_resv = pad << 4;
+    srh->resv = 0;
+
+    uint8_t *vec = (uint8_t *)(srh + 1);
+    for (unsigned i = 1; i < n; i++) {
+        memcpy(vec, &_nodes[p->hops[i]].addr.u8[cmpri], 16 - cmpri);
+        vec += 16 - cmpri;
+    }
+    memcpy(vec, &last->u8[cmpre], 16 - cmpre);
+    memset(vec + 16 - cmpre, 0, pad);
+    *first = _nodes[p->hops[0]].addr;
+    mutex_unlock(&_mutex);
+
+    DEBUG("RPL SRH root: %u hops to %s\n", n + 1,
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    return snip;
+}
+
+/** @} */
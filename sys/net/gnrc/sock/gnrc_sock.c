@@ -27,6 +27,10 @@
 #include "sock_types.h"
 #include "gnrc_sock_internal.h"
 
+#ifdef MODULE_NETSTATS_LATENCY
+#include "net/netstats/latency.h"
+#endif
+
 #ifdef MODULE_XTIMER
 #define _TIMEOUT_MAGIC      (0xF38A0B63U)
 #define _TIMEOUT_MSG_TYPE   (0x8474)
@@ -107,6 +111,9 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         /* TODO: use API in #5511 */
         remote->netif = (uint16_t)netif_hdr->if_pid;
     }
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_RX_SOCK);
+#endif
     *pkt_out = pkt; /* set out parameter */
     return 0;
 }
@@ -171,6 +178,9 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
     }
 #ifdef MODULE_GNRC_NETERR
     gnrc_neterr_reg(pkt);   /* no error should occur since pkt was created here */
+#endif
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_TX_SOCK);
 #endif
     if (!gnrc_netapi_dispatch_send(type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         /* this should not happen, but just in case */
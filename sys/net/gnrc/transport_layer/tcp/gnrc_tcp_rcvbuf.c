@@ -26,9 +26,8 @@ void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : Entry\n");
     mutex_init(&(_static_buf.lock));
-    for (int i=0; i<GNRC_TCP_RCV_BUFFERS; i++) {
-        _static_buf.entries[i].used = 0;
-    }
+    memarray_init(&(_static_buf.mem), _static_buf.entries,
+                  sizeof(rcvbuf_entry_t), GNRC_TCP_RCV_BUFFERS);
 }
 
 static void* _rcvbuf_alloc(void)
@@ -36,13 +35,7 @@ static void* _rcvbuf_alloc(void)
     void *result = NULL;
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (int i=0; i<GNRC_TCP_RCV_BUFFERS; i++) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
-        }
-    }
+    result = memarray_alloc(&(_static_buf.mem));
     mutex_unlock(&(_static_buf.lock));
     return result;
 }
@@ -51,11 +44,7 @@ static void _rcvbuf_free(void * const buf)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (int i=0; i<GNRC_TCP_RCV_BUFFERS; i++) {
-        if (_static_buf.entries[i].used == 1 && buf == _static_buf.entries[i].buffer) {
-            _static_buf.entries[i].used = 0;
-        }
-    }
+    memarray_free(&(_static_buf.mem), buf);
     mutex_unlock(&(_static_buf.lock));
 }
 
@@ -23,6 +23,7 @@
  #define GNRC_TCP_INTERNAL_RCVBUF_H_
 
 #include <stdint.h>
+#include "memarray.h"
 #include "mutex.h"
 #include "ringbuffer.h"
 #include "net/gnrc/tcp/config.h"
@@ -37,7 +38,6 @@ extern "C" {
  * @internal
  */
 typedef struct rcvbuf_entry {
-    uint8_t used;                            /**< Is entry currently in use */
     uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE];   /**< Raw Buffer Data */
 } rcvbuf_entry_t;
 
@@ -47,6 +47,7 @@ typedef struct rcvbuf_entry {
  */
 typedef struct rcvbuf {
     mutex_t lock;                                   /**< Lock for synchronization */
+    memarray_t mem;                                 /**< Pool of the entries */
     rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS];   /**< Number of receive buffers */
 } rcvbuf_t;
 
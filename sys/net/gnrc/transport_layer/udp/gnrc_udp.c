@@ -28,7 +28,9 @@
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
 #include "net/inet_csum.h"
-
+#ifdef MODULE_NETSTATS_LATENCY
+#include "net/netstats/latency.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -154,6 +156,9 @@ static void _receive(gnrc_pktsnip_t *pkt)
     /* get port (netreg demux context) */
     port = (uint32_t)byteorder_ntohs(hdr->dst_port);
 
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_RX_UDP);
+#endif
     /* send payload to receivers */
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt)) {
         DEBUG("udp: unable to forward packet as no one is interested in it\n");
@@ -209,6 +214,9 @@ static void _send(gnrc_pktsnip_t *pkt)
         target_type = pkt->next->type;
     }
 
+#ifdef MODULE_NETSTATS_LATENCY
+    netstats_lat_stamp(pkt, NETSTATS_LAT_TX_UDP);
+#endif
     /* and forward packet to the network layer */
     if (!gnrc_netapi_dispatch_send(target_type, GNRC_NETREG_DEMUX_CTX_ALL,
                                    pkt)) {
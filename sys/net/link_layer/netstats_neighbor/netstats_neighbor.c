@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_netstats_neighbor
+ * @file
+ * @brief       Implementation of per neighbor link statistics
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static netstats_nb_t _nbs[NETSTATS_NB_SIZE];
+static mutex_t _mutex = MUTEX_INIT;
+static uint16_t _clock;
+
+static netstats_nb_t *_find(kernel_pid_t iface, const uint8_t *l2_addr,
+                            size_t l2_addr_len)
+{
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        if ((_nbs[i].l2_addr_len == l2_addr_len) && (_nbs[i].iface == iface)
+            && (memcmp(_nbs[i].l2_addr, l2_addr, l2_addr_len) == 0)) {
+            return &_nbs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Adds ETX sample, in transmissions, to the moving average */
+static void _add_sample(netstats_nb_t *nb, unsigned transmissions)
+{
+    if (nb->etx == 0) {
+        nb->etx = transmissions * NETSTATS_NB_ETX_DIVISOR;
+        return;
+    }
+
+    uint32_t etx = ((uint32_t)nb->etx * NETSTATS_NB_ETX_ALPHA) +
+                   ((uint32_t)transmissions * NETSTATS_NB_ETX_DIVISOR *
+                    (100U - NETSTATS_NB_ETX_ALPHA));
+
+    nb->etx = etx / 100U;
+}
+
+netstats_nb_t *netstats_nb_record(kernel_pid_t iface, const uint8_t *l2_addr,
+                                  size_t l2_addr_len)
+{
+    if ((l2_addr_len == 0) || (l2_addr_len > NETSTATS_NB_L2_ADDR_MAX)) {
+        return NULL;
+    }
+
+    mutex_lock(&_mutex);
+    netstats_nb_t *nb = _find(iface, l2_addr, l2_addr_len);
+
+    if (nb == NULL) {
+        /* use a free entry, or replace the least recently used one */
+        nb = &_nbs[0];
+        for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+            if (_nbs[i].l2_addr_len == 0) {
+                nb = &_nbs[i];
+                break;
+            }
+            if ((uint16_t)(_clock - _nbs[i].last_use) >
+                (uint16_t)(_clock - nb->last_use)) {
+                nb = &_nbs[i];
+            }
+        }
+        DEBUG("netstats_nb: new neighbor in entry %u\n",
+              (unsigned)(nb - _nbs));
+        memset(nb, 0, sizeof(netstats_nb_t));
+        memcpy(nb->l2_addr, l2_addr, l2_addr_len);
+        nb->l2_addr_len = l2_addr_len;
+        nb->iface = iface;
+    }
+    nb->last_use = _clock++;
+    mutex_unlock(&_mutex);
+
+    return nb;
+}
+
+void netstats_nb_update_tx(netstats_nb_t *nb, unsigned result)
+{
+    /* A busy medium tells nothing about the link */
+    if ((nb == NULL) || (result == NETSTATS_NB_BUSY)) {
+        return;
+    }
+
+    mutex_lock(&_mutex);
+    nb->tx_count++;
+    if (result == NETSTATS_NB_SUCCESS) {
+        _add_sample(nb, nb->failures + 1);
+        nb->failures = 0;
+    }
+    else {
+        nb->tx_failed++;
+        if (++nb->failures >= NETSTATS_NB_MAX_FAILURES) {
+            _add_sample(nb, NETSTATS_NB_ETX_NOACK_PENALTY);
+            nb->failures = 0;
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+uint16_t netstats_nb_get_etx(kernel_pid_t iface, const uint8_t *l2_addr,
+                             size_t l2_addr_len)
+{
+    uint16_t etx = 0;
+
+    mutex_lock(&_mutex);
+    netstats_nb_t *nb = _find(iface, l2_addr, l2_addr_len);
+    if (nb != NULL) {
+        etx = nb->etx;
+    }
+    mutex_unlock(&_mutex);
+
+    return etx;
+}
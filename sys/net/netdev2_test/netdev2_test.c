@@ -25,6 +25,7 @@ static int _init(netdev2_t *dev);
 static void _isr(netdev2_t *dev);
 static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len);
 static int _set(netdev2_t *dev, netopt_t opt, void *value, size_t value_len);
+static int _send_batch(netdev2_t *dev, const netdev2_frame_t *frames, unsigned num);
 
 static const netdev2_driver_t _driver = {
     .send   = _send,
@@ -33,6 +34,7 @@ static const netdev2_driver_t _driver = {
     .isr    = _isr,
     .get    = _get,
     .set    = _set,
+    .send_batch = _send_batch,
 };
 
 void netdev2_test_setup(netdev2_test_t *dev, void *state)
@@ -49,6 +51,7 @@ void netdev2_test_reset(netdev2_test_t *dev)
 {
     mutex_lock(&dev->mutex);
     dev->send_cb = NULL;
+    dev->send_batch_cb = NULL;
     dev->recv_cb = NULL;
     dev->init_cb = NULL;
     dev->isr_cb = NULL;
@@ -70,6 +73,20 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count)
     return res;
 }
 
+static int _send_batch(netdev2_t *netdev, const netdev2_frame_t *frames,
+                       unsigned num)
+{
+    netdev2_test_t *dev = (netdev2_test_t *)netdev;
+    int res = -ENOTSUP;     /* let the caller send one by one */
+
+    mutex_lock(&dev->mutex);
+    if (dev->send_batch_cb != NULL) {
+        res = dev->send_batch_cb(netdev, frames, num);
+    }
+    mutex_unlock(&dev->mutex);
+    return res;
+}
+
 static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
 {
     netdev2_test_t *dev = (netdev2_test_t *)netdev;
@@ -114,6 +114,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                 /* remove this entry if its lifetime expired */
                 table->data.entries[i].lifetime = 0;
                 table->data.entries[i].global_flags = 0;
+                table->gen++;
                 table->data.entries[i].next_hop_flags = 0;
                 table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
 
@@ -409,6 +410,7 @@ int fib_add_entry(fib_table_t *table,
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
                                next_hop, next_hop_size, next_hop_flags, lifetime);
     }
+    table->gen++;
 
     mutex_unlock(&(table->mtx_access));
     return ret;
@@ -434,6 +436,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        table->gen++;
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -458,6 +461,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
     if (ret == 1) {
         /* we must take the according entry and update the values */
         fib_remove(entry[0]);
+        table->gen++;
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -480,6 +484,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
             fib_remove(&table->data.entries[i]);
         }
     }
+    table->gen++;
 
     mutex_unlock(&(table->mtx_access));
 }
@@ -597,6 +602,7 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    table->gen++;
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -622,6 +628,7 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    table->gen++;
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
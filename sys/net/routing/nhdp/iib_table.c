@@ -55,20 +55,20 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
                                              uint8_t sym, uint8_t lost);
 static void release_link_tuple_addresses(iib_link_set_entry_t *ls_entry);
 
-static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                              timex_t *now, uint64_t val_time);
-static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                             nhdp_addr_t *th_addr, timex_t *now, uint64_t val_time);
-static void rem_two_hop_entry(iib_base_entry_t *base_entry, iib_two_hop_set_entry_t *th_entry);
+static int update_two_hop_set(iib_link_set_entry_t *ls_entry, timex_t *now, uint64_t val_time);
+static int add_two_hop_entry(iib_link_set_entry_t *ls_entry, nhdp_addr_t *th_addr,
+                             timex_t *now, uint64_t val_time);
+static void rem_two_hop_entry(iib_link_set_entry_t *ls_entry, iib_two_hop_set_entry_t *th_entry);
+static void rem_two_hop_entries(iib_link_set_entry_t *ls_entry);
 
 static void wr_update_ls_status(iib_base_entry_t *base_entry,
                                 iib_link_set_entry_t *ls_elt, timex_t *now);
-static void update_nb_tuple_symmetry(iib_base_entry_t *base_entry,
-                                     iib_link_set_entry_t *ls_entry, timex_t *now);
+static void update_nb_tuple_symmetry(iib_link_set_entry_t *ls_entry, timex_t *now);
 static void rem_not_heard_nb_tuple(iib_link_set_entry_t *ls_entry, timex_t *now);
 
 static inline timex_t get_max_timex(timex_t time_one, timex_t time_two);
 static iib_link_tuple_status_t get_tuple_status(iib_link_set_entry_t *ls_entry, timex_t *now);
+static inline void set_metric(uint32_t *metric, uint32_t value);
 
 #if (NHDP_METRIC == NHDP_LMT_DAT)
 static void queue_rem(uint8_t *queue);
@@ -91,7 +91,6 @@ int iib_register_if(kernel_pid_t pid)
 
     new_entry->if_pid = pid;
     new_entry->link_set_head = NULL;
-    new_entry->two_hop_set_head = NULL;
     LL_PREPEND(iib_base_entry_head, new_entry);
 
     return 0;
@@ -125,7 +124,7 @@ iib_link_set_entry_t *iib_process_hello(kernel_pid_t if_pid, nib_entry_t *nb_elt
 
         /* Create new two hop tuples for signaled symmetric neighbors */
         if (ls_entry) {
-            update_two_hop_set(base_elt, ls_entry, &now, validity_time);
+            update_two_hop_set(ls_entry, &now, validity_time);
         }
     }
 
@@ -222,6 +221,31 @@ void iib_update_lt_status(timex_t *now)
     }
 }
 
+void iib_update_status(timex_t *now)
+{
+    iib_base_entry_t *base_elt;
+    iib_link_set_entry_t *ls_elt;
+
+    mutex_lock(&mtx_iib_access);
+
+    iib_update_lt_status(now);
+
+    /* 2-hop tuples of links heard from are refreshed during HELLO processing, */
+    /* the ones of all other links expire here */
+    LL_FOREACH(iib_base_entry_head, base_elt) {
+        LL_FOREACH(base_elt->link_set_head, ls_elt) {
+            iib_two_hop_set_entry_t *th_elt, *th_tmp;
+            LL_FOREACH_SAFE(ls_elt->two_hop_set_head, th_elt, th_tmp) {
+                if (timex_cmp(th_elt->exp_time, *now) != 1) {
+                    rem_two_hop_entry(ls_elt, th_elt);
+                }
+            }
+        }
+    }
+
+    mutex_unlock(&mtx_iib_access);
+}
+
 void iib_propagate_nb_entry_change(nib_entry_t *old_entry, nib_entry_t *new_entry)
 {
     iib_base_entry_t *base_elt;
@@ -240,11 +264,11 @@ void iib_process_metric_msg(iib_link_set_entry_t *ls_entry, uint64_t int_time)
 #if (NHDP_METRIC == NHDP_LMT_HOP_COUNT)
     /* Hop metric value for an existing direct link is always 1 */
     (void)int_time;
-    ls_entry->metric_in = 1;
-    ls_entry->metric_out = 1;
+    set_metric(&ls_entry->metric_in, 1);
+    set_metric(&ls_entry->metric_out, 1);
     if (ls_entry->nb_elt) {
-        ls_entry->nb_elt->metric_in = 1;
-        ls_entry->nb_elt->metric_out = 1;
+        set_metric(&ls_entry->nb_elt->metric_in, 1);
+        set_metric(&ls_entry->nb_elt->metric_out, 1);
     }
 #elif (NHDP_METRIC == NHDP_LMT_DAT)
     /* Process required DAT metric steps */
@@ -308,19 +332,19 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
         if ((metric_out <= ls_entry->nb_elt->metric_out) ||
                 (ls_entry->nb_elt->metric_out == NHDP_METRIC_UNKNOWN)) {
             /* Better value, use it also for your neighbor */
-            ls_entry->nb_elt->metric_out = metric_out;
+            set_metric(&ls_entry->nb_elt->metric_out, metric_out);
         }
         else if (ls_entry->metric_out == ls_entry->nb_elt->metric_out){
             /* The corresponding neighbor tuples metric needs to be updated */
             iib_base_entry_t *base_elt;
             iib_link_set_entry_t *ls_elt;
-            ls_entry->nb_elt->metric_out = metric_out;
+            set_metric(&ls_entry->nb_elt->metric_out, metric_out);
             LL_FOREACH(iib_base_entry_head, base_elt) {
                 LL_FOREACH(base_elt->link_set_head, ls_elt) {
                     if ((ls_elt->nb_elt == ls_entry->nb_elt) && (ls_elt != ls_entry)) {
                         if (ls_elt->metric_out < ls_entry->nb_elt->metric_out) {
                             /* Smaller DAT value is better */
-                            ls_entry->nb_elt->metric_out = ls_elt->metric_out;
+                            set_metric(&ls_entry->nb_elt->metric_out, ls_elt->metric_out);
                         }
                         break;
                     }
@@ -328,7 +352,7 @@ void iib_process_metric_pckt(iib_link_set_entry_t *ls_entry, uint32_t metric_out
             }
         }
     }
-    ls_entry->metric_out = metric_out;
+    set_metric(&ls_entry->metric_out, metric_out);
 #else
     /* NHDP_METRIC is not set properly */
     (void)ls_entry;
@@ -376,21 +400,12 @@ static void cleanup_link_sets(void)
                     /* Remove link tuple address if included in the Removed Addr List */
                     LL_DELETE(ls_elt->address_list_head, lt_elt);
                     nhdp_free_addr_entry(lt_elt);
+                    nhdp_writer_mark_dirty();
                 }
             }
 
-            /* Remove link tuples with empty address list */
+            /* Remove link tuples with empty address list (and their two hop entries) */
             if (!ls_elt->address_list_head) {
-                if (ls_elt->last_status == IIB_LT_STATUS_SYM) {
-                    /* Remove all two hop entries for the corresponding link tuple */
-                    iib_two_hop_set_entry_t *th_elt, *th_tmp;
-                    LL_FOREACH_SAFE(base_elt->two_hop_set_head, th_elt, th_tmp) {
-                        if (th_elt->ls_elt == ls_elt) {
-                            rem_two_hop_entry(base_elt, th_elt);
-                        }
-                    }
-                }
-
                 rem_link_set_entry(base_elt, ls_elt);
             }
         }
@@ -407,6 +422,7 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     iib_link_set_entry_t *ls_elt, *ls_tmp;
     iib_link_set_entry_t *matching_lt = NULL;
     nhdp_addr_entry_t *lt_elt;
+    iib_link_tuple_status_t last_status;
     timex_t v_time, l_hold;
     uint8_t matches = 0;
 
@@ -421,7 +437,7 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
                 if (matches > 1) {
                     /* Multiple matching link tuples, delete the previous one */
                     if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-                        update_nb_tuple_symmetry(base_entry, matching_lt, now);
+                        update_nb_tuple_symmetry(matching_lt, now);
                     }
 
                     rem_link_set_entry(base_entry, matching_lt);
@@ -436,14 +452,18 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     if (matches > 1) {
         /* Multiple matching link tuples, reset the last one for reuse */
         if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, matching_lt, now);
+            update_nb_tuple_symmetry(matching_lt, now);
         }
 
         reset_link_set_entry(matching_lt, now, val_time);
     }
     else if (matches == 1) {
-        /* A single matching link tuple, only release the address list */
-        release_link_tuple_addresses(matching_lt);
+        /* A single matching link tuple, only release the address list if it changed */
+        if (!nhdp_addr_list_matches_tmp(matching_lt->address_list_head,
+                                        NHDP_ADDR_TMP_SEND_LIST)) {
+            release_link_tuple_addresses(matching_lt);
+            nhdp_writer_mark_dirty();
+        }
     }
     else {
         /* No single matching link tuple existant, create a new one */
@@ -458,16 +478,19 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     v_time = timex_from_uint64(val_time * US_PER_MS);
     l_hold = timex_from_uint64(((uint64_t)NHDP_L_HOLD_TIME_MS) * US_PER_MS);
 
-    /* Set Sending Address List as this tuples address list */
-    matching_lt->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_SEND_LIST);
-
     if (!matching_lt->address_list_head) {
-        /* Insufficient memory */
-        rem_link_set_entry(base_entry, matching_lt);
-        return NULL;
+        /* Set Sending Address List as this tuples address list */
+        matching_lt->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_SEND_LIST);
+
+        if (!matching_lt->address_list_head) {
+            /* Insufficient memory */
+            rem_link_set_entry(base_entry, matching_lt);
+            return NULL;
+        }
     }
 
     matching_lt->nb_elt = nb_elt;
+    last_status = matching_lt->last_status;
 
     /* Set values dependent on link status */
     if (sym) {
@@ -486,7 +509,7 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
         matching_lt->sym_time.seconds = 0;
 
         if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, matching_lt, now);
+            update_nb_tuple_symmetry(matching_lt, now);
         }
 
         if (get_tuple_status(matching_lt, now) == IIB_LT_STATUS_HEARD) {
@@ -498,6 +521,10 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
         }
     }
 
+    if (matching_lt->last_status != last_status) {
+        nhdp_writer_mark_dirty();
+    }
+
     /* Set time values */
     matching_lt->heard_time = get_max_timex(timex_add(*now, v_time), matching_lt->sym_time);
 
@@ -528,7 +555,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
     if (timex_cmp(ls_elt->exp_time, *now) != 1) {
         /* Entry expired and has to be removed */
         if (ls_elt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, ls_elt, now);
+            update_nb_tuple_symmetry(ls_elt, now);
         }
 
         rem_not_heard_nb_tuple(ls_elt, now);
@@ -537,8 +564,9 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
     else if ((ls_elt->last_status == IIB_LT_STATUS_SYM)
              && (timex_cmp(ls_elt->sym_time, *now) != 1)) {
         /* Status changed from SYMMETRIC to HEARD */
-        update_nb_tuple_symmetry(base_entry, ls_elt, now);
+        update_nb_tuple_symmetry(ls_elt, now);
         ls_elt->last_status = IIB_LT_STATUS_HEARD;
+        nhdp_writer_mark_dirty();
 
         if (timex_cmp(ls_elt->heard_time, *now) != 1) {
             /* New status is LOST (equals IIB_LT_STATUS_UNKNOWN) */
@@ -553,6 +581,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
         rem_not_heard_nb_tuple(ls_elt, now);
         ls_elt->nb_elt = NULL;
         ls_elt->last_status = IIB_LT_STATUS_UNKNOWN;
+        nhdp_writer_mark_dirty();
     }
 }
 
@@ -572,8 +601,10 @@ static iib_link_set_entry_t *add_default_link_set_entry(iib_base_entry_t *base_e
     }
 
     new_entry->address_list_head = NULL;
+    new_entry->two_hop_set_head = NULL;
     reset_link_set_entry(new_entry, now, val_time);
     LL_PREPEND(base_entry->link_set_head, new_entry);
+    nhdp_writer_mark_dirty();
 
     return new_entry;
 }
@@ -586,6 +617,7 @@ static void reset_link_set_entry(iib_link_set_entry_t *ls_entry, timex_t *now, u
     timex_t v_time = timex_from_uint64(val_time * US_PER_MS);
 
     release_link_tuple_addresses(ls_entry);
+    rem_two_hop_entries(ls_entry);
     ls_entry->sym_time.microseconds = 0;
     ls_entry->sym_time.seconds = 0;
     ls_entry->heard_time.microseconds = 0;
@@ -616,7 +648,9 @@ static void rem_link_set_entry(iib_base_entry_t *base_entry, iib_link_set_entry_
 {
     LL_DELETE(base_entry->link_set_head, ls_entry);
     release_link_tuple_addresses(ls_entry);
+    rem_two_hop_entries(ls_entry);
     free(ls_entry);
+    nhdp_writer_mark_dirty();
 }
 
 /**
@@ -631,8 +665,7 @@ static void release_link_tuple_addresses(iib_link_set_entry_t *ls_entry)
 /**
  * Update the 2-Hop Set during HELLO message processing
  */
-static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                              timex_t *now, uint64_t val_time)
+static int update_two_hop_set(iib_link_set_entry_t *ls_entry, timex_t *now, uint64_t val_time)
 {
     /* Check whether a corresponding link tuple was created */
     if (ls_entry == NULL) {
@@ -644,24 +677,22 @@ static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t
         iib_two_hop_set_entry_t *ths_elt, *ths_tmp;
         nhdp_addr_t *addr_elt;
 
-        /* Loop through all the two hop tuples of the two hop set */
-        LL_FOREACH_SAFE(base_entry->two_hop_set_head, ths_elt, ths_tmp) {
+        /* Loop through the two hop tuples reached via the link tuple */
+        LL_FOREACH_SAFE(ls_entry->two_hop_set_head, ths_elt, ths_tmp) {
             if (timex_cmp(ths_elt->exp_time, *now) != 1) {
                 /* Entry is expired, remove it */
-                rem_two_hop_entry(base_entry, ths_elt);
+                rem_two_hop_entry(ls_entry, ths_elt);
             }
-            else if (ths_elt->ls_elt == ls_entry) {
-                if (ths_elt->th_nb_addr->in_tmp_table &
-                    (NHDP_ADDR_TMP_TH_REM_LIST | NHDP_ADDR_TMP_TH_SYM_LIST)) {
-                    rem_two_hop_entry(base_entry, ths_elt);
-                }
+            else if (ths_elt->th_nb_addr->in_tmp_table &
+                     (NHDP_ADDR_TMP_TH_REM_LIST | NHDP_ADDR_TMP_TH_SYM_LIST)) {
+                rem_two_hop_entry(ls_entry, ths_elt);
             }
         }
 
         /* Add a new entry for every signaled symmetric neighbor address */
         LL_FOREACH(nhdp_get_addr_db_head(), addr_elt) {
             if (NHDP_ADDR_TMP_IN_TH_SYM_LIST(addr_elt)) {
-                if (add_two_hop_entry(base_entry, ls_entry, addr_elt, now, val_time)) {
+                if (add_two_hop_entry(ls_entry, addr_elt, now, val_time)) {
                     /* No more memory available, return error */
                     return -1;
                 }
@@ -675,8 +706,8 @@ static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t
 /**
  * Add a 2-Hop Tuple for a given address
  */
-static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                             nhdp_addr_t *th_addr, timex_t *now, uint64_t val_time)
+static int add_two_hop_entry(iib_link_set_entry_t *ls_entry, nhdp_addr_t *th_addr,
+                             timex_t *now, uint64_t val_time)
 {
     iib_two_hop_set_entry_t *new_entry;
     timex_t v_time = timex_from_uint64(val_time * US_PER_MS);
@@ -702,7 +733,7 @@ static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t
         new_entry->metric_out = NHDP_METRIC_UNKNOWN;
     }
 
-    LL_PREPEND(base_entry->two_hop_set_head, new_entry);
+    LL_PREPEND(ls_entry->two_hop_set_head, new_entry);
 
     return 0;
 }
@@ -710,30 +741,33 @@ static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t
 /**
  * Remove a given 2-Hop Tuple
  */
-static void rem_two_hop_entry(iib_base_entry_t *base_entry, iib_two_hop_set_entry_t *th_entry)
+static void rem_two_hop_entry(iib_link_set_entry_t *ls_entry, iib_two_hop_set_entry_t *th_entry)
 {
-    LL_DELETE(base_entry->two_hop_set_head, th_entry);
+    LL_DELETE(ls_entry->two_hop_set_head, th_entry);
     nhdp_decrement_addr_usage(th_entry->th_nb_addr);
     free(th_entry);
 }
 
+/**
+ * Remove all 2-Hop Tuples reached via a given link tuple
+ */
+static void rem_two_hop_entries(iib_link_set_entry_t *ls_entry)
+{
+    while (ls_entry->two_hop_set_head) {
+        rem_two_hop_entry(ls_entry, ls_entry->two_hop_set_head);
+    }
+}
+
 /**
  * Remove all corresponding two hop entries for a given link tuple that lost symmetry status.
  * Additionally reset the neighbor tuple's symmmetry flag (for the neighbor tuple this link
  * tuple is represented in), if no more corresponding symmetric link tuples are left.
  * Implements section 13.2 of RFC 6130
  */
-static void update_nb_tuple_symmetry(iib_base_entry_t *base_entry,
-                                     iib_link_set_entry_t *ls_entry, timex_t *now)
+static void update_nb_tuple_symmetry(iib_link_set_entry_t *ls_entry, timex_t *now)
 {
-    iib_two_hop_set_entry_t *th_elt, *th_tmp;
-
     /* First remove all two hop entries for the corresponding link tuple */
-    LL_FOREACH_SAFE(base_entry->two_hop_set_head, th_elt, th_tmp) {
-        if (th_elt->ls_elt == ls_entry) {
-            rem_two_hop_entry(base_entry, th_elt);
-        }
-    }
+    rem_two_hop_entries(ls_entry);
 
     /* Afterwards check the neighbor tuple containing the link tuple's addresses */
     if ((ls_entry->nb_elt != NULL) && (ls_entry->nb_elt->symmetric == 1)) {
@@ -814,6 +848,17 @@ static inline timex_t get_max_timex(timex_t time_one, timex_t time_two)
     return time_two;
 }
 
+/**
+ * Set a metric value, a changed value has to be advertised in the next HELLO
+ */
+static inline void set_metric(uint32_t *metric, uint32_t value)
+{
+    if (*metric != value) {
+        *metric = value;
+        nhdp_writer_mark_dirty();
+    }
+}
+
 #if (NHDP_METRIC == NHDP_LMT_DAT)
 /**
  * Sum all elements in the queue
@@ -890,23 +935,28 @@ static void dat_metric_refresh(void)
                 }
             }
 
+            if (ls_elt->metric_in != metric_temp) {
+                /* The changed value has to be advertised in the next HELLO */
+                nhdp_writer_mark_dirty();
+            }
+
             if (ls_elt->nb_elt) {
                 if (ls_elt->metric_in <= ls_elt->nb_elt->metric_in ||
                         (ls_elt->nb_elt->metric_in == NHDP_METRIC_UNKNOWN)) {
                     /* Better value, use it also for your neighbor */
-                    ls_elt->nb_elt->metric_in = ls_elt->metric_in;
+                    set_metric(&ls_elt->nb_elt->metric_in, ls_elt->metric_in);
                 }
                 else if (metric_temp == ls_elt->nb_elt->metric_in){
                     /* The corresponding neighbor tuples metric needs to be updated */
                     iib_base_entry_t *base_entry;
                     iib_link_set_entry_t *ls_entry;
-                    ls_elt->nb_elt->metric_in = ls_elt->metric_in;
+                    set_metric(&ls_elt->nb_elt->metric_in, ls_elt->metric_in);
                     LL_FOREACH(iib_base_entry_head, base_entry) {
                         LL_FOREACH(base_entry->link_set_head, ls_entry) {
                             if ((ls_elt->nb_elt == ls_entry->nb_elt) && (ls_elt != ls_entry)) {
                                 if (ls_entry->metric_in < ls_elt->nb_elt->metric_in) {
                                     /* Smaller DAT value is better */
-                                    ls_elt->nb_elt->metric_in = ls_entry->metric_in;
+                                    set_metric(&ls_elt->nb_elt->metric_in, ls_entry->metric_in);
                                 }
                                 break;
                             }
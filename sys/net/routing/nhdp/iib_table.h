@@ -64,6 +64,7 @@ typedef struct iib_link_set_entry {
     uint32_t rx_bitrate;                        /**< Incoming Bitrate for this link in Bit/s */
     uint16_t last_seq_no;                       /**< The last received packet sequence number */
 #endif
+    struct iib_two_hop_set_entry *two_hop_set_head; /**< Pointer to 2-hop tuples via this link */
     struct iib_link_set_entry *next;            /**< Pointer to next list entry */
 } iib_link_set_entry_t;
 
@@ -81,11 +82,13 @@ typedef struct iib_two_hop_set_entry {
 
 /**
  * @brief   Link set for a registered interface
+ *
+ * The interface's 2-Hop Set is kept indexed by link tuple, every link tuple
+ * holds the 2-hop tuples of the neighbors reached through it.
  */
 typedef struct iib_base_entry {
     kernel_pid_t if_pid;                                /**< PID of the interface */
     iib_link_set_entry_t *link_set_head;                /**< Pointer to this if's link tuples */
-    iib_two_hop_set_entry_t *two_hop_set_head;          /**< Pointer to this if's 2-hop tuples */
     struct iib_base_entry *next;                        /**< Pointer to next list entry */
 } iib_base_entry_t;
 
@@ -142,6 +145,16 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr);
  */
 void iib_update_lt_status(timex_t *now);
 
+/**
+ * @brief                   Apply all timeouts to the IIB
+ *
+ * Updates L_STATUS of all existing Link Tuples like iib_update_lt_status() and
+ * removes expired 2-Hop Tuples.
+ *
+ * @param[in] now           Pointer to current time timex representation
+ */
+void iib_update_status(timex_t *now);
+
 /**
  * @brief                   Exchange the corresponding Neighbor Tuple of existing Link Tuples
  *
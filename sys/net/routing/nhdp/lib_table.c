@@ -45,31 +45,39 @@ static int add_address_to_if(lib_entry_t *if_entry, nhdp_addr_t *addr);
 int lib_add_if_addr(kernel_pid_t if_pid, nhdp_addr_t *addr)
 {
     lib_entry_t *lib_elt;
-    nhdp_addr_entry_t *addr_elt;
-    int result = -1;
+    int result;
 
     mutex_lock(&mtx_lib_access);
 
+    if (addr->lib_if_pid == if_pid) {
+        /* Address already known for the interface */
+        mutex_unlock(&mtx_lib_access);
+        return 0;
+    }
+
     /* Check whether the given interface is already registered */
     LL_FOREACH(lib_entry_head, lib_elt) {
         if (lib_elt->if_pid == if_pid) {
-            LL_FOREACH(lib_entry_head->if_addr_list_head, addr_elt) {
+            break;
+        }
+    }
+
+    if (lib_elt) {
+        nhdp_addr_entry_t *addr_elt = NULL;
+
+        if (addr->lib_if_pid != KERNEL_PID_UNDEF) {
+            /* Address is indexed for another interface, but may be known here too */
+            LL_FOREACH(lib_elt->if_addr_list_head, addr_elt) {
                 if (addr_elt->address == addr) {
-                    /* Address already known for the interface */
-                    result = 0;
                     break;
                 }
             }
-
-            if (result) {
-                /* Existing interface entry, but new address */
-                result = add_address_to_if(lib_elt, addr);
-                break;
-            }
         }
-    }
 
-    if (result) {
+        /* Existing interface entry, but maybe new address */
+        result = addr_elt ? 0 : add_address_to_if(lib_elt, addr);
+    }
+    else {
         /* New interface, create a lib entry */
         result = create_if_entry(if_pid, addr);
     }
@@ -82,14 +90,21 @@ int lib_add_if_addr(kernel_pid_t if_pid, nhdp_addr_t *addr)
 void lib_rem_if(kernel_pid_t if_pid)
 {
     lib_entry_t *lib_elt, *lib_tmp;
+    nhdp_addr_entry_t *addr_elt;
 
     mutex_lock(&mtx_lib_access);
 
     LL_FOREACH_SAFE(lib_entry_head, lib_elt, lib_tmp) {
         if (lib_elt->if_pid == if_pid) {
+            LL_FOREACH(lib_elt->if_addr_list_head, addr_elt) {
+                if (addr_elt->address->lib_if_pid == if_pid) {
+                    addr_elt->address->lib_if_pid = KERNEL_PID_UNDEF;
+                }
+            }
             nhdp_free_addr_list(lib_elt->if_addr_list_head);
             LL_DELETE(lib_entry_head, lib_elt);
             free(lib_elt);
+            nhdp_writer_mark_dirty();
             break;
         }
     }
@@ -138,23 +153,16 @@ void lib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
 
 uint8_t lib_is_reg_addr(kernel_pid_t if_pid, nhdp_addr_t *addr)
 {
-    lib_entry_t *lib_elt;
-    nhdp_addr_entry_t *addr_elt;
-
-    LL_FOREACH(lib_entry_head, lib_elt) {
-        LL_FOREACH(lib_elt->if_addr_list_head, addr_elt) {
-            if (addr_elt->address == addr) {
-                if (lib_elt->if_pid == if_pid) {
-                    /* Given address is assigned to the given IF */
-                    return 1;
-                }
-
-                /* Given address is assigned to any other IF */
-                return 2;
-            }
-        }
+    if (addr->lib_if_pid == KERNEL_PID_UNDEF) {
+        return 0;
     }
-    return 0;
+    else if (addr->lib_if_pid == if_pid) {
+        /* Given address is assigned to the given IF */
+        return 1;
+    }
+
+    /* Given address is assigned to any other IF */
+    return 2;
 }
 
 
@@ -207,5 +215,11 @@ static int add_address_to_if(lib_entry_t *if_entry, nhdp_addr_t *addr)
     new_entry->address = addr;
     LL_PREPEND(if_entry->if_addr_list_head, new_entry);
 
+    if (addr->lib_if_pid == KERNEL_PID_UNDEF) {
+        /* Index the address, the first interface it was assigned to wins */
+        addr->lib_if_pid = if_entry->if_pid;
+    }
+    nhdp_writer_mark_dirty();
+
     return 0;
 }
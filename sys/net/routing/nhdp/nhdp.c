@@ -83,6 +83,9 @@ void nhdp_init(void)
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         nhdp_if_table[i].if_pid = KERNEL_PID_UNDEF;
         memset(&nhdp_if_table[i].wr_target, 0, sizeof(struct rfc5444_writer_target));
+        nhdp_if_table[i].hello_buf = NULL;
+        nhdp_if_table[i].hello_buf_size = 0;
+        nhdp_if_table[i].hello_len = 0;
     }
 
     /* Initialize reader and writer */
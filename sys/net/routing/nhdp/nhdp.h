@@ -95,6 +95,10 @@ typedef struct {
     timex_t validity_time;                      /**< Validity time for propagated information */
     uint16_t seq_no;                            /**< Sequence number of last send RFC5444 packet */
     struct rfc5444_writer_target wr_target;     /**< Interface specific writer target */
+    uint8_t *hello_buf;                         /**< Packets of the last HELLO, for resending */
+    size_t hello_buf_size;                      /**< Size in bytes of hello_buf */
+    size_t hello_len;                           /**< Bytes used in hello_buf, 0 if not resendable */
+    uint32_t hello_gen;                         /**< Information base state the last HELLO shows */
 } nhdp_if_entry_t;
 
 /**
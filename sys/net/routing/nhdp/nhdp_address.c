@@ -27,6 +27,10 @@
 /* Internal variables */
 static mutex_t mtx_addr_access = MUTEX_INIT;
 static nhdp_addr_t *nhdp_addr_db_head = NULL;
+static nhdp_addr_t *nhdp_addr_db_buckets[NHDP_ADDR_BUCKETS];
+
+/* Internal function prototypes */
+static inline unsigned addr_hash(uint8_t *addr, size_t addr_size);
 
 
 /*---------------------------------------------------------------------------*
@@ -36,10 +40,11 @@ static nhdp_addr_t *nhdp_addr_db_head = NULL;
 nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t addr_type)
 {
     nhdp_addr_t *addr_elt;
+    unsigned bucket = addr_hash(addr, addr_size);
 
     mutex_lock(&mtx_addr_access);
 
-    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+    LL_FOREACH2(nhdp_addr_db_buckets[bucket], addr_elt, hash_next) {
         if ((addr_elt->addr_size == addr_size) && (addr_elt->addr_type == addr_type)) {
             if (memcmp(addr_elt->addr, addr, addr_size) == 0) {
                 /* Found a matching entry */
@@ -54,6 +59,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
 
         if (!addr_elt) {
             /* Insufficient memory */
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -63,6 +69,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         if (!addr_elt->addr) {
             /* Insufficient memory */
             free(addr_elt);
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -72,7 +79,11 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         addr_elt->usg_count = 0;
         addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
         addr_elt->tmp_metric_val = NHDP_METRIC_UNKNOWN;
-        LL_PREPEND(nhdp_addr_db_head, addr_elt);
+        addr_elt->lib_if_pid = KERNEL_PID_UNDEF;
+        addr_elt->nb_elt = NULL;
+        addr_elt->ln_elt = NULL;
+        LL_PREPEND2(nhdp_addr_db_buckets[bucket], addr_elt, hash_next);
+        DL_PREPEND(nhdp_addr_db_head, addr_elt);
     }
 
     addr_elt->usg_count++;
@@ -91,7 +102,9 @@ void nhdp_decrement_addr_usage(nhdp_addr_t *addr)
         addr->usg_count--;
         if (addr->usg_count == 0) {
             /* Free address space if address is no longer used */
-            LL_DELETE(nhdp_addr_db_head, addr);
+            LL_DELETE2(nhdp_addr_db_buckets[addr_hash(addr->addr, addr->addr_size)],
+                       addr, hash_next);
+            DL_DELETE(nhdp_addr_db_head, addr);
             free(addr->addr);
             free(addr);
         }
@@ -140,6 +153,32 @@ nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type)
     return new_list_head;
 }
 
+uint8_t nhdp_addr_list_matches_tmp(nhdp_addr_entry_t *list_head, uint8_t tmp_type)
+{
+    nhdp_addr_entry_t *list_elt;
+    nhdp_addr_t *addr_elt;
+    unsigned count = 0;
+
+    /* Addresses are unique in a list, so counting is enough after the first check */
+    LL_FOREACH(list_head, list_elt) {
+        if (!(list_elt->address->in_tmp_table & tmp_type)) {
+            return 0;
+        }
+        count++;
+    }
+
+    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+        if (addr_elt->in_tmp_table & tmp_type) {
+            if (count == 0) {
+                return 0;
+            }
+            count--;
+        }
+    }
+
+    return (count == 0);
+}
+
 void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg)
 {
     nhdp_addr_t *addr_elt, *addr_tmp;
@@ -159,3 +198,22 @@ nhdp_addr_t *nhdp_get_addr_db_head(void)
 {
     return nhdp_addr_db_head;
 }
+
+
+/*------------------------------------------------------------------------------------*/
+/*                                Internal functions                                  */
+/*------------------------------------------------------------------------------------*/
+
+/**
+ * Get the hash bucket of an address
+ */
+static inline unsigned addr_hash(uint8_t *addr, size_t addr_size)
+{
+    uint32_t hash = 0;
+
+    for (size_t i = 0; i < addr_size; i++) {
+        hash = (hash * 31) + addr[i];
+    }
+
+    return ((hash * 0x9e3779b1UL) >> 16) & (NHDP_ADDR_BUCKETS - 1);
+}
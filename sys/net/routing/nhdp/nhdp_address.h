@@ -19,12 +19,31 @@
 #ifndef NHDP_ADDRESS_H
 #define NHDP_ADDRESS_H
 
+#include "kernel_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets of the central address storage
+ *
+ * @note    Must be a power of 2
+ */
+#ifndef NHDP_ADDR_BUCKETS
+#define NHDP_ADDR_BUCKETS           (16U)
+#endif
+
+#if (NHDP_ADDR_BUCKETS & (NHDP_ADDR_BUCKETS - 1))
+#error "NHDP_ADDR_BUCKETS must be a power of 2"
+#endif
+
 /**
  * @brief   NHDP address representation
+ *
+ * Every address is stored only once, so the information bases index their
+ * tuples by it: lib_if_pid, nb_elt and ln_elt lead from an address to the
+ * tuples it belongs to without searching the tables.
  */
 typedef struct nhdp_addr {
     uint8_t *addr;                      /**< Pointer to the address data */
@@ -33,6 +52,11 @@ typedef struct nhdp_addr {
     uint8_t usg_count;                  /**< Usage count in information bases */
     uint8_t in_tmp_table;               /**< Signals usage in a writers temp table */
     uint16_t tmp_metric_val;            /**< Encoded metric value used during HELLO processing */
+    kernel_pid_t lib_if_pid;            /**< Local interface of the address in the LIB */
+    struct nib_entry *nb_elt;           /**< Neighbor tuple of the address in the NIB */
+    struct nib_lost_address_entry *ln_elt;  /**< Lost neighbor tuple of the address */
+    struct nhdp_addr *hash_next;        /**< Pointer to next address in the same hash bucket */
+    struct nhdp_addr *prev;             /**< Pointer to previous address (used in central storage) */
     struct nhdp_addr *next;             /**< Pointer to next address (used in central storage) */
 } nhdp_addr_t;
 
@@ -116,6 +140,20 @@ void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry);
  */
 nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type);
 
+/**
+ * @brief                   Check whether an address list holds exactly the
+ *                          addresses with the given tmp_type
+ *
+ * Used to keep an existing address list instead of generating an equal one.
+ *
+ * @param[in] list_head     Pointer to the head of the address list to check
+ * @param[in] tmp_type      The tmp_type the addresses are compared with
+ *
+ * @return                  1 if the address list matches
+ * @return                  0 otherwise
+ */
+uint8_t nhdp_addr_list_matches_tmp(nhdp_addr_entry_t *list_head, uint8_t tmp_type);
+
 /**
  * @brief                   Reset in_tmp_table flag of all NHDP addresses
  *
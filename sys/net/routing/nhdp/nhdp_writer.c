@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "timex.h"
@@ -34,12 +35,21 @@
 #include "nib_table.h"
 #include "iib_table.h"
 
+/* Packet header flag for an included sequence number (RFC 5444, section 5.1) */
+#define PKT_FLAG_SEQNO      (0x08)
+/* Position of the sequence number in the packet header */
+#define PKT_SEQNO_OFFSET    (1)
+
 /* Internal variables */
 static mutex_t mtx_packet_write = MUTEX_INIT;
 static struct rfc5444_writer nhdp_writer;
 static nhdp_if_entry_t *nhdp_wr_curr_if_entry;
 static uint8_t msg_buffer[NHDP_WR_MSG_BUF_SIZE];
 static uint8_t msg_addrtlvs[NHDP_WR_TLV_BUF_SIZE];
+static uint32_t ib_gen = 0;
+static uint8_t hello_storable;
+static void (*send_packet)(struct rfc5444_writer *, struct rfc5444_writer_target *,
+                           void *, size_t);
 
 /* Internal function prototypes */
 static void _nhdp_add_hello_msg_header_cb(struct rfc5444_writer *wr,
@@ -48,6 +58,10 @@ static void _nhdp_add_message_tlvs_cb(struct rfc5444_writer *wr);
 static void _nhdp_add_addresses_cb(struct rfc5444_writer *wr);
 static void _nhdp_add_packet_header_cb(struct rfc5444_writer *writer,
                                        struct rfc5444_writer_target *rfc5444_target);
+static void _nhdp_store_packet_cb(struct rfc5444_writer *wr,
+                                  struct rfc5444_writer_target *iface,
+                                  void *buffer, size_t length);
+static void resend_hello(nhdp_if_entry_t *if_entry);
 static void netaddr_from_nhdp_address(struct netaddr *target, nhdp_addr_t *n_addr);
 
 /* Array containing the known Address TLVs */
@@ -121,19 +135,50 @@ void nhdp_writer_register_if(struct rfc5444_writer_target *new_if)
 
 void nhdp_writer_send_hello(nhdp_if_entry_t *if_entry)
 {
+    timex_t now;
+
     mutex_lock(&mtx_packet_write);
 
+    /* Timeouts change the information bases, so apply them first */
+    xtimer_now_timex(&now);
+    iib_update_status(&now);
+    nib_update_status(&now);
+
+    if ((if_entry->hello_len > 0) && (if_entry->hello_gen == ib_gen)) {
+        /* Nothing changed since the last HELLO, send its packets again */
+        resend_hello(if_entry);
+        mutex_unlock(&mtx_packet_write);
+        return;
+    }
+
     /* Register interface as current sending interface */
     nhdp_wr_curr_if_entry = if_entry;
 
+    /* Keep a copy of every packet sent for the HELLO */
+    if_entry->hello_len = 0;
+    hello_storable = 1;
+    send_packet = if_entry->wr_target.sendPacket;
+    if_entry->wr_target.sendPacket = _nhdp_store_packet_cb;
+
     /* Create HELLO message and send it using the given interface */
     rfc5444_writer_create_message(&nhdp_writer, RFC5444_MSGTYPE_HELLO,
                                   rfc5444_writer_singletarget_selector, &if_entry->wr_target);
     rfc5444_writer_flush(&nhdp_writer, &if_entry->wr_target, false);
 
+    if_entry->wr_target.sendPacket = send_packet;
+    if_entry->hello_gen = ib_gen;
+    if (!hello_storable) {
+        if_entry->hello_len = 0;
+    }
+
     mutex_unlock(&mtx_packet_write);
 }
 
+void nhdp_writer_mark_dirty(void)
+{
+    ib_gen++;
+}
+
 void nhdp_writer_add_addr(struct rfc5444_writer *wr, nhdp_addr_t *addr,
                           enum rfc5444_addrtlv_iana type, uint8_t value,
                           uint16_t metric_in, uint16_t metric_out)
@@ -248,6 +293,73 @@ static void _nhdp_add_packet_header_cb(struct rfc5444_writer *writer,
     rfc5444_writer_set_pkt_seqno(writer, rfc5444_target, ++nhdp_wr_curr_if_entry->seq_no);
 }
 
+/**
+ * Send a packet and keep a copy of it to be able to resend the HELLO
+ * Called by oonf_api instead of the interface's sendPacket during HELLO creation
+ */
+static void _nhdp_store_packet_cb(struct rfc5444_writer *wr,
+                                  struct rfc5444_writer_target *iface,
+                                  void *buffer, size_t length)
+{
+    nhdp_if_entry_t *if_entry = nhdp_wr_curr_if_entry;
+    size_t needed = if_entry->hello_len + sizeof(uint16_t) + length;
+    uint16_t pkt_len = length;
+
+    send_packet(wr, iface, buffer, length);
+
+    if (!hello_storable) {
+        return;
+    }
+
+    if ((length < PKT_SEQNO_OFFSET + sizeof(uint16_t))
+        || !(((uint8_t *)buffer)[0] & PKT_FLAG_SEQNO)) {
+        /* Packets without sequence number can not be resent */
+        hello_storable = 0;
+        return;
+    }
+
+    if (needed > if_entry->hello_buf_size) {
+        uint8_t *hello_buf = realloc(if_entry->hello_buf, needed);
+
+        if (!hello_buf) {
+            /* Insufficient memory, the next HELLO is created again */
+            hello_storable = 0;
+            return;
+        }
+
+        if_entry->hello_buf = hello_buf;
+        if_entry->hello_buf_size = needed;
+    }
+
+    /* Every packet is stored with its length in front of it */
+    memcpy(&if_entry->hello_buf[if_entry->hello_len], &pkt_len, sizeof(pkt_len));
+    memcpy(&if_entry->hello_buf[if_entry->hello_len + sizeof(pkt_len)], buffer, length);
+    if_entry->hello_len = needed;
+}
+
+/**
+ * Send the stored packets of the last HELLO with new sequence numbers
+ */
+static void resend_hello(nhdp_if_entry_t *if_entry)
+{
+    size_t pos = 0;
+
+    while (pos < if_entry->hello_len) {
+        uint8_t *pkt = &if_entry->hello_buf[pos + sizeof(uint16_t)];
+        uint16_t pkt_len;
+
+        memcpy(&pkt_len, &if_entry->hello_buf[pos], sizeof(pkt_len));
+
+        /* Same as in _nhdp_add_packet_header_cb, but in network byte order */
+        if_entry->seq_no++;
+        pkt[PKT_SEQNO_OFFSET] = if_entry->seq_no >> 8;
+        pkt[PKT_SEQNO_OFFSET + 1] = if_entry->seq_no & 0xff;
+
+        if_entry->wr_target.sendPacket(&nhdp_writer, &if_entry->wr_target, pkt, pkt_len);
+        pos += sizeof(pkt_len) + pkt_len;
+    }
+}
+
 /**
  * Construct a netaddr from a given NHDP address
  */
@@ -51,10 +51,21 @@ void nhdp_writer_register_if(struct rfc5444_writer_target *new_if);
 /**
  * @brief                   Construct and send a HELLO message using the given interface
  *
+ * If the information bases did not change since the last HELLO on the interface,
+ * its packets are sent again with new sequence numbers instead.
+ *
  * @param[in] if_entry      Pointer to NHDP interface entry the message must be created for
  */
 void nhdp_writer_send_hello(nhdp_if_entry_t *if_entry);
 
+/**
+ * @brief                   Signal a change of the information bases
+ *
+ * Must be called on every change that alters the content of HELLO messages, the next
+ * HELLO on every interface is created from scratch afterwards.
+ */
+void nhdp_writer_mark_dirty(void);
+
 /**
  * @brief                   Add a NHDP address to the currently constructed message
  *
@@ -42,6 +42,7 @@ static void rem_nib_entry(nib_entry_t *nib_entry, timex_t *now);
 static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now);
 static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now);
 static void rem_ln_entry(nib_lost_address_entry_t *ln_entry);
+static void index_nb_addresses(nib_entry_t *nib_entry, nib_entry_t *index);
 
 
 /*---------------------------------------------------------------------------*
@@ -51,7 +52,7 @@ static void rem_ln_entry(nib_lost_address_entry_t *ln_entry);
 nib_entry_t *nib_process_hello(void)
 {
     nib_entry_t *nb_match = NULL;
-    nib_entry_t *nib_elt, *nib_tmp;
+    nhdp_addr_t *addr_elt, *addr_tmp;
     timex_t now;
     uint8_t matches = 0;
 
@@ -59,27 +60,30 @@ nib_entry_t *nib_process_hello(void)
 
     xtimer_now_timex(&now);
 
-    LL_FOREACH_SAFE(nib_entry_head, nib_elt, nib_tmp) {
-        nhdp_addr_entry_t *list_elt;
-        LL_FOREACH(nib_elt->address_list_head, list_elt) {
-            if (NHDP_ADDR_TMP_IN_NB_LIST(list_elt->address)) {
-                /* Matching neighbor tuple */
-                matches++;
-
-                if (matches > 1) {
-                    /* Multiple matching nb tuples, delete the previous one */
-                    iib_propagate_nb_entry_change(nb_match, nib_elt);
-                    rem_nib_entry(nb_match, &now);
-                }
+    /* The received neighbor addresses lead to the matching nb tuples */
+    LL_FOREACH_SAFE(nhdp_get_addr_db_head(), addr_elt, addr_tmp) {
+        nib_entry_t *nib_elt = addr_elt->nb_elt;
+
+        if (NHDP_ADDR_TMP_IN_NB_LIST(addr_elt) && nib_elt && (nib_elt != nb_match)) {
+            /* Matching neighbor tuple */
+            matches++;
 
-                nb_match = nib_elt;
-                break;
+            if (nb_match) {
+                /* Multiple matching nb tuples, delete the previous one */
+                iib_propagate_nb_entry_change(nb_match, nib_elt);
+                rem_nib_entry(nb_match, &now);
             }
+
+            nb_match = nib_elt;
         }
     }
 
     /* Add or update nb tuple */
-    if (matches > 0) {
+    if ((matches == 1)
+        && nhdp_addr_list_matches_tmp(nb_match->address_list_head, NHDP_ADDR_TMP_NB_LIST)) {
+        /* The neighbor's address list did not change, keep it */
+    }
+    else if (matches > 0) {
         /* We found matching nb tuples, reuse the last one */
         clear_nb_addresses(nb_match, &now);
 
@@ -95,6 +99,9 @@ nib_entry_t *nib_process_hello(void)
             free(nb_match);
             nb_match = NULL;
         }
+        else {
+            index_nb_addresses(nb_match, nb_match);
+        }
     }
     else {
         nb_match = add_nib_entry_for_nb_addr_list();
@@ -151,8 +158,29 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
     mutex_unlock(&mtx_nib_access);
 }
 
+void nib_update_status(timex_t *now)
+{
+    nib_lost_address_entry_t *lost_elt, *lost_tmp;
+
+    mutex_lock(&mtx_nib_access);
+
+    LL_FOREACH_SAFE(nib_lost_address_entry_head, lost_elt, lost_tmp) {
+        if (timex_cmp(lost_elt->expiration_time, *now) != 1) {
+            /* Entry expired, remove it */
+            rem_ln_entry(lost_elt);
+        }
+    }
+
+    mutex_unlock(&mtx_nib_access);
+}
+
 void nib_rem_nb_entry(nib_entry_t *nib_entry)
 {
+    if (nib_entry->symmetric) {
+        nhdp_writer_mark_dirty();
+    }
+
+    index_nb_addresses(nib_entry, NULL);
     nhdp_free_addr_list(nib_entry->address_list_head);
     LL_DELETE(nib_entry_head, nib_entry);
     free(nib_entry);
@@ -160,17 +188,17 @@ void nib_rem_nb_entry(nib_entry_t *nib_entry)
 
 void nib_set_nb_entry_sym(nib_entry_t *nib_entry)
 {
-    nib_lost_address_entry_t *ln_elt, *ln_tmp;
     nhdp_addr_entry_t *nb_elt;
 
+    if (!nib_entry->symmetric) {
+        nhdp_writer_mark_dirty();
+    }
+
     nib_entry->symmetric = 1;
     LL_FOREACH(nib_entry->address_list_head, nb_elt) {
-        LL_FOREACH_SAFE(nib_lost_address_entry_head, ln_elt, ln_tmp) {
-            /* Remove all Lost Neighbor Tuples matching an address of the newly sym nb */
-            if (ln_elt->address == nb_elt->address) {
-                rem_ln_entry(ln_elt);
-                break;
-            }
+        /* Remove all Lost Neighbor Tuples matching an address of the newly sym nb */
+        if (nb_elt->address->ln_elt) {
+            rem_ln_entry(nb_elt->address->ln_elt);
         }
     }
 }
@@ -179,6 +207,10 @@ void nib_reset_nb_entry_sym(nib_entry_t *nib_entry, timex_t *now)
 {
     nhdp_addr_entry_t *nb_elt;
 
+    if (nib_entry->symmetric) {
+        nhdp_writer_mark_dirty();
+    }
+
     nib_entry->symmetric = 0;
     LL_FOREACH(nib_entry->address_list_head, nb_elt) {
         /* Add a Lost Neighbor Tuple for each address of the neighbor */
@@ -220,6 +252,7 @@ static nib_entry_t *add_nib_entry_for_nb_addr_list(void)
     new_elem->symmetric = 0;
     new_elem->metric_in = NHDP_METRIC_UNKNOWN;
     new_elem->metric_out = NHDP_METRIC_UNKNOWN;
+    index_nb_addresses(new_elem, new_elem);
     LL_PREPEND(nib_entry_head, new_elem);
 
     return new_elem;
@@ -243,6 +276,11 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
 {
     nhdp_addr_entry_t *nib_elt, *nib_tmp;
 
+    if (nib_entry->symmetric && nib_entry->address_list_head) {
+        nhdp_writer_mark_dirty();
+    }
+
+    index_nb_addresses(nib_entry, NULL);
     LL_FOREACH_SAFE(nib_entry->address_list_head, nib_elt, nib_tmp) {
         /* Check whether address is still present in the new neighbor address list */
         if (!NHDP_ADDR_TMP_IN_NB_LIST(nib_elt->address)) {
@@ -269,19 +307,18 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
  */
 static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now)
 {
-    nib_lost_address_entry_t *elt;
+    nib_lost_address_entry_t *elt = lost_addr->ln_elt;
     timex_t n_hold = timex_from_uint64(((uint64_t)NHDP_N_HOLD_TIME_MS) * US_PER_MS);
 
-    LL_FOREACH(nib_lost_address_entry_head, elt) {
-        if (elt->address == lost_addr) {
-            /* Existing entry for this address, no need to add a new one */
-            if (timex_cmp(elt->expiration_time, *now) == -1) {
-                /* Entry expired, so just update expiration time */
-                elt->expiration_time = timex_add(*now, n_hold);
-            }
-
-            return 0;
+    if (elt) {
+        /* Existing entry for this address, no need to add a new one */
+        if (timex_cmp(elt->expiration_time, *now) == -1) {
+            /* Entry expired, so just update expiration time */
+            elt->expiration_time = timex_add(*now, n_hold);
+            nhdp_writer_mark_dirty();
         }
+
+        return 0;
     }
 
     /* No existing entry, create a new one */
@@ -294,9 +331,11 @@ static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now)
 
     /* Increment usage counter of address in central NHDP address storage */
     lost_addr->usg_count++;
+    lost_addr->ln_elt = elt;
     elt->address = lost_addr;
     elt->expiration_time = timex_add(*now, n_hold);
     LL_PREPEND(nib_lost_address_entry_head, elt);
+    nhdp_writer_mark_dirty();
 
     return 0;
 }
@@ -306,7 +345,21 @@ static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now)
  */
 static void rem_ln_entry(nib_lost_address_entry_t *ln_entry)
 {
+    ln_entry->address->ln_elt = NULL;
     nhdp_decrement_addr_usage(ln_entry->address);
     LL_DELETE(nib_lost_address_entry_head, ln_entry);
     free(ln_entry);
+    nhdp_writer_mark_dirty();
+}
+
+/**
+ * Set the Neighbor Tuple the addresses of a Neighbor Tuple are indexed for
+ */
+static void index_nb_addresses(nib_entry_t *nib_entry, nib_entry_t *index)
+{
+    nhdp_addr_entry_t *nib_elt;
+
+    LL_FOREACH(nib_entry->address_list_head, nib_elt) {
+        nib_elt->address->nb_elt = index;
+    }
 }
@@ -70,6 +70,13 @@ nib_entry_t *nib_process_hello(void);
  */
 void nib_fill_wr_addresses(struct rfc5444_writer *wr);
 
+/**
+ * @brief                   Remove expired Lost Neighbor Tuples
+ *
+ * @param[in] now           Pointer to current time timex representation
+ */
+void nib_update_status(timex_t *now);
+
 /**
  * @brief                   Remove a Neighbor Tuple
  *
@@ -22,8 +22,8 @@
 #include <stdbool.h>
 #include <string.h>
 
-#include "bitfield.h"
 #include "fd.h"
+#include "memarray.h"
 #include "mutex.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
@@ -63,12 +63,13 @@ typedef union {
 } socket_sock_t;
 
 typedef struct {
+    socket_sock_t *sock;        /* first, as the pool links free sockets
+                                 * through it */
     int fd;
     sa_family_t domain;
     int type;
     int protocol;
     bool bound;
-    socket_sock_t *sock;
 #ifdef MODULE_SOCK_TCP
     sock_tcp_t *queue_array;
     unsigned queue_array_len;
@@ -81,7 +82,9 @@ static socket_sock_t _sock_pool[SOCKET_POOL_SIZE];
 #ifdef MODULE_SOCK_TCP
 static sock_tcp_t _tcp_sock_pool[SOCKET_POOL_SIZE][SOCKET_TCP_QUEUE_SIZE];
 #endif
-BITFIELD(_sock_pool_used, SOCKET_POOL_SIZE);
+static memarray_t _socket_mem = MEMARRAY_INIT(_socket_pool,
+                                              _ACTUAL_SOCKET_POOL_SIZE);
+static memarray_t _sock_mem = MEMARRAY_INIT(_sock_pool, SOCKET_POOL_SIZE);
 static mutex_t _socket_pool_mutex = MUTEX_INIT;
 
 const struct in6_addr in6addr_any = IN6ADDR_ANY_INIT;
@@ -89,27 +92,26 @@ const struct in6_addr in6addr_loopback = IN6ADDR_LOOPBACK_INIT;
 
 static socket_t *_get_free_socket(void)
 {
-    for (int i = 0; i < _ACTUAL_SOCKET_POOL_SIZE; i++) {
-        if (_socket_pool[i].domain == AF_UNSPEC) {
-            return &_socket_pool[i];
-        }
-    }
-    return NULL;
+    return memarray_alloc(&_socket_mem);
 }
 
 static socket_sock_t *_get_free_sock(void)
 {
-    int i = bf_get_unset(_sock_pool_used, SOCKET_POOL_SIZE);
-    if (i < 0) {
-        return NULL;
-    }
-    return &_sock_pool[i];
+    return memarray_alloc(&_sock_mem);
+}
+
+static void _free_sock(socket_sock_t *sock)
+{
+    mutex_lock(&_socket_pool_mutex);
+    memarray_free(&_sock_mem, sock);
+    mutex_unlock(&_socket_pool_mutex);
 }
 
 static socket_t *_get_socket(int fd)
 {
     for (int i = 0; i < _ACTUAL_SOCKET_POOL_SIZE; i++) {
-        if (_socket_pool[i].fd == fd) {
+        if ((_socket_pool[i].domain != AF_UNSPEC) &&
+            (_socket_pool[i].fd == fd)) {
             return &_socket_pool[i];
         }
     }
@@ -267,12 +269,12 @@ static int socket_close(int socket)
                 break;
         }
         if (idx >= 0) {
-            bf_unset(_sock_pool_used, idx);
+            memarray_free(&_sock_mem, s->sock);
         }
     }
-    mutex_unlock(&_socket_pool_mutex);
-    s->sock = NULL;
     s->domain = AF_UNSPEC;
+    memarray_free(&_socket_mem, s);
+    mutex_unlock(&_socket_pool_mutex);
     return res;
 }
 
@@ -298,6 +300,8 @@ int socket(int domain, int type, int protocol)
         mutex_unlock(&_socket_pool_mutex);
         return -1;
     }
+    s->sock = NULL;
+    s->domain = AF_UNSPEC;
     switch (domain) {
         case AF_INET:
 #ifdef SOCK_HAS_IPV6
@@ -322,7 +326,6 @@ int socket(int domain, int type, int protocol)
                 break;
             }
             s->bound = false;
-            s->sock = NULL;
 #ifdef MODULE_SOCK_TCP
             if (type == SOCK_STREAM)  {
                 s->queue_array = NULL;
@@ -338,6 +341,10 @@ int socket(int domain, int type, int protocol)
             errno = EAFNOSUPPORT;
             res = -1;
     }
+    if (s->domain == AF_UNSPEC) {
+        /* no file descriptor refers to it */
+        memarray_free(&_socket_mem, s);
+    }
     mutex_unlock(&_socket_pool_mutex);
     return res;
 }
@@ -366,7 +373,6 @@ int accept(int socket, struct sockaddr *restrict address,
     switch (s->type) {
         case SOCK_STREAM:
             new_s = _get_free_socket();
-            sock = (sock_tcp_t *)new_s->sock;
             if (new_s == NULL) {
                 errno = ENFILE;
                 res = -1;
@@ -406,6 +412,7 @@ int accept(int socket, struct sockaddr *restrict address,
                 else {
                     new_s->fd = res = fd;
                 }
+                new_s->sock = (socket_sock_t *)sock;
                 new_s->domain = s->domain;
                 new_s->type = s->type;
                 new_s->protocol = s->protocol;
@@ -423,6 +430,9 @@ int accept(int socket, struct sockaddr *restrict address,
     if ((res < 0) && (sock != NULL)) {
         sock_tcp_disconnect(sock);
     }
+    if ((res < 0) && (new_s != NULL)) {
+        memarray_free(&_socket_mem, new_s);
+    }
     mutex_unlock(&_socket_pool_mutex);
     return res;
 #else
@@ -539,9 +549,7 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
     if (res < 0) {
         errno = -res;
         /* free sock again */
-        mutex_lock(&_socket_pool_mutex);
-        bf_unset(_sock_pool_used, _get_sock_idx(sock));
-        mutex_unlock(&_socket_pool_mutex);
+        _free_sock(sock);
         return -1;
     }
     s->sock = sock;
@@ -748,9 +756,7 @@ int listen(int socket, int backlog)
     else {
         errno = -res;
         res = -1;
-        mutex_lock(&_socket_pool_mutex);
-        bf_unset(_sock_pool_used, _get_sock_idx(sock));
-        mutex_unlock(&_socket_pool_mutex);
+        _free_sock(sock);
     }
     return -res;
 #else
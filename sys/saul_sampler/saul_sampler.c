@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_sampler
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "saul_sampler.h"
+
+void saul_sampler_init(saul_sampler_t *sampler, saul_reg_t *const *devs,
+                       unsigned numof, saul_sample_t *ring, unsigned size)
+{
+    assert(numof <= (UINT8_MAX + 1));
+
+    sampler->next = NULL;
+    sampler->devs = devs;
+    sampler->numof = numof;
+    sampler->ring = ring;
+    cib_init(&sampler->cib, size);
+    sampler->period = 0;
+    sampler->deadline = 0;
+    sampler->lost = 0;
+    sampler->errors = 0;
+}
+
+/* the slot is only handed to the reader by _commit(), so the drivers can
+ * write into the ring directly */
+static inline saul_sample_t *_slot(saul_sampler_t *sampler)
+{
+    return &sampler->ring[sampler->cib.write_count & sampler->cib.mask];
+}
+
+static inline void _commit(saul_sampler_t *sampler, saul_sample_t *sample,
+                           unsigned dev, int dim, uint32_t now)
+{
+    sample->time = now;
+    sample->dev = dev;
+    sample->dim = dim;
+    sampler->cib.write_count++;
+}
+
+static int _read_multi(saul_sampler_t *sampler, unsigned dev, uint32_t now)
+{
+    saul_reg_t *reg = sampler->devs[dev];
+    phydat_t buf[SAUL_SAMPLER_FIFO_MAX];
+    unsigned space = sampler->cib.mask + 1 - cib_avail(&sampler->cib);
+    uint8_t dim;
+    int res;
+
+    /* leave what doesn't fit in the device's FIFO */
+    res = reg->driver->read_multi(reg->dev, buf,
+                                  (space < SAUL_SAMPLER_FIFO_MAX) ?
+                                  space : SAUL_SAMPLER_FIFO_MAX, &dim);
+    if (res < 0) {
+        return res;
+    }
+    for (int i = 0; i < res; i++) {
+        saul_sample_t *sample = _slot(sampler);
+
+        sample->data = buf[i];
+        _commit(sampler, sample, dev, dim, now);
+    }
+    return res;
+}
+
+int saul_sampler_read(saul_sampler_t *sampler)
+{
+    uint32_t now = xtimer_now_usec();
+    int stored = 0;
+
+    for (unsigned i = 0; i < sampler->numof; i++) {
+        saul_reg_t *reg = sampler->devs[i];
+        saul_sample_t *sample;
+        int res;
+
+        if (cib_full(&sampler->cib)) {
+            sampler->lost++;
+            continue;
+        }
+        if (reg->driver->read_multi) {
+            res = _read_multi(sampler, i, now);
+            if (res >= 0) {
+                stored += res;
+                continue;
+            }
+            if (res != -ENOTSUP) {
+                sampler->errors++;
+                continue;
+            }
+        }
+        sample = _slot(sampler);
+        res = reg->driver->read(reg->dev, &sample->data);
+        if (res <= 0) {
+            sampler->errors++;
+            continue;
+        }
+        _commit(sampler, sample, i, res, now);
+        stored++;
+    }
+    return stored;
+}
+
+unsigned saul_sampler_get(saul_sampler_t *sampler, saul_sample_t *samples,
+                          unsigned max)
+{
+    unsigned avail = cib_avail(&sampler->cib);
+
+    if (max > avail) {
+        max = avail;
+    }
+    for (unsigned i = 0; i < max; i++) {
+        samples[i] = sampler->ring[sampler->cib.read_count & sampler->cib.mask];
+        sampler->cib.read_count++;
+    }
+    return max;
+}
+
+static void _arm(saul_sched_t *sched)
+{
+    uint32_t now = xtimer_now_usec();
+    int32_t next = INT32_MAX;
+
+    if (sched->samplers == NULL) {
+        xtimer_remove(&sched->timer);
+        return;
+    }
+    for (saul_sampler_t *s = sched->samplers; s != NULL; s = s->next) {
+        int32_t diff = (int32_t)(s->deadline - now);
+
+        if (diff < next) {
+            next = diff;
+        }
+    }
+    xtimer_set_msg(&sched->timer, (next > 0) ? (uint32_t)next : 0,
+                   &sched->msg, sched->pid);
+}
+
+void saul_sched_init(saul_sched_t *sched, kernel_pid_t pid)
+{
+    sched->samplers = NULL;
+    memset(&sched->timer, 0, sizeof(sched->timer));
+    sched->msg.type = SAUL_SCHED_MSG_TYPE;
+    sched->msg.content.ptr = sched;
+    sched->pid = pid;
+}
+
+void saul_sched_add(saul_sched_t *sched, saul_sampler_t *sampler,
+                    uint32_t period)
+{
+    sampler->period = period;
+    sampler->deadline = xtimer_now_usec() + period;
+    sampler->next = sched->samplers;
+    sched->samplers = sampler;
+    _arm(sched);
+}
+
+void saul_sched_remove(saul_sched_t *sched, saul_sampler_t *sampler)
+{
+    saul_sampler_t **s = &sched->samplers;
+
+    while (*s != NULL) {
+        if (*s == sampler) {
+            *s = sampler->next;
+            sampler->next = NULL;
+            break;
+        }
+        s = &(*s)->next;
+    }
+    _arm(sched);
+}
+
+int saul_sched_handle(saul_sched_t *sched, const msg_t *msg)
+{
+    uint32_t now;
+    int run = 0;
+
+    if ((msg->type != SAUL_SCHED_MSG_TYPE) || (msg->content.ptr != sched)) {
+        return -EINVAL;
+    }
+    now = xtimer_now_usec();
+    for (saul_sampler_t *s = sched->samplers; s != NULL; s = s->next) {
+        if ((int32_t)(now - s->deadline) < 0) {
+            continue;
+        }
+        saul_sampler_read(s);
+        s->deadline += s->period;
+        if ((int32_t)(now - s->deadline) >= 0) {
+            /* overrun: skip the missed periods instead of catching up */
+            s->deadline = now + s->period;
+        }
+        run++;
+    }
+    _arm(sched);
+    return run;
+}
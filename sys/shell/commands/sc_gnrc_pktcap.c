@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to control the packet capture and drain it
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gnrc/pktcap.h"
+
+#define BYTES_PER_LINE  (32U)
+
+static const struct {
+    const char *name;
+    gnrc_nettype_t type;
+} _nettypes[] = {
+    { "undef", GNRC_NETTYPE_UNDEF },
+#ifdef MODULE_GNRC_SIXLOWPAN
+    { "6lo", GNRC_NETTYPE_SIXLOWPAN },
+#endif
+#ifdef MODULE_GNRC_IPV6
+    { "ipv6", GNRC_NETTYPE_IPV6 },
+#endif
+#ifdef MODULE_CCN_LITE
+    { "ccn", GNRC_NETTYPE_CCN },
+    { "ccn_chunk", GNRC_NETTYPE_CCN_CHUNK },
+#endif
+};
+
+static unsigned _col;
+
+static void _usage(char *cmd)
+{
+    printf("usage: * %s on|off\n", cmd);
+    puts("         Starts or stops the capture.");
+    printf("       * %s dump\n", cmd);
+    puts("         Drains the capture as pcapng in hex, 'xxd -r -p' converts it.");
+    printf("       * %s stats\n", cmd);
+    puts("         Prints the number of captured and dropped packets.");
+    printf("       * %s snaplen <bytes>\n", cmd);
+    printf("         Sets the bytes captured per packet (at most %u).\n",
+           GNRC_PKTCAP_SNAPLEN);
+    printf("       * %s filter all|<type> [<type> ...]\n", cmd);
+    printf("         Captures only packets of the given types:");
+    for (unsigned i = 0; i < sizeof(_nettypes) / sizeof(_nettypes[0]); i++) {
+        printf(" %s", _nettypes[i].name);
+    }
+    puts("");
+}
+
+static int _print_hex(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", data[i]);
+        if (++_col == BYTES_PER_LINE) {
+            puts("");
+            _col = 0;
+        }
+    }
+    return 0;
+}
+
+static int _filter(int argc, char **argv)
+{
+    uint32_t nettypes = 0;
+
+    if ((argc == 3) && (strcmp(argv[2], "all") == 0)) {
+        gnrc_pktcap_set_filter(GNRC_PKTCAP_NETTYPE_ALL);
+        return 0;
+    }
+    for (int arg = 2; arg < argc; arg++) {
+        unsigned i;
+
+        for (i = 0; i < sizeof(_nettypes) / sizeof(_nettypes[0]); i++) {
+            if (strcmp(argv[arg], _nettypes[i].name) == 0) {
+                nettypes |= GNRC_PKTCAP_NETTYPE(_nettypes[i].type);
+                break;
+            }
+        }
+        if (i == sizeof(_nettypes) / sizeof(_nettypes[0])) {
+            printf("error: unknown type %s\n", argv[arg]);
+            return 1;
+        }
+    }
+    if (nettypes == 0) {
+        _usage(argv[0]);
+        return 1;
+    }
+    gnrc_pktcap_set_filter(nettypes);
+    return 0;
+}
+
+int _gnrc_pktcap(int argc, char **argv)
+{
+    if (argc < 2) {
+        _usage(argv[0]);
+        return 1;
+    }
+    if (strcmp(argv[1], "on") == 0) {
+        gnrc_pktcap_enable(true);
+    }
+    else if (strcmp(argv[1], "off") == 0) {
+        gnrc_pktcap_enable(false);
+    }
+    else if (strcmp(argv[1], "dump") == 0) {
+        int res;
+
+        _col = 0;
+        res = gnrc_pktcap_export(_print_hex, NULL);
+        if (_col != 0) {
+            puts("");
+        }
+        printf("%d packets\n", res);
+    }
+    else if (strcmp(argv[1], "stats") == 0) {
+        const gnrc_pktcap_stats_t *stats = gnrc_pktcap_get_stats();
+
+        printf("capture %s: %lu captured, %lu dropped\n",
+               gnrc_pktcap_enabled() ? "on" : "off",
+               (unsigned long)stats->captured, (unsigned long)stats->dropped);
+    }
+    else if ((strcmp(argv[1], "snaplen") == 0) && (argc == 3)) {
+        gnrc_pktcap_set_snaplen(atoi(argv[2]));
+    }
+    else if ((strcmp(argv[1], "filter") == 0) && (argc > 2)) {
+        return _filter(argc, argv);
+    }
+    else {
+        _usage(argv[0]);
+        return (strcmp(argv[1], "help") == 0) ? 0 : 1;
+    }
+    return 0;
+}
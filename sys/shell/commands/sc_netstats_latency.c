@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to print the packet latency per layer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/netstats/latency.h"
+
+static const char *_stages[NETSTATS_LAT_NUMOF] = {
+    [NETSTATS_LAT_RX_SIXLOWPAN] = "rx 6lo",
+    [NETSTATS_LAT_RX_IPV6] = "rx ipv6",
+    [NETSTATS_LAT_RX_UDP] = "rx udp",
+    [NETSTATS_LAT_RX_SOCK] = "rx sock",
+    [NETSTATS_LAT_TX_UDP] = "tx udp",
+    [NETSTATS_LAT_TX_IPV6] = "tx ipv6",
+    [NETSTATS_LAT_TX_SIXLOWPAN] = "tx 6lo",
+    [NETSTATS_LAT_TX_NETDEV] = "tx netdev",
+};
+
+int _netstats_latency(int argc, char **argv)
+{
+    if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+        netstats_lat_reset();
+        return 0;
+    }
+    if (argc != 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+    puts("stage       count    mean     p50     p99     max (us)");
+    for (unsigned i = 0; i < NETSTATS_LAT_NUMOF; i++) {
+        const netstats_lat_hist_t *hist = netstats_lat_get(i);
+
+        if (_stages[i] == NULL) {
+            /* the first stage of a direction has no samples */
+            continue;
+        }
+        printf("%-9s %7lu %7lu %7lu %7lu %7lu\n", _stages[i],
+               (unsigned long)hist->count,
+               (unsigned long)(hist->count ? (hist->sum / hist->count) : 0),
+               (unsigned long)netstats_lat_percentile(hist, 50),
+               (unsigned long)netstats_lat_percentile(hist, 99),
+               (unsigned long)hist->max);
+    }
+    return 0;
+}
@@ -29,7 +29,7 @@ extern int _reboot_handler(int argc, char **argv);
 extern int _id_handler(int argc, char **argv);
 #endif
 
-#ifdef MODULE_LPC_COMMON
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_HEAP)
 extern int _heap_handler(int argc, char **argv);
 #endif
 
@@ -106,6 +106,14 @@ extern int _whitelist(int argc, char **argv);
 extern int _blacklist(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTCAP
+extern int _gnrc_pktcap(int argc, char **argv);
+#endif
+
+#ifdef MODULE_NETSTATS_LATENCY
+extern int _netstats_latency(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_RPL
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
@@ -134,6 +142,8 @@ const shell_command_t _shell_command_list[] = {
 #endif
 #ifdef MODULE_LPC_COMMON
     {"heap", "Shows the heap state for the LPC2387 on the command shell.", _heap_handler},
+#elif defined(MODULE_HEAP)
+    {"heap", "Shows usage and fragmentation of the heap.", _heap_handler},
 #endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
@@ -192,6 +202,12 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_IPV6_BLACKLIST
     {"blacklist", "blacklists an address for receival ('blacklist [add|del|help]')", _blacklist },
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+    {"pktcap", "packet capture ('pktcap help' for more information)", _gnrc_pktcap },
+#endif
+#ifdef MODULE_NETSTATS_LATENCY
+    {"latency", "print packet latency per layer", _netstats_latency },
+#endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
@@ -0,0 +1,386 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_tlsf_heap
+ * @{
+ *
+ * @file
+ * @brief       TLSF heap implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "tlsf_heap.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* blocks are laid out back to back in a pool, each one headed by a
+ * struct tlsf_block, of which only prev_phys and size are kept in used
+ * blocks. A used block of size 0 terminates the pool. */
+struct tlsf_block {
+    tlsf_block_t *prev_phys;    /* block in front of this one, or NULL */
+    size_t size;                /* usable size, or'ed with FREE */
+    tlsf_block_t *next_free;    /* free list */
+    tlsf_block_t *prev_free;
+};
+
+struct tlsf_pool {
+    tlsf_pool_t *next;
+    size_t size;
+};
+
+#define ALIGN           (TLSF_HEAP_ALIGN)
+#define ALIGN_LOG2      ((ALIGN == 16) ? 4 : 3)
+#define HDR             (offsetof(tlsf_block_t, next_free))
+#define FREE            ((size_t)1)
+#define SIZE_MASK       (~(size_t)(ALIGN - 1))
+#define MIN_SIZE        (sizeof(tlsf_block_t) - HDR)
+#define MAX_SIZE        (((size_t)1 << TLSF_HEAP_SIZE_LOG2) - ALIGN)
+/* sizes below SMALL map linearly to the lists of first level class 0 */
+#define FL_SHIFT        (TLSF_HEAP_SL_LOG2 + ALIGN_LOG2)
+#define SMALL           ((size_t)1 << FL_SHIFT)
+
+static inline size_t _size(const tlsf_block_t *block)
+{
+    return block->size & SIZE_MASK;
+}
+
+static inline int _is_free(const tlsf_block_t *block)
+{
+    return block->size & FREE;
+}
+
+static inline void *_ptr(tlsf_block_t *block)
+{
+    return (uint8_t *)block + HDR;
+}
+
+static inline tlsf_block_t *_block(const void *ptr)
+{
+    return (tlsf_block_t *)((uint8_t *)ptr - HDR);
+}
+
+static inline tlsf_block_t *_next(tlsf_block_t *block)
+{
+    return (tlsf_block_t *)((uint8_t *)_ptr(block) + _size(block));
+}
+
+static inline tlsf_block_t *_first(tlsf_pool_t *pool)
+{
+    return (tlsf_block_t *)(pool + 1);
+}
+
+static inline size_t _adjust(size_t size)
+{
+    size = (size + ALIGN - 1) & SIZE_MASK;
+    return (size < MIN_SIZE) ? MIN_SIZE : size;
+}
+
+static void _mapping(size_t size, unsigned *fl, unsigned *sl)
+{
+    if (size < SMALL) {
+        *fl = 0;
+        *sl = size >> ALIGN_LOG2;
+    }
+    else {
+        unsigned msb = bitarithm_msb(size);
+
+        *sl = (size >> (msb - TLSF_HEAP_SL_LOG2)) ^ TLSF_HEAP_SL_COUNT;
+        *fl = msb - FL_SHIFT + 1;
+    }
+}
+
+static void _remove(tlsf_heap_t *heap, tlsf_block_t *block)
+{
+    unsigned fl, sl;
+
+    _mapping(_size(block), &fl, &sl);
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    }
+    else {
+        heap->blocks[fl][sl] = block->next_free;
+        if (block->next_free == NULL) {
+            heap->sl_bitmap[fl] &= ~(1U << sl);
+            if (heap->sl_bitmap[fl] == 0) {
+                heap->fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+}
+
+static void _insert(tlsf_heap_t *heap, tlsf_block_t *block)
+{
+    unsigned fl, sl;
+
+    _mapping(_size(block), &fl, &sl);
+    block->size |= FREE;
+    block->prev_free = NULL;
+    block->next_free = heap->blocks[fl][sl];
+    if (block->next_free) {
+        block->next_free->prev_free = block;
+    }
+    heap->blocks[fl][sl] = block;
+    heap->sl_bitmap[fl] |= (1U << sl);
+    heap->fl_bitmap |= (1U << fl);
+}
+
+/* finds a free block of at least size bytes in the first non-empty list
+ * whose every block is large enough, in constant time */
+static tlsf_block_t *_search(tlsf_heap_t *heap, size_t size)
+{
+    unsigned fl, sl, map;
+
+    if (size >= SMALL) {
+        size_t round = ((size_t)1 << (bitarithm_msb(size) - TLSF_HEAP_SL_LOG2)) - 1;
+
+        _mapping(size + round, &fl, &sl);
+    }
+    else {
+        _mapping(size, &fl, &sl);
+    }
+    map = (fl < TLSF_HEAP_FL_COUNT) ? heap->sl_bitmap[fl] & (~0U << sl) : 0;
+    if (map == 0) {
+        map = heap->fl_bitmap & (~0U << (fl + 1));
+        if (map == 0) {
+            /* the head of the list size falls in may still fit */
+            tlsf_block_t *block;
+
+            _mapping(size, &fl, &sl);
+            block = heap->blocks[fl][sl];
+            return (block && (_size(block) >= size)) ? block : NULL;
+        }
+        fl = bitarithm_lsb(map);
+        map = heap->sl_bitmap[fl];
+    }
+    return heap->blocks[fl][bitarithm_lsb(map)];
+}
+
+/* links a new block into the pool behind block */
+static tlsf_block_t *_split(tlsf_block_t *block, size_t size)
+{
+    tlsf_block_t *rest = (tlsf_block_t *)((uint8_t *)_ptr(block) + size);
+
+    rest->size = _size(block) - size - HDR;
+    rest->prev_phys = block;
+    _next(rest)->prev_phys = rest;
+    block->size = size | (block->size & FREE);
+    return rest;
+}
+
+/* block absorbs the block behind it */
+static void _absorb(tlsf_block_t *block, tlsf_block_t *next)
+{
+    block->size += _size(next) + HDR;
+    _next(block)->prev_phys = block;
+}
+
+/* gives the tail of a used block exceeding size back to the heap */
+static void _trim(tlsf_heap_t *heap, tlsf_block_t *block, size_t size)
+{
+    tlsf_block_t *rest, *next;
+
+    if (_size(block) < size + HDR + MIN_SIZE) {
+        return;
+    }
+    rest = _split(block, size);
+    next = _next(rest);
+    if (_is_free(next)) {
+        _remove(heap, next);
+        _absorb(rest, next);
+    }
+    _insert(heap, rest);
+}
+
+static inline void _account(tlsf_heap_t *heap, size_t old, size_t new)
+{
+    heap->used += new - old;
+    if (heap->used > heap->peak) {
+        heap->peak = heap->used;
+    }
+}
+
+void tlsf_heap_init(tlsf_heap_t *heap)
+{
+    memset(heap, 0, sizeof(*heap));
+}
+
+int tlsf_heap_add_pool(tlsf_heap_t *heap, void *mem, size_t size)
+{
+    uintptr_t start = ((uintptr_t)mem + ALIGN - 1) & SIZE_MASK;
+    tlsf_pool_t *pool = (tlsf_pool_t *)start;
+    tlsf_block_t *block, *end;
+
+    if (size < (start - (uintptr_t)mem) + (3 * HDR) + MIN_SIZE) {
+        return -EINVAL;
+    }
+    size = (size - (start - (uintptr_t)mem)) & SIZE_MASK;
+    if (size - (3 * HDR) > MAX_SIZE) {
+        return -EINVAL;
+    }
+    pool->size = size;
+    pool->next = heap->pools;
+    heap->pools = pool;
+
+    block = _first(pool);
+    block->prev_phys = NULL;
+    block->size = size - (3 * HDR);
+    end = _next(block);
+    end->prev_phys = block;
+    end->size = 0;
+    _insert(heap, block);
+    DEBUG("tlsf_heap: added %u bytes at %p\n", (unsigned)size, (void *)pool);
+    return 0;
+}
+
+void *tlsf_heap_alloc(tlsf_heap_t *heap, size_t size)
+{
+    tlsf_block_t *block;
+
+    if ((size == 0) || (size > MAX_SIZE)) {
+        return NULL;
+    }
+    size = _adjust(size);
+    block = _search(heap, size);
+    if (block == NULL) {
+        return NULL;
+    }
+    _remove(heap, block);
+    if (_size(block) >= size + HDR + MIN_SIZE) {
+        /* the block behind is used, or it would have been merged */
+        _insert(heap, _split(block, size));
+    }
+    block->size &= ~FREE;
+    _account(heap, 0, _size(block) + HDR);
+    return _ptr(block);
+}
+
+void tlsf_heap_free(tlsf_heap_t *heap, void *ptr)
+{
+    tlsf_block_t *block, *next;
+
+    if (ptr == NULL) {
+        return;
+    }
+    block = _block(ptr);
+    _account(heap, _size(block) + HDR, 0);
+    next = _next(block);
+    if (_is_free(next)) {
+        _remove(heap, next);
+        _absorb(block, next);
+    }
+    if (block->prev_phys && _is_free(block->prev_phys)) {
+        tlsf_block_t *prev = block->prev_phys;
+
+        _remove(heap, prev);
+        _absorb(prev, block);
+        block = prev;
+    }
+    _insert(heap, block);
+}
+
+void *tlsf_heap_realloc(tlsf_heap_t *heap, void *ptr, size_t size)
+{
+    tlsf_block_t *block, *next;
+    size_t old;
+    void *res;
+
+    if (ptr == NULL) {
+        return tlsf_heap_alloc(heap, size);
+    }
+    if (size == 0) {
+        tlsf_heap_free(heap, ptr);
+        return NULL;
+    }
+    if (size > MAX_SIZE) {
+        return NULL;
+    }
+    block = _block(ptr);
+    old = _size(block);
+    size = _adjust(size);
+    next = _next(block);
+    if ((size > old) && _is_free(next) && (old + HDR + _size(next) >= size)) {
+        _remove(heap, next);
+        _absorb(block, next);
+    }
+    if (_size(block) >= size) {
+        _trim(heap, block, size);
+        _account(heap, old, _size(block));
+        return ptr;
+    }
+    res = tlsf_heap_alloc(heap, size);
+    if (res) {
+        memcpy(res, ptr, old);
+        tlsf_heap_free(heap, ptr);
+    }
+    return res;
+}
+
+int tlsf_heap_contains(const tlsf_heap_t *heap, const void *ptr)
+{
+    for (const tlsf_pool_t *pool = heap->pools; pool; pool = pool->next) {
+        if (((uintptr_t)ptr >= (uintptr_t)pool) &&
+            ((uintptr_t)ptr < (uintptr_t)pool + pool->size)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+size_t tlsf_heap_size(const void *ptr)
+{
+    return _size(_block(ptr));
+}
+
+void tlsf_heap_walk(const tlsf_heap_t *heap, tlsf_heap_walker_t walker,
+                    void *arg)
+{
+    for (tlsf_pool_t *pool = heap->pools; pool; pool = pool->next) {
+        for (tlsf_block_t *block = _first(pool); _size(block) > 0;
+             block = _next(block)) {
+            walker(_ptr(block), _size(block), !_is_free(block), arg);
+        }
+    }
+}
+
+static void _stats_walker(void *ptr, size_t size, int used, void *arg)
+{
+    tlsf_heap_stats_t *stats = arg;
+
+    (void)ptr;
+    if (used) {
+        stats->used += size + HDR;
+        stats->used_blocks++;
+    }
+    else {
+        stats->free += size;
+        stats->free_blocks++;
+        if (size > stats->largest) {
+            stats->largest = size;
+        }
+    }
+}
+
+void tlsf_heap_stats(const tlsf_heap_t *heap, tlsf_heap_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    for (const tlsf_pool_t *pool = heap->pools; pool; pool = pool->next) {
+        stats->size += pool->size;
+    }
+    stats->peak = heap->peak;
+    tlsf_heap_walk(heap, _stats_walker, stats);
+}
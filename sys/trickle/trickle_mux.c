@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "random.h"
+#include "trickle.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_MS);
+}
+
+/* xorshift32, so an interval costs neither a call to the random module nor
+ * a division */
+static uint32_t _rand(trickle_mux_inst_t *inst, uint32_t range)
+{
+    uint32_t x = inst->rand;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    inst->rand = x;
+    return ((uint64_t)x * range) >> 32;
+}
+
+static void _begin_interval(trickle_mux_inst_t *inst, uint32_t start)
+{
+    inst->start = start;
+    inst->c = 0;
+    inst->called = false;
+    inst->t = (inst->I / 2) + _rand(inst, inst->I - (inst->I / 2));
+    DEBUG("trickle_mux: I == %" PRIu32 ", t == %" PRIu32 "\n", inst->I, inst->t);
+}
+
+static inline uint32_t _deadline(const trickle_mux_inst_t *inst)
+{
+    return inst->start + (inst->called ? inst->I : inst->t);
+}
+
+static inline bool _before(const trickle_mux_inst_t *a, const trickle_mux_inst_t *b)
+{
+    return (int32_t)(_deadline(a) - _deadline(b)) < 0;
+}
+
+static inline void _place(trickle_mux_t *mux, unsigned idx, trickle_mux_inst_t *inst)
+{
+    mux->heap[idx] = inst;
+    inst->pos = idx + 1;
+}
+
+/* moves the instance at idx up or down to where its deadline belongs */
+static void _sift(trickle_mux_t *mux, unsigned idx)
+{
+    trickle_mux_inst_t *inst = mux->heap[idx];
+
+    while (idx > 0) {
+        unsigned parent = (idx - 1) / 2;
+
+        if (!_before(inst, mux->heap[parent])) {
+            break;
+        }
+        _place(mux, idx, mux->heap[parent]);
+        idx = parent;
+    }
+    while (1) {
+        unsigned child = (2 * idx) + 1;
+
+        if (child >= mux->numof) {
+            break;
+        }
+        if (((child + 1) < mux->numof) &&
+            _before(mux->heap[child + 1], mux->heap[child])) {
+            child++;
+        }
+        if (!_before(mux->heap[child], inst)) {
+            break;
+        }
+        _place(mux, idx, mux->heap[child]);
+        idx = child;
+    }
+    _place(mux, idx, inst);
+}
+
+/* sets the timer for the earliest deadline, unless it already is */
+static void _arm(trickle_mux_t *mux)
+{
+    uint32_t due, offset;
+
+    if (mux->numof == 0) {
+        if (mux->armed) {
+            xtimer_remove(&mux->timer);
+            mux->armed = false;
+            mux->timer_ops++;
+        }
+        return;
+    }
+    /* round up, so that close deadlines share a wakeup */
+    due = _deadline(mux->heap[0]) + TRICKLE_MUX_TICK - 1;
+    due -= due % TRICKLE_MUX_TICK;
+    if (mux->armed && (mux->due == due)) {
+        return;
+    }
+    offset = due - _now();
+    if ((int32_t)offset < 0) {
+        offset = 0;
+    }
+    else if (offset > (UINT32_MAX / US_PER_MS)) {
+        /* wake up early, nothing will be due then */
+        offset = UINT32_MAX / US_PER_MS;
+    }
+    xtimer_set_msg(&mux->timer, offset * US_PER_MS, &mux->msg, mux->pid);
+    mux->armed = true;
+    mux->due = due;
+    mux->timer_ops++;
+}
+
+void trickle_mux_init(trickle_mux_t *mux, trickle_mux_inst_t **heap, unsigned size,
+                      kernel_pid_t pid, uint16_t msg_type)
+{
+    memset(mux, 0, sizeof(*mux));
+    mux->heap = heap;
+    mux->size = size;
+    mux->pid = pid;
+    mux->msg.type = msg_type;
+    mux->msg.content.ptr = mux;
+}
+
+int trickle_mux_start(trickle_mux_t *mux, trickle_mux_inst_t *inst, uint32_t Imin,
+                      uint8_t Imax, uint8_t k)
+{
+    uint32_t max_interval;
+
+    /* deadlines are compared by their signed difference */
+    if ((Imin == 0) || (Imax >= 31) || (Imin > ((uint32_t)INT32_MAX >> Imax))) {
+        return -EINVAL;
+    }
+    if (mux->numof >= mux->size) {
+        return -ENOMEM;
+    }
+    max_interval = Imin << Imax;
+    inst->k = k;
+    inst->Imin = Imin;
+    inst->Imax = Imax;
+    /* the only draw from the random module, instances started at the same
+     * time still get out of step */
+    inst->rand = random_uint32() | 1;
+    inst->I = Imin + _rand(inst, 4 * Imin);
+    if (inst->I > max_interval) {
+        inst->I = max_interval;
+    }
+    _begin_interval(inst, _now());
+    mux->heap[mux->numof] = inst;
+    _sift(mux, mux->numof++);
+    _arm(mux);
+    return 0;
+}
+
+void trickle_mux_stop(trickle_mux_t *mux, trickle_mux_inst_t *inst)
+{
+    unsigned idx;
+
+    if (inst->pos == 0) {
+        return;
+    }
+    idx = inst->pos - 1;
+    inst->pos = 0;
+    if (idx < --mux->numof) {
+        mux->heap[idx] = mux->heap[mux->numof];
+        _sift(mux, idx);
+    }
+    _arm(mux);
+}
+
+void trickle_mux_reset(trickle_mux_t *mux, trickle_mux_inst_t *inst)
+{
+    if ((inst->pos == 0) || (inst->I == inst->Imin)) {
+        return;
+    }
+    inst->I = inst->Imin;
+    _begin_interval(inst, _now());
+    _sift(mux, inst->pos - 1);
+    _arm(mux);
+}
+
+void trickle_mux_handle(trickle_mux_t *mux)
+{
+    uint32_t now = _now();
+
+    mux->wakeups++;
+    if ((int32_t)(mux->due - now) <= 0) {
+        mux->armed = false;
+    }
+    while ((mux->numof > 0) && ((int32_t)(_deadline(mux->heap[0]) - now) <= 0)) {
+        trickle_mux_inst_t *inst = mux->heap[0];
+
+        if (!inst->called) {
+            inst->called = true;
+            /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
+            if ((inst->c < inst->k) || (inst->k == 0)) {
+                mux->callbacks++;
+                inst->callback.func(inst->callback.args);
+            }
+        }
+        else {
+            uint32_t max_interval = inst->Imin << inst->Imax;
+            uint32_t start = inst->start + inst->I;
+
+            inst->I = (inst->I > (max_interval / 2)) ? max_interval : (inst->I * 2);
+            _begin_interval(inst, start);
+        }
+        /* the callback may have stopped or reset the instance */
+        if (inst->pos != 0) {
+            _sift(mux, inst->pos - 1);
+        }
+    }
+    _arm(mux);
+}
+
+/** @} */
@@ -259,7 +259,8 @@ typedef bool (*_ubjson_read_struct_continue)(ubjson_cookie_t *restrict cookie, c
                                              ubjson_type_t *type1, ssize_t *content1);
 
 static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restrict cookie,
-                                                         _ubjson_read_struct_continue get_continue)
+                                                         _ubjson_read_struct_continue get_continue,
+                                                         bool array)
 {
     ubjson_read_callback_result_t result;
     ssize_t count = -1;
@@ -281,7 +282,13 @@ static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restri
         if (result != UBJSON_OKAY) {
             return result;
         }
-        READ_MARKER();
+        /* the elements of a typed array have no marker to peek at */
+        if (array && (type_marker != 0)) {
+            marker = 0;
+        }
+        else {
+            READ_MARKER();
+        }
     }
 
     cookie->marker = marker;
@@ -298,7 +305,12 @@ static ubjson_read_callback_result_t _ubjson_read_struct(ubjson_cookie_t *restri
         ubjson_type_t type1;
         ssize_t content1;
 
-        READ_MARKER();
+        if (array && (type_marker != 0)) {
+            marker = 0;
+        }
+        else {
+            READ_MARKER();
+        }
         if (!get_continue(cookie, marker, &result, count, index, &type1, &content1)
             || (result != UBJSON_OKAY)) {
             break;
@@ -356,12 +368,12 @@ static bool _ubjson_read_object_continue(ubjson_cookie_t *restrict cookie, char
 
 ubjson_read_callback_result_t ubjson_read_array(ubjson_cookie_t *restrict cookie)
 {
-    return _ubjson_read_struct(cookie, _ubjson_read_array_continue);
+    return _ubjson_read_struct(cookie, _ubjson_read_array_continue, true);
 }
 
 ubjson_read_callback_result_t ubjson_read_object(ubjson_cookie_t *restrict cookie)
 {
-    return _ubjson_read_struct(cookie, _ubjson_read_object_continue);
+    return _ubjson_read_struct(cookie, _ubjson_read_object_continue, false);
 }
 
 ubjson_read_callback_result_t ubjson_read_next(ubjson_cookie_t *restrict cookie)
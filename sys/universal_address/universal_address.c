@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +26,9 @@
 #include "net/gnrc/ipv6.h"
 #endif
 #endif
+#include "bitarithm.h"
+#include "byteorder.h"
+#include "memarray.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -46,21 +50,125 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES > UINT16_MAX
+#error "UNIVERSAL_ADDRESS_MAX_ENTRIES must fit the 16 bit hash index"
+#endif
+
+/**
+ * @brief Number of hash buckets, defaults to one per entry
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_BUCKETS
+#   if UNIVERSAL_ADDRESS_MAX_ENTRIES > 0
+#       define UNIVERSAL_ADDRESS_HASH_BUCKETS   (UNIVERSAL_ADDRESS_MAX_ENTRIES)
+#   else
+#       define UNIVERSAL_ADDRESS_HASH_BUCKETS   (1)
+#   endif
+#endif
+
 /**
- * @brief counter indicating the number of entries allocated
+ * @brief Addresses are compared in words of this size
  */
-static size_t universal_address_table_filled = 0;
+#define UA_WORD_SIZE    (sizeof(unsigned))
 
 /**
  * @brief The array of universal_address containers
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief pool of the containers, its use count is the number of entries in use
+ */
+static memarray_t universal_address_mem = MEMARRAY_INIT(universal_address_table,
+                                                        UNIVERSAL_ADDRESS_MAX_ENTRIES);
+
+/**
+ * @brief hash index of the entries in use, holding the table index + 1 of the
+ *        first entry of each bucket, or 0 if the bucket is empty
+ */
+static uint16_t universal_address_buckets[UNIVERSAL_ADDRESS_HASH_BUCKETS];
+
+/**
+ * @brief table index + 1 of the next entry in the same bucket, or 0
+ */
+static uint16_t universal_address_chain[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief loads up to one word of an address in network byte order, so the
+ *        most significant bit of the word is the first bit of the address
+ *
+ * @param[in] addr  pointer to the address bytes
+ * @param[in] len   number of bytes left in the address, missing ones are 0
+ */
+static inline unsigned _word(const uint8_t *addr, size_t len)
+{
+#if ARCH_32_BIT
+    network_uint32_t w = { .u32 = 0 };
+#else
+    network_uint16_t w = { .u16 = 0 };
+#endif
+
+    /* a copy of constant size compiles to a single load */
+    if (len >= sizeof(w)) {
+        memcpy(w.u8, addr, sizeof(w));
+    }
+    else {
+        memcpy(w.u8, addr, len);
+    }
+#if ARCH_32_BIT
+    return byteorder_ntohl(w);
+#else
+    return byteorder_ntohs(w);
+#endif
+}
+
+/**
+ * @brief gets the hash bucket of an address
+ */
+static unsigned _bucket(const uint8_t *addr, size_t addr_size)
+{
+    uint32_t hash = 2166136261U ^ addr_size;
+
+    for (size_t i = 0; i < addr_size; i += UA_WORD_SIZE) {
+        hash = (hash ^ _word(&addr[i], addr_size - i)) * 16777619U;
+    }
+    return (hash ^ (hash >> 16)) % UNIVERSAL_ADDRESS_HASH_BUCKETS;
+}
+
+/**
+ * @brief counts the leading bits two addresses of the same size have in common
+ *
+ * @return the number of equal bits, `addr_size * 8` if the addresses are equal
+ */
+static size_t _common_bits(const uint8_t *a, const uint8_t *b, size_t addr_size)
+{
+    for (size_t i = 0; i < addr_size; i += UA_WORD_SIZE) {
+        unsigned diff = _word(&a[i], addr_size - i) ^ _word(&b[i], addr_size - i);
+
+        if (diff != 0) {
+            return (i << 3) + (UA_WORD_SIZE * 8) - 1 - bitarithm_msb(diff);
+        }
+    }
+    return addr_size << 3;
+}
+
+/**
+ * @brief checks if an address consists of `0`s only
+ */
+static bool _is_zero(const uint8_t *addr, size_t addr_size)
+{
+    for (size_t i = 0; i < addr_size; i += UA_WORD_SIZE) {
+        if (_word(&addr[i], addr_size - i) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,11 +180,14 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    unsigned i = universal_address_buckets[_bucket(addr, addr_size)];
+
+    for ( ; i != 0; i = universal_address_chain[i - 1]) {
+        universal_address_container_t *entry = &universal_address_table[i - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
         }
     }
 
@@ -84,22 +195,30 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
 }
 
 /**
- * @brief finds the next empty or unused universal address containers
- *
- * @return pointer to the next free/unused universal_address_container_t
- *         or NULL if no memory is left in universal_address_table
+ * @brief adds an entry in use to the hash index
  */
-static universal_address_container_t *universal_address_get_next_unused_entry(void)
+static void universal_address_link(universal_address_container_t *entry)
 {
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
-        }
-    }
+    unsigned bucket = _bucket(entry->address, entry->address_size);
+    unsigned idx = memarray_idx(&universal_address_mem, entry);
 
-    return NULL;
+    universal_address_chain[idx] = universal_address_buckets[bucket];
+    universal_address_buckets[bucket] = idx + 1;
+}
+
+/**
+ * @brief removes an entry from the hash index
+ */
+static void universal_address_unlink(universal_address_container_t *entry)
+{
+    unsigned idx = memarray_idx(&universal_address_mem, entry) + 1;
+    uint16_t *link = &universal_address_buckets[_bucket(entry->address,
+                                                        entry->address_size)];
+
+    while (*link != idx) {
+        link = &universal_address_chain[*link - 1];
+    }
+    *link = universal_address_chain[idx - 1];
 }
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
@@ -109,7 +228,7 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
     if (pEntry == NULL) {
         /* look for a free entry */
-        pEntry = universal_address_get_next_unused_entry();
+        pEntry = memarray_alloc(&universal_address_mem);
 
         if (pEntry == NULL) {
             mutex_unlock(&mtx_access);
@@ -117,28 +236,21 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
-        /* look if the former memory has distinct size */
-        if (pEntry->address_size != addr_size) {
-            /* clean the address */
-            memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
+        DEBUG("[universal_address_add] universal_address_table_filled: %u\n", \
+              universal_address_mem.used);
 
-            /* set the used bytes */
-            pEntry->address_size = addr_size;
-            pEntry->use_count = 0;
-        }
+        /* clean the address and set the used bytes */
+        memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
+        pEntry->address_size = addr_size;
+        pEntry->use_count = 0;
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+        universal_address_link(pEntry);
     }
 
     pEntry->use_count++;
 
-    if (pEntry->use_count == 1) {
-        DEBUG("[universal_address_add] universal_address_table_filled: %d\n", \
-              (int)universal_address_table_filled);
-        universal_address_table_filled++;
-    }
-
     mutex_unlock(&mtx_access);
     return pEntry;
 }
@@ -154,12 +266,13 @@ void universal_address_rem(universal_address_container_t *entry)
             entry->use_count--;
 
             if (entry->use_count == 0) {
-                universal_address_table_filled--;
+                universal_address_unlink(entry);
+                memarray_free(&universal_address_mem, entry);
             }
         }
         else {
-            DEBUG("[universal_address_rem] universal_address_table_filled: %d\n", \
-                  (int)universal_address_table_filled);
+            DEBUG("[universal_address_rem] universal_address_table_filled: %u\n", \
+                  universal_address_mem.used);
         }
     }
 
@@ -196,45 +309,23 @@ int universal_address_compare(universal_address_container_t *entry,
         return ret;
     }
 
-    /* compare up to fist distinct byte, pretty clumsy method for now */
-    int idx = -1;
-    bool test_all_zeros = true;
-    for (size_t i = 0; i < entry->address_size; i++) {
-        if ((idx == -1) && (entry->address[i] != addr[i])) {
-            idx = i;
-        }
-        if (test_all_zeros) {
-            test_all_zeros = (entry->address[i] == 0);
-        }
-        if ((idx != -1) && !test_all_zeros) {
-            break;
-        }
-    }
-
     /* if the address is all 0 its a default route address */
-    if (test_all_zeros) {
+    if (_is_zero(entry->address, entry->address_size)) {
         *addr_size_in_bits = 0;
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS;
     }
 
-    /* if we have no distinct bytes the addresses are equal */
-    if (idx == -1) {
+    /* get the total number of matching bits */
+    size_t bits = _common_bits(entry->address, addr, entry->address_size);
+
+    /* if we have no distinct bits the addresses are equal */
+    if (bits == *addr_size_in_bits) {
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_EQUAL;
     }
 
-    /* count equal bits */
-    uint8_t xor = entry->address[idx]^addr[idx];
-    int8_t j = 7;
-    for ( ; j > 0; --j) {
-        if ((xor >> j) & 0x01) {
-            break;
-        }
-    }
-
-    /* get the total number of matching bits */
-    *addr_size_in_bits = (idx << 3) + j;
+    *addr_size_in_bits = bits;
     ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
 
     mutex_unlock(&mtx_access);
@@ -252,38 +343,26 @@ int universal_address_compare_prefix(universal_address_container_t *entry,
         return ret;
     }
 
-    /* Get the index of the first trailing `0` */
-    int i = 0;
-    for (i = entry->address_size-1; i >= 0; --i) {
-        if (prefix[i] != 0) {
+    /* the prefix ends with its last `1` bit, search backwards until i wraps */
+    size_t prefix_len = 0;
+    for (size_t i = ((entry->address_size - 1) / UA_WORD_SIZE) * UA_WORD_SIZE;
+         i < entry->address_size; i -= UA_WORD_SIZE) {
+        unsigned word = _word(&prefix[i], entry->address_size - i);
+
+        if (word != 0) {
+            prefix_len = ((i + UA_WORD_SIZE) << 3) - bitarithm_lsb(word);
             break;
         }
     }
 
-    if (memcmp(entry->address, prefix, i) == 0) {
-        /* if the bytes-1 equals we check the bits of the lowest byte */
-        uint8_t bitmask = 0x00;
-        /* get a bitmask for the trailing 0b */
-        for (uint8_t j = 0; j < 8; ++j) {
-            if ((prefix[i] >> j) & 0x01) {
-                bitmask = 0xff << j;
-                break;
-            }
-        }
+    size_t bits = _common_bits(entry->address, prefix, entry->address_size);
 
-        if ((entry->address[i] & bitmask) == (prefix[i] & bitmask)) {
-            ret = entry->address[i] != prefix[i];
-            if (ret == UNIVERSAL_ADDRESS_EQUAL) {
-                /* check if the remaining bits from entry are significant */
-                i++;
-                for ( ; i < entry->address_size; ++i) {
-                    if (entry->address[i] != 0) {
-                        ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
-                        break;
-                    }
-                }
-            }
-        }
+    if (bits == prefix_size_in_bits) {
+        ret = UNIVERSAL_ADDRESS_EQUAL;
+    }
+    else if (bits >= prefix_len) {
+        /* the remaining bits from entry are significant */
+        ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
     }
 
     mutex_unlock(&mtx_access);
@@ -299,6 +378,10 @@ void universal_address_init(void)
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
+    memarray_init(&universal_address_mem, universal_address_table,
+                  sizeof(universal_address_table[0]),
+                  UNIVERSAL_ADDRESS_MAX_ENTRIES);
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
 
     mutex_unlock(&mtx_access);
 }
@@ -311,7 +394,10 @@ void universal_address_reset(void)
         universal_address_table[i].use_count = 0;
     }
 
-    universal_address_table_filled = 0;
+    memarray_init(&universal_address_mem, universal_address_table,
+                  sizeof(universal_address_table[0]),
+                  UNIVERSAL_ADDRESS_MAX_ENTRIES);
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
     mutex_unlock(&mtx_access);
 }
 
@@ -338,15 +424,15 @@ address_size: %d, content: ", \
 int universal_address_get_num_used_entries(void)
 {
     mutex_lock(&mtx_access);
-    size_t ret = universal_address_table_filled;
+    size_t ret = universal_address_mem.used;
     mutex_unlock(&mtx_access);
     return ret;
 }
 
 void universal_address_print_table(void)
 {
-    printf("[universal_address_print_table] universal_address_table_filled: %d\n", \
-           (int)universal_address_table_filled);
+    printf("[universal_address_print_table] universal_address_table_filled: %u\n", \
+           universal_address_mem.used);
 
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
         universal_address_print_entry(&universal_address_table[i]);
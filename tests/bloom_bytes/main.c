@@ -31,6 +31,7 @@
 
 #define BLOOM_BITS (1UL << 12)
 #define BLOOM_HASHF (8)
+#define BLOOM_BLOCKED_K (4)
 #define lenB 512
 #define lenA (10 * 1000)
 
@@ -40,7 +41,20 @@
 #define myseed 0x83d385c0 /* random number */
 
 #define BUF_SIZE 50
-static uint32_t buf[BUF_SIZE];
+#define BATCH 8
+
+typedef struct {
+    const char *name;
+    void (*add)(const uint8_t *buf, size_t len);
+    bool (*check)(const uint8_t *buf, size_t len);
+    /* handle BATCH buffers at once */
+    void (*add_many)(const uint8_t *const *bufs, const size_t *lens);
+    unsigned (*check_many)(const uint8_t *const *bufs, const size_t *lens);
+} filter_t;
+
+static uint32_t buf[BATCH][BUF_SIZE];
+static const uint8_t *bufs[BATCH];
+static size_t lens[BATCH];
 static bloom_t bloom;
 BITFIELD(bf, BLOOM_BITS);
 hashfp_t hashes[BLOOM_HASHF] = {
@@ -48,6 +62,10 @@ hashfp_t hashes[BLOOM_HASHF] = {
     (hashfp_t) djb2_hash, (hashfp_t) kr_hash, (hashfp_t) dek_hash,
     (hashfp_t) rotating_hash, (hashfp_t) one_at_a_time_hash,
 };
+static bloom_blocked_t blocked;
+static uint32_t blocks[BLOOM_BLOCKS(BLOOM_BITS)];
+static bloom_counting_t counting;
+static uint8_t counters[BLOOM_COUNTING_SIZE(BLOOM_BLOCKS(BLOOM_BITS))];
 
 static void buf_fill(uint32_t *buf, int len)
 {
@@ -56,60 +74,171 @@ static void buf_fill(uint32_t *buf, int len)
     }
 }
 
-int main(void)
+static void _classic_add(const uint8_t *buf, size_t len)
 {
-    xtimer_init();
+    bloom_add(&bloom, buf, len);
+}
 
-    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+static bool _classic_check(const uint8_t *buf, size_t len)
+{
+    return bloom_check(&bloom, buf, len);
+}
 
-    printf("Testing Bloom filter.\n\n");
-    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
-           (uint32_t) bloom.k);
+static void _blocked_add(const uint8_t *buf, size_t len)
+{
+    bloom_blocked_add(&blocked, buf, len);
+}
 
-    random_init(myseed);
+static bool _blocked_check(const uint8_t *buf, size_t len)
+{
+    return bloom_blocked_check(&blocked, buf, len);
+}
 
-    unsigned long t1 = xtimer_now_usec();
+static void _blocked_add_many(const uint8_t *const *bufs, const size_t *lens)
+{
+    bloom_blocked_add_many(&blocked, bufs, lens, BATCH);
+}
 
-    for (int i = 0; i < lenB; i++) {
-        buf_fill(buf, BUF_SIZE);
-        buf[0] = MAGIC_B;
-        bloom_add(&bloom,
-                  (uint8_t *) buf,
-                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
-    }
+static unsigned _blocked_check_many(const uint8_t *const *bufs,
+                                    const size_t *lens)
+{
+    return bloom_blocked_check_many(&blocked, bufs, lens, BATCH, NULL);
+}
 
-    unsigned long t2 = xtimer_now_usec();
-    printf("adding %d elements took %" PRIu32 "ms\n", lenB,
-           (uint32_t) (t2 - t1) / 1000);
+static void _counting_add(const uint8_t *buf, size_t len)
+{
+    bloom_counting_add(&counting, buf, len);
+}
 
-    int in = 0;
-    int not_in = 0;
+static bool _counting_check(const uint8_t *buf, size_t len)
+{
+    return bloom_counting_check(&counting, buf, len);
+}
+
+static const filter_t filters[] = {
+    { "classic", _classic_add, _classic_check, NULL, NULL },
+    { "blocked", _blocked_add, _blocked_check, NULL, NULL },
+    { "blocked batch", NULL, NULL, _blocked_add_many, _blocked_check_many },
+    { "counting", _counting_add, _counting_check, NULL, NULL },
+};
 
-    unsigned long t3 = xtimer_now_usec();
+/* fills a batch of buffers, which is not part of the measured time */
+static void batch_fill(uint32_t magic)
+{
+    for (int b = 0; b < BATCH; b++) {
+        buf_fill(buf[b], BUF_SIZE);
+        buf[b][0] = magic;
+    }
+}
 
-    for (int i = 0; i < lenA; i++) {
-        buf_fill(buf, BUF_SIZE);
-        buf[0] = MAGIC_A;
+static uint32_t batch_add(const filter_t *filter)
+{
+    uint32_t start = xtimer_now_usec();
 
-        if (bloom_check(&bloom,
-                        (uint8_t *) buf,
-                        BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
-            in++;
+    if (filter->add_many) {
+        filter->add_many(bufs, lens);
+    }
+    else {
+        for (int b = 0; b < BATCH; b++) {
+            filter->add(bufs[b], lens[b]);
         }
-        else {
-            not_in++;
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t batch_check(const filter_t *filter, int *in)
+{
+    uint32_t start = xtimer_now_usec();
+
+    if (filter->check_many) {
+        *in += filter->check_many(bufs, lens);
+    }
+    else {
+        for (int b = 0; b < BATCH; b++) {
+            *in += filter->check(bufs[b], lens[b]);
         }
     }
+    return xtimer_now_usec() - start;
+}
 
-    unsigned long t4 = xtimer_now_usec();
-    printf("checking %d elements took %" PRIu32 "ms\n", lenA,
-           (uint32_t) (t4 - t3) / 1000);
+static unsigned long rate(int num, uint32_t usec)
+{
+    return ((uint64_t)num * US_PER_SEC) / (usec ? usec : 1);
+}
 
-    printf("\n");
+static void run(const filter_t *filter)
+{
+    uint32_t t_add = 0, t_check = 0;
+    int in = 0;
+
+    /* every filter sees the same elements */
+    random_init(myseed);
+
+    for (int i = 0; i < lenB; i += BATCH) {
+        batch_fill(MAGIC_B);
+        t_add += batch_add(filter);
+    }
+
+    for (int i = 0; i < lenA; i += BATCH) {
+        batch_fill(MAGIC_A);
+        t_check += batch_check(filter, &in);
+    }
+
+    printf("%s:\n", filter->name);
+    printf("adding %d elements took %" PRIu32 "us (%lu/s)\n", lenB, t_add,
+           rate(lenB, t_add));
+    printf("checking %d elements took %" PRIu32 "us (%lu/s)\n", lenA,
+           t_check, rate(lenA, t_check));
     printf("%d elements probably in the filter.\n", in);
-    printf("%d elements not in the filter.\n", not_in);
+    printf("%d elements not in the filter.\n", lenA - in);
     double false_positive_rate = (double) in / (double) lenA;
-    printf("%f false positive rate.\n", false_positive_rate);
+    printf("%f false positive rate.\n\n", false_positive_rate);
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    for (int b = 0; b < BATCH; b++) {
+        bufs[b] = (const uint8_t *)buf[b];
+        lens[b] = sizeof(buf[b]);
+    }
+
+    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+    bloom_blocked_init(&blocked, blocks, BLOOM_BLOCKS(BLOOM_BITS),
+                       BLOOM_BLOCKED_K);
+    bloom_counting_init(&counting, counters, BLOOM_BLOCKS(BLOOM_BITS),
+                        BLOOM_BLOCKED_K);
+
+    printf("Testing Bloom filter.\n\n");
+    printf("m: %" PRIu32 " k: %" PRIu32 " (blocked k: %d)\n\n",
+           (uint32_t) bloom.m, (uint32_t) bloom.k, BLOOM_BLOCKED_K);
+
+    for (unsigned f = 0; f < sizeof(filters) / sizeof(filters[0]); f++) {
+        if (filters[f].add_many) {
+            /* fill the filter anew, but keep the same content */
+            bloom_blocked_clear(&blocked);
+        }
+        run(&filters[f]);
+    }
+
+    /* the counting filter must be empty again after removing everything */
+    random_init(myseed);
+    int failed = 0;
+    uint32_t t_remove = 0;
+    for (int i = 0; i < lenB; i += BATCH) {
+        batch_fill(MAGIC_B);
+        uint32_t start = xtimer_now_usec();
+        for (int b = 0; b < BATCH; b++) {
+            failed += (bloom_counting_remove(&counting, bufs[b], lens[b]) != 0);
+        }
+        t_remove += xtimer_now_usec() - start;
+    }
+    for (unsigned i = 0; i < sizeof(counters); i++) {
+        failed += (counters[i] != 0);
+    }
+    printf("removing %d elements took %" PRIu32 "us (%lu/s), %d failed\n",
+           lenB, t_remove, rate(lenB, t_remove), failed);
 
     bloom_del(&bloom);
     printf("\nAll done!\n");
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the streaming CBOR writer and cursor reader with the
+ *              buffer based CBOR API on a batch of sensor samples
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cbor.h"
+#include "phydat.h"
+#include "xtimer.h"
+
+#define SAMPLES         (1000U)
+/* at most 1 + 5 + 1 + 2 + 3 * 3 bytes per sample, and the array header */
+#define DOC_MAX         (SAMPLES * 18U + 8U)
+#define CHUNK           (64U)
+#define ROUNDS          (10U)
+
+static phydat_t _samples[SAMPLES];
+static unsigned char _doc[DOC_MAX];
+static uint8_t _chunk[CHUNK];
+
+/* reference document, for checking the data passed to the sink */
+static cbor_stream_t _ref;
+static size_t _sink_pos;
+static unsigned _sink_calls;
+
+static void _gen(void)
+{
+    uint32_t seed = 1;
+
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            seed = (seed * 1103515245U) + 12345U;
+            _samples[i].val[j] = (int16_t)(seed >> 12);
+        }
+        _samples[i].unit = UNIT_TEMP_C;
+        _samples[i].scale = -2;
+    }
+}
+
+/* [_ [timestamp, unit, scale, x, y, z], ...] */
+static void _encode_stream(cbor_stream_t *s)
+{
+    cbor_clear(s);
+    cbor_serialize_array_indefinite(s);
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        cbor_serialize_array(s, 3 + PHYDAT_DIM);
+        cbor_serialize_uint64_t(s, 1000000UL + (i * 1000UL));
+        cbor_serialize_int(s, _samples[i].unit);
+        cbor_serialize_int(s, _samples[i].scale);
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            cbor_serialize_int(s, _samples[i].val[j]);
+        }
+    }
+    cbor_write_break(s);
+}
+
+static int _sink(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    if ((_sink_pos + len > _ref.pos) ||
+        (memcmp(_ref.data + _sink_pos, data, len) != 0)) {
+        return -EIO;
+    }
+    _sink_pos += len;
+    _sink_calls++;
+    return 0;
+}
+
+static int _encode_writer(void)
+{
+    cbor_writer_t w;
+
+    _sink_pos = 0;
+    _sink_calls = 0;
+    cbor_writer_init(&w, _chunk, sizeof(_chunk), _sink, NULL);
+    cbor_writer_array_indefinite(&w);
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        cbor_writer_array(&w, 3 + PHYDAT_DIM);
+        cbor_writer_uint(&w, 1000000UL + (i * 1000UL));
+        cbor_writer_int(&w, _samples[i].unit);
+        cbor_writer_int(&w, _samples[i].scale);
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            cbor_writer_int(&w, _samples[i].val[j]);
+        }
+    }
+    cbor_writer_break(&w);
+    return cbor_writer_flush(&w);
+}
+
+/* Decodes all samples with the offset based API, returns the sum of values */
+static int32_t _decode_stream(const cbor_stream_t *s)
+{
+    size_t offset = cbor_deserialize_array_indefinite(s, 0);
+    int32_t sum = 0;
+
+    while (!cbor_at_break(s, offset)) {
+        size_t len;
+        uint64_t ts;
+        int val;
+
+        offset += cbor_deserialize_array(s, offset, &len);
+        offset += cbor_deserialize_uint64_t(s, offset, &ts);
+        for (unsigned j = 1; j < len; j++) {
+            offset += cbor_deserialize_int(s, offset, &val);
+            if (j >= 3) {
+                sum += val;
+            }
+        }
+    }
+    return sum;
+}
+
+static int32_t _decode_reader(const cbor_stream_t *s)
+{
+    cbor_reader_t r;
+    cbor_item_t item;
+    int32_t sum = 0;
+
+    cbor_reader_init(&r, s->data, s->pos);
+    cbor_reader_next(&r, &item);
+    while ((cbor_reader_next(&r, &item) == 0) && (item.type == CBOR_TYPE_ARRAY)) {
+        for (unsigned j = 0; j < item.val; j++) {
+            int64_t val;
+
+            cbor_reader_int(&r, &val);
+            if (j >= 3) {
+                sum += val;
+            }
+        }
+    }
+    return sum;
+}
+
+/* Finds the last sample, returns its first value */
+static int _seek_stream(const cbor_stream_t *s)
+{
+    size_t offset = cbor_deserialize_array_indefinite(s, 0);
+    int val = 0;
+
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        size_t len;
+        uint64_t ts;
+
+        offset += cbor_deserialize_array(s, offset, &len);
+        offset += cbor_deserialize_uint64_t(s, offset, &ts);
+        for (unsigned j = 1; j < len; j++) {
+            offset += cbor_deserialize_int(s, offset, &val);
+            if ((i == SAMPLES - 1) && (j == 3)) {
+                return val;
+            }
+        }
+    }
+    return 0;
+}
+
+static int _seek_reader(const cbor_stream_t *s)
+{
+    cbor_reader_t r;
+    cbor_item_t item;
+    int64_t val = 0;
+
+    cbor_reader_init(&r, s->data, s->pos);
+    cbor_reader_next(&r, &item);
+    for (unsigned i = 0; i < SAMPLES - 1; i++) {
+        cbor_reader_skip(&r);
+    }
+    cbor_reader_next(&r, &item);
+    for (unsigned j = 0; j < 4; j++) {
+        cbor_reader_int(&r, &val);
+    }
+    return val;
+}
+
+static void _report(const char *name, uint32_t usec, size_t ram)
+{
+    printf("%s: %lu us per run, %u bytes of buffer\n", name,
+           (unsigned long)(usec / ROUNDS), (unsigned)ram);
+}
+
+int main(void)
+{
+    uint32_t start;
+    int32_t expected = 0;
+    int ok = 1;
+
+    puts("CBOR benchmark\n");
+    _gen();
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        for (unsigned j = 0; j < PHYDAT_DIM; j++) {
+            expected += _samples[i].val[j];
+        }
+    }
+
+    cbor_init(&_ref, _doc, sizeof(_doc));
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        _encode_stream(&_ref);
+    }
+    _report("encode cbor_stream", xtimer_now_usec() - start, _ref.pos);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ok &= (_encode_writer() == 0) && (_sink_pos == _ref.pos);
+    }
+    _report("encode cbor_writer", xtimer_now_usec() - start, sizeof(_chunk));
+    printf("encode cbor_writer: %u bytes in %u sink calls\n",
+           (unsigned)_sink_pos, _sink_calls);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ok &= (_decode_stream(&_ref) == expected);
+    }
+    _report("decode cbor_stream", xtimer_now_usec() - start, 0);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ok &= (_decode_reader(&_ref) == expected);
+    }
+    _report("decode cbor_reader", xtimer_now_usec() - start, 0);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ok &= (_seek_stream(&_ref) == _samples[SAMPLES - 1].val[0]);
+    }
+    _report("seek last cbor_stream", xtimer_now_usec() - start, 0);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        ok &= (_seek_reader(&_ref) == _samples[SAMPLES - 1].val[0]);
+    }
+    _report("seek last cbor_reader", xtimer_now_usec() - start, 0);
+
+    puts(ok ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
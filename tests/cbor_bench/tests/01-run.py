@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"encode cbor_stream: \d+ us per run, (\d+) bytes of buffer")
+    size = int(child.match.group(1))
+    child.expect(r"encode cbor_writer: \d+ us per run, 64 bytes of buffer")
+    child.expect(r"encode cbor_writer: (\d+) bytes in \d+ sink calls")
+    assert int(child.match.group(1)) == size
+    for case in ("decode cbor_stream", "decode cbor_reader",
+                 "seek last cbor_stream", "seek last cbor_reader"):
+        child.expect(case + r": \d+ us per run")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
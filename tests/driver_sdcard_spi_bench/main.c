@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput test for the sdcard_spi driver against an emulated
+ *              card
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sdcard_spi.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "sdcard_emu.h"
+
+#define BLOCKS          (128U)  /* blocks per test */
+#define CHUNK           (16U)   /* blocks per multiple block command */
+/* bus clock used to estimate the throughput from the bytes on the bus */
+#define SPI_KHZ         (10000U)
+
+static sdcard_spi_t _card = {
+    .params = {
+        .spi_dev = SPI_DEV(0),
+        .cs = GPIO_UNDEF,
+        .clk = GPIO_UNDEF,
+        .mosi = GPIO_UNDEF,
+        .miso = GPIO_UNDEF,
+        .power = GPIO_UNDEF,
+    },
+    .spi_clk = SPI_CLK_10MHZ,
+    /* the emulated card is an initialized SDHC card */
+    .use_block_addr = true,
+    .init_done = true,
+    .card_type = SD_V2,
+};
+
+static char _data[BLOCKS * SD_HC_BLOCK_SIZE];
+static char _read[CHUNK * SD_HC_BLOCK_SIZE];
+static sdcard_spi_wb_t _wb;
+static char _wb_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _fill(unsigned seed)
+{
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (char)((i * 7) ^ (i >> 9) ^ seed);
+    }
+}
+
+static int _verify(void)
+{
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        if (memcmp(sdcard_emu_block(i), &_data[i * SD_HC_BLOCK_SIZE],
+                   SD_HC_BLOCK_SIZE) != 0) {
+            printf("block %u differs\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void _report(const char *name, uint32_t usec)
+{
+    sdcard_emu_stats_t stats;
+
+    sdcard_emu_stats(&stats);
+    /* each byte takes 8 clock cycles */
+    uint32_t bus_usec = (uint32_t)(((uint64_t)stats.bytes * 8 * 1000) / SPI_KHZ);
+    printf("%s: %u blocks in %lu us, %lu bus bytes (%lu busy) in %lu calls, "
+           "%lu KiB/s at %u kHz\n", name, BLOCKS, (unsigned long)usec,
+           (unsigned long)stats.bytes, (unsigned long)stats.busy,
+           (unsigned long)stats.calls,
+           (unsigned long)(((uint64_t)sizeof(_data) * US_PER_SEC / 1024) /
+                           (bus_usec ? bus_usec : 1)), SPI_KHZ);
+    if (stats.errors) {
+        printf("%s: %lu errors\n", name, (unsigned long)stats.errors);
+    }
+}
+
+/* blocks: number of blocks per command */
+static int _bench_write(const char *name, unsigned blocks)
+{
+    sd_rw_response_t state;
+
+    _fill(blocks);
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < BLOCKS; i += blocks) {
+        if (sdcard_spi_write_blocks(&_card, i, &_data[i * SD_HC_BLOCK_SIZE],
+                                    SD_HC_BLOCK_SIZE, blocks, &state) != (int)blocks) {
+            printf("%s: write failed (%d)\n", name, state);
+            return -1;
+        }
+    }
+    _report(name, xtimer_now_usec() - start);
+    return _verify();
+}
+
+static int _bench_read(const char *name, unsigned blocks)
+{
+    sd_rw_response_t state;
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < BLOCKS; i += blocks) {
+        if ((sdcard_spi_read_blocks(&_card, i, _read, SD_HC_BLOCK_SIZE, blocks,
+                                    &state) != (int)blocks) ||
+            (memcmp(_read, &_data[i * SD_HC_BLOCK_SIZE],
+                    blocks * SD_HC_BLOCK_SIZE) != 0)) {
+            printf("%s: read failed (%d)\n", name, state);
+            return -1;
+        }
+    }
+    _report(name, xtimer_now_usec() - start);
+    return 0;
+}
+
+/*
+ * A logger writes bursts of one queue length, block by block. Measures the
+ * time the logger spends in the write calls, and the total time until all
+ * blocks are on the card.
+ */
+static int _bench_async(void)
+{
+    uint32_t blocked = 0;
+
+    _fill(0xa5);
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        uint32_t t = xtimer_now_usec();
+        sdcard_spi_wb_write(&_wb, i, &_data[i * SD_HC_BLOCK_SIZE], 1);
+        blocked += xtimer_now_usec() - t;
+        if (((i + 1) % SDCARD_SPI_WB_BLOCKS) == 0) {
+            /* the logger is idle while collecting the next burst */
+            if (sdcard_spi_wb_flush(&_wb) != SD_RW_OK) {
+                puts("async: write failed");
+                return -1;
+            }
+        }
+    }
+    _report("async", xtimer_now_usec() - start);
+    printf("async: logger blocked for %lu us\n", (unsigned long)blocked);
+    return _verify();
+}
+
+int main(void)
+{
+    puts("sdcard_spi throughput test\n");
+
+    /* the writer thread only runs while the logger is idle */
+    sdcard_spi_wb_init(&_wb, &_card, _wb_stack, sizeof(_wb_stack),
+                       THREAD_PRIORITY_MAIN + 1);
+
+    if ((_bench_write("write single", 1) == 0) &&
+        (_bench_read("read single", 1) == 0) &&
+        (_bench_write("write multi", CHUNK) == 0) &&
+        (_bench_read("read multi", CHUNK) == 0) &&
+        (_bench_async() == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
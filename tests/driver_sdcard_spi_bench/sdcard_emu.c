@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an SD card in SPI mode attached, emulated in RAM
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "mutex.h"
+#include "periph/spi.h"
+
+#include "sdcard_emu.h"
+
+#define BLOCK_SIZE      (512U)
+
+typedef enum {
+    ST_CMD,             /**< idle, waiting for a command */
+    ST_NCR,             /**< gap between command and response */
+    ST_R1,              /**< R1 response */
+    ST_RD_WAIT,         /**< access time before a data block */
+    ST_RD_TOKEN,        /**< start block token of a data block */
+    ST_RD_DATA,         /**< data block sent to the host */
+    ST_RD_CRC,          /**< CRC16 of the data block */
+    ST_WR_TOKEN,        /**< waiting for a start block or stop token */
+    ST_WR_DATA,         /**< data block received from the host */
+    ST_WR_CRC,          /**< CRC16 of the data block */
+    ST_WR_RESP,         /**< data response token */
+    ST_STOP,            /**< byte after the stop token */
+    ST_BUSY,            /**< programming */
+} _state_t;
+
+static uint8_t _blocks[SDCARD_EMU_BLOCKS][BLOCK_SIZE];
+static uint8_t _buf[BLOCK_SIZE];
+static uint8_t _cmd[6];
+static unsigned _cmd_len;
+static _state_t _state = ST_CMD, _after_r1, _after_busy;
+static uint8_t _r1, _resp;
+static unsigned _pos, _busy;
+static uint32_t _addr, _erase_count;
+static uint16_t _crc;
+static uint8_t _multi, _app;
+static sdcard_emu_stats_t _stats;
+static mutex_t _lock = MUTEX_INIT;
+
+static uint8_t _crc_7(const uint8_t *data, unsigned n)
+{
+    uint8_t crc = 0;
+
+    for (unsigned i = 0; i < n; i++) {
+        uint8_t d = data[i];
+        for (unsigned j = 0; j < 8; j++) {
+            crc <<= 1;
+            if ((d ^ crc) & 0x80) {
+                crc ^= 0x09;
+            }
+            d <<= 1;
+        }
+    }
+    return (crc << 1) | 1;
+}
+
+static void _command(void)
+{
+    uint8_t idx = _cmd[0] & 0x3f;
+    uint32_t arg = ((uint32_t)_cmd[1] << 24) | ((uint32_t)_cmd[2] << 16) |
+                   ((uint32_t)_cmd[3] << 8) | _cmd[4];
+    uint8_t app = _app;
+
+    _state = ST_NCR;
+    _after_r1 = ST_CMD;
+    _r1 = 0x00;
+    _app = 0;
+    if (_crc_7(_cmd, 5) != _cmd[5]) {
+        _r1 = 0x08;     /* command CRC error */
+        _stats.errors++;
+        return;
+    }
+    switch (idx) {
+        case 12:
+            _multi = 0;
+            break;
+        case 17:
+        case 18:
+        case 24:
+        case 25:
+            if (arg >= SDCARD_EMU_BLOCKS) {
+                _r1 = 0x20;     /* address error */
+                _stats.errors++;
+                break;
+            }
+            _addr = arg;
+            _multi = (idx == 18) || (idx == 25);
+            _after_r1 = (idx < 24) ? ST_RD_WAIT : ST_WR_TOKEN;
+            if (idx == 24) {
+                _erase_count = 0;
+            }
+            break;
+        case 23:
+            if (!app) {
+                _r1 = 0x04;
+                _stats.errors++;
+                break;
+            }
+            _erase_count = arg;
+            break;
+        case 55:
+            _app = 1;
+            break;
+        default:
+            _r1 = 0x04;         /* illegal command */
+            _stats.errors++;
+            break;
+    }
+}
+
+static uint8_t _byte(uint8_t in)
+{
+    uint8_t out = 0xff;
+
+    _stats.bytes++;
+    switch (_state) {
+        case ST_CMD:
+            break;
+        case ST_NCR:
+            _state = ST_R1;
+            break;
+        case ST_R1:
+            out = _r1;
+            _state = _after_r1;
+            break;
+        case ST_RD_WAIT:
+            _state = (_addr < SDCARD_EMU_BLOCKS) ? ST_RD_TOKEN : ST_CMD;
+            break;
+        case ST_RD_TOKEN:
+            out = 0xfe;
+            _pos = 0;
+            _state = ST_RD_DATA;
+            break;
+        case ST_RD_DATA:
+            out = _blocks[_addr][_pos++];
+            if (_pos == BLOCK_SIZE) {
+                _crc = crc16_ccitt_update(0, _blocks[_addr], BLOCK_SIZE);
+                _pos = 0;
+                _state = ST_RD_CRC;
+            }
+            break;
+        case ST_RD_CRC:
+            out = (_pos++ == 0) ? (_crc >> 8) : (_crc & 0xff);
+            if (_pos == 2) {
+                _addr++;
+                _state = _multi ? ST_RD_WAIT : ST_CMD;
+            }
+            break;
+        case ST_WR_TOKEN:
+            if (in == (_multi ? 0xfc : 0xfe)) {
+                _pos = 0;
+                _state = ST_WR_DATA;
+            }
+            else if (_multi && (in == 0xfd)) {
+                _state = ST_STOP;
+            }
+            break;
+        case ST_WR_DATA:
+            _buf[_pos++] = in;
+            if (_pos == BLOCK_SIZE) {
+                _pos = 0;
+                _crc = 0;
+                _state = ST_WR_CRC;
+            }
+            break;
+        case ST_WR_CRC:
+            _crc = (_crc << 8) | in;
+            if (++_pos < 2) {
+                break;
+            }
+            if ((_addr < SDCARD_EMU_BLOCKS) &&
+                (_crc == crc16_ccitt_update(0, _buf, BLOCK_SIZE))) {
+                memcpy(_blocks[_addr], _buf, BLOCK_SIZE);
+                _resp = 0x05;   /* accepted */
+                _busy = SDCARD_EMU_BUSY_BYTES;
+                if (_erase_count > 0) {
+                    _erase_count--;
+                    _busy = SDCARD_EMU_BUSY_ERASED;
+                }
+            }
+            else {
+                _resp = 0x0b;   /* CRC error */
+                _busy = 0;
+                _stats.errors++;
+            }
+            _state = ST_WR_RESP;
+            break;
+        case ST_WR_RESP:
+            out = _resp;
+            _addr++;
+            _after_busy = _multi ? ST_WR_TOKEN : ST_CMD;
+            _state = ST_BUSY;
+            break;
+        case ST_STOP:
+            _multi = 0;
+            _erase_count = 0;
+            _busy = SDCARD_EMU_BUSY_ERASED;
+            _after_busy = ST_CMD;
+            _state = ST_BUSY;
+            break;
+        case ST_BUSY:
+            if (_busy > 0) {
+                _busy--;
+                _stats.busy++;
+                out = 0x00;
+            }
+            else {
+                _state = _after_busy;
+            }
+            break;
+    }
+
+    /* commands are accepted when idle and stop multiple block reads */
+    if ((_state == ST_CMD) || (_multi && (_state >= ST_RD_WAIT) &&
+                               (_state <= ST_RD_CRC))) {
+        if ((_cmd_len > 0) || ((in & 0xc0) == 0x40)) {
+            _cmd[_cmd_len++] = in;
+            if (_cmd_len == sizeof(_cmd)) {
+                _cmd_len = 0;
+                _command();
+            }
+        }
+    }
+    return out;
+}
+
+uint8_t *sdcard_emu_block(unsigned addr)
+{
+    return _blocks[addr];
+}
+
+void sdcard_emu_stats(sdcard_emu_stats_t *stats)
+{
+    *stats = _stats;
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void spi_init(spi_t bus)
+{
+    (void)bus;
+}
+
+void spi_init_pins(spi_t bus)
+{
+    (void)bus;
+}
+
+int spi_init_cs(spi_t bus, spi_cs_t cs)
+{
+    (void)bus;
+    (void)cs;
+    return SPI_OK;
+}
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    mutex_lock(&_lock);
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    (void)bus;
+    mutex_unlock(&_lock);
+}
+
+uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out)
+{
+    (void)bus;
+    (void)cs;
+    (void)cont;
+    _stats.calls++;
+    return _byte(out);
+}
+
+void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
+                        const void *out, void *in, size_t len)
+{
+    const uint8_t *out_buf = out;
+    uint8_t *in_buf = in;
+
+    (void)bus;
+    (void)cs;
+    (void)cont;
+    _stats.calls++;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t tmp = _byte((out_buf) ? out_buf[i] : 0);
+        if (in_buf) {
+            in_buf[i] = tmp;
+        }
+    }
+}
+
+uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out)
+{
+    spi_transfer_byte(bus, cs, true, reg);
+    return spi_transfer_byte(bus, cs, false, out);
+}
+
+void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
+                       const void *out, void *in, size_t len)
+{
+    spi_transfer_byte(bus, cs, true, reg);
+    spi_transfer_bytes(bus, cs, false, out, in, len);
+}
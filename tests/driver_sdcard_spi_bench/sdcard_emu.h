@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an SD card in SPI mode attached, emulated in RAM
+ *
+ * Implements the periph/spi API for boards without one, e.g. native. The card
+ * is an already initialized SDHC card that answers single and multiple block
+ * reads and writes, CMD12, and ACMD23. It checks command CRC7 and data CRC16,
+ * and signals busy for a fixed number of bytes after each written block.
+ */
+#ifndef SDCARD_EMU_H
+#define SDCARD_EMU_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of blocks of the emulated card
+ */
+#ifndef SDCARD_EMU_BLOCKS
+#define SDCARD_EMU_BLOCKS           (512U)
+#endif
+
+/**
+ * @brief   Bytes the card is busy after programming a block
+ */
+#ifndef SDCARD_EMU_BUSY_BYTES
+#define SDCARD_EMU_BUSY_BYTES       (256U)
+#endif
+
+/**
+ * @brief   Bytes the card is busy after programming a pre-erased block
+ */
+#ifndef SDCARD_EMU_BUSY_ERASED
+#define SDCARD_EMU_BUSY_ERASED      (64U)
+#endif
+
+/**
+ * @brief   Bus statistics
+ */
+typedef struct {
+    uint32_t calls;     /**< calls of spi_transfer_byte(s) */
+    uint32_t bytes;     /**< bytes clocked over the bus */
+    uint32_t busy;      /**< bytes read while the card was busy */
+    uint32_t errors;    /**< CRC errors and illegal commands */
+} sdcard_emu_stats_t;
+
+/**
+ * @brief   Returns the contents of a block of the card
+ */
+uint8_t *sdcard_emu_block(unsigned addr);
+
+/**
+ * @brief   Returns the bus statistics and resets them
+ */
+void sdcard_emu_stats(sdcard_emu_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDCARD_EMU_H */
+/** @} */
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def _bench(child, name):
+    child.expect(r"%s: 128 blocks in \d+ us, (\d+) bus bytes \(\d+ busy\) "
+                 r"in \d+ calls, \d+ KiB/s at \d+ kHz" % name)
+    return int(child.match.group(1))
+
+
+def testfunc(child):
+    write_single = _bench(child, "write single")
+    _bench(child, "read single")
+    write_multi = _bench(child, "write multi")
+    _bench(child, "read multi")
+    _bench(child, "async")
+    child.expect(r"async: logger blocked for \d+ us")
+    child.expect_exact("[SUCCESS]")
+    assert write_multi < write_single
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput test for gcoap block-wise transfer
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define RESOURCE_SIZE   (256U * 1024U)
+
+static ssize_t _blk_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+static const coap_resource_t _resources[] = {
+    { "/blk", COAP_GET | COAP_PUT, _blk_handler },
+};
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL
+};
+
+static gcoap_block_xfer_t _xfer;
+static mutex_t _xfer_done = MUTEX_INIT_LOCKED;
+static unsigned _xfer_state;
+static unsigned _xfer_code;
+static size_t _client_bytes;    /* produced or consumed by the client */
+static size_t _server_bytes;    /* consumed by the server */
+
+/* Deterministic content, so the receiver can verify each byte */
+static inline uint8_t _pattern(size_t offset)
+{
+    return (uint8_t)((offset * 7) ^ (offset >> 8));
+}
+
+static ssize_t _read_block(void *arg, size_t offset, uint8_t *buf, size_t len,
+                           int *more)
+{
+    size_t i;
+
+    for (i = 0; (i < len) && (offset + i < RESOURCE_SIZE); i++) {
+        buf[i] = _pattern(offset + i);
+    }
+    *more = (offset + i < RESOURCE_SIZE);
+    if (arg) {
+        *(size_t *)arg = offset + i;
+    }
+    return i;
+}
+
+static int _write_block(void *arg, size_t offset, const uint8_t *buf,
+                        size_t len, int more)
+{
+    size_t *count = arg;
+    (void)more;
+
+    if (offset == 0) {
+        *count = 0;
+    }
+    if (offset != *count) {
+        return -ESPIPE;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != _pattern(offset + i)) {
+            return -1;
+        }
+    }
+    *count += len;
+    return 0;
+}
+
+static ssize_t _blk_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    if (coap_get_code_detail(pdu) == COAP_METHOD_GET) {
+        return gcoap_block2_respond(pdu, buf, len, COAP_FORMAT_OCTET,
+                                    _read_block, NULL);
+    }
+    return gcoap_block1_receive(pdu, buf, len, _write_block, &_server_bytes);
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu)
+{
+    _xfer_state = req_state;
+    _xfer_code  = (req_state == GCOAP_MEMO_RESP) ? coap_get_code(pdu) : 0;
+    mutex_unlock(&_xfer_done);
+}
+
+static int _transfer(const char *addr_str, unsigned code)
+{
+    ipv6_addr_t addr;
+    char *name = (code == COAP_METHOD_GET) ? "GET" : "PUT";
+
+    if (ipv6_addr_from_str(&addr, addr_str) == NULL) {
+        puts("blk: unable to parse destination address");
+        return 1;
+    }
+
+    memset(&_xfer, 0, sizeof(_xfer));
+    _xfer.remote.family = AF_INET6;
+    _xfer.remote.netif  = SOCK_ADDR_ANY_NETIF;
+    _xfer.remote.port   = GCOAP_PORT;
+    memcpy(&_xfer.remote.addr.ipv6[0], &addr.u8[0], sizeof(addr.u8));
+    _xfer.path          = "/blk";
+    _xfer.code          = code;
+    _xfer.format        = COAP_FORMAT_OCTET;
+    _xfer.reader        = _read_block;
+    _xfer.writer        = _write_block;
+    _xfer.arg           = &_client_bytes;
+    _xfer.resp_handler  = _resp_handler;
+    _client_bytes       = 0;
+
+    uint32_t start = xtimer_now_usec();
+    if (gcoap_block_xfer_start(&_xfer) == 0) {
+        printf("%s: can't send request\n", name);
+        return 1;
+    }
+    mutex_lock(&_xfer_done);
+    uint32_t usec = xtimer_now_usec() - start;
+
+    if ((_xfer_state != GCOAP_MEMO_RESP) || ((_xfer_code / 100) != 2)
+            || (_client_bytes != RESOURCE_SIZE)) {
+        printf("%s: failed, state %u, code %u, %u bytes\n", name, _xfer_state,
+               _xfer_code, (unsigned)_client_bytes);
+        return 1;
+    }
+    printf("%s: %u bytes in %lu us (%lu KiB/s)\n", name, RESOURCE_SIZE,
+           (unsigned long)usec,
+           (unsigned long)(((uint64_t)RESOURCE_SIZE * US_PER_SEC / 1024)
+                           / (usec ? usec : 1)));
+    return 0;
+}
+
+static int _blk_cmd(int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("usage: %s <get|put> <addr>\n", argv[0]);
+        return 1;
+    }
+    if (strcmp(argv[1], "get") == 0) {
+        return _transfer(argv[2], COAP_METHOD_GET);
+    }
+    else if (strcmp(argv[1], "put") == 0) {
+        return _transfer(argv[2], COAP_METHOD_PUT);
+    }
+    printf("usage: %s <get|put> <addr>\n", argv[0]);
+    return 1;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "blk", "block-wise transfer of 256 KiB", _blk_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    gcoap_register_listener(&_listener);
+
+    puts("gcoap block-wise transfer test\n");
+
+    if ((_transfer("::1", COAP_METHOD_GET) == 0)
+            && (_transfer("::1", COAP_METHOD_PUT) == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Request dispatch benchmark for gcoap with 100 resources
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gcoap.h"
+#include "xtimer.h"
+
+#define NUM_RESOURCES   (100U)
+#define NUM_LISTENERS   (4U)
+#define ROUNDS          (100U)
+#define PATH_LEN        (sizeof("/r000"))
+#define RECV_TIMEOUT    (1U * US_PER_SEC)
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+static char _paths[NUM_RESOURCES][PATH_LEN];
+static coap_resource_t _resources[NUM_LISTENERS][NUM_RESOURCES / NUM_LISTENERS];
+static gcoap_listener_t _listeners[NUM_LISTENERS];
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    return gcoap_finish(pdu, 0, COAP_FORMAT_NONE);
+}
+
+/*
+ * Spreads the resources over the listeners round robin, so no listener
+ * holds a contiguous range of paths.
+ */
+static void _setup(void)
+{
+    for (unsigned i = 0; i < NUM_RESOURCES; i++) {
+        coap_resource_t *resource = &_resources[i % NUM_LISTENERS][i / NUM_LISTENERS];
+        char *path = _paths[i];
+
+        path[0] = '/';
+        path[1] = 'r';
+        fmt_u32_dec(&path[2], i / 100);
+        fmt_u32_dec(&path[3], (i / 10) % 10);
+        fmt_u32_dec(&path[4], i % 10);
+        path[5] = '\0';
+        resource->path    = path;
+        resource->methods = COAP_GET;
+        resource->handler = _handler;
+    }
+    for (unsigned i = 0; i < NUM_LISTENERS; i++) {
+        _listeners[i].resources     = &_resources[i][0];
+        _listeners[i].resources_len = NUM_RESOURCES / NUM_LISTENERS;
+        _listeners[i].next          = NULL;
+        gcoap_register_listener(&_listeners[i]);
+    }
+}
+
+/* Linear search over all listeners, like gcoap's former dispatch */
+static const coap_resource_t *_find_linear(const char *path, unsigned method)
+{
+    unsigned method_flag = coap_method2flag(method);
+
+    for (unsigned i = 0; i < NUM_LISTENERS; i++) {
+        coap_resource_t *resource = _listeners[i].resources;
+        for (size_t j = 0; j < _listeners[i].resources_len; j++, resource++) {
+            if ((strcmp(path, resource->path) == 0)
+                    && (resource->methods & method_flag)) {
+                return resource;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void _print_rate(const char *name, uint32_t usec, unsigned count)
+{
+    printf("%s: %u lookups in %lu us (%lu ns/lookup)\n", name, count,
+           (unsigned long)usec,
+           (unsigned long)(((uint64_t)usec * 1000U) / count));
+}
+
+static int _bench(void)
+{
+    unsigned count = ROUNDS * NUM_RESOURCES;
+    uint32_t start;
+    unsigned found = 0;
+
+    start = xtimer_now_usec();
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        for (unsigned i = 0; i < NUM_RESOURCES; i++) {
+            if (gcoap_find_resource(_paths[i], COAP_METHOD_GET)) {
+                found++;
+            }
+        }
+    }
+    _print_rate("index", xtimer_now_usec() - start, count);
+
+    start = xtimer_now_usec();
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        for (unsigned i = 0; i < NUM_RESOURCES; i++) {
+            if (_find_linear(_paths[i], COAP_METHOD_GET)) {
+                found++;
+            }
+        }
+    }
+    _print_rate("linear", xtimer_now_usec() - start, count);
+
+    /* both searches must agree, also on unknown paths and methods */
+    for (unsigned i = 0; i < NUM_RESOURCES; i++) {
+        if (gcoap_find_resource(_paths[i], COAP_METHOD_GET)
+                != _find_linear(_paths[i], COAP_METHOD_GET)) {
+            return -1;
+        }
+    }
+    if (gcoap_find_resource("/r100", COAP_METHOD_GET)
+            || gcoap_find_resource("/r000", COAP_METHOD_POST)) {
+        return -1;
+    }
+    return (found == 2 * count) ? 0 : -1;
+}
+
+/* Requests /.well-known/core over loopback; returns payload length */
+static ssize_t _get_wkc(sock_udp_t *sock, const sock_udp_ep_t *server,
+                        uint8_t msg_id, const char *label)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t req[] = {
+        0x40, 0x01, 0x00, msg_id,
+        0xbb, '.', 'w', 'e', 'l', 'l', '-', 'k', 'n', 'o', 'w', 'n',
+        0x04, 'c', 'o', 'r', 'e'
+    };
+    coap_pkt_t pdu;
+
+    uint32_t start = xtimer_now_usec();
+    sock_udp_send(sock, req, sizeof(req), server);
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), RECV_TIMEOUT, NULL);
+    uint32_t usec = xtimer_now_usec() - start;
+
+    if ((res <= 0) || (coap_parse(&pdu, buf, res) < 0)
+            || (coap_get_code(&pdu) != 205)) {
+        return -1;
+    }
+    printf("/.well-known/core: %u bytes in %lu us (%s)\n",
+           (unsigned)pdu.payload_len, (unsigned long)usec, label);
+    return pdu.payload_len;
+}
+
+static int _test_wkc(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+    sock_udp_ep_t server = { .family = AF_INET6, .port = GCOAP_PORT };
+    sock_udp_t sock;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&server.addr.ipv6);
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        return -1;
+    }
+    ssize_t built = _get_wkc(&sock, &server, 1, "build");
+    ssize_t cached = _get_wkc(&sock, &server, 2, "cached");
+    sock_udp_close(&sock);
+
+    /* "<" "/r000" ">" per resource, separated by "," */
+    size_t expected = NUM_RESOURCES * (PATH_LEN + 2) - 1;
+    return ((built == (ssize_t)expected) && (cached == built)) ? 0 : -1;
+}
+
+int main(void)
+{
+    puts("gcoap request dispatch benchmark\n");
+
+    _setup();
+
+    if ((_bench() == 0) && (_test_wkc() == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Notification rate test for the gcoap Observe server
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gcoap.h"
+#include "xtimer.h"
+
+#define ROUNDS          (100U)
+#define RECV_TIMEOUT    (1U * US_PER_SEC)
+#define CLIENT_PORT     (20000U)
+
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+static const coap_resource_t _resources[] = {
+    { "/obs", COAP_GET, _obs_handler },
+};
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL
+};
+
+static sock_udp_t _socks[NUM_OBSERVERS];
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static uint32_t _value;
+
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    size_t payload_len = fmt_u32_dec((char *)pdu->payload, _value);
+    return gcoap_finish(pdu, payload_len, COAP_FORMAT_TEXT);
+}
+
+/*
+ * Receives a notification on the sock of an observer, and checks its token.
+ * Returns the message type, or -1 on error.
+ */
+static int _recv(unsigned i, coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    ssize_t res = sock_udp_recv(&_socks[i], buf, len, RECV_TIMEOUT, NULL);
+    if ((res <= 0) || (coap_parse(pdu, buf, res) < 0)
+            || (coap_get_token_len(pdu) != 2)
+            || (pdu->token[0] != 0xfe) || (pdu->token[1] != i)) {
+        return -1;
+    }
+    return coap_get_type(pdu);
+}
+
+/* Registers an observer for each sock; returns the count registered. */
+static unsigned _register(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < NUM_OBSERVERS; i++) {
+        sock_udp_ep_t local = { .family = AF_INET6,
+                                .port = CLIENT_PORT + i };
+        /* GET /obs, token 0xfe <i>, Observe 0 */
+        uint8_t req[] = {
+            0x52, 0x01, 0x00, i, 0xfe, i, 0x60, 0x53,
+            'o', 'b', 's'
+        };
+
+        if (sock_udp_create(&_socks[i], &local, NULL, 0) < 0) {
+            break;
+        }
+        sock_udp_send(&_socks[i], req, sizeof(req), &_server);
+        /* registration response carries Observe option after token */
+        if ((_recv(i, &pdu, buf, sizeof(buf)) >= 0) && (buf[6] == 0x63)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Measures rate of non-confirmable notifications. */
+static int _bench_non(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    unsigned received = 0;
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        _value++;
+        gcoap_obs_notify(&_resources[0], COAP_TYPE_NON);
+        for (unsigned i = 0; i < NUM_OBSERVERS; i++) {
+            if (_recv(i, &pdu, buf, sizeof(buf)) == COAP_TYPE_NON) {
+                received++;
+            }
+        }
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+
+    printf("NON: %u notifications in %lu us (%lu notifications/s)\n",
+           received, (unsigned long)usec,
+           (unsigned long)(((uint64_t)received * US_PER_SEC) / (usec ? usec : 1)));
+    return (received == ROUNDS * NUM_OBSERVERS) ? 0 : -1;
+}
+
+/*
+ * Sends one round of confirmable notifications. All observers acknowledge
+ * except the first one, which resets the notification.
+ */
+static int _test_con(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    unsigned acked = 0, reset = 0;
+
+    _value++;
+    gcoap_obs_notify(&_resources[0], COAP_TYPE_CON);
+    for (unsigned i = 0; i < NUM_OBSERVERS; i++) {
+        if (_recv(i, &pdu, buf, sizeof(buf)) != COAP_TYPE_CON) {
+            continue;
+        }
+        /* empty ACK or RST with the notification's message ID */
+        uint8_t reply[] = { 0x60, 0x00, buf[2], buf[3] };
+        if (i == 0) {
+            reply[0] = 0x70;
+            reset++;
+        }
+        else {
+            acked++;
+        }
+        sock_udp_send(&_socks[i], reply, sizeof(reply), &_server);
+    }
+    printf("CON: %u acknowledged, %u reset\n", acked, reset);
+
+    /* wait until gcoap handled all replies */
+    xtimer_usleep(100U * US_PER_MS);
+    int observers = gcoap_obs_notify(&_resources[0], COAP_TYPE_NON);
+    printf("observers after reset: %d\n", observers);
+    /* drain last notification */
+    for (unsigned i = 1; i < NUM_OBSERVERS; i++) {
+        _recv(i, &pdu, buf, sizeof(buf));
+    }
+    return (observers == (NUM_OBSERVERS - 1)) ? 0 : -1;
+}
+
+int main(void)
+{
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+
+    puts("gcoap Observe notification test\n");
+
+    unsigned count = _register();
+    printf("registered %u observers\n", count);
+
+    if ((count == NUM_OBSERVERS) && (_bench_non() == 0)
+            && (_test_con() == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
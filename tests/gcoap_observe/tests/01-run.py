@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"registered (\d+) observers")
+    observers = int(child.match.group(1))
+    child.expect(r"NON: \d+ notifications in \d+ us \(\d+ notifications/s\)")
+    child.expect_exact("CON: %d acknowledged, 1 reset" % (observers - 1))
+    child.expect_exact("observers after reset: %d" % (observers - 1))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the IPv6 forwarding rate between two interfaces
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/netdev2_test.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PKTS            (1000U)
+#define PAYLOAD_LEN     (16U)
+#define FRAME_LEN       (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                         PAYLOAD_LEN)
+#define HOP_LIMIT       (64U)
+#define TIMEOUT         (100U * US_PER_MS)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+typedef struct {
+    gnrc_netdev2_t gnrc;
+    netdev2_test_t dev;
+    kernel_pid_t pid;
+    const char *name;
+    uint8_t addr[ETHERNET_ADDR_LEN];
+    ipv6_addr_t ipv6_addr;
+    char stack[MAC_STACKSIZE];
+} iface_t;
+
+static iface_t _in = {
+    .name = "in",
+    .addr = { 0x02, 0x00, 0x00, 0x00, 0x01, 0x01 },
+    .ipv6_addr = { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } },
+};
+static iface_t _out = {
+    .name = "out",
+    .addr = { 0x02, 0x00, 0x00, 0x00, 0x02, 0x01 },
+    .ipv6_addr = { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } },
+};
+
+/* sending host on the incoming link */
+static const uint8_t _src_l2addr[] = { 0x02, 0x00, 0x00, 0x00, 0x01, 0x02 };
+static const ipv6_addr_t _src = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+/* destination host on the outgoing link */
+static const uint8_t _dst_l2addr[] = { 0x02, 0x00, 0x00, 0x00, 0x02, 0x02 };
+static const ipv6_addr_t _dst = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+
+static uint8_t _frame[FRAME_LEN];
+static uint8_t _sent_frame[FRAME_LEN];
+static mutex_t _sent = MUTEX_INIT_LOCKED;
+static unsigned _malformed;
+
+static void _isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _recv(netdev2_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if (len < (int)sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+static int _send_in(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    /* neighbor discovery only, nothing is forwarded back */
+    (void)dev;
+    (void)vector;
+    (void)count;
+    return 0;
+}
+
+static int _send_out(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_sent_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    size_t len = 0;
+
+    (void)dev;
+    for (int i = 0; i < count; i++) {
+        if ((len + vector[i].iov_len) > sizeof(_sent_frame)) {
+            return 0;   /* not a forwarded packet */
+        }
+        memcpy(&_sent_frame[len], vector[i].iov_base, vector[i].iov_len);
+        len += vector[i].iov_len;
+    }
+    if ((len != sizeof(_sent_frame)) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        !ipv6_addr_equal(&ipv6->dst, &_dst)) {
+        return 0;       /* neighbor discovery */
+    }
+    if ((memcmp(eth->dst, _dst_l2addr, sizeof(_dst_l2addr)) != 0) ||
+        (memcmp(eth->src, _out.addr, sizeof(_out.addr)) != 0) ||
+        (ipv6->hl != (HOP_LIMIT - 1)) ||
+        (memcmp(ipv6 + 1, &_frame[sizeof(_frame) - PAYLOAD_LEN],
+                PAYLOAD_LEN) != 0)) {
+        _malformed++;
+    }
+    mutex_unlock(&_sent);
+    return len;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    iface_t *iface = ((netdev2_test_t *)dev)->state;
+
+    if (max_len < sizeof(iface->addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, iface->addr, sizeof(iface->addr));
+    return sizeof(iface->addr);
+}
+
+static int _init_iface(iface_t *iface, netdev2_test_send_cb_t send_cb)
+{
+    netdev2_test_setup(&iface->dev, iface);
+    netdev2_test_set_isr_cb(&iface->dev, _isr);
+    netdev2_test_set_recv_cb(&iface->dev, _recv);
+    netdev2_test_set_send_cb(&iface->dev, send_cb);
+    netdev2_test_set_get_cb(&iface->dev, NETOPT_ADDRESS, _get_addr);
+    gnrc_netdev2_eth_init(&iface->gnrc, (netdev2_t *)&iface->dev);
+    iface->pid = gnrc_netdev2_init(iface->stack, sizeof(iface->stack),
+                                   MAC_PRIO, iface->name, &iface->gnrc);
+    return (iface->pid > KERNEL_PID_UNDEF) ? 0 : -1;
+}
+
+static void _init_frame(void)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    uint8_t *payload = (uint8_t *)(ipv6 + 1);
+
+    memcpy(eth->dst, _in.addr, sizeof(_in.addr));
+    memcpy(eth->src, _src_l2addr, sizeof(_src_l2addr));
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(PAYLOAD_LEN);
+    ipv6->nh = PROTNUM_IPV6_NONXT;
+    ipv6->hl = HOP_LIMIT;
+    ipv6->src = _src;
+    ipv6->dst = _dst;
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+}
+
+static unsigned _run(const char *name, int invalidate)
+{
+    unsigned lost = 0;
+    uint32_t start;
+
+    _malformed = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < PKTS; i++) {
+        if (invalidate) {
+            /* as if the neighbor cache changed for every packet */
+            gnrc_ipv6_nc_gen++;
+        }
+        _in.dev.netdev.event_callback((netdev2_t *)&_in.dev,
+                                      NETDEV2_EVENT_ISR);
+        if (xtimer_mutex_lock_timeout(&_sent, TIMEOUT) < 0) {
+            lost++;
+        }
+    }
+    start = xtimer_now_usec() - start;
+    printf("%s: %u packets in %lu us (%lu packets/s), %u lost, %u malformed\n",
+           name, PKTS, (unsigned long)start,
+           (unsigned long)(((uint64_t)PKTS * US_PER_SEC) / (start ? start : 1)),
+           lost, _malformed);
+    return lost + _malformed;
+}
+
+int main(void)
+{
+    unsigned failed;
+
+    puts("IPv6 forwarding benchmark\n");
+    if ((_init_iface(&_in, _send_in) < 0) ||
+        (_init_iface(&_out, _send_out) < 0)) {
+        puts("Could not start interfaces");
+        return 1;
+    }
+    gnrc_ipv6_netif_init_by_dev();
+    if ((gnrc_ipv6_netif_add_addr(_in.pid, &_in.ipv6_addr, 64,
+                                  GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
+                                  GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_ON_LINK) == NULL) ||
+        (gnrc_ipv6_netif_add_addr(_out.pid, &_out.ipv6_addr, 64,
+                                  GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
+                                  GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_ON_LINK) == NULL) ||
+        (gnrc_ipv6_nc_add(_out.pid, &_dst, _dst_l2addr, sizeof(_dst_l2addr),
+                          GNRC_IPV6_NC_STATE_UNMANAGED) == NULL)) {
+        puts("Could not configure interfaces");
+        return 1;
+    }
+    _init_frame();
+
+    printf("%u packets of %u bytes each\n", PKTS, (unsigned)FRAME_LEN);
+    failed = _run("cached", 0);
+    failed += _run("uncached", 1);
+
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
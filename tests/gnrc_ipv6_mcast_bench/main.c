@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate of IPv6 multicast sent over all interfaces
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev2_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define IFACES          (GNRC_NETIF_NUMOF - 1)  /**< Ethernet interfaces */
+#define SIXLOWPAN_IFACE (IFACES)                /**< index of the 6LoWPAN one */
+#define PKTS            (500U)
+#define PAYLOAD_LEN     (32U)
+#define PORT            (61616U)
+#define TIMEOUT         (100U * US_PER_MS)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+typedef struct {
+    gnrc_netdev2_t gnrc;
+    netdev2_test_t dev;
+    kernel_pid_t pid;
+    bool sixlowpan;
+    uint8_t addr[ETHERNET_ADDR_LEN];
+    char stack[MAC_STACKSIZE];
+} iface_t;
+
+static const char *_names[] = { "if0", "if1", "if2", "if3",
+                                "if4", "if5", "if6", "if7", "6lo" };
+static iface_t _ifaces[IFACES + 1];
+
+static uint8_t _payload[PAYLOAD_LEN];
+static mutex_t _sent = MUTEX_INIT_LOCKED;
+static unsigned _frames, _expected, _malformed;
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    uint8_t frame[sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) +
+                  sizeof(udp_hdr_t) + PAYLOAD_LEN];
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    iface_t *iface = ((netdev2_test_t *)dev)->state;
+    size_t len = 0;
+
+    for (int i = 0; i < count; i++) {
+        if ((len + vector[i].iov_len) > sizeof(frame)) {
+            return 0;   /* not a benchmark packet */
+        }
+        memcpy(&frame[len], vector[i].iov_base, vector[i].iov_len);
+        len += vector[i].iov_len;
+    }
+    if (iface->sixlowpan) {
+        uint8_t *iphc = (uint8_t *)(eth + 1);
+
+        /* only UDP is compressed with NHC, neighbor discovery is not */
+        if ((len <= sizeof(ethernet_hdr_t)) || !sixlowpan_iphc_is(iphc) ||
+            !(iphc[0] & SIXLOWPAN_IPHC1_NH)) {
+            return 0;
+        }
+    }
+    else if ((len != sizeof(frame)) ||
+             (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+             (ipv6->nh != PROTNUM_UDP) ||
+             (byteorder_ntohs(udp->dst_port) != PORT)) {
+        return 0;       /* neighbor discovery */
+    }
+    else if (!ipv6_addr_equal(&ipv6->dst, &ipv6_addr_all_nodes_link_local) ||
+             (ipv6->hl == 0) ||
+             (udp->checksum.u16 == 0) ||
+             (memcmp(udp + 1, _payload, PAYLOAD_LEN) != 0)) {
+        _malformed++;
+    }
+    if (++_frames == _expected) {
+        mutex_unlock(&_sent);
+    }
+    return len;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    iface_t *iface = ((netdev2_test_t *)dev)->state;
+
+    if (max_len < sizeof(iface->addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, iface->addr, sizeof(iface->addr));
+    return sizeof(iface->addr);
+}
+
+static int _get_proto(netdev2_t *dev, void *value, size_t max_len)
+{
+    iface_t *iface = ((netdev2_test_t *)dev)->state;
+
+    if (!iface->sixlowpan) {
+        return -ENOTSUP;
+    }
+    if (max_len < sizeof(gnrc_nettype_t)) {
+        return -ENOBUFS;
+    }
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _init_iface(unsigned i)
+{
+    iface_t *iface = &_ifaces[i];
+
+    iface->addr[0] = 0x02;
+    iface->addr[5] = i + 1;
+    /* the stack compresses the headers of packets sent over this one */
+    iface->sixlowpan = (i == SIXLOWPAN_IFACE);
+    netdev2_test_setup(&iface->dev, iface);
+    netdev2_test_set_send_cb(&iface->dev, _send);
+    netdev2_test_set_get_cb(&iface->dev, NETOPT_ADDRESS, _get_addr);
+    netdev2_test_set_get_cb(&iface->dev, NETOPT_PROTO, _get_proto);
+    gnrc_netdev2_eth_init(&iface->gnrc, (netdev2_t *)&iface->dev);
+    iface->pid = gnrc_netdev2_init(iface->stack, sizeof(iface->stack),
+                                   MAC_PRIO, _names[i], &iface->gnrc);
+    return (iface->pid > KERNEL_PID_UNDEF) ? 0 : -1;
+}
+
+/* a packet without netif header is sent over all interfaces */
+static gnrc_pktsnip_t *_build(const ipv6_addr_t *src)
+{
+    gnrc_pktsnip_t *payload, *udp, *ipv6;
+
+    payload = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    udp = gnrc_udp_hdr_build(payload, PORT, PORT);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(udp, src, &ipv6_addr_all_nodes_link_local);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    if (src != NULL) {
+        /* nothing left to fill in per interface */
+        ((ipv6_hdr_t *)ipv6->data)->hl = 1;
+    }
+    return ipv6;
+}
+
+static unsigned _run(unsigned ifnum, const char *name, const ipv6_addr_t *src)
+{
+    unsigned lost = 0;
+    uint32_t start;
+
+    _malformed = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < PKTS; i++) {
+        gnrc_pktsnip_t *pkt = _build(src);
+
+        _frames = 0;
+        _expected = ifnum;
+        if (pkt == NULL) {
+            lost++;
+            continue;
+        }
+        if (!gnrc_netapi_send(gnrc_ipv6_pid, pkt)) {
+            gnrc_pktbuf_release(pkt);
+            lost++;
+            continue;
+        }
+        if (xtimer_mutex_lock_timeout(&_sent, TIMEOUT) < 0) {
+            lost++;
+        }
+    }
+    start = xtimer_now_usec() - start;
+    printf("%u interfaces, %s: %u packets in %lu us (%lu packets/s), "
+           "%u lost, %u malformed\n", ifnum, name, PKTS, (unsigned long)start,
+           (unsigned long)(((uint64_t)PKTS * US_PER_SEC) / (start ? start : 1)),
+           lost, _malformed);
+    return lost + _malformed;
+}
+
+int main(void)
+{
+    static const unsigned ifnums[] = { IFACES, IFACES / 2, 1 };
+    ipv6_addr_t src = IPV6_ADDR_UNSPECIFIED;
+    unsigned failed = 0, active = IFACES;
+
+    puts("IPv6 multicast benchmark\n");
+    for (unsigned i = 0; i <= IFACES; i++) {
+        if (_init_iface(i) < 0) {
+            puts("Could not start interfaces");
+            return 1;
+        }
+    }
+    gnrc_ipv6_netif_init_by_dev();
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        _payload[i] = i;
+    }
+    /* any link-local address will do as fixed source */
+    ipv6_addr_set_link_local_prefix(&src);
+    src.u8[15] = 1;
+
+    printf("%u packets of %u bytes payload each\n", PKTS, PAYLOAD_LEN);
+    /* 6LoWPAN changes the headers of its copy, so the other interfaces must
+     * not share them */
+    failed += _run(IFACES + 1, "with 6LoWPAN", &src);
+    gnrc_netif_remove(_ifaces[SIXLOWPAN_IFACE].pid);
+    for (unsigned n = 0; n < sizeof(ifnums) / sizeof(ifnums[0]); n++) {
+        /* interfaces removed from the stack are left out of multicast */
+        while (active > ifnums[n]) {
+            gnrc_netif_remove(_ifaces[--active].pid);
+        }
+        failed += _run(active, "shared", &src);
+        failed += _run(active, "per interface", NULL);
+    }
+
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"9 interfaces, with 6LoWPAN: \d+ packets in \d+ us "
+                 r"\(\d+ packets/s\), 0 lost, 0 malformed")
+    for ifnum in (8, 4, 1):
+        for run in ("shared", "per interface"):
+            child.expect(r"%d interfaces, %s: \d+ packets in \d+ us "
+                         r"\(\d+ packets/s\), 0 lost, 0 malformed" %
+                         (ifnum, run))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends bursts of packets to neighbors whose link-layer
+ *              addresses are not known yet
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ndp.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/gnrc/udp.h"
+#include "net/icmpv6.h"
+#include "net/inet_csum.h"
+#include "net/ndp.h"
+#include "net/netdev2_test.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define NBRS            (20U)
+#define PKTS            (100U)
+#define PAYLOAD_LEN     (16U)
+#define PORT            (61616U)
+#define TIMEOUT         (100U * US_PER_MS)
+#define FRAME_LEN       (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                         sizeof(ndp_nbr_adv_t) + sizeof(ndp_opt_t) + \
+                         ETHERNET_ADDR_LEN)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _pid;
+static char _stack[MAC_STACKSIZE];
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const ipv6_addr_t _ipv6_addr = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+
+static uint8_t _rx_frame[FRAME_LEN];
+static mutex_t _rx_done = MUTEX_INIT_LOCKED;
+/* neighbors that were solicited, but did not answer yet */
+static volatile uint32_t _solicited;
+static volatile unsigned _delivered, _malformed;
+
+/* neighbor i is 2001:db8::1:i with link-layer address 02:00:00:00:01:i */
+static void _nbr_ipv6(ipv6_addr_t *addr, unsigned i)
+{
+    *addr = _ipv6_addr;
+    addr->u8[14] = 0x01;
+    addr->u8[15] = i;
+}
+
+static void _nbr_l2(uint8_t *addr, unsigned i)
+{
+    memcpy(addr, _addr, sizeof(_addr));
+    addr[4] = 0x01;
+    addr[5] = i;
+}
+
+/* returns the neighbor of an address, or NBRS if it is none */
+static unsigned _nbr(const ipv6_addr_t *addr)
+{
+    ipv6_addr_t nbr;
+
+    _nbr_ipv6(&nbr, addr->u8[15]);
+    return ((addr->u8[15] < NBRS) && ipv6_addr_equal(addr, &nbr)) ?
+           addr->u8[15] : NBRS;
+}
+
+static void _isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _recv(netdev2_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_rx_frame);
+    }
+    if (len < (int)sizeof(_rx_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_frame, sizeof(_rx_frame));
+    mutex_unlock(&_rx_done);
+    return sizeof(_rx_frame);
+}
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    uint8_t frame[FRAME_LEN];
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    size_t len = 0;
+
+    (void)dev;
+    for (int i = 0; i < count; i++) {
+        size_t part = vector[i].iov_len;
+
+        /* only the headers are of interest */
+        if ((len + part) > sizeof(frame)) {
+            part = sizeof(frame) - len;
+        }
+        memcpy(&frame[len], vector[i].iov_base, part);
+        len += part;
+    }
+    if ((len < (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t))) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6)) {
+        return 0;
+    }
+    if ((ipv6->nh == PROTNUM_ICMPV6) && (len >= (sizeof(ethernet_hdr_t) +
+                                                 sizeof(ipv6_hdr_t) +
+                                                 sizeof(ndp_nbr_sol_t)))) {
+        ndp_nbr_sol_t *nbr_sol = (ndp_nbr_sol_t *)(ipv6 + 1);
+        unsigned nbr = _nbr(&nbr_sol->tgt);
+
+        if ((nbr_sol->type == ICMPV6_NBR_SOL) && (nbr < NBRS)) {
+            _solicited |= (uint32_t)1 << nbr;
+        }
+    }
+    else if (ipv6->nh == PROTNUM_UDP) {
+        udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+        unsigned nbr = _nbr(&ipv6->dst);
+        uint8_t l2addr[ETHERNET_ADDR_LEN];
+
+        if (byteorder_ntohs(udp->dst_port) != PORT) {
+            return 0;
+        }
+        _nbr_l2(l2addr, nbr);
+        if ((nbr < NBRS) && (memcmp(eth->dst, l2addr, sizeof(l2addr)) == 0)) {
+            _delivered++;
+        }
+        else {
+            _malformed++;
+        }
+    }
+    return len;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _addr, sizeof(_addr));
+    return sizeof(_addr);
+}
+
+/* answers the neighbor solicitation for a neighbor */
+static void _advertise(unsigned nbr)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_rx_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    ndp_nbr_adv_t *nbr_adv = (ndp_nbr_adv_t *)(ipv6 + 1);
+    ndp_opt_t *tl2a = (ndp_opt_t *)(nbr_adv + 1);
+    uint16_t len = sizeof(*nbr_adv) + sizeof(*tl2a) + ETHERNET_ADDR_LEN;
+    uint16_t csum;
+
+    memset(_rx_frame, 0, sizeof(_rx_frame));
+    memcpy(eth->dst, _addr, sizeof(_addr));
+    _nbr_l2(eth->src, nbr);
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_ICMPV6;
+    ipv6->hl = 255;
+    _nbr_ipv6(&ipv6->src, nbr);
+    ipv6->dst = _ipv6_addr;
+    nbr_adv->type = ICMPV6_NBR_ADV;
+    nbr_adv->flags = NDP_NBR_ADV_FLAGS_S | NDP_NBR_ADV_FLAGS_O;
+    nbr_adv->tgt = ipv6->src;
+    tl2a->type = NDP_OPT_TL2A;
+    tl2a->len = 1;
+    _nbr_l2((uint8_t *)(tl2a + 1), nbr);
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_ICMPV6, len);
+    csum = inet_csum(csum, (uint8_t *)nbr_adv, len);
+    nbr_adv->csum = byteorder_htons(~csum);
+
+    _dev.netdev.event_callback((netdev2_t *)&_dev, NETDEV2_EVENT_ISR);
+    xtimer_mutex_lock_timeout(&_rx_done, TIMEOUT);
+}
+
+static gnrc_pktsnip_t *_build(unsigned nbr)
+{
+    gnrc_pktsnip_t *pkt, *udp, *ipv6;
+    ipv6_addr_t dst;
+
+    /* the content of the payload does not matter */
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    udp = gnrc_udp_hdr_build(pkt, PORT, PORT);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    _nbr_ipv6(&dst, nbr);
+    ipv6 = gnrc_ipv6_hdr_build(udp, NULL, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    return ipv6;
+}
+
+int main(void)
+{
+    gnrc_ndp_node_stats_t *stats = gnrc_ndp_node_get_stats();
+    unsigned lost = 0;
+    uint32_t start;
+
+    puts("NDP address resolution benchmark\n");
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_isr_cb(&_dev, _isr);
+    netdev2_test_set_recv_cb(&_dev, _recv);
+    netdev2_test_set_send_cb(&_dev, _send);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_addr);
+    gnrc_netdev2_eth_init(&_gnrc, (netdev2_t *)&_dev);
+    _pid = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "eth", &_gnrc);
+    if (_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+    gnrc_ipv6_netif_init_by_dev();
+    if (gnrc_ipv6_netif_add_addr(_pid, &_ipv6_addr, 64,
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_ON_LINK) == NULL) {
+        puts("Could not configure interface");
+        return 1;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    /* all packets are sent before any neighbor answers */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < PKTS; i++) {
+        gnrc_pktsnip_t *pkt = _build(i % NBRS);
+
+        if (pkt == NULL) {
+            lost++;
+            continue;
+        }
+        if (!gnrc_netapi_send(gnrc_ipv6_pid, pkt)) {
+            gnrc_pktbuf_release(pkt);
+            lost++;
+        }
+    }
+    for (unsigned nbr = 0; nbr < NBRS; nbr++) {
+        if (_solicited & ((uint32_t)1 << nbr)) {
+            _solicited &= ~((uint32_t)1 << nbr);
+            _advertise(nbr);
+        }
+    }
+    /* queued packets leave as soon as their neighbor answered */
+    xtimer_usleep(TIMEOUT);
+    start = xtimer_now_usec() - start - TIMEOUT;
+
+    printf("%u packets to %u neighbors in %lu us: %u delivered, "
+           "%lu dropped, %u lost, %u malformed\n", PKTS, NBRS,
+           (unsigned long)start, _delivered, (unsigned long)stats->dropped,
+           lost, _malformed);
+    printf("%lu neighbors resolved in %lu us on average, %lu us at most\n",
+           (unsigned long)stats->resolved,
+           (unsigned long)(stats->resolved ?
+                           (stats->res_time_sum / stats->resolved) : 0),
+           (unsigned long)stats->res_time_max);
+
+    puts(((stats->resolved == NBRS) && (lost == 0) && (_malformed == 0) &&
+          ((_delivered + stats->dropped) == PKTS)) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the frame rate of a network interface with frames
+ *              handled one by one and in batches
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/netdev2_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define FRAMES          (4096U)
+#define BURST           (8U)    /* frames per burst, at most the queue size of
+                                 * the interface, a multiple of
+                                 * GNRC_NETDEV2_TX_BATCH */
+#define PAYLOAD_LEN     (100U)
+#define FRAME_LEN       (sizeof(ethernet_hdr_t) + PAYLOAD_LEN)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+/* the interface thread runs below the main thread, so the frames of a burst
+ * queue up as they would behind a busy device */
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN + 1)
+
+typedef struct {
+    const char *name;
+    bool batch;
+    uint32_t rx_time;
+    uint32_t tx_time;
+    unsigned received;
+    unsigned sent;
+    unsigned sends;
+} result_t;
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _pid;
+static char _stack[MAC_STACKSIZE];
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static uint8_t _rx_frame[FRAME_LEN];
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static result_t *_res;
+static unsigned _pending, _expected;
+static bool _rx_batch;
+
+static void _isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, (_res->batch && _rx_batch) ?
+                             NETDEV2_EVENT_RX_PENDING :
+                             NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _recv(netdev2_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return (_pending > 0) ? (int)sizeof(_rx_frame) : 0;
+    }
+    if (len < (int)sizeof(_rx_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_frame, sizeof(_rx_frame));
+    _res->received++;
+    if (--_pending == 0) {
+        mutex_unlock(&_done);
+    }
+    return sizeof(_rx_frame);
+}
+
+static void _sent(unsigned num)
+{
+    _res->sent += num;
+    _res->sends++;
+    if (_res->sent == _expected) {
+        mutex_unlock(&_done);
+    }
+}
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    int len = 0;
+
+    (void)dev;
+    for (int i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    _sent(1);
+    return len;
+}
+
+static int _send_batch(netdev2_t *dev, const netdev2_frame_t *frames,
+                       unsigned num)
+{
+    (void)dev;
+    (void)frames;
+    _sent(num);
+    return num;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _addr, sizeof(_addr));
+    return sizeof(_addr);
+}
+
+static int _set_rx_batch(netdev2_t *dev, void *value, size_t value_len)
+{
+    (void)dev;
+    if (value_len != sizeof(netopt_enable_t)) {
+        return -EINVAL;
+    }
+    _rx_batch = (*((netopt_enable_t *)value) == NETOPT_ENABLE);
+    return sizeof(netopt_enable_t);
+}
+
+static unsigned _send_frame(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return 1;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return 1;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->flags = GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, netif);
+    if (gnrc_netapi_send(_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned _run(result_t *res)
+{
+    int (*send_batch)(gnrc_netdev2_t *, gnrc_pktsnip_t **, unsigned);
+    unsigned failed = 0;
+    uint32_t start;
+
+    _res = res;
+    /* without batches, the interface is used as for a device that provides
+     * neither NETOPT_RX_BATCH nor send_batch() */
+    send_batch = _gnrc.send_batch;
+    if (!res->batch) {
+        _gnrc.send_batch = NULL;
+    }
+    netdev2_test_set_send_batch_cb(&_dev, _send_batch);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < FRAMES; i += BURST) {
+        _pending = BURST;
+        /* a device that does not batch interrupts once per frame */
+        for (unsigned j = 0; j < (res->batch ? 1 : BURST); j++) {
+            _dev.netdev.event_callback((netdev2_t *)&_dev, NETDEV2_EVENT_ISR);
+        }
+        mutex_lock(&_done);
+    }
+    res->rx_time = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < FRAMES; i += BURST) {
+        _expected = i + BURST;
+        for (unsigned j = 0; j < BURST; j++) {
+            failed += _send_frame();
+        }
+        if (failed == 0) {
+            mutex_lock(&_done);
+        }
+    }
+    res->tx_time = xtimer_now_usec() - start;
+
+    _gnrc.send_batch = send_batch;
+    return failed + (res->received != FRAMES) + (res->sent != FRAMES);
+}
+
+static void _report(result_t *res)
+{
+    printf("%s: %lu frames/s received, %lu frames/s sent in %u driver calls\n",
+           res->name,
+           (unsigned long)(((uint64_t)FRAMES * US_PER_SEC) / (res->rx_time ? res->rx_time : 1)),
+           (unsigned long)(((uint64_t)FRAMES * US_PER_SEC) / (res->tx_time ? res->tx_time : 1)),
+           res->sends);
+}
+
+int main(void)
+{
+    result_t single = { .name = "one by one", .batch = false };
+    result_t batch = { .name = "in batches", .batch = true };
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_rx_frame;
+    unsigned failed = 0;
+
+    puts("netdev2 batch benchmark\n");
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_isr_cb(&_dev, _isr);
+    netdev2_test_set_recv_cb(&_dev, _recv);
+    netdev2_test_set_send_cb(&_dev, _send);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_addr);
+    netdev2_test_set_set_cb(&_dev, NETOPT_RX_BATCH, _set_rx_batch);
+    gnrc_netdev2_eth_init(&_gnrc, (netdev2_t *)&_dev);
+    _pid = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "eth", &_gnrc);
+    if (_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+    /* let the interface enable NETOPT_RX_BATCH */
+    xtimer_usleep(US_PER_MS);
+    if (!_rx_batch || (_gnrc.send_batch == NULL)) {
+        puts("Interface does not use batches");
+        return 1;
+    }
+    /* received frames are not handled by any other module */
+    memset(eth->dst, 0xff, sizeof(eth->dst));
+    memcpy(eth->src, _addr, sizeof(_addr));
+    eth->src[5]++;
+    eth->type = byteorder_htons(ETHERTYPE_UNKNOWN);
+    printf("%u frames of %u bytes each way in bursts of %u\n", FRAMES,
+           (unsigned)FRAME_LEN, BURST);
+
+    failed += _run(&single);
+    _report(&single);
+    failed += _run(&batch);
+    _report(&batch);
+
+    puts(((failed == 0) && (single.sends == FRAMES) &&
+          (batch.sends == (FRAMES / GNRC_NETDEV2_TX_BATCH))) ?
+         "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact("4096 frames of 114 bytes each way in bursts of 8")
+    child.expect(r"one by one: \d+ frames/s received, \d+ frames/s sent in "
+                 r"4096 driver calls")
+    child.expect(r"in batches: \d+ frames/s received, \d+ frames/s sent in "
+                 r"1024 driver calls")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the latency of UDP packets per layer while bursts
+ *              of packets are received and sent
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/inet_csum.h"
+#include "net/netdev2_test.h"
+#include "net/netstats/latency.h"
+#include "net/protnum.h"
+#include "net/sock/udp.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PKTS            (1024U)
+#define BURST           (4U)    /* frames per interrupt, at most SOCK_MBOX_SIZE */
+#define PAYLOAD_LEN     (16U)
+#define PORT            (61616U)
+#define FRAME_LEN       (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                         sizeof(udp_hdr_t) + PAYLOAD_LEN)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+static const struct {
+    const char *name;
+    netstats_lat_stage_t stage;
+} _stages[] = {
+    { "rx ipv6", NETSTATS_LAT_RX_IPV6 },
+    { "rx udp", NETSTATS_LAT_RX_UDP },
+    { "rx sock", NETSTATS_LAT_RX_SOCK },
+    { "tx udp", NETSTATS_LAT_TX_UDP },
+    { "tx ipv6", NETSTATS_LAT_TX_IPV6 },
+    { "tx netdev", NETSTATS_LAT_TX_NETDEV },
+};
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _pid;
+static char _stack[MAC_STACKSIZE];
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const ipv6_addr_t _ipv6_addr = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _nbr_addr = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+
+static uint8_t _rx_frame[FRAME_LEN];
+static sock_udp_t _sock;
+static unsigned _sent;
+
+/* delivers a burst of frames, so that they queue up in the layers above */
+static void _isr(netdev2_t *dev)
+{
+    for (unsigned i = 0; i < BURST; i++) {
+        dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+    }
+}
+
+static int _recv(netdev2_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_rx_frame);
+    }
+    if (len < (int)sizeof(_rx_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_frame, sizeof(_rx_frame));
+    return sizeof(_rx_frame);
+}
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    int len = 0;
+
+    (void)dev;
+    for (int i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    if (len == (int)FRAME_LEN) {
+        _sent++;
+    }
+    return len;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _addr, sizeof(_addr));
+    return sizeof(_addr);
+}
+
+static void _build_rx_frame(void)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_rx_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint16_t len = sizeof(*udp) + PAYLOAD_LEN;
+    uint16_t csum;
+
+    memset(_rx_frame, 0, sizeof(_rx_frame));
+    memcpy(eth->dst, _addr, sizeof(_addr));
+    memcpy(eth->src, _addr, sizeof(_addr));
+    eth->src[5]++;
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6->src = _nbr_addr;
+    ipv6->dst = _ipv6_addr;
+    udp->src_port = byteorder_htons(PORT);
+    udp->dst_port = byteorder_htons(PORT);
+    udp->length = byteorder_htons(len);
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_UDP, len);
+    csum = inet_csum(csum, (uint8_t *)udp, len);
+    udp->checksum = byteorder_htons(~csum);
+}
+
+/* all threads of the stack have a higher priority than this one, so they
+ * have handled the burst completely when the interrupt returns */
+static unsigned _receive_burst(void)
+{
+    uint8_t buf[PAYLOAD_LEN];
+    unsigned received = 0;
+
+    _dev.netdev.event_callback((netdev2_t *)&_dev, NETDEV2_EVENT_ISR);
+    while (sock_udp_recv(&_sock, buf, sizeof(buf), 0, NULL) >= 0) {
+        received++;
+    }
+    return received;
+}
+
+static unsigned _send_burst(const sock_udp_ep_t *remote)
+{
+    uint8_t buf[PAYLOAD_LEN] = { 0 };
+    unsigned sent = 0;
+
+    for (unsigned i = 0; i < BURST; i++) {
+        if (sock_udp_send(&_sock, buf, sizeof(buf), remote) > 0) {
+            sent++;
+        }
+    }
+    return sent;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+    unsigned received = 0, sent = 0;
+    bool ok = true;
+
+    puts("Per layer latency benchmark\n");
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_isr_cb(&_dev, _isr);
+    netdev2_test_set_recv_cb(&_dev, _recv);
+    netdev2_test_set_send_cb(&_dev, _send);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_addr);
+    gnrc_netdev2_eth_init(&_gnrc, (netdev2_t *)&_dev);
+    _pid = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "eth", &_gnrc);
+    if (_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+    gnrc_ipv6_netif_init_by_dev();
+    if (gnrc_ipv6_netif_add_addr(_pid, &_ipv6_addr, 64,
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_ON_LINK) == NULL) {
+        puts("Could not configure interface");
+        return 1;
+    }
+    local.port = PORT;
+    if (sock_udp_create(&_sock, &local, NULL, 0) < 0) {
+        puts("Could not create sock");
+        return 1;
+    }
+    /* sent to all nodes, so no address resolution is needed */
+    ipv6_addr_set_all_nodes_multicast((ipv6_addr_t *)&remote.addr.ipv6,
+                                      IPV6_ADDR_MCAST_SCP_LINK_LOCAL);
+    remote.netif = _pid;
+    remote.port = PORT;
+    _build_rx_frame();
+    netstats_lat_reset();
+
+    printf("%u packets of %u bytes each way in bursts of %u\n", PKTS,
+           PAYLOAD_LEN, BURST);
+    for (unsigned i = 0; i < PKTS; i += BURST) {
+        received += _receive_burst();
+        sent += _send_burst(&remote);
+    }
+    printf("%u received, %u sent\n", received, _sent);
+
+    for (unsigned i = 0; i < sizeof(_stages) / sizeof(_stages[0]); i++) {
+        const netstats_lat_hist_t *hist = netstats_lat_get(_stages[i].stage);
+
+        printf("%s: %lu packets, p50 %lu us, p99 %lu us, max %lu us\n",
+               _stages[i].name, (unsigned long)hist->count,
+               (unsigned long)netstats_lat_percentile(hist, 50),
+               (unsigned long)netstats_lat_percentile(hist, 99),
+               (unsigned long)hist->max);
+        ok &= (hist->count == PKTS);
+    }
+
+    puts((ok && (received == PKTS) && (sent == PKTS) && (_sent == PKTS)) ?
+         "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact("1024 packets of 16 bytes each way in bursts of 4")
+    child.expect_exact("1024 received, 1024 sent")
+    for stage in ("rx ipv6", "rx udp", "rx sock", "tx udp", "tx ipv6",
+                  "tx netdev"):
+        child.expect(stage + r": 1024 packets, p50 \d+ us, p99 \d+ us, "
+                     r"max \d+ us")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the frame rate of a network interface with the
+ *              packet capture off and on
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktcap.h"
+#include "net/netdev2_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define FRAMES          (4096U)
+#define BATCH           (8U)    /* frames per direction between exports */
+#define PAYLOAD_LEN     (100U)
+#define FRAME_LEN       (sizeof(ethernet_hdr_t) + PAYLOAD_LEN)
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+typedef struct {
+    const char *name;
+    uint32_t tx_time;
+    uint32_t rx_time;
+    uint32_t export_time;
+    unsigned exported;
+} result_t;
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _pid;
+static char _stack[MAC_STACKSIZE];
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static uint8_t _rx_frame[FRAME_LEN];
+static unsigned _sent, _received;
+
+static void _isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _recv(netdev2_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_rx_frame);
+    }
+    if (len < (int)sizeof(_rx_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _rx_frame, sizeof(_rx_frame));
+    _received++;
+    return sizeof(_rx_frame);
+}
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    int len = 0;
+
+    (void)dev;
+    for (int i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    _sent++;
+    return len;
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _addr, sizeof(_addr));
+    return sizeof(_addr);
+}
+
+static int _discard(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    (void)data;
+    (void)len;
+    return 0;
+}
+
+/* the interface thread has the higher priority, so a frame is handled
+ * completely before the functions below return */
+static unsigned _send_frame(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return 1;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return 1;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->flags = GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, netif);
+    if (gnrc_netapi_send(_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return 1;
+    }
+    return 0;
+}
+
+static void _receive_frame(void)
+{
+    _dev.netdev.event_callback((netdev2_t *)&_dev, NETDEV2_EVENT_ISR);
+}
+
+static unsigned _run(result_t *res)
+{
+    unsigned failed = 0;
+
+    _sent = 0;
+    _received = 0;
+    for (unsigned i = 0; i < FRAMES; i += BATCH) {
+        uint32_t start = xtimer_now_usec();
+        int num;
+
+        for (unsigned j = 0; j < BATCH; j++) {
+            failed += _send_frame();
+        }
+        res->tx_time += xtimer_now_usec() - start;
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < BATCH; j++) {
+            _receive_frame();
+        }
+        res->rx_time += xtimer_now_usec() - start;
+        /* the ring is drained in between, as a shell command would do */
+        start = xtimer_now_usec();
+        num = gnrc_pktcap_export(_discard, NULL);
+        res->export_time += xtimer_now_usec() - start;
+        res->exported += (num > 0) ? num : 0;
+    }
+    failed += (_sent != FRAMES) + (_received != FRAMES);
+    return failed;
+}
+
+static void _report(result_t *res)
+{
+    printf("%s: %lu frames/s sent, %lu frames/s received, "
+           "%u packets exported in %lu us\n", res->name,
+           (unsigned long)(((uint64_t)FRAMES * US_PER_SEC) / (res->tx_time ? res->tx_time : 1)),
+           (unsigned long)(((uint64_t)FRAMES * US_PER_SEC) / (res->rx_time ? res->rx_time : 1)),
+           res->exported, (unsigned long)res->export_time);
+}
+
+int main(void)
+{
+    result_t off = { .name = "capture off" };
+    result_t on = { .name = "capture on" };
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_rx_frame;
+    const gnrc_pktcap_stats_t *stats = gnrc_pktcap_get_stats();
+    unsigned failed = 0;
+
+    puts("Packet capture benchmark\n");
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_isr_cb(&_dev, _isr);
+    netdev2_test_set_recv_cb(&_dev, _recv);
+    netdev2_test_set_send_cb(&_dev, _send);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_addr);
+    gnrc_netdev2_eth_init(&_gnrc, (netdev2_t *)&_dev);
+    _pid = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "eth", &_gnrc);
+    if (_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+    /* received frames are not handled by any other module */
+    memset(eth->dst, 0xff, sizeof(eth->dst));
+    memcpy(eth->src, _addr, sizeof(_addr));
+    eth->src[5]++;
+    eth->type = byteorder_htons(ETHERTYPE_UNKNOWN);
+    printf("%u frames of %u bytes each way\n", FRAMES, (unsigned)FRAME_LEN);
+
+    failed += _run(&off);
+    _report(&off);
+    gnrc_pktcap_enable(true);
+    failed += _run(&on);
+    gnrc_pktcap_enable(false);
+    _report(&on);
+    printf("%lu captured, %lu dropped\n", (unsigned long)stats->captured,
+           (unsigned long)stats->dropped);
+
+    puts(((failed == 0) && (off.exported == 0) && (stats->dropped == 0) &&
+          (stats->captured == (2 * FRAMES)) && (on.exported == (2 * FRAMES))) ?
+         "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"4096 frames of \d+ bytes each way")
+    child.expect(r"capture off: \d+ frames/s sent, \d+ frames/s received, "
+                 r"0 packets exported in \d+ us")
+    child.expect(r"capture on: \d+ frames/s sent, \d+ frames/s received, "
+                 r"8192 packets exported in \d+ us")
+    child.expect_exact("8192 captured, 0 dropped")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
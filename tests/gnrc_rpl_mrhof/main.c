@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulation of a lossy mesh routed with OF0 and MRHOF
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev2/ieee802154.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "net/netdev2_test.h"
+#include "net/netstats/neighbor.h"
+#include "random.h"
+#include "thread.h"
+
+#define GRID_SIZE       (6U)
+#define NUM_NODES       (GRID_SIZE * GRID_SIZE)
+#define ROOT            (0U)
+#define ROUNDS          (20U)       /**< DIO intervals until the DODAG is used */
+#define PROBE_FRAMES    (50U)       /**< frames per link to estimate its ETX */
+#define PACKETS         (100U)      /**< packets sent by each node */
+#define MAC_ATTEMPTS    (4U)        /**< attempts of the MAC per frame */
+#define MAX_HOPS        (64U)
+#define ORDER_PARENTS   (3U)        /**< parents of the parent order test */
+#define ORDER_ADDR      (0xffU)     /**< first byte of the short addresses of
+                                     *   the parents of the parent order test */
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 1)
+
+/**
+ * @brief   Simulated node
+ */
+typedef struct {
+    gnrc_rpl_instance_t inst;
+    gnrc_rpl_parent_t parents[NUM_NODES];
+    gnrc_rpl_parent_t *preferred;
+    uint16_t rank;
+} node_t;
+
+static node_t _nodes[NUM_NODES];
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _iface;
+static char _stack[MAC_STACKSIZE];
+static netdev2_event_t _tx_event;   /* outcome of the frame in flight */
+static mutex_t _tx_done = MUTEX_INIT_LOCKED;
+
+/*
+ * Starts to send a frame. As at86rf2xx, mrf24j40 and kw2xrf do, the device
+ * reports the outcome from its isr() only after send() returned.
+ */
+static int _dev_send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    int len = 0;
+
+    for (int i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    dev->event_callback(dev, NETDEV2_EVENT_ISR);
+    return len;
+}
+
+static void _dev_isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, _tx_event);
+    mutex_unlock(&_tx_done);
+}
+
+/*
+ * Sends a frame to the neighbor with the short address a:b through the
+ * simulated interface, whose device reports event as the outcome. Returns
+ * false if the frame could not be sent.
+ */
+static bool _tx(uint8_t a, uint8_t b, netdev2_event_t event)
+{
+    uint8_t l2_addr[] = { a, b };
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, 1, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return false;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, l2_addr, sizeof(l2_addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    LL_PREPEND(pkt, netif);
+    _tx_event = event;
+    if (gnrc_netapi_send(_iface, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    mutex_lock(&_tx_done);
+    return true;
+}
+
+/*
+ * Returns the loss rate of an attempt to send a frame on the link between
+ * two nodes in percent, or 100 if the nodes are out of range. The loss grows
+ * with the distance.
+ */
+static unsigned _loss(unsigned a, unsigned b)
+{
+    int dx = (int)(a % GRID_SIZE) - (int)(b % GRID_SIZE);
+    int dy = (int)(a / GRID_SIZE) - (int)(b / GRID_SIZE);
+
+    switch (dx * dx + dy * dy) {
+        case 1:
+            return 5;
+        case 2:
+            return 40;
+        case 4:
+            return 90;
+        case 5:
+            return 95;
+        default:
+            return 100;
+    }
+}
+
+/*
+ * Sends a frame with up to MAC_ATTEMPTS attempts, which are added to
+ * attempts. Returns true if the frame was acknowledged.
+ */
+static bool _send_frame(unsigned from, unsigned to, uint32_t *attempts)
+{
+    for (unsigned i = 1; i <= MAC_ATTEMPTS; i++) {
+        if ((random_uint32() % 100) >= _loss(from, to)) {
+            *attempts += i;
+            return true;
+        }
+    }
+    *attempts += MAC_ATTEMPTS;
+    return false;
+}
+
+/*
+ * Estimates the ETX of all links with probe frames. The link from node i to
+ * node j is the neighbor i:j of the simulated interface.
+ */
+static bool _probe_links(void)
+{
+    bool res = true;
+
+    for (unsigned i = 0; i < NUM_NODES; i++) {
+        for (unsigned j = 0; j < NUM_NODES; j++) {
+            if ((i == j) || (_loss(i, j) == 100)) {
+                continue;
+            }
+            for (unsigned k = 0; k < PROBE_FRAMES; k++) {
+                uint32_t attempts = 0;
+                res = _tx(i, j, _send_frame(i, j, &attempts) ?
+                                NETDEV2_EVENT_TX_COMPLETE :
+                                NETDEV2_EVENT_TX_NOACK) && res;
+            }
+        }
+    }
+    return res;
+}
+
+static void _init_nodes(gnrc_rpl_of_t *of)
+{
+    memset(_nodes, 0, sizeof(_nodes));
+    for (unsigned i = 0; i < NUM_NODES; i++) {
+        node_t *node = &_nodes[i];
+
+        node->inst.state = 1;
+        node->inst.of = of;
+        node->inst.min_hop_rank_inc = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+        node->inst.dodag.instance = &node->inst;
+        node->rank = (i == ROOT) ? GNRC_RPL_ROOT_RANK : GNRC_RPL_INFINITE_RANK;
+        for (unsigned j = 0; j < NUM_NODES; j++) {
+            node->parents[j].dodag = &node->inst.dodag;
+            node->parents[j].rank = GNRC_RPL_INFINITE_RANK;
+        }
+    }
+}
+
+/*
+ * Lets each node select its preferred parent after one DIO interval, in
+ * which each node sends one DIO with the rank of the previous round. A DIO
+ * is lost like any other frame, but not retransmitted.
+ */
+static void _round(void)
+{
+    uint16_t ranks[NUM_NODES];
+
+    for (unsigned i = 0; i < NUM_NODES; i++) {
+        ranks[i] = _nodes[i].rank;
+    }
+
+    for (unsigned i = 0; i < NUM_NODES; i++) {
+        node_t *node = &_nodes[i];
+        gnrc_rpl_of_t *of = node->inst.of;
+        uint16_t mhri = node->inst.min_hop_rank_inc;
+        gnrc_rpl_parent_t *best = node->preferred;
+
+        if (i == ROOT) {
+            continue;
+        }
+        for (unsigned j = 0; j < NUM_NODES; j++) {
+            gnrc_rpl_parent_t *parent = &node->parents[j];
+            uint8_t l2_addr[] = { i, j };
+
+            if ((i == j) || (_loss(i, j) == 100)) {
+                continue;
+            }
+            if ((random_uint32() % 100) >= _loss(j, i)) {
+                parent->rank = ranks[j];
+            }
+            parent->link_metric = netstats_nb_get_etx(_iface, l2_addr,
+                                                    sizeof(l2_addr));
+            /* only nodes closer to the root are parents */
+            if ((parent->rank == GNRC_RPL_INFINITE_RANK) ||
+                ((node->rank != GNRC_RPL_INFINITE_RANK) &&
+                 (DAGRANK(parent->rank, mhri) >= DAGRANK(node->rank, mhri)))) {
+                continue;
+            }
+            best = (best == NULL) ? parent : of->which_parent(best, parent);
+        }
+        node->preferred = best;
+        node->inst.dodag.parents = best;
+        node->rank = of->calc_rank(best, 0);
+    }
+}
+
+static void _print_per_mille(const char *name, uint32_t value, uint32_t count)
+{
+    uint32_t per_mille = (value * 1000U) / (count ? count : 1);
+
+    printf(", %s %lu.%03lu", name, (unsigned long)(per_mille / 1000U),
+           (unsigned long)(per_mille % 1000U));
+}
+
+/*
+ * Sends packets from each node to the root along the preferred parents.
+ * Returns the number of delivered packets.
+ */
+static uint32_t _simulate(const char *name, gnrc_rpl_of_t *of)
+{
+    uint32_t delivered = 0, hops = 0, attempts = 0, sent = 0;
+
+    random_init(1);
+    _init_nodes(of);
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        _round();
+    }
+
+    for (unsigned i = 0; i < NUM_NODES; i++) {
+        if (i == ROOT) {
+            continue;
+        }
+        for (unsigned k = 0; k < PACKETS; k++) {
+            unsigned node = i, hop = 0;
+
+            sent++;
+            while ((node != ROOT) && _nodes[node].preferred && (hop < MAX_HOPS)) {
+                unsigned next = _nodes[node].preferred - _nodes[node].parents;
+
+                if (!_send_frame(node, next, &attempts)) {
+                    break;
+                }
+                node = next;
+                hop++;
+            }
+            if (node == ROOT) {
+                delivered++;
+                hops += hop;
+            }
+        }
+    }
+
+    printf("%s: delivered %lu/%lu", name,
+           (unsigned long)delivered, (unsigned long)sent);
+    _print_per_mille("hops", hops, delivered);
+    _print_per_mille("attempts/packet", attempts, sent);
+    puts("");
+    return delivered;
+}
+
+/*
+ * Sends frames to parent n of the parent order test, whose link layer
+ * address gnrc_rpl derives from its IPv6 address
+ */
+static bool _order_tx(unsigned n, netdev2_event_t event, unsigned count)
+{
+    bool res = true;
+
+    for (unsigned i = 0; i < count; i++) {
+        res = _tx(ORDER_ADDR, n, event) && res;
+    }
+    return res;
+}
+
+/*
+ * Prints the parents of a DODAG, preferred parent first, and returns true
+ * if they are in the expected order
+ */
+static bool _order_check(gnrc_rpl_dodag_t *dodag, const unsigned *expected)
+{
+    gnrc_rpl_parent_t *parent = dodag->parents;
+    bool res = true;
+
+    printf("parents:");
+    for (unsigned i = 0; i < ORDER_PARENTS; i++) {
+        if (parent == NULL) {
+            res = false;
+            break;
+        }
+        unsigned n = parent->addr.u8[15];
+        printf(" %u", n);
+        res = res && (n == expected[i]);
+        parent = parent->next;
+    }
+    puts("");
+    return res && (parent == NULL);
+}
+
+/*
+ * Updates the parents of a DODAG one by one as gnrc_rpl does when it
+ * receives their DIOs, and checks that the changed parent is moved to its
+ * place and replaces the preferred parent only if it is sufficiently better.
+ */
+static bool _test_parent_order(void)
+{
+    static const unsigned initial[] = { 1, 2, 3 };
+    static const unsigned improved[] = { 1, 3, 2 };
+    static const unsigned broken[] = { 3, 2, 1 };
+    gnrc_rpl_parent_t *parents[ORDER_PARENTS];
+    gnrc_rpl_instance_t *inst;
+    gnrc_rpl_dodag_t *dodag;
+    ipv6_addr_t dodag_id = IPV6_ADDR_UNSPECIFIED;
+    bool res = true;
+
+    dodag_id.u8[15] = 1;
+    if (!gnrc_rpl_instance_add(0, &inst)) {
+        return false;
+    }
+    inst->mop = GNRC_RPL_MOP_NO_DOWNWARD_ROUTES;
+    inst->of = gnrc_rpl_get_of_for_ocp(GNRC_RPL_MRHOF_OCP);
+    gnrc_rpl_dodag_init(inst, &dodag_id, _iface, NULL);
+    dodag = &inst->dodag;
+    trickle_start(thread_getpid(), &dodag->trickle,
+                  GNRC_RPL_MSG_TYPE_TRICKLE_INTERVAL,
+                  GNRC_RPL_MSG_TYPE_TRICKLE_CALLBACK, (1 << dodag->dio_min),
+                  dodag->dio_interval_doubl, dodag->dio_redun);
+
+    /* parent n is a root with a link ETX of n */
+    for (unsigned n = 1; n <= ORDER_PARENTS; n++) {
+        ipv6_addr_t addr;
+
+        ipv6_addr_from_str(&addr, "fe80::ff:fe00:0");
+        addr.u8[14] = ORDER_ADDR;
+        addr.u8[15] = n;
+        res = _order_tx(n, NETDEV2_EVENT_TX_NOACK, n - 1) && res;
+        res = _order_tx(n, NETDEV2_EVENT_TX_COMPLETE, 1) && res;
+        gnrc_rpl_parent_add_by_addr(dodag, &addr, &parents[n - 1]);
+        parents[n - 1]->rank = GNRC_RPL_ROOT_RANK;
+        gnrc_rpl_parent_update(dodag, parents[n - 1]);
+    }
+    res = _order_check(dodag, initial) && res;
+
+    /* the link to parent 3 improves: it overtakes parent 2, but is not
+     * better than the preferred parent by the switch threshold */
+    res = _order_tx(3, NETDEV2_EVENT_TX_COMPLETE, 20) && res;
+    gnrc_rpl_parent_update(dodag, parents[2]);
+    res = _order_check(dodag, improved) && res;
+
+    /* the link to the preferred parent breaks */
+    res = _order_tx(1, NETDEV2_EVENT_TX_NOACK, 4 * NETSTATS_NB_MAX_FAILURES) && res;
+    gnrc_rpl_parent_update(dodag, parents[0]);
+    res = _order_check(dodag, broken) && res;
+
+    trickle_stop(&dodag->trickle);
+    gnrc_rpl_instance_remove(inst);
+    return res;
+}
+
+int main(void)
+{
+    puts("RPL objective function simulation\n");
+
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_send_cb(&_dev, _dev_send);
+    netdev2_test_set_isr_cb(&_dev, _dev_isr);
+    gnrc_netdev2_ieee802154_init(&_gnrc, (netdev2_ieee802154_t *)&_dev);
+    _iface = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "wpan",
+                               &_gnrc);
+    if (_iface <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+
+    gnrc_rpl_of_manager_init();
+    bool order = _test_parent_order();
+
+    random_init(0);
+    bool probed = _probe_links();
+
+    uint32_t of0 = _simulate("OF0", gnrc_rpl_get_of_for_ocp(0));
+    uint32_t mrhof = _simulate("MRHOF", gnrc_rpl_get_of_for_ocp(GNRC_RPL_MRHOF_OCP));
+
+    if (order && probed && (mrhof > of0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
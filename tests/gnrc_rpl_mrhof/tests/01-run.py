@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+RESULT = r"delivered (\d+)/\d+, hops \d+\.\d+, attempts/packet \d+\.\d+"
+
+
+def testfunc(child):
+    child.expect_exact("parents: 1 2 3")
+    child.expect_exact("parents: 1 3 2")
+    child.expect_exact("parents: 3 2 1")
+    child.expect("OF0: " + RESULT)
+    of0 = int(child.match.group(1))
+    child.expect("MRHOF: " + RESULT)
+    mrhof = int(child.match.group(1))
+    assert mrhof > of0
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the rate at which a 6LoWPAN router handles address
+ *              registrations of many hosts
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/eui64.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netdev2/eth.h"
+#include "net/gnrc/sixlowpan/nd.h"
+#include "net/gnrc/sixlowpan/nd/router.h"
+#include "net/icmpv6.h"
+#include "net/inet_csum.h"
+#include "net/ndp.h"
+#include "net/netdev2_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan/nd.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS          (4U)
+#define LTIME           (30U)   /* in minutes */
+
+#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
+
+static gnrc_netdev2_t _gnrc;
+static netdev2_test_t _dev;
+static kernel_pid_t _pid;
+static char _stack[MAC_STACKSIZE];
+static const eui64_t _eui64 = { .uint8 = {
+        0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _prefix = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    } };
+static const ipv6_addr_t _router = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+
+static int _send(netdev2_t *dev, const struct iovec *vector, int count)
+{
+    /* router and neighbor advertisements are of no interest */
+    (void)dev;
+    (void)vector;
+    (void)count;
+    return 0;
+}
+
+static int _get_eui64(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_eui64)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, &_eui64, sizeof(_eui64));
+    return sizeof(_eui64);
+}
+
+static int _get_addr(netdev2_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < ETHERNET_ADDR_LEN) {
+        return -ENOBUFS;
+    }
+    /* EUI-48 of the EUI-64 above */
+    memcpy(value, _eui64.uint8, 3);
+    memcpy((uint8_t *)value + 3, &_eui64.uint8[5], 3);
+    return ETHERNET_ADDR_LEN;
+}
+
+/* host i has EUI-64 02:00:00:ff:fe:01:i and address 2001:db8::ff:fe01:i */
+static void _host(unsigned i, eui64_t *eui64, ipv6_addr_t *addr)
+{
+    *eui64 = _eui64;
+    eui64->uint8[5] = 0x01;
+    eui64->uint8[6] = i >> 8;
+    eui64->uint8[7] = i & 0xff;
+    *addr = _prefix;
+    memcpy(&addr->u8[8], eui64, sizeof(*eui64));
+    addr->u8[8] ^= 0x02;
+}
+
+/* hands a neighbor solicitation with address registration option of host i
+ * to the IPv6 thread, as if it was received from that host. The IPv6 thread
+ * has a higher priority than this thread, so the solicitation is handled
+ * when this function returns. Returns 1 if the solicitation could not be
+ * handed over. */
+static unsigned _register(unsigned i, uint16_t ltime)
+{
+    uint8_t frame[sizeof(ipv6_hdr_t) + sizeof(ndp_nbr_sol_t) +
+                  (2 * sizeof(sixlowpan_nd_opt_ar_t))];
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)frame;
+    ndp_nbr_sol_t *nbr_sol = (ndp_nbr_sol_t *)(ipv6 + 1);
+    /* an SL2AO with an EUI-64 is as long as an ARO */
+    ndp_opt_t *sl2a_opt = (ndp_opt_t *)(nbr_sol + 1);
+    sixlowpan_nd_opt_ar_t *ar_opt = (sixlowpan_nd_opt_ar_t *)(nbr_sol + 1) + 1;
+    uint16_t len = sizeof(frame) - sizeof(ipv6_hdr_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    eui64_t eui64;
+    uint16_t csum;
+
+    memset(frame, 0, sizeof(frame));
+    _host(i, &eui64, &ipv6->src);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_ICMPV6;
+    ipv6->hl = 255;
+    ipv6->dst = _router;
+    nbr_sol->type = ICMPV6_NBR_SOL;
+    nbr_sol->tgt = _router;
+    sl2a_opt->type = NDP_OPT_SL2A;
+    sl2a_opt->len = SIXLOWPAN_ND_OPT_AR_LEN;
+    memcpy(sl2a_opt + 1, &eui64, sizeof(eui64));
+    ar_opt->type = NDP_OPT_AR;
+    ar_opt->len = SIXLOWPAN_ND_OPT_AR_LEN;
+    ar_opt->ltime = byteorder_htons(ltime);
+    ar_opt->eui64 = eui64;
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_ICMPV6, len);
+    csum = inet_csum(csum, (uint8_t *)nbr_sol, len);
+    nbr_sol->csum = byteorder_htons(~csum);
+
+    netif = gnrc_netif_hdr_build(eui64.uint8, sizeof(eui64),
+                                 (uint8_t *)_eui64.uint8, sizeof(_eui64));
+    if (netif == NULL) {
+        return 1;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _pid;
+    pkt = gnrc_pktbuf_add(netif, frame, sizeof(frame), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return 1;
+    }
+    if (gnrc_netapi_receive(gnrc_ipv6_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned long _rate(unsigned num, uint32_t usec)
+{
+    return ((uint64_t)num * US_PER_SEC) / (usec ? usec : 1);
+}
+
+static unsigned _run(unsigned hosts)
+{
+    uint32_t start, t_reg, t_refresh, t_dereg, t_table, t_nc;
+    unsigned failed = 0;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < hosts; i++) {
+        failed += _register(i, LTIME);
+    }
+    t_reg = xtimer_now_usec() - start;
+    failed += (gnrc_sixlowpan_nd_router_reg_numof() != hosts);
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < hosts; i++) {
+            failed += _register(i, LTIME);
+        }
+    }
+    t_refresh = xtimer_now_usec() - start;
+    failed += (gnrc_sixlowpan_nd_router_reg_numof() != hosts);
+
+    /* lookups as done when forwarding to a registered host. The IPv6 thread
+     * handled all solicitations and no registration expires, so it does
+     * not touch the tables meanwhile. */
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < hosts; i++) {
+            eui64_t eui64;
+            ipv6_addr_t addr;
+
+            _host(i, &eui64, &addr);
+            failed += (gnrc_sixlowpan_nd_router_reg_get(_pid, &addr) == NULL);
+        }
+    }
+    t_table = xtimer_now_usec() - start;
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < hosts; i++) {
+            eui64_t eui64;
+            ipv6_addr_t addr;
+
+            _host(i, &eui64, &addr);
+            failed += (gnrc_ipv6_nc_get(_pid, &addr) == NULL);
+        }
+    }
+    t_nc = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < hosts; i++) {
+        failed += _register(i, 0);
+    }
+    t_dereg = xtimer_now_usec() - start;
+    failed += (gnrc_sixlowpan_nd_router_reg_numof() != 0);
+
+    printf("%u hosts: %lu registrations/s, %lu refreshes/s, "
+           "%lu deregistrations/s, %u failed\n", hosts, _rate(hosts, t_reg),
+           _rate(hosts * ROUNDS, t_refresh), _rate(hosts, t_dereg), failed);
+    printf("%u hosts: %lu lookups/s in the registration table, "
+           "%lu lookups/s in the neighbor cache\n", hosts,
+           _rate(hosts * ROUNDS, t_table), _rate(hosts * ROUNDS, t_nc));
+    return failed;
+}
+
+int main(void)
+{
+    static const unsigned hosts[] = { 50, 200, 500 };
+    gnrc_ipv6_netif_t *ipv6_if;
+    unsigned failed = 0;
+
+    puts("6LoWPAN-ND address registration benchmark\n");
+    netdev2_test_setup(&_dev, NULL);
+    netdev2_test_set_send_cb(&_dev, _send);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_addr);
+    netdev2_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_eui64);
+    gnrc_netdev2_eth_init(&_gnrc, (netdev2_t *)&_dev);
+    _pid = gnrc_netdev2_init(_stack, sizeof(_stack), MAC_PRIO, "eth", &_gnrc);
+    if (_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start interface");
+        return 1;
+    }
+    gnrc_ipv6_netif_init_by_dev();
+    if ((ipv6_if = gnrc_ipv6_netif_get(_pid)) == NULL) {
+        puts("Could not configure interface");
+        return 1;
+    }
+    if (gnrc_ipv6_netif_add_addr(_pid, &_router, 64,
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST) == NULL) {
+        puts("Could not configure interface");
+        return 1;
+    }
+    /* registrations are accepted on forwarding 6LoWPAN interfaces */
+    ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_ROUTER | GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN;
+
+    for (unsigned n = 0; n < sizeof(hosts) / sizeof(hosts[0]); n++) {
+        failed += _run(hosts[n]);
+    }
+
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
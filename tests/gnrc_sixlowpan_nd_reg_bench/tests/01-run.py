@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    for hosts in (50, 200, 500):
+        child.expect(r"{} hosts: \d+ registrations/s, \d+ refreshes/s, "
+                     r"\d+ deregistrations/s, 0 failed".format(hosts))
+        child.expect(r"{} hosts: \d+ lookups/s in the registration table, "
+                     r"\d+ lookups/s in the neighbor cache".format(hosts))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Write amplification, index rebuild and crash consistency test
+ *              for the key/value store
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kvs.h"
+#include "mtd_native.h"
+#include "xtimer.h"
+
+#define KEYS            (48U)
+#define VAL_MAX         (40U)
+#define OPS             (4000U)
+#define SYNC_EVERY      (4U)
+#define CRASH_OPS       (300U)
+#define CRASH_KEYS      (16U)
+#define INDEX_SIZE      (64U)
+#define PAGE_SIZE       (256U)
+
+/*
+ * Wraps a device and loses power after a number of writes and erases. The
+ * last write is torn: only its first half is programmed.
+ */
+typedef struct {
+    mtd_dev_t base;
+    mtd_dev_t *parent;
+    int budget;                 /**< operations left, -1 for unlimited */
+    unsigned ops;               /**< operations done */
+} crash_mtd_t;
+
+typedef struct {
+    int len;                    /**< length of the value, -1 if deleted */
+    unsigned op;                /**< operation that set the value */
+} model_t;
+
+/* NOR flash of 4 KiB sectors for the workload */
+static mtd_native_t _flash = {
+    .base = {
+        .driver = &mtd_native_nor_driver,
+        .sector_count = 8,
+        .pages_per_sector = 16,
+        .page_size = PAGE_SIZE,
+    },
+    .fname = "kvs_flash.bin",
+};
+
+/* small device for the crash test, so that the log wraps often */
+static mtd_native_t _small = {
+    .base = {
+        .driver = &mtd_native_nor_driver,
+        .sector_count = 6,
+        .pages_per_sector = 4,
+        .page_size = PAGE_SIZE,
+    },
+    .fname = "kvs_small.bin",
+};
+
+static crash_mtd_t _crash;
+static kvs_t _kvs;
+static kvs_entry_t _index[INDEX_SIZE];
+static uint8_t _buf[2 * PAGE_SIZE];
+static model_t _model[KEYS];
+static uint32_t _seed;
+static uint32_t _compactions;
+
+static int _crash_init(mtd_dev_t *dev)
+{
+    crash_mtd_t *crash = (crash_mtd_t *)dev;
+
+    dev->sector_count = crash->parent->sector_count;
+    dev->pages_per_sector = crash->parent->pages_per_sector;
+    dev->page_size = crash->parent->page_size;
+    return 0;
+}
+
+static int _crash_read(mtd_dev_t *dev, void *buf, uint32_t addr, uint32_t size)
+{
+    return mtd_read(((crash_mtd_t *)dev)->parent, buf, addr, size);
+}
+
+static int _crash_write(mtd_dev_t *dev, const void *buf, uint32_t addr,
+                        uint32_t size)
+{
+    crash_mtd_t *crash = (crash_mtd_t *)dev;
+    uint8_t torn[PAGE_SIZE];
+
+    if (crash->budget == 0) {
+        return -EIO;
+    }
+    crash->ops++;
+    if ((crash->budget > 0) && (--crash->budget == 0) && (size <= sizeof(torn))) {
+        /* erased bytes leave the flash as it is */
+        memcpy(torn, buf, size);
+        memset(torn + (size / 2), 0xff, size - (size / 2));
+        mtd_write(crash->parent, torn, addr, size);
+        return -EIO;
+    }
+    return mtd_write(crash->parent, buf, addr, size);
+}
+
+static int _crash_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    crash_mtd_t *crash = (crash_mtd_t *)dev;
+
+    if (crash->budget == 0) {
+        return -EIO;
+    }
+    crash->ops++;
+    if ((crash->budget > 0) && (--crash->budget == 0)) {
+        return -EIO;
+    }
+    return mtd_erase(crash->parent, addr, size);
+}
+
+static const mtd_desc_t _crash_driver = {
+    .init = _crash_init,
+    .read = _crash_read,
+    .write = _crash_write,
+    .erase = _crash_erase,
+    .flush = NULL,
+    .flags = MTD_DRIVER_FLAG_ERASE,
+};
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+static void _key(char *key, unsigned k)
+{
+    sprintf(key, "key%02u", k);
+}
+
+static void _value(uint8_t *val, unsigned len, unsigned op)
+{
+    for (unsigned i = 0; i < len; i++) {
+        val[i] = (uint8_t)((op * 7) + i);
+    }
+}
+
+static void _reset_model(void)
+{
+    for (unsigned k = 0; k < KEYS; k++) {
+        _model[k].len = -1;
+    }
+}
+
+/* Returns 0 if key k holds the value of m. */
+static int _check(unsigned k, const model_t *m)
+{
+    char key[8];
+    uint8_t val[VAL_MAX], expected[VAL_MAX];
+    int res;
+
+    _key(key, k);
+    res = kvs_get(&_kvs, key, val, sizeof(val));
+    if (m->len < 0) {
+        return (res == -ENOENT) ? 0 : -1;
+    }
+    _value(expected, m->len, m->op);
+    return ((res == m->len) && (memcmp(val, expected, m->len) == 0)) ? 0 : -1;
+}
+
+static int _verify(void)
+{
+    for (unsigned k = 0; k < KEYS; k++) {
+        if (_check(k, &_model[k]) < 0) {
+            printf("key%02u differs\n", k);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Runs operation op: sets one of the first keys to a value of random length,
+ * or deletes it. Returns the key in *k and its new value in *next.
+ */
+static int _op(unsigned op, unsigned keys, unsigned *k, model_t *next)
+{
+    char key[8];
+    uint8_t val[VAL_MAX];
+    int res;
+
+    *k = _rand() % keys;
+    _key(key, *k);
+    next->op = op;
+    if ((_rand() % 8) == 0) {
+        next->len = -1;
+        res = kvs_delete(&_kvs, key);
+        if (res == -ENOENT) {
+            res = 0;
+        }
+    }
+    else {
+        next->len = 1 + (_rand() % VAL_MAX);
+        _value(val, next->len, op);
+        res = kvs_set(&_kvs, key, val, next->len);
+    }
+    return res;
+}
+
+static int _workload(void)
+{
+    mtd_dev_t *dev = &_flash.base;
+    unsigned k;
+    model_t next;
+
+    if ((mtd_init(dev) < 0) || (mtd_erase(dev, 0, mtd_size(dev)) < 0) ||
+        (kvs_init(&_kvs, dev, _buf, _index, INDEX_SIZE) < 0)) {
+        return -1;
+    }
+    _reset_model();
+    _seed = 1;
+    for (unsigned op = 0; op < OPS; op++) {
+        if (_op(op, KEYS, &k, &next) < 0) {
+            printf("workload: operation %u failed\n", op);
+            return -1;
+        }
+        _model[k] = next;
+        if ((op % SYNC_EVERY) == (SYNC_EVERY - 1)) {
+            /* idle: sync and compact in the background */
+            if ((kvs_sync(&_kvs) < 0) || (kvs_compact(&_kvs) < 0)) {
+                return -1;
+            }
+        }
+    }
+    if ((kvs_sync(&_kvs) < 0) || (_verify() < 0)) {
+        return -1;
+    }
+
+    kvs_stats_t *stats = &_kvs.stats;
+    uint32_t wa = (uint32_t)(((uint64_t)stats->flash_bytes * 100) / stats->user_bytes);
+    printf("workload: %u operations, %lu user bytes, %lu flash bytes, "
+           "write amplification %lu.%02lu, %lu erases, %lu compactions\n",
+           OPS, (unsigned long)stats->user_bytes,
+           (unsigned long)stats->flash_bytes, (unsigned long)(wa / 100),
+           (unsigned long)(wa % 100), (unsigned long)stats->erases,
+           (unsigned long)stats->compactions);
+
+    /* reboot */
+    uint32_t start = xtimer_now_usec();
+    if (kvs_init(&_kvs, dev, _buf, _index, INDEX_SIZE) < 0) {
+        return -1;
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+    printf("rebuild: %u keys in %lu us\n", _kvs.count, (unsigned long)usec);
+    return _verify();
+}
+
+/*
+ * Runs the crash workload, syncing after each operation, until the device
+ * loses power after budget operations. After remounting, all keys must hold
+ * the value of their last completed operation, except for the key of the
+ * interrupted operation, which may also hold the new value.
+ */
+static int _crash_run(int budget)
+{
+    unsigned k = 0;
+    uint8_t val[4];
+    model_t next, last;
+    int res = 0;
+
+    mtd_erase(&_small.base, 0, mtd_size(&_small.base));
+    _crash.budget = budget;
+    _crash.ops = 0;
+    if (kvs_init(&_kvs, &_crash.base, _buf, _index, INDEX_SIZE) < 0) {
+        return -1;
+    }
+    _reset_model();
+    _seed = 2;
+    for (unsigned op = 0; op < CRASH_OPS; op++) {
+        if (((res = _op(op, CRASH_KEYS, &k, &next)) < 0) ||
+            ((res = kvs_sync(&_kvs)) < 0)) {
+            break;
+        }
+        _model[k] = next;
+        if ((op % SYNC_EVERY) == 0) {
+            if ((res = kvs_compact(&_kvs)) < 0) {
+                /* the operation itself is complete */
+                k = KEYS;
+                break;
+            }
+        }
+    }
+    if ((res < 0) && (res != -EIO)) {
+        printf("crash: operation failed (%d)\n", res);
+        return -1;
+    }
+
+    _compactions = _kvs.stats.compactions;
+    _crash.budget = -1;
+    if (kvs_init(&_kvs, &_crash.base, _buf, _index, INDEX_SIZE) < 0) {
+        puts("crash: mount failed");
+        return -1;
+    }
+    for (unsigned i = 0; i < KEYS; i++) {
+        if ((_check(i, &_model[i]) < 0) &&
+            ((res >= 0) || (i != k) || (_check(i, &next) < 0))) {
+            printf("crash: key%02u differs after %d operations\n", i, budget);
+            return -1;
+        }
+    }
+    /* the store must remain usable */
+    last.len = sizeof(val);
+    last.op = 0;
+    _value(val, sizeof(val), 0);
+    if ((kvs_set(&_kvs, "key00", val, sizeof(val)) < 0) ||
+        (kvs_sync(&_kvs) < 0) || (_check(0, &last) < 0)) {
+        printf("crash: store unusable after %d operations\n", budget);
+        return -1;
+    }
+    return 0;
+}
+
+static int _crash_test(void)
+{
+    unsigned total;
+    uint32_t compactions;
+
+    _crash.base.driver = &_crash_driver;
+    _crash.parent = &_small.base;
+    if (mtd_init(&_small.base) < 0) {
+        return -1;
+    }
+    /* count the operations of an uninterrupted run */
+    if (_crash_run(-1) < 0) {
+        return -1;
+    }
+    total = _crash.ops;
+    compactions = _compactions;
+    for (unsigned budget = 1; budget <= total; budget++) {
+        if (_crash_run(budget) < 0) {
+            return -1;
+        }
+    }
+    printf("crash: %u power losses during %lu compactions, all consistent\n",
+           total, (unsigned long)compactions);
+    return 0;
+}
+
+int main(void)
+{
+    puts("kvs test\n");
+
+    if ((_workload() == 0) && (_crash_test() == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"workload: 4000 operations, \d+ user bytes, \d+ flash bytes, "
+                 r"write amplification \d+\.\d+, \d+ erases, (\d+) compactions")
+    assert int(child.match.group(1)) > 0
+    child.expect(r"rebuild: \d+ keys in \d+ us")
+    child.expect(r"crash: \d+ power losses during (\d+) compactions, "
+                 r"all consistent")
+    assert int(child.match.group(1)) > 0
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=120))
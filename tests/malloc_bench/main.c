@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares allocators under a random allocation pattern
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "heap.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SLOTS           (32U)
+#define ROUNDS          (20000U)
+#define MAX_ALLOC       (256U)
+#define POOL_SIZE       (8U * 1024)
+#define THREADS         (2U)
+
+typedef struct {
+    const char *name;
+    void *(*malloc)(size_t size);
+    void *(*realloc)(void *ptr, size_t size);
+    void (*free)(void *ptr);
+} alloc_t;
+
+typedef struct {
+    const alloc_t *alloc;
+    uint8_t *ptrs[SLOTS];
+    unsigned failed;
+    uint32_t seed;
+    int yield;
+} run_t;
+
+static uint8_t _oneway_pool[POOL_SIZE];
+static size_t _oneway_pos;
+static uint8_t _pools[THREADS + 1][POOL_SIZE];
+static heap_arena_t _arenas[THREADS + 1];
+static uint8_t _shared_pool[THREADS * POOL_SIZE];
+static heap_arena_t _shared;
+static char _stacks[THREADS][THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _main_pid;
+
+/* same behaviour as sys/oneway-malloc, on a pool of the same size as the
+ * arenas instead of sbrk() */
+static void *_oneway_malloc(size_t size)
+{
+    size = (size + 7) & ~7U;
+    if ((size == 0) || (_oneway_pos + size > sizeof(_oneway_pool))) {
+        return NULL;
+    }
+    _oneway_pos += size;
+    return &_oneway_pool[_oneway_pos - size];
+}
+
+static void *_oneway_realloc(void *ptr, size_t size)
+{
+    void *res = _oneway_malloc(size);
+
+    if (res && ptr) {
+        memcpy(res, ptr, size);
+    }
+    return res;
+}
+
+static void _oneway_free(void *ptr)
+{
+    (void)ptr;
+}
+
+static const alloc_t _allocs[] = {
+    { "libc", malloc, realloc, free },
+    { "oneway", _oneway_malloc, _oneway_realloc, _oneway_free },
+    { "heap", heap_malloc, heap_realloc, heap_free },
+};
+
+static void _run(run_t *run, unsigned rounds)
+{
+    const alloc_t *alloc = run->alloc;
+
+    for (unsigned r = 0; r < rounds; r++) {
+        unsigned i, size;
+
+        run->seed = (run->seed * 1103515245U) + 12345U;
+        i = (run->seed >> 16) % SLOTS;
+        /* mostly small, sometimes large allocations */
+        size = 1 + ((run->seed >> 4) % ((run->seed & 0x300) ? 64 : MAX_ALLOC));
+        if (run->ptrs[i] && (run->seed & 0x8000)) {
+            alloc->free(run->ptrs[i]);
+            run->ptrs[i] = NULL;
+        }
+        else if (run->ptrs[i]) {
+            uint8_t *res = alloc->realloc(run->ptrs[i], size);
+
+            if (res) {
+                run->ptrs[i] = res;
+            }
+            else {
+                run->failed++;
+            }
+        }
+        else {
+            run->ptrs[i] = alloc->malloc(size);
+            if (run->ptrs[i] == NULL) {
+                run->failed++;
+                continue;
+            }
+            /* touch the memory, as real users would */
+            run->ptrs[i][0] = i;
+            run->ptrs[i][size - 1] = i;
+        }
+        if (run->yield) {
+            thread_yield();
+        }
+    }
+}
+
+static void _release(run_t *run)
+{
+    for (unsigned i = 0; i < SLOTS; i++) {
+        run->alloc->free(run->ptrs[i]);
+        run->ptrs[i] = NULL;
+    }
+}
+
+static void _bench(const alloc_t *alloc)
+{
+    run_t run = { .alloc = alloc, .seed = 1 };
+    uint32_t start = xtimer_now_usec();
+
+    _run(&run, ROUNDS);
+    _release(&run);
+    start = xtimer_now_usec() - start;
+    printf("%s: %u ops in %lu us (%lu ops/s), %u failed\n", alloc->name,
+           ROUNDS, (unsigned long)start,
+           (unsigned long)(((uint64_t)ROUNDS * US_PER_SEC) / (start ? start : 1)),
+           run.failed);
+}
+
+static void _frag(const char *name, heap_arena_t *arena)
+{
+    tlsf_heap_stats_t stats;
+
+    tlsf_heap_stats(&arena->heap, &stats);
+    printf("%s: %u bytes used, %u free blocks, largest %u of %u bytes "
+           "free, %u%% fragmented\n", name, (unsigned)stats.used,
+           stats.free_blocks, (unsigned)stats.largest, (unsigned)stats.free,
+           tlsf_heap_fragmentation(&stats));
+}
+
+/* keeps its memory until told to release it */
+static void *_thread(void *arg)
+{
+    run_t run = { .alloc = &_allocs[2], .seed = (uintptr_t)arg, .yield = 1 };
+    msg_t msg;
+
+    _run(&run, ROUNDS / THREADS);
+    msg.content.value = run.failed;
+    msg_send(&msg, _main_pid);
+    msg_receive(&msg);
+    _release(&run);
+    msg_reply(&msg, &msg);
+    return NULL;
+}
+
+static unsigned _threads(const char *name, int private)
+{
+    kernel_pid_t pids[THREADS];
+    unsigned failed = 0;
+    msg_t msg;
+
+    for (unsigned t = 0; t < THREADS; t++) {
+        pids[t] = thread_create(_stacks[t], sizeof(_stacks[t]),
+                                THREAD_PRIORITY_MAIN,
+                                THREAD_CREATE_SLEEPING, _thread,
+                                (void *)(uintptr_t)(t + 1), "alloc");
+        heap_arena_use(pids[t], private ? &_arenas[t + 1] : &_shared);
+    }
+    /* of the same priority as this thread, so they start taking turns
+     * once it waits for them */
+    for (unsigned t = 0; t < THREADS; t++) {
+        thread_wakeup(pids[t]);
+    }
+    for (unsigned t = 0; t < THREADS; t++) {
+        msg_receive(&msg);
+        failed += msg.content.value;
+    }
+    /* the first thread is done, the second one still uses its memory */
+    msg_send_receive(&msg, &msg, pids[0]);
+    if (private) {
+        _frag("private arena 1", &_arenas[1]);
+        _frag("private arena 2", &_arenas[2]);
+    }
+    else {
+        _frag("shared arena", &_shared);
+    }
+    msg_send_receive(&msg, &msg, pids[1]);
+    printf("%s: %u failed\n", name, failed);
+    return failed;
+}
+
+int main(void)
+{
+    unsigned failed;
+
+    puts("malloc benchmark\n");
+    _main_pid = thread_getpid();
+    for (unsigned t = 0; t <= THREADS; t++) {
+        heap_arena_init(&_arenas[t], _pools[t], sizeof(_pools[t]));
+    }
+    heap_arena_init(&_shared, _shared_pool, sizeof(_shared_pool));
+
+    printf("%u ops each, %u bytes of memory\n", ROUNDS, POOL_SIZE);
+    heap_arena_use(_main_pid, &_arenas[0]);
+    for (unsigned i = 0; i < sizeof(_allocs) / sizeof(_allocs[0]); i++) {
+        _bench(&_allocs[i]);
+    }
+    heap_arena_use(_main_pid, NULL);
+
+    puts("\ntwo threads interleaving their allocations");
+    failed = _threads("shared arena", 0);
+    failed += _threads("private arenas", 1);
+
+    puts("");
+    heap_stats();
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
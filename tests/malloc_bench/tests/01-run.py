@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    for alloc in ("libc", "oneway", "heap"):
+        child.expect(alloc + r": \d+ ops in \d+ us \(\d+ ops/s\), \d+ failed")
+    child.expect(r"shared arena: \d+ bytes used, \d+ free blocks")
+    child.expect_exact("shared arena: 0 failed")
+    child.expect(r"private arena 1: 0 bytes used, 1 free blocks")
+    child.expect_exact("private arenas: 0 failed")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
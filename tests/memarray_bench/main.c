@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the cost of taking an element from a nearly full
+ *              pool with a memarray and with a linear scan for a free slot
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "memarray.h"
+#include "xtimer.h"
+
+#define MAX_NUM         (128U)
+#define ROUNDS          (10000U)
+
+typedef struct {
+    uint8_t data[12];
+    uint8_t used;
+} elem_t;
+
+static elem_t _elems[MAX_NUM];
+static elem_t *_taken[MAX_NUM];
+
+/* the way the converted modules used to look for a free slot */
+static elem_t *_scan_alloc(unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        if (!_elems[i].used) {
+            _elems[i].used = 1;
+            return &_elems[i];
+        }
+    }
+    return NULL;
+}
+
+static void _scan_free(elem_t *elem)
+{
+    elem->used = 0;
+}
+
+static unsigned _bench_scan(unsigned num)
+{
+    unsigned failed = 0;
+    uint32_t start;
+
+    for (unsigned i = 0; i < num; i++) {
+        _elems[i].used = 0;
+    }
+    /* fill all but one, so every allocation scans up to the last slot */
+    for (unsigned i = 0; i < num - 1; i++) {
+        _taken[i] = _scan_alloc(num);
+    }
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        elem_t *elem = _scan_alloc(num);
+
+        if ((elem == NULL) || (_scan_alloc(num) != NULL)) {
+            failed++;
+        }
+        _scan_free(elem);
+    }
+    start = xtimer_now_usec() - start;
+    printf("scan %3u: %lu ns per alloc/free\n", num,
+           (unsigned long)(((uint64_t)start * 1000) / ROUNDS));
+    return failed;
+}
+
+static unsigned _bench_memarray(unsigned num)
+{
+    memarray_t mem;
+    unsigned failed = 0;
+    uint32_t start;
+
+    memarray_init(&mem, _elems, sizeof(_elems[0]), num);
+    for (unsigned i = 0; i < num; i++) {
+        _taken[i] = memarray_alloc(&mem);
+    }
+    /* release them in random order, to leave a shuffled free list */
+    for (unsigned i = num - 1; i > 0; i--) {
+        unsigned j = (i * 2654435761U) % (i + 1);
+        elem_t *tmp = _taken[i];
+
+        _taken[i] = _taken[j];
+        _taken[j] = tmp;
+    }
+    for (unsigned i = 0; i < num; i++) {
+        memarray_free(&mem, _taken[i]);
+    }
+    for (unsigned i = 0; i < num - 1; i++) {
+        _taken[i] = memarray_alloc(&mem);
+    }
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        elem_t *elem = memarray_alloc(&mem);
+
+        if ((elem == NULL) || (memarray_alloc(&mem) != NULL)) {
+            failed++;
+        }
+        memarray_free(&mem, elem);
+    }
+    start = xtimer_now_usec() - start;
+    printf("memarray %3u: %lu ns per alloc/free, peak %u of %u\n", num,
+           (unsigned long)(((uint64_t)start * 1000) / ROUNDS), mem.peak,
+           mem.num);
+    return failed;
+}
+
+int main(void)
+{
+    unsigned failed = 0;
+
+    puts("memarray benchmark\n");
+    for (unsigned num = 8; num <= MAX_NUM; num *= 4) {
+        failed += _bench_scan(num);
+        failed += _bench_memarray(num);
+    }
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
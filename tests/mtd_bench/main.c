@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sequential and random I/O test for MTD devices and the MTD
+ *              write-back cache
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mtd_native.h"
+#include "xtimer.h"
+
+#define SECTORS         (64U)
+#define RECORD_SIZE     (32U)
+#define OPS             (2048U)
+#define CACHE_LINES     (4U)
+#define MAX_SECTOR_SIZE (4096U)
+
+/* NOR flash of 4 KiB sectors and 256 byte pages */
+static mtd_native_t _nor = {
+    .base = {
+        .driver = &mtd_native_nor_driver,
+        .sector_count = SECTORS,
+        .pages_per_sector = 16,
+        .page_size = 256,
+    },
+    .fname = "mtd_bench_nor.bin",
+};
+
+/* SD card like device of 512 byte blocks, grouped to 4 KiB sectors */
+static mtd_native_t _blk = {
+    .base = {
+        .driver = &mtd_native_driver,
+        .sector_count = SECTORS,
+        .pages_per_sector = 8,
+        .page_size = 512,
+    },
+    .fname = "mtd_bench_blk.bin",
+};
+
+static uint8_t _cache_buf[CACHE_LINES * MAX_SECTOR_SIZE];
+static mtd_cache_line_t _lines[CACHE_LINES];
+static mtd_cache_t _cache = {
+    .base = { .driver = &mtd_cache_driver },
+    .buf = _cache_buf,
+    .lines = _lines,
+};
+
+/* expected contents of the device */
+static uint8_t _shadow[SECTORS * MAX_SECTOR_SIZE];
+static uint8_t _buf[MAX_SECTOR_SIZE];
+static uint32_t _seed;
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+/* record i of the workload; sequential or random */
+static uint32_t _addr(unsigned i, int random)
+{
+    uint32_t records = mtd_size(&_cache.base) / RECORD_SIZE;
+
+    return (random ? (_rand() % records) : (i % records)) * RECORD_SIZE;
+}
+
+static int _setup(mtd_native_t *dev, unsigned lines)
+{
+    _cache.parent = &dev->base;
+    _cache.lines_numof = lines;
+    if (mtd_init(&_cache.base) < 0) {
+        return -1;
+    }
+    /* start from an erased device */
+    memset(_shadow, 0xff, sizeof(_shadow));
+    if (mtd_erase(&_cache.base, 0, mtd_size(&_cache.base)) < 0) {
+        return -1;
+    }
+    dev->reads = dev->writes = dev->erases = 0;
+    return 0;
+}
+
+/*
+ * Writes OPS records. Without write-back, i.e. with a single cache line
+ * flushed after each write, every record costs a read-modify-write of its
+ * sector, as with hand-written page caching.
+ */
+static int _bench_write(mtd_native_t *dev, const char *name, int random,
+                        int write_back)
+{
+    uint8_t record[RECORD_SIZE];
+
+    if (_setup(dev, write_back ? CACHE_LINES : 1) < 0) {
+        return -1;
+    }
+    _seed = 1;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < OPS; i++) {
+        uint32_t addr = _addr(i, random);
+
+        memset(record, i, sizeof(record));
+        memcpy(&_shadow[addr], record, sizeof(record));
+        if ((mtd_write(&_cache.base, record, addr, sizeof(record)) < 0) ||
+            (!write_back && (mtd_flush(&_cache.base) < 0))) {
+            return -1;
+        }
+    }
+    if (mtd_flush(&_cache.base) < 0) {
+        return -1;
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+
+    printf("%s %s %s: %u records in %lu us, %lu reads, %lu writes, "
+           "%lu erases\n", name, random ? "random" : "sequential",
+           write_back ? "write-back" : "write-through", OPS,
+           (unsigned long)usec, (unsigned long)dev->reads,
+           (unsigned long)dev->writes, (unsigned long)dev->erases);
+
+    /* check the device itself */
+    for (uint32_t s = 0; s < SECTORS; s++) {
+        uint32_t size = mtd_sector_size(&dev->base);
+
+        if ((mtd_read(&dev->base, _buf, s * size, size) < 0) ||
+            (memcmp(_buf, &_shadow[s * size], size) != 0)) {
+            printf("%s: sector %lu differs\n", name, (unsigned long)s);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Reads OPS random records through the cache. */
+static int _bench_read(mtd_native_t *dev, const char *name)
+{
+    uint8_t record[RECORD_SIZE];
+
+    dev->reads = 0;
+    _seed = 2;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < OPS; i++) {
+        uint32_t addr = _addr(i, 1);
+
+        if ((mtd_read(&_cache.base, record, addr, sizeof(record)) < 0) ||
+            (memcmp(record, &_shadow[addr], sizeof(record)) != 0)) {
+            printf("%s: record at %lu differs\n", name, (unsigned long)addr);
+            return -1;
+        }
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+
+    printf("%s random read: %u records in %lu us, %lu reads\n", name, OPS,
+           (unsigned long)usec, (unsigned long)dev->reads);
+    return 0;
+}
+
+static int _bench(mtd_native_t *dev, const char *name)
+{
+    for (int random = 0; random < 2; random++) {
+        for (int write_back = 0; write_back < 2; write_back++) {
+            if (_bench_write(dev, name, random, write_back) < 0) {
+                return -1;
+            }
+        }
+    }
+    return _bench_read(dev, name);
+}
+
+int main(void)
+{
+    puts("MTD I/O test\n");
+
+    if ((_bench(&_nor, "nor") == 0) && (_bench(&_blk, "blk") == 0)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+    return 0;
+}
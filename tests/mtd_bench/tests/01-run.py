@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def _bench(child, dev, order, mode):
+    child.expect(r"%s %s %s: 2048 records in \d+ us, \d+ reads, (\d+) writes, "
+                 r"(\d+) erases" % (dev, order, mode))
+    return int(child.match.group(1)), int(child.match.group(2))
+
+
+def _dev(child, dev):
+    res = {}
+    for order in ("sequential", "random"):
+        for mode in ("write-through", "write-back"):
+            res[order, mode] = _bench(child, dev, order, mode)
+    child.expect(r"%s random read: 2048 records in \d+ us, \d+ reads" % dev)
+    for order in ("sequential", "random"):
+        assert res[order, "write-back"] < res[order, "write-through"]
+    return res
+
+
+def testfunc(child):
+    nor = _dev(child, "nor")
+    # 64 KiB of sequential records fill 16 sectors, erased once each
+    assert nor["sequential", "write-back"][1] == 16
+    _dev(child, "blk")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
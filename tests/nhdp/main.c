@@ -1,5 +1,6 @@
 /*
  * Copyright (C) 2015 Cenk Gündoğan <cnkgndgn@gmail.com>
+ *               2017 Freie Universität Berlin
  *
  * This file is subject to the terms and conditions of the GNU Lesser
  * General Public License v2.1. See the file LICENSE in the top level
@@ -7,17 +8,221 @@
  */
 
 /**
+ * @ingroup     tests
+ * @{
+ *
  * @file
- * @brief       Check if the nhdp module builds.
+ * @brief       Measures the time NHDP spends per HELLO in a dense
+ *              neighborhood of growing size
  *
  * @author      Cenk Gündoğan <cnkgndgn@gmail.com>
  *
+ * @}
  */
 
 #include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "thread.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "rfc5444/rfc5444.h"
+#include "rfc5444/rfc5444_iana.h"
+#include "rfc5444/rfc5444_reader.h"
+
+#include "iib_table.h"
+#include "nhdp.h"
+#include "nhdp_reader.h"
+#include "nhdp_writer.h"
+
+#define ROUNDS          (4U)
+#define MAX_NBRS        (100U)
+#define ADDR_LEN        (16U)
+#define VALIDITY_MS     (60U * MS_PER_SEC)
+#define INTERVAL_MS     (NHDP_DEFAULT_HELLO_INT_MS)
+
+#define PKT_FLAG_SEQNO  (0x08)
+#define TLV_FLAG_VALUE  (0x10)
+#define HELLO_LEN       (64U + (MAX_NBRS * ADDR_LEN))
+
+static kernel_pid_t _pid;
+static nhdp_if_entry_t _if_entry;
+static uint8_t _pkt_buf[NHDP_MAX_RFC5444_PACKET_SZ];
+static uint8_t _hello[HELLO_LEN];
+static uint16_t _seq_no;
+static uint8_t _own[ADDR_LEN] = {
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff
+};
+/* packets and checksum of the HELLO sent last, sequence numbers excluded */
+static unsigned _pkts;
+static uint32_t _sum;
+
+static void _send(struct rfc5444_writer *wr, struct rfc5444_writer_target *iface,
+                  void *buffer, size_t length)
+{
+    uint8_t *pkt = buffer;
+
+    (void)wr;
+    (void)iface;
+    _pkts++;
+    for (size_t i = 3; i < length; i++) {
+        _sum = (_sum * 31) + pkt[i];
+    }
+}
+
+/* neighbor i has the address fe80::1:i */
+static uint8_t *_nbr_addr(uint8_t *addr, unsigned i)
+{
+    memcpy(addr, _own, ADDR_LEN);
+    addr[13] = 0x01;
+    addr[14] = i >> 8;
+    addr[15] = i & 0xff;
+    return addr + ADDR_LEN;
+}
+
+static inline uint8_t *_tlv(uint8_t *p, uint8_t type, uint8_t value)
+{
+    *p++ = type;
+    *p++ = TLV_FLAG_VALUE;
+    *p++ = 1;
+    *p++ = value;
+    return p;
+}
+
+/* builds the HELLO of neighbor nbr, which has symmetric links to us and to
+ * all other neighbors */
+static size_t _build_hello(unsigned nbr, unsigned nbrs)
+{
+    uint8_t *msg = &_hello[3];
+    uint8_t *p = &msg[4];
+    size_t msg_len;
+
+    _hello[0] = PKT_FLAG_SEQNO;
+    _hello[1] = _seq_no >> 8;
+    _hello[2] = _seq_no & 0xff;
+    _seq_no++;
+
+    /* message header without optional fields and 16 byte addresses */
+    msg[0] = RFC5444_MSGTYPE_HELLO;
+    msg[1] = ADDR_LEN - 1;
+
+    /* message TLV block */
+    *p++ = 0;
+    *p++ = 8;
+    p = _tlv(p, RFC5444_MSGTLV_VALIDITY_TIME, rfc5444_timetlv_encode(VALIDITY_MS));
+    p = _tlv(p, RFC5444_MSGTLV_INTERVAL_TIME, rfc5444_timetlv_encode(INTERVAL_MS));
+
+    /* address block of the sending interface */
+    *p++ = 1;
+    *p++ = 0;
+    p = _nbr_addr(p, nbr);
+    *p++ = 0;
+    *p++ = 4;
+    p = _tlv(p, RFC5444_ADDRTLV_LOCAL_IF, RFC5444_LOCALIF_THIS_IF);
+
+    /* address block of the symmetric neighbors */
+    *p++ = nbrs;
+    *p++ = 0;
+    memcpy(p, _own, ADDR_LEN);
+    p += ADDR_LEN;
+    for (unsigned i = 0; i < nbrs; i++) {
+        if (i != nbr) {
+            p = _nbr_addr(p, i);
+        }
+    }
+    *p++ = 0;
+    *p++ = 4;
+    p = _tlv(p, RFC5444_ADDRTLV_LINK_STATUS, RFC5444_LINKSTATUS_SYMMETRIC);
+
+    msg_len = p - msg;
+    msg[2] = msg_len >> 8;
+    msg[3] = msg_len & 0xff;
+    return p - _hello;
+}
+
+static unsigned _receive_round(unsigned nbrs)
+{
+    unsigned failed = 0;
+
+    for (unsigned i = 0; i < nbrs; i++) {
+        size_t len = _build_hello(i, nbrs);
+
+        failed += (nhdp_reader_handle_packet(_pid, _hello, len) != RFC5444_OKAY);
+    }
+    return failed;
+}
+
+static unsigned _run(unsigned nbrs)
+{
+    uint32_t start, t_rx, t_built = 0, t_resent = 0;
+    unsigned built_pkts = 0;
+    unsigned failed;
+
+    /* the first round fills the information bases */
+    failed = _receive_round(nbrs);
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        failed += _receive_round(nbrs);
+    }
+    t_rx = xtimer_now_usec() - start;
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        uint32_t built_sum;
+
+        nhdp_writer_mark_dirty();
+        _pkts = 0;
+        _sum = 0;
+        start = xtimer_now_usec();
+        nhdp_writer_send_hello(&_if_entry);
+        t_built += xtimer_now_usec() - start;
+        built_pkts = _pkts;
+        built_sum = _sum;
+
+        /* nothing changed, so the same HELLO is sent again */
+        _pkts = 0;
+        _sum = 0;
+        start = xtimer_now_usec();
+        nhdp_writer_send_hello(&_if_entry);
+        t_resent += xtimer_now_usec() - start;
+        failed += (built_pkts == 0) || (_pkts != built_pkts) || (_sum != built_sum);
+    }
+
+    printf("%u neighbors: %lu us per received HELLO, %lu us per built HELLO, "
+           "%lu us per resent HELLO (%u packets), %u failed\n", nbrs,
+           (unsigned long)(t_rx / (ROUNDS * nbrs)),
+           (unsigned long)(t_built / ROUNDS), (unsigned long)(t_resent / ROUNDS),
+           built_pkts, failed);
+    return failed;
+}
 
 int main(void)
 {
-    puts("NHDP compiled!");
+    static const unsigned nbrs[] = { 10, 25, 50, MAX_NBRS };
+    unsigned failed = 0;
+
+    puts("NHDP benchmark\n");
+    _pid = thread_getpid();
+    nhdp_init();
+    if ((nhdp_add_address(_pid, _own, ADDR_LEN, AF_INET6) != 0) ||
+        (iib_register_if(_pid) != 0)) {
+        puts("Could not configure NHDP");
+        return 1;
+    }
+    _if_entry.if_pid = _pid;
+    _if_entry.hello_interval = timex_from_uint64(INTERVAL_MS * US_PER_MS);
+    _if_entry.validity_time = timex_from_uint64(VALIDITY_MS * US_PER_MS);
+    _if_entry.wr_target.packet_buffer = _pkt_buf;
+    _if_entry.wr_target.packet_size = sizeof(_pkt_buf);
+    _if_entry.wr_target.sendPacket = _send;
+    nhdp_writer_register_if(&_if_entry.wr_target);
+
+    for (unsigned n = 0; n < sizeof(nbrs) / sizeof(nbrs[0]); n++) {
+        failed += _run(nbrs[n]);
+    }
+
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
     return 0;
 }
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    for nbrs in (10, 25, 50, 100):
+        child.expect(r"{} neighbors: \d+ us per received HELLO, "
+                     r"\d+ us per built HELLO, \d+ us per resent HELLO "
+                     r"\(\d+ packets\), 0 failed".format(nbrs))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
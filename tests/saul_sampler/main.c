@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares reading SAUL devices one by one with the batch reads
+ *              of the saul_sampler module, and runs a sampler periodically
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "saul_sampler.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SENSORS         (20U)
+#define FIFO_DEPTH      (4U)
+#define DEVS            (SENSORS + 1)
+#define ROUNDS          (1000U)
+#define RING_SIZE       (64U)
+#define PERIOD          (10U * US_PER_MS)
+#define DURATION        (US_PER_SEC)
+#define STOP_MSG_TYPE   (0xcafe)
+
+static const char *_names[DEVS] = {
+    "sensor0", "sensor1", "sensor2", "sensor3", "sensor4", "sensor5",
+    "sensor6", "sensor7", "sensor8", "sensor9", "sensor10", "sensor11",
+    "sensor12", "sensor13", "sensor14", "sensor15", "sensor16", "sensor17",
+    "sensor18", "sensor19", "fifo",
+};
+
+static int16_t _counters[DEVS];
+static saul_reg_t _regs[DEVS];
+static saul_reg_t *_devs[DEVS];
+static saul_sample_t _ring[RING_SIZE];
+static saul_sample_t _out[RING_SIZE];
+static msg_t _queue[8];
+
+static int _read(void *dev, phydat_t *res)
+{
+    int16_t *counter = dev;
+
+    res->val[0] = (*counter)++;
+    res->val[1] = 0;
+    res->val[2] = 0;
+    res->unit = UNIT_TEMP_C;
+    res->scale = -2;
+    return 1;
+}
+
+/* the FIFO device always has FIFO_DEPTH readings of 3 values buffered */
+static int _read_multi(void *dev, phydat_t *res, unsigned max, uint8_t *dim)
+{
+    int16_t *counter = dev;
+    unsigned n = (max < FIFO_DEPTH) ? max : FIFO_DEPTH;
+
+    for (unsigned i = 0; i < n; i++) {
+        res[i].val[0] = (*counter)++;
+        res[i].val[1] = 1;
+        res[i].val[2] = 2;
+        res[i].unit = UNIT_G;
+        res[i].scale = -3;
+    }
+    *dim = 3;
+    return n;
+}
+
+static int _read_fifo(void *dev, phydat_t *res)
+{
+    uint8_t dim;
+
+    return (_read_multi(dev, res, 1, &dim) == 1) ? dim : -ECANCELED;
+}
+
+static const saul_driver_t _sensor_driver = {
+    .read = _read,
+    .write = saul_notsup,
+    .type = SAUL_SENSE_TEMP,
+};
+
+static const saul_driver_t _fifo_driver = {
+    .read = _read_fifo,
+    .write = saul_notsup,
+    .type = SAUL_SENSE_ACCEL,
+    .read_multi = _read_multi,
+};
+
+static void _register(void)
+{
+    for (unsigned i = 0; i < DEVS; i++) {
+        _regs[i].dev = &_counters[i];
+        _regs[i].name = _names[i];
+        _regs[i].driver = (i < SENSORS) ? &_sensor_driver : &_fifo_driver;
+        saul_reg_add(&_regs[i]);
+    }
+}
+
+static unsigned long _rate(unsigned samples, uint32_t usec)
+{
+    return (unsigned long)(((uint64_t)samples * US_PER_SEC) /
+                           ((usec > 0) ? usec : 1));
+}
+
+static int _bench_naive(void)
+{
+    unsigned samples = 0;
+    uint32_t start;
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < DEVS; i++) {
+            saul_reg_t *dev = saul_reg_find_name(_names[i]);
+            saul_sample_t *sample = &_out[i];
+            int dim = saul_reg_read(dev, &sample->data);
+
+            if (dim <= 0) {
+                puts("naive: read failed");
+                return -1;
+            }
+            sample->time = xtimer_now_usec();
+            sample->dev = i;
+            sample->dim = dim;
+            samples++;
+        }
+    }
+    start = xtimer_now_usec() - start;
+    printf("naive: %u samples in %lu us (%lu samples/s)\n", samples,
+           (unsigned long)start, _rate(samples, start));
+    return 0;
+}
+
+static int _bench_batch(void)
+{
+    saul_sampler_t sampler;
+    unsigned samples = 0;
+    uint32_t start;
+
+    saul_sampler_init(&sampler, _devs, DEVS, _ring, RING_SIZE);
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        saul_sampler_read(&sampler);
+        samples += saul_sampler_get(&sampler, _out, RING_SIZE);
+    }
+    start = xtimer_now_usec() - start;
+    printf("batch: %u samples in %lu us (%lu samples/s)\n", samples,
+           (unsigned long)start, _rate(samples, start));
+    if ((samples != ROUNDS * (SENSORS + FIFO_DEPTH)) || sampler.lost ||
+        sampler.errors) {
+        puts("batch: samples missing");
+        return -1;
+    }
+    /* the last batch: one reading per sensor, then the FIFO contents */
+    for (unsigned i = 0; i < SENSORS + FIFO_DEPTH; i++) {
+        unsigned dev = (i < SENSORS) ? i : SENSORS;
+
+        if ((_out[i].dev != dev) || (_out[i].time != _out[0].time) ||
+            (_out[i].dim != ((dev < SENSORS) ? 1 : 3))) {
+            printf("batch: sample %u differs\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _scheduled(void)
+{
+    saul_sampler_t sampler;
+    saul_sched_t sched;
+    xtimer_t stop;
+    msg_t msg, stop_msg = { .type = STOP_MSG_TYPE };
+    unsigned batches = 0, samples = 0;
+
+    saul_sampler_init(&sampler, _devs, DEVS, _ring, RING_SIZE);
+    saul_sched_init(&sched, thread_getpid());
+    saul_sched_add(&sched, &sampler, PERIOD);
+    /* stop half a period after the last reading */
+    xtimer_set_msg(&stop, DURATION + (PERIOD / 2), &stop_msg, thread_getpid());
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == STOP_MSG_TYPE) {
+            break;
+        }
+        if (saul_sched_handle(&sched, &msg) > 0) {
+            batches++;
+            samples += saul_sampler_get(&sampler, _out, RING_SIZE);
+        }
+    }
+    saul_sched_remove(&sched, &sampler);
+    printf("scheduled: %u batches, %u samples, %lu lost, %lu errors\n",
+           batches, samples, (unsigned long)sampler.lost,
+           (unsigned long)sampler.errors);
+    if ((batches < (DURATION / PERIOD) - 2) || (batches > DURATION / PERIOD) ||
+        (samples != batches * (SENSORS + FIFO_DEPTH)) || sampler.lost ||
+        sampler.errors) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    msg_init_queue(_queue, sizeof(_queue) / sizeof(_queue[0]));
+    puts("saul_sampler test\n");
+    _register();
+    for (unsigned i = 0; i < DEVS; i++) {
+        _devs[i] = saul_reg_find_name(_names[i]);
+    }
+    printf("%u devices, %u rounds each\n", DEVS, ROUNDS);
+    res |= _bench_naive();
+    res |= _bench_batch();
+    res |= _scheduled();
+    puts((res == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    for mode in ("naive", "batch"):
+        child.expect(mode + r": \d+ samples in \d+ us \(\d+ samples/s\)")
+    child.expect(r"scheduled: \d+ batches, \d+ samples, 0 lost, 0 errors")
+    child.expect_exact("[SUCCESS]", timeout=10)
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
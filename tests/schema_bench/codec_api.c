@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Telemetry codecs written by hand with the cbor and ubjson
+ *              modules
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "cbor.h"
+#include "kernel_defines.h"
+#include "ubjson.h"
+
+#include "telemetry.h"
+
+#define FIELDS          (11U)
+#define KEY_MAX         (16U)
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    uint8_t *buf;
+    size_t len;
+    size_t pos;
+    telemetry_t *t;
+    char key[KEY_MAX];
+} ubjson_state_t;
+
+size_t telemetry_api_cbor_encode(const telemetry_t *t, uint8_t *buf, size_t len)
+{
+    cbor_stream_t s;
+
+    cbor_init(&s, buf, len);
+    cbor_serialize_map(&s, FIELDS);
+    cbor_serialize_unicode_string(&s, "time");
+    cbor_serialize_uint64_t(&s, t->time);
+    cbor_serialize_unicode_string(&s, "pressure");
+    cbor_serialize_int(&s, t->pressure);
+    cbor_serialize_unicode_string(&s, "temp");
+    cbor_serialize_int(&s, t->temp);
+    cbor_serialize_unicode_string(&s, "humidity");
+    cbor_serialize_int(&s, t->humidity);
+    cbor_serialize_unicode_string(&s, "accel_x");
+    cbor_serialize_int(&s, t->accel_x);
+    cbor_serialize_unicode_string(&s, "accel_y");
+    cbor_serialize_int(&s, t->accel_y);
+    cbor_serialize_unicode_string(&s, "accel_z");
+    cbor_serialize_int(&s, t->accel_z);
+    cbor_serialize_unicode_string(&s, "battery");
+    cbor_serialize_int(&s, t->battery);
+    cbor_serialize_unicode_string(&s, "moving");
+    cbor_serialize_bool(&s, t->moving);
+    cbor_serialize_unicode_string(&s, "rssi");
+    cbor_serialize_float(&s, t->rssi);
+    cbor_serialize_unicode_string(&s, "id");
+    if (cbor_serialize_byte_stringl(&s, (const char *)t->id, sizeof(t->id)) == 0) {
+        return 0;
+    }
+    return s.pos;
+}
+
+int telemetry_api_cbor_decode(telemetry_t *t, const uint8_t *buf, size_t len)
+{
+    cbor_stream_t s = { (unsigned char *)buf, len, len };
+    size_t offset, read, count;
+
+    offset = cbor_deserialize_map(&s, 0, &count);
+    if (offset == 0) {
+        return -EBADMSG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        char key[KEY_MAX];
+        int val;
+
+        /* accepts strings of up to length + 1 bytes, plus the terminator */
+        read = cbor_deserialize_unicode_string(&s, offset, key, sizeof(key) - 2);
+        if (read == 0) {
+            return -EBADMSG;
+        }
+        offset += read;
+        if (strcmp(key, "time") == 0) {
+            uint64_t time;
+            read = cbor_deserialize_uint64_t(&s, offset, &time);
+            t->time = time;
+        }
+        else if (strcmp(key, "moving") == 0) {
+            read = cbor_deserialize_bool(&s, offset, &t->moving);
+        }
+        else if (strcmp(key, "rssi") == 0) {
+            read = cbor_deserialize_float(&s, offset, &t->rssi);
+        }
+        else if (strcmp(key, "id") == 0) {
+            unsigned char *id;
+            size_t id_len;
+            read = cbor_deserialize_byte_string_no_copy(&s, offset, &id, &id_len);
+            if (id_len != sizeof(t->id)) {
+                return -EBADMSG;
+            }
+            memcpy(t->id, id, sizeof(t->id));
+        }
+        else {
+            read = cbor_deserialize_int(&s, offset, &val);
+            if (strcmp(key, "pressure") == 0) {
+                t->pressure = val;
+            }
+            else if (strcmp(key, "temp") == 0) {
+                t->temp = val;
+            }
+            else if (strcmp(key, "humidity") == 0) {
+                t->humidity = val;
+            }
+            else if (strcmp(key, "accel_x") == 0) {
+                t->accel_x = val;
+            }
+            else if (strcmp(key, "accel_y") == 0) {
+                t->accel_y = val;
+            }
+            else if (strcmp(key, "accel_z") == 0) {
+                t->accel_z = val;
+            }
+            else if (strcmp(key, "battery") == 0) {
+                t->battery = val;
+            }
+            else {
+                return -EBADMSG;
+            }
+        }
+        if (read == 0) {
+            return -EBADMSG;
+        }
+        offset += read;
+    }
+    return offset;
+}
+
+static ssize_t _write(ubjson_cookie_t *__restrict cookie, const void *buf,
+                      size_t len)
+{
+    ubjson_state_t *state = container_of(cookie, ubjson_state_t, cookie);
+
+    if (state->pos + len > state->len) {
+        return -1;
+    }
+    memcpy(state->buf + state->pos, buf, len);
+    state->pos += len;
+    return len;
+}
+
+static void _write_key(ubjson_cookie_t *cookie, const char *key)
+{
+    ubjson_write_key(cookie, key, strlen(key));
+}
+
+size_t telemetry_api_ubjson_encode(const telemetry_t *t, uint8_t *buf, size_t len)
+{
+    ubjson_state_t state = { .buf = buf, .len = len };
+    ubjson_cookie_t *c = &state.cookie;
+
+    ubjson_write_init(c, _write);
+    ubjson_open_object_len(c, FIELDS);
+    _write_key(c, "time");
+    ubjson_write_i64(c, t->time);
+    _write_key(c, "pressure");
+    ubjson_write_i32(c, t->pressure);
+    _write_key(c, "temp");
+    ubjson_write_i32(c, t->temp);
+    _write_key(c, "humidity");
+    ubjson_write_i32(c, t->humidity);
+    _write_key(c, "accel_x");
+    ubjson_write_i32(c, t->accel_x);
+    _write_key(c, "accel_y");
+    ubjson_write_i32(c, t->accel_y);
+    _write_key(c, "accel_z");
+    ubjson_write_i32(c, t->accel_z);
+    _write_key(c, "battery");
+    ubjson_write_i32(c, t->battery);
+    _write_key(c, "moving");
+    ubjson_write_bool(c, t->moving);
+    _write_key(c, "rssi");
+    ubjson_write_float(c, t->rssi);
+    _write_key(c, "id");
+    ubjson_open_array_len(c, sizeof(t->id));
+    for (unsigned i = 0; i < sizeof(t->id); i++) {
+        if (ubjson_write_i32(c, t->id[i]) < 0) {
+            return 0;
+        }
+    }
+    return state.pos;
+}
+
+static ssize_t _read(ubjson_cookie_t *__restrict cookie, void *buf,
+                     size_t max_len)
+{
+    ubjson_state_t *state = container_of(cookie, ubjson_state_t, cookie);
+
+    if (state->pos + max_len > state->len) {
+        max_len = state->len - state->pos;
+    }
+    if (max_len == 0) {
+        return -1;
+    }
+    memcpy(buf, state->buf + state->pos, max_len);
+    state->pos += max_len;
+    return max_len;
+}
+
+static ubjson_read_callback_result_t _get_int(ubjson_cookie_t *cookie,
+                                              ubjson_type_t type, ssize_t content,
+                                              int64_t *val)
+{
+    if (type == UBJSON_TYPE_INT32) {
+        int32_t val32;
+        if (ubjson_get_i32(cookie, content, &val32) <= 0) {
+            return UBJSON_PREMATURELY_ENDED;
+        }
+        *val = val32;
+    }
+    else if (type == UBJSON_TYPE_INT64) {
+        if (ubjson_get_i64(cookie, content, val) <= 0) {
+            return UBJSON_PREMATURELY_ENDED;
+        }
+    }
+    else {
+        return UBJSON_INVALID_DATA;
+    }
+    return UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t _read_value(ubjson_state_t *state,
+                                                 ubjson_type_t type,
+                                                 ssize_t content)
+{
+    ubjson_cookie_t *c = &state->cookie;
+    telemetry_t *t = state->t;
+    int64_t val;
+
+    if (strcmp(state->key, "moving") == 0) {
+        return (type == UBJSON_TYPE_BOOL) && (ubjson_get_bool(c, content, &t->moving) > 0) ?
+               UBJSON_OKAY : UBJSON_INVALID_DATA;
+    }
+    if (strcmp(state->key, "rssi") == 0) {
+        return (type == UBJSON_TYPE_FLOAT) && (ubjson_get_float(c, content, &t->rssi) > 0) ?
+               UBJSON_OKAY : UBJSON_INVALID_DATA;
+    }
+    if (strcmp(state->key, "id") == 0) {
+        return (type == UBJSON_ENTER_ARRAY) ? ubjson_read_array(c) : UBJSON_INVALID_DATA;
+    }
+    if (_get_int(c, type, content, &val) != UBJSON_OKAY) {
+        return UBJSON_INVALID_DATA;
+    }
+    if (strcmp(state->key, "time") == 0) {
+        t->time = val;
+    }
+    else if (strcmp(state->key, "pressure") == 0) {
+        t->pressure = val;
+    }
+    else if (strcmp(state->key, "temp") == 0) {
+        t->temp = val;
+    }
+    else if (strcmp(state->key, "humidity") == 0) {
+        t->humidity = val;
+    }
+    else if (strcmp(state->key, "accel_x") == 0) {
+        t->accel_x = val;
+    }
+    else if (strcmp(state->key, "accel_y") == 0) {
+        t->accel_y = val;
+    }
+    else if (strcmp(state->key, "accel_z") == 0) {
+        t->accel_z = val;
+    }
+    else if (strcmp(state->key, "battery") == 0) {
+        t->battery = val;
+    }
+    else {
+        return UBJSON_INVALID_DATA;
+    }
+    return UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t _callback(ubjson_cookie_t *__restrict cookie,
+                                               ubjson_type_t type1, ssize_t content1,
+                                               ubjson_type_t type2, ssize_t content2)
+{
+    ubjson_state_t *state = container_of(cookie, ubjson_state_t, cookie);
+    ubjson_read_callback_result_t res;
+    int64_t val;
+
+    (void)type2;
+    switch (type1) {
+        case UBJSON_ENTER_OBJECT:
+            return ubjson_read_object(cookie);
+        case UBJSON_KEY:
+            if ((content1 >= (ssize_t)sizeof(state->key)) ||
+                (ubjson_get_string(cookie, content1, state->key) != content1)) {
+                return UBJSON_INVALID_DATA;
+            }
+            state->key[content1] = '\0';
+            res = ubjson_peek_value(cookie, &type2, &content2);
+            if (res != UBJSON_OKAY) {
+                return res;
+            }
+            return _read_value(state, type2, content2);
+        case UBJSON_INDEX:
+            /* elements of id */
+            if ((content1 >= (ssize_t)sizeof(state->t->id)) ||
+                (ubjson_peek_value(cookie, &type2, &content2) != UBJSON_OKAY) ||
+                (_get_int(cookie, type2, content2, &val) != UBJSON_OKAY)) {
+                return UBJSON_INVALID_DATA;
+            }
+            state->t->id[content1] = val;
+            return UBJSON_OKAY;
+        default:
+            return UBJSON_INVALID_DATA;
+    }
+}
+
+int telemetry_api_ubjson_decode(telemetry_t *t, const uint8_t *buf, size_t len)
+{
+    ubjson_state_t state = { .buf = (uint8_t *)buf, .len = len, .t = t };
+
+    if (ubjson_read(&state.cookie, _read, _callback) != UBJSON_OKAY) {
+        return -EBADMSG;
+    }
+    return state.pos;
+}
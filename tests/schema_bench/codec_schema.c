@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Telemetry codecs generated from the schema
+ *
+ * @}
+ */
+
+#include "telemetry.h"
+
+SCHEMA_DEFINE(telemetry, telemetry_t, TELEMETRY_FIELDS)
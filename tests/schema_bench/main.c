@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares codecs generated from a schema with hand-written
+ *              use of the cbor and ubjson modules
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "xtimer.h"
+
+#include "telemetry.h"
+
+#define RECORDS         (16U)
+#define ROUNDS          (1000U)
+
+typedef struct {
+    const char *name;
+    size_t (*encode)(const telemetry_t *t, uint8_t *buf, size_t len);
+    int (*decode)(telemetry_t *t, const uint8_t *buf, size_t len);
+    /* hand-written decoder of the same format, must read this encoding */
+    int (*check)(telemetry_t *t, const uint8_t *buf, size_t len);
+} codec_t;
+
+static const codec_t _codecs[] = {
+    { "cbor api", telemetry_api_cbor_encode, telemetry_api_cbor_decode,
+      telemetry_api_cbor_decode },
+    { "cbor schema", telemetry_cbor_encode, telemetry_cbor_decode,
+      telemetry_api_cbor_decode },
+    { "ubjson api", telemetry_api_ubjson_encode, telemetry_api_ubjson_decode,
+      telemetry_api_ubjson_decode },
+    { "ubjson schema", telemetry_ubjson_encode, telemetry_ubjson_decode,
+      telemetry_api_ubjson_decode },
+};
+
+static telemetry_t _records[RECORDS];
+static uint8_t _bufs[RECORDS][TELEMETRY_BUF_SIZE];
+static size_t _lens[RECORDS];
+
+static void _gen(void)
+{
+    uint32_t seed = 1;
+
+    for (unsigned i = 0; i < RECORDS; i++) {
+        telemetry_t *t = &_records[i];
+
+        seed = (seed * 1103515245U) + 12345U;
+        t->time = 86400UL * 30 + (i * 60);
+        t->pressure = 95000L + (seed % 10000);
+        t->temp = (int16_t)((seed >> 8) % 6000) - 2000;
+        t->humidity = (seed >> 4) % 1001;
+        t->accel_x = (int16_t)(seed >> 16) % 2000;
+        t->accel_y = -(int16_t)((seed >> 12) % 2000);
+        t->accel_z = 1000 + (seed % 7);
+        t->battery = 100 - i;
+        t->moving = (seed >> 20) & 1;
+        t->rssi = -50.5f - i;
+        for (unsigned j = 0; j < sizeof(t->id); j++) {
+            t->id[j] = (uint8_t)(seed >> j);
+        }
+    }
+}
+
+static int _equal(const telemetry_t *a, const telemetry_t *b)
+{
+    return (a->time == b->time) && (a->pressure == b->pressure) &&
+           (a->temp == b->temp) && (a->humidity == b->humidity) &&
+           (a->accel_x == b->accel_x) && (a->accel_y == b->accel_y) &&
+           (a->accel_z == b->accel_z) && (a->battery == b->battery) &&
+           (a->moving == b->moving) && (a->rssi == b->rssi) &&
+           (memcmp(a->id, b->id, sizeof(a->id)) == 0);
+}
+
+static unsigned long _rate(size_t bytes, uint32_t usec)
+{
+    return (unsigned long)(((uint64_t)bytes * ROUNDS * 1000000) /
+                           ((usec > 0) ? usec : 1));
+}
+
+static int _bench(const codec_t *codec)
+{
+    telemetry_t t;
+    uint32_t start, enc, dec;
+    size_t bytes = 0;
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        unsigned i = r % RECORDS;
+        _lens[i] = codec->encode(&_records[i], _bufs[i], sizeof(_bufs[i]));
+    }
+    enc = xtimer_now_usec() - start;
+
+    for (unsigned i = 0; i < RECORDS; i++) {
+        memset(&t, 0, sizeof(t));
+        if ((_lens[i] == 0) ||
+            (codec->check(&t, _bufs[i], _lens[i]) != (int)_lens[i]) ||
+            !_equal(&t, &_records[i])) {
+            printf("%s: record %u differs\n", codec->name, i);
+            return -1;
+        }
+        bytes += _lens[i];
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        unsigned i = r % RECORDS;
+        if (codec->decode(&t, _bufs[i], _lens[i]) < 0) {
+            printf("%s: decoding failed\n", codec->name);
+            return -1;
+        }
+    }
+    dec = xtimer_now_usec() - start;
+    if (!_equal(&t, &_records[(ROUNDS - 1) % RECORDS])) {
+        printf("%s: decoded record differs\n", codec->name);
+        return -1;
+    }
+
+    bytes /= RECORDS;
+    printf("%s: %u bytes, encode %lu us (%lu B/s), decode %lu us (%lu B/s)\n",
+           codec->name, (unsigned)bytes, (unsigned long)enc, _rate(bytes, enc),
+           (unsigned long)dec, _rate(bytes, dec));
+    return 0;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("schema benchmark\n");
+    printf("%u records each\n", ROUNDS);
+    _gen();
+    for (unsigned i = 0; i < sizeof(_codecs) / sizeof(_codecs[0]); i++) {
+        res |= _bench(&_codecs[i]);
+    }
+    puts((res == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
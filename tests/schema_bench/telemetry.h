@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Telemetry record and its codecs
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "schema.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Telemetry record of a sensor node
+ */
+typedef struct {
+    uint32_t time;              /**< seconds since boot */
+    int32_t pressure;           /**< air pressure in Pa */
+    int16_t temp;               /**< temperature in centi degree Celsius */
+    uint16_t humidity;          /**< relative humidity in per mille */
+    int16_t accel_x;            /**< acceleration in mg */
+    int16_t accel_y;            /**< acceleration in mg */
+    int16_t accel_z;            /**< acceleration in mg */
+    uint8_t battery;            /**< battery level in percent */
+    bool moving;                /**< node is moving */
+    float rssi;                 /**< signal strength of the last packet */
+    uint8_t id[8];              /**< EUI-64 of the node */
+} telemetry_t;
+
+/**
+ * @brief   Schema of @ref telemetry_t
+ */
+#define TELEMETRY_FIELDS(FIELD)             \
+    FIELD(time, SCHEMA_U32)                 \
+    FIELD(pressure, SCHEMA_I32)             \
+    FIELD(temp, SCHEMA_I16)                 \
+    FIELD(humidity, SCHEMA_U16)             \
+    FIELD(accel_x, SCHEMA_I16)              \
+    FIELD(accel_y, SCHEMA_I16)              \
+    FIELD(accel_z, SCHEMA_I16)              \
+    FIELD(battery, SCHEMA_U8)               \
+    FIELD(moving, SCHEMA_BOOL)              \
+    FIELD(rssi, SCHEMA_FLOAT)               \
+    FIELD(id, SCHEMA_BYTES(8))
+
+/**
+ * @brief   Buffer size for any of the encodings
+ */
+#define TELEMETRY_BUF_SIZE      (160U)
+
+/**
+ * @brief   Codecs generated from the schema, in codec_schema.c
+ */
+SCHEMA_DECLARE(telemetry, telemetry_t);
+
+/**
+ * @brief   Codecs written by hand with the cbor and ubjson modules, in
+ *          codec_api.c
+ *
+ * The encoders return the number of bytes written, or 0 on error. The
+ * decoders return the number of bytes read, or -EBADMSG.
+ * @{
+ */
+size_t telemetry_api_cbor_encode(const telemetry_t *t, uint8_t *buf, size_t len);
+int telemetry_api_cbor_decode(telemetry_t *t, const uint8_t *buf, size_t len);
+size_t telemetry_api_ubjson_encode(const telemetry_t *t, uint8_t *buf, size_t len);
+int telemetry_api_ubjson_decode(telemetry_t *t, const uint8_t *buf, size_t len);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H */
+/** @} */
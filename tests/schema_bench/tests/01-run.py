@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    for codec in ("cbor api", "cbor schema", "ubjson api", "ubjson schema"):
+        child.expect(codec + r": \d+ bytes, encode \d+ us \(\d+ B/s\), "
+                     r"decode \d+ us \(\d+ B/s\)")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
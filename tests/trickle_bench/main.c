@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the timer load of many trickle instances with one
+ *              timer each and multiplexed onto a single timer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "trickle.h"
+#include "xtimer.h"
+
+#define INSTANCES       (64U)
+#define IMIN            (64U)   /* in ms */
+#define IMAX            (4U)    /* doublings, 1024 ms */
+#define K               (0U)    /* always transmit */
+#define DURATION        (10U)   /* in s */
+
+#define MSG_INTERVAL    (0x0001)
+#define MSG_CALLBACK    (0x0002)
+#define MSG_MUX         (0x0003)
+#define MSG_QUEUE_SIZE  (2 * INSTANCES)
+
+typedef struct {
+    const char *name;
+    uint32_t wakeups;
+    uint32_t timer_ops;
+    uint32_t transmissions;
+} result_t;
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static unsigned _calls[INSTANCES];
+static trickle_t _classic[INSTANCES];
+static trickle_mux_t _mux;
+static trickle_mux_inst_t _insts[INSTANCES];
+static trickle_mux_inst_t *_heap[INSTANCES];
+
+static void _transmit(void *args)
+{
+    (*(unsigned *)args)++;
+}
+
+static unsigned _silent(void)
+{
+    unsigned silent = 0;
+
+    for (unsigned i = 0; i < INSTANCES; i++) {
+        silent += (_calls[i] == 0);
+    }
+    return silent;
+}
+
+/* receives messages until the run is over */
+static int _receive(msg_t *msg, uint32_t end)
+{
+    int32_t left = end - xtimer_now_usec();
+
+    if (left <= 0) {
+        return -1;
+    }
+    return xtimer_msg_receive_timeout(msg, left);
+}
+
+static void _run_classic(result_t *res)
+{
+    uint32_t end = xtimer_now_usec() + (DURATION * US_PER_SEC);
+    msg_t msg;
+
+    for (unsigned i = 0; i < INSTANCES; i++) {
+        _classic[i].callback.func = _transmit;
+        _classic[i].callback.args = &_calls[i];
+        trickle_start(thread_getpid(), &_classic[i], MSG_INTERVAL, MSG_CALLBACK,
+                      IMIN, IMAX, K);
+        res->timer_ops += 2;
+    }
+    while (_receive(&msg, end) >= 0) {
+        switch (msg.type) {
+            case MSG_INTERVAL:
+                res->wakeups++;
+                res->timer_ops += 2;
+                trickle_interval(msg.content.ptr);
+                break;
+            case MSG_CALLBACK:
+                res->wakeups++;
+                res->transmissions++;
+                trickle_callback(msg.content.ptr);
+                break;
+            default:
+                break;
+        }
+    }
+    for (unsigned i = 0; i < INSTANCES; i++) {
+        trickle_stop(&_classic[i]);
+        res->timer_ops += 2;
+    }
+}
+
+static void _run_mux(result_t *res)
+{
+    uint32_t end = xtimer_now_usec() + (DURATION * US_PER_SEC);
+    msg_t msg;
+
+    trickle_mux_init(&_mux, _heap, INSTANCES, thread_getpid(), MSG_MUX);
+    for (unsigned i = 0; i < INSTANCES; i++) {
+        _insts[i].callback.func = _transmit;
+        _insts[i].callback.args = &_calls[i];
+        trickle_mux_start(&_mux, &_insts[i], IMIN, IMAX, K);
+    }
+    while (_receive(&msg, end) >= 0) {
+        /* messages of the classic run may still be queued */
+        if (msg.type == MSG_MUX) {
+            trickle_mux_handle(&_mux);
+        }
+    }
+    for (unsigned i = 0; i < INSTANCES; i++) {
+        trickle_mux_stop(&_mux, &_insts[i]);
+    }
+    res->wakeups = _mux.wakeups;
+    res->timer_ops = _mux.timer_ops;
+    res->transmissions = _mux.callbacks;
+}
+
+static unsigned _report(result_t *res)
+{
+    unsigned silent = _silent();
+
+    printf("%s: %lu wakeups/min, %lu timer operations/min, "
+           "%lu transmissions/min, %u silent instances\n", res->name,
+           (unsigned long)(res->wakeups * (60U / DURATION)),
+           (unsigned long)(res->timer_ops * (60U / DURATION)),
+           (unsigned long)(res->transmissions * (60U / DURATION)), silent);
+    return silent;
+}
+
+int main(void)
+{
+    result_t classic = { .name = "classic" };
+    result_t mux = { .name = "multiplexed" };
+    unsigned failed = 0;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    puts("Trickle benchmark\n");
+    printf("%u instances for %u s each\n", INSTANCES, DURATION);
+
+    memset(_calls, 0, sizeof(_calls));
+    _run_classic(&classic);
+    failed += _report(&classic);
+    memset(_calls, 0, sizeof(_calls));
+    _run_mux(&mux);
+    failed += _report(&mux);
+
+    puts(((failed == 0) && (mux.wakeups < classic.wakeups)) ?
+         "[SUCCESS]" : "[FAILED]");
+    return 0;
+}
@@ -6,6 +6,7 @@
  * General Public License v2.1. See the file LICENSE in the top level
  * directory for more details.
  */
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -22,6 +23,7 @@
 #define TESTS_BLOOM_PROB_IN_FILTER (4)
 #define TESTS_BLOOM_NOT_IN_FILTER (996)
 #define TESTS_BLOOM_FALSE_POS_RATE_THR (0.005)
+#define TESTS_BLOOM_BLOCKED_PROB_IN_FILTER (8)
 
 static bloom_t bloom;
 BITFIELD(bf, TESTS_BLOOM_BITS);
@@ -85,11 +87,114 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static void test_bloom_blocked_based_on_dictionary_fixture(void)
+{
+    uint32_t blocks[BLOOM_BLOCKS(TESTS_BLOOM_BITS)];
+    bloom_blocked_t blocked;
+    int in = 0;
+
+    bloom_blocked_init(&blocked, blocks, BLOOM_BLOCKS(TESTS_BLOOM_BITS),
+                       TESTS_BLOOM_HASHF);
+    for (int i = 0; i < lenB; i++) {
+        bloom_blocked_add(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_blocked_check(&blocked, (const uint8_t *) B[i],
+                                        strlen(B[i])));
+    }
+    for (int i = 0; i < lenA; i++) {
+        if (bloom_blocked_check(&blocked, (const uint8_t *) A[i],
+                                strlen(A[i]))) {
+            in++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_BLOCKED_PROB_IN_FILTER, in);
+}
+
+static void test_bloom_blocked_many(void)
+{
+    uint32_t blocks[BLOOM_BLOCKS(TESTS_BLOOM_BITS)];
+    uint32_t single[BLOOM_BLOCKS(TESTS_BLOOM_BITS)];
+    bloom_blocked_t blocked, blocked_single;
+    size_t lens[lenA];
+    bool res[lenA];
+    unsigned in = 0;
+
+    for (int i = 0; i < lenA; i++) {
+        lens[i] = strlen(A[i]);
+    }
+    bloom_blocked_init(&blocked, blocks, BLOOM_BLOCKS(TESTS_BLOOM_BITS),
+                       TESTS_BLOOM_HASHF);
+    bloom_blocked_init(&blocked_single, single,
+                       BLOOM_BLOCKS(TESTS_BLOOM_BITS), TESTS_BLOOM_HASHF);
+    /* an odd number, so the last group is incomplete */
+    bloom_blocked_add_many(&blocked, (const uint8_t *const *) A, lens, 11);
+    for (int i = 0; i < 11; i++) {
+        bloom_blocked_add(&blocked_single, (const uint8_t *) A[i], lens[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(blocks, single, sizeof(blocks)));
+
+    TEST_ASSERT_EQUAL_INT(11, bloom_blocked_check_many(&blocked,
+                                                       (const uint8_t *const *) A,
+                                                       lens, 11, NULL));
+    bloom_blocked_check_many(&blocked, (const uint8_t *const *) A, lens, lenA,
+                             res);
+    for (int i = 0; i < lenA; i++) {
+        TEST_ASSERT_EQUAL_INT(bloom_blocked_check(&blocked,
+                                                  (const uint8_t *) A[i],
+                                                  lens[i]), res[i]);
+        in += res[i];
+    }
+    TEST_ASSERT_EQUAL_INT(in, bloom_blocked_check_many(&blocked,
+                                                       (const uint8_t *const *) A,
+                                                       lens, lenA, NULL));
+}
+
+static void test_bloom_counting_remove(void)
+{
+    uint8_t counters[BLOOM_COUNTING_SIZE(BLOOM_BLOCKS(TESTS_BLOOM_BITS))];
+    uint8_t zero[sizeof(counters)];
+    bloom_counting_t counting;
+
+    memset(zero, 0, sizeof(zero));
+    bloom_counting_init(&counting, counters, BLOOM_BLOCKS(TESTS_BLOOM_BITS),
+                        TESTS_BLOOM_HASHF);
+    for (int i = 0; i < lenB; i++) {
+        bloom_counting_add(&counting, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    /* removing one leaves the others in the filter */
+    TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&counting,
+                                                   (const uint8_t *) B[0],
+                                                   strlen(B[0])));
+    for (int i = 1; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+    for (int i = 1; i < lenB; i++) {
+        TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&counting,
+                                                       (const uint8_t *) B[i],
+                                                       strlen(B[i])));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(counters, zero, sizeof(counters)));
+    TEST_ASSERT(!bloom_counting_check(&counting, (const uint8_t *) B[0],
+                                      strlen(B[0])));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, bloom_counting_remove(&counting,
+                                                         (const uint8_t *) B[0],
+                                                         strlen(B[0])));
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_blocked_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_blocked_many),
+        new_TestFixture(test_bloom_counting_remove),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
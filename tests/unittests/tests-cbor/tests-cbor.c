@@ -18,6 +18,7 @@
 #include "bitarithm.h"
 #include "cbor.h"
 
+#include <errno.h>
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -753,6 +754,174 @@ static void test_double_invalid(void)
 }
 #endif /* CBOR_NO_FLOAT */
 
+static unsigned char sink_data[128];
+static size_t sink_len;
+static unsigned sink_calls;
+
+static int sink(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    if (sink_len + len > sizeof(sink_data)) {
+        return -ENOSPC;
+    }
+    memcpy(sink_data + sink_len, data, len);
+    sink_len += len;
+    sink_calls++;
+    return 0;
+}
+
+static void test_writer(void)
+{
+    uint8_t buf[9];
+    cbor_writer_t writer;
+    const char *bytes = "a byte string longer than the buffer";
+
+    cbor_serialize_map(&stream, 2);
+    cbor_serialize_int(&stream, 1);
+    cbor_serialize_array_indefinite(&stream);
+    cbor_serialize_int(&stream, -500);
+    cbor_serialize_uint64_t(&stream, 0x100000000ull);
+    cbor_serialize_bool(&stream, true);
+    cbor_write_break(&stream);
+    cbor_serialize_int(&stream, 2);
+    cbor_serialize_byte_string(&stream, bytes);
+
+    sink_len = 0;
+    sink_calls = 0;
+    cbor_writer_init(&writer, buf, sizeof(buf), sink, NULL);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_map(&writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_array_indefinite(&writer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, -500));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(&writer, 0x100000000ull));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_bool(&writer, true));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_break(&writer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_bytes(&writer, bytes, strlen(bytes)));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_flush(&writer));
+
+    TEST_ASSERT_EQUAL_INT(stream.pos, cbor_writer_len(&writer));
+    TEST_ASSERT_EQUAL_INT(stream.pos, sink_len);
+    TEST_ASSERT(sink_calls > 1);
+    CBOR_CHECK_SERIALIZED(stream, sink_data, sink_len);
+}
+
+static void test_writer_invalid(void)
+{
+    uint8_t buf[9];
+    cbor_writer_t writer;
+
+    /* without sink, encoding stops when the buffer is full */
+    cbor_writer_init(&writer, buf, sizeof(buf), NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_uint(&writer, 0xffffffffull));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_uint(&writer, 0xffffffffull));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_int(&writer, 0));
+    TEST_ASSERT_EQUAL_INT(5, cbor_writer_len(&writer));
+
+    cbor_writer_init(&writer, buf, 8, sink, NULL);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_int(&writer, 0));
+
+    /* errors of the sink are sticky */
+    sink_len = sizeof(sink_data);
+    cbor_writer_init(&writer, buf, sizeof(buf), sink, NULL);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_int(&writer, 0));
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, cbor_writer_flush(&writer));
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, cbor_writer_int(&writer, 0));
+}
+
+static void test_reader(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    int64_t val;
+
+    cbor_serialize_array(&stream, 3);
+    cbor_serialize_int(&stream, -500);
+    cbor_serialize_byte_string(&stream, "abc");
+    cbor_serialize_map_indefinite(&stream);
+    cbor_write_break(&stream);
+
+    cbor_reader_init(&reader, stream.data, stream.pos);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_TYPE_ARRAY, item.type);
+    TEST_ASSERT_EQUAL_INT(3, item.val);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT_EQUAL_INT(-500, val);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_int(&reader, &val));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_TYPE_BYTES, item.type);
+    TEST_ASSERT_EQUAL_INT(3, item.val);
+    /* strings are not copied */
+    TEST_ASSERT(item.data == stream.data + 5);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_TYPE_MAP, item.type);
+    TEST_ASSERT(item.indefinite);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_TYPE_SIMPLE, item.type);
+    TEST_ASSERT_EQUAL_INT(31, item.info);
+    TEST_ASSERT(cbor_reader_at_end(&reader));
+    TEST_ASSERT_EQUAL_INT(-ENODATA, cbor_reader_next(&reader, &item));
+}
+
+static void test_reader_skip(void)
+{
+    cbor_reader_t reader;
+    int64_t val;
+
+    /* {1: [[1, 2], {"a": [_ 3, {4: 5}]}], 2: 42} */
+    cbor_serialize_map(&stream, 2);
+    cbor_serialize_int(&stream, 1);
+    cbor_serialize_array(&stream, 2);
+    cbor_serialize_array(&stream, 2);
+    cbor_serialize_int(&stream, 1);
+    cbor_serialize_int(&stream, 2);
+    cbor_serialize_map(&stream, 1);
+    cbor_serialize_unicode_string(&stream, "a");
+    cbor_serialize_array_indefinite(&stream);
+    cbor_serialize_int(&stream, 3);
+    cbor_serialize_map(&stream, 1);
+    cbor_serialize_int(&stream, 4);
+    cbor_serialize_int(&stream, 5);
+    cbor_write_break(&stream);
+    cbor_serialize_int(&stream, 2);
+    cbor_serialize_int(&stream, 42);
+
+    cbor_reader_init(&reader, stream.data, stream.pos);
+    reader.pos = 1;
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT_EQUAL_INT(2, val);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_int(&reader, &val));
+    TEST_ASSERT_EQUAL_INT(42, val);
+
+    /* the whole map at once */
+    reader.pos = 0;
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader));
+    TEST_ASSERT(cbor_reader_at_end(&reader));
+}
+
+static void test_reader_invalid(void)
+{
+    /* truncated array, break outside of an indefinite item, reserved info */
+    static const uint8_t truncated[] = { 0x83, 0x01, 0x02 };
+    static const uint8_t stray_break[] = { 0x82, 0x01, 0xff };
+    static const uint8_t reserved[] = { 0x1c };
+    static const uint8_t long_string[] = { 0x45, 0x01 };
+    cbor_reader_t reader;
+    cbor_item_t item;
+
+    cbor_reader_init(&reader, truncated, sizeof(truncated));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_skip(&reader));
+    TEST_ASSERT_EQUAL_INT(0, reader.pos);
+    cbor_reader_init(&reader, stray_break, sizeof(stray_break));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_skip(&reader));
+    cbor_reader_init(&reader, reserved, sizeof(reserved));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_next(&reader, &item));
+    cbor_reader_init(&reader, long_string, sizeof(long_string));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_next(&reader, &item));
+}
+
 #ifndef CBOR_NO_PRINT
 /**
  * Manual test for testing the cbor_stream_decode function
@@ -855,6 +1024,11 @@ TestRef tests_cbor_all(void)
                         new_TestFixture(test_double),
                         new_TestFixture(test_double_invalid),
 #endif /* CBOR_NO_FLOAT */
+                        new_TestFixture(test_writer),
+                        new_TestFixture(test_writer_invalid),
+                        new_TestFixture(test_reader),
+                        new_TestFixture(test_reader_skip),
+                        new_TestFixture(test_reader_invalid),
     };
 
     EMB_UNIT_TESTCALLER(CborTest, setUp, tearDown, fixtures);
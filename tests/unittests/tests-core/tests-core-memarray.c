@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "memarray.h"
+
+#include "tests-core.h"
+
+#define TEST_MEMARRAY_NUM   (4U)
+
+typedef struct {
+    void *link;
+    uint8_t data[3];
+} test_elem_t;
+
+static test_elem_t elems[TEST_MEMARRAY_NUM];
+static memarray_t mem;
+
+static void set_up(void)
+{
+    memarray_init(&mem, elems, sizeof(elems[0]), TEST_MEMARRAY_NUM);
+}
+
+static void test_memarray_static_init(void)
+{
+    memarray_t m = MEMARRAY_INIT(elems, TEST_MEMARRAY_NUM);
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&m, &mem, sizeof(mem)));
+}
+
+static void test_memarray_alloc_all(void)
+{
+    for (unsigned i = 0; i < TEST_MEMARRAY_NUM; i++) {
+        test_elem_t *elem = memarray_alloc(&mem);
+
+        TEST_ASSERT(elem == &elems[i]);
+        TEST_ASSERT_EQUAL_INT(i, memarray_idx(&mem, elem));
+        TEST_ASSERT_EQUAL_INT(TEST_MEMARRAY_NUM - i - 1, memarray_available(&mem));
+    }
+    TEST_ASSERT_NULL(memarray_alloc(&mem));
+    TEST_ASSERT_EQUAL_INT(TEST_MEMARRAY_NUM, mem.peak);
+}
+
+static void test_memarray_free(void)
+{
+    test_elem_t *a, *b;
+
+    a = memarray_alloc(&mem);
+    b = memarray_alloc(&mem);
+    memset(b->data, 0xab, sizeof(b->data));
+    memarray_free(&mem, b);
+    memarray_free(&mem, a);
+    TEST_ASSERT_EQUAL_INT(TEST_MEMARRAY_NUM, memarray_available(&mem));
+    TEST_ASSERT_EQUAL_INT(2, mem.peak);
+    /* only the link of a free element is overwritten */
+    TEST_ASSERT_EQUAL_INT(0xab, b->data[0]);
+    /* released elements are reused first, last in first out */
+    TEST_ASSERT(memarray_alloc(&mem) == a);
+    TEST_ASSERT(memarray_alloc(&mem) == b);
+    TEST_ASSERT(memarray_alloc(&mem) == &elems[2]);
+}
+
+static void test_memarray_unaligned(void)
+{
+    uint8_t raw[(3 * sizeof(void *)) + 1];
+    uint8_t *a, *b;
+
+    /* elements of an odd size, not aligned for the link */
+    memarray_init(&mem, raw, sizeof(void *) + 1, 3);
+    a = memarray_alloc_irqsafe(&mem);
+    b = memarray_alloc_irqsafe(&mem);
+    TEST_ASSERT(b == a + sizeof(void *) + 1);
+    memarray_free_irqsafe(&mem, a);
+    memarray_free_irqsafe(&mem, b);
+    TEST_ASSERT(memarray_alloc_irqsafe(&mem) == b);
+    TEST_ASSERT(memarray_alloc_irqsafe(&mem) == a);
+    TEST_ASSERT_NOT_NULL(memarray_alloc_irqsafe(&mem));
+    TEST_ASSERT_NULL(memarray_alloc_irqsafe(&mem));
+}
+
+Test *tests_core_memarray_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_memarray_static_init),
+        new_TestFixture(test_memarray_alloc_all),
+        new_TestFixture(test_memarray_free),
+        new_TestFixture(test_memarray_unaligned),
+    };
+
+    EMB_UNIT_TESTCALLER(core_memarray_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_memarray_tests;
+}
@@ -71,6 +71,13 @@ Test *tests_core_lifo_tests(void);
  */
 Test *tests_core_list_tests(void);
 
+/**
+ * @brief   Generates tests for memarray.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_core_memarray_tests(void);
+
 /**
  * @brief   Generates tests for priority_queue.h
  *
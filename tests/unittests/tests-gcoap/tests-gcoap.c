@@ -156,6 +156,175 @@ static void test_gcoap__server_get_resp(void)
     }
 }
 
+/* Streaming reader for a 200 byte resource of lowercase letters */
+static ssize_t _block_reader(void *arg, size_t offset, uint8_t *buf, size_t len,
+                                                                     int *more)
+{
+    size_t total = *(size_t *)arg;
+    size_t i;
+
+    for (i = 0; (i < len) && (offset + i < total); i++) {
+        buf[i] = 'a' + ((offset + i) % 26);
+    }
+    *more = (offset + i < total);
+    return i;
+}
+
+/*
+ * Helper for server_block2 tests below.
+ * GET request for /blk with 2-byte token and Block2 option for block 2,
+ * size 64.
+ */
+static int _read_block2_req(coap_pkt_t *pdu, uint8_t *buf)
+{
+    uint8_t pdu_data[] = {
+        0x52, 0x01, 0x12, 0x34, 0xab, 0xcd, 0xb3, 0x62,
+        0x6c, 0x6b, 0xc1, 0x22
+    };
+    memcpy(buf, pdu_data, sizeof(pdu_data));
+
+    return gcoap_parse(pdu, buf, sizeof(pdu_data));
+}
+
+/* Server Block2 request success case. Validate block option parsing. */
+static void test_gcoap__server_block2_req(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_block_t block;
+
+    int res = _read_block2_req(&pdu, &buf[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(COAP_METHOD_GET, coap_get_code(&pdu));
+    TEST_ASSERT_EQUAL_STRING("/blk", (char *) &pdu.url[0]);
+    TEST_ASSERT_EQUAL_INT(1, gcoap_get_block2(&pdu, &block));
+    TEST_ASSERT_EQUAL_INT(2, block.blknum);
+    TEST_ASSERT_EQUAL_INT(2, block.szx);
+    TEST_ASSERT_EQUAL_INT(0, block.more);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_get_block1(&pdu, &block));
+}
+
+/*
+ * Server Block2 response success case. Test writing a block of a resource
+ * with the streaming reader.
+ */
+static void test_gcoap__server_block2_resp(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    size_t total = 200;
+
+    _read_block2_req(&pdu, &buf[0]);
+
+    ssize_t res = gcoap_block2_respond(&pdu, &buf[0], sizeof(buf),
+                                       COAP_FORMAT_TEXT, _block_reader, &total);
+
+    /* Content-Format text, Block2 block 2, more, size 64 */
+    uint8_t resp_hdr[] = {
+        0x52, 0x45, 0x12, 0x34, 0xab, 0xcd, 0xc0, 0xb1,
+        0x2a, 0xff
+    };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(resp_hdr) + 64, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(resp_hdr, buf, sizeof(resp_hdr)));
+    TEST_ASSERT_EQUAL_INT('a' + (128 % 26), buf[sizeof(resp_hdr)]);
+    TEST_ASSERT_EQUAL_INT('a' + (191 % 26), buf[res - 1]);
+}
+
+/*
+ * Client Block1 request success case. Test writing a block of a request body,
+ * and parsing it back.
+ */
+static void test_gcoap__client_block1_req(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_blockopts_t opts = { .flags = GCOAP_BLOCKOPT_BLOCK1 };
+    gcoap_block_t block;
+    char path[] = "/blk";
+
+    opts.block1.blknum = 1;
+    opts.block1.szx    = 2;
+    opts.block1.more   = 1;
+
+    gcoap_req_init(&pdu, &buf[0], sizeof(buf), COAP_METHOD_PUT, &path[0]);
+    memset(pdu.payload, 0x5a, 64);
+    ssize_t len = gcoap_finish_block(&pdu, 64, COAP_FORMAT_NONE, &opts);
+
+    /* Uri-Path (4), Block1 (3), payload marker (1) */
+    TEST_ASSERT_EQUAL_INT(4 + GCOAP_TOKENLEN + 4 + 3 + 1 + 64, len);
+
+    int res = gcoap_parse(&pdu, &buf[0], len);
+
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_STRING(&path[0], (char *)&pdu.url[0]);
+    TEST_ASSERT_EQUAL_INT(64, pdu.payload_len);
+    TEST_ASSERT_EQUAL_INT(0x5a, pdu.payload[63]);
+    TEST_ASSERT_EQUAL_INT(1, gcoap_get_block1(&pdu, &block));
+    TEST_ASSERT_EQUAL_INT(1, block.blknum);
+    TEST_ASSERT_EQUAL_INT(2, block.szx);
+    TEST_ASSERT_EQUAL_INT(1, block.more);
+}
+
+/*
+ * Block options are read from the PDU passed in, not from the PDU parsed
+ * last.
+ */
+static void test_gcoap__block_opts_per_pdu(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t buf2[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu, pdu2;
+    gcoap_block_t block;
+    char path[] = "/blk";
+
+    _read_block2_req(&pdu, &buf[0]);
+    gcoap_req_init(&pdu2, &buf2[0], sizeof(buf2), COAP_METHOD_GET, &path[0]);
+    ssize_t len = gcoap_finish(&pdu2, 0, COAP_FORMAT_NONE);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_parse(&pdu2, &buf2[0], len));
+
+    TEST_ASSERT_EQUAL_INT(0, gcoap_get_block2(&pdu2, &block));
+    TEST_ASSERT_EQUAL_INT(1, gcoap_get_block2(&pdu, &block));
+    TEST_ASSERT_EQUAL_INT(2, block.blknum);
+    TEST_ASSERT_EQUAL_INT(2, block.szx);
+}
+
+/* Accepts only the block at offset 0 */
+static int _block_writer(void *arg, size_t offset, const uint8_t *buf,
+                         size_t len, int more)
+{
+    (void)arg;
+    (void)buf;
+    (void)len;
+    (void)more;
+    return (offset == 0) ? 0 : -ESPIPE;
+}
+
+/* Server Block1 request out of order; responds 4.08 */
+static void test_gcoap__server_block1_incomplete(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_blockopts_t opts = { .flags = GCOAP_BLOCKOPT_BLOCK1 };
+    char path[] = "/blk";
+
+    opts.block1.blknum = 1;
+    opts.block1.szx    = 2;
+    opts.block1.more   = 1;
+
+    gcoap_req_init(&pdu, &buf[0], sizeof(buf), COAP_METHOD_PUT, &path[0]);
+    memset(pdu.payload, 0x5a, 64);
+    ssize_t len = gcoap_finish_block(&pdu, 64, COAP_FORMAT_NONE, &opts);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_parse(&pdu, &buf[0], len));
+
+    len = gcoap_block1_receive(&pdu, &buf[0], sizeof(buf), _block_writer, NULL);
+
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(GCOAP_CODE_REQUEST_ENTITY_INCOMPLETE,
+                          pdu.hdr->code);
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -163,6 +332,11 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__client_get_resp),
         new_TestFixture(test_gcoap__server_get_req),
         new_TestFixture(test_gcoap__server_get_resp),
+        new_TestFixture(test_gcoap__server_block2_req),
+        new_TestFixture(test_gcoap__server_block2_resp),
+        new_TestFixture(test_gcoap__client_block1_req),
+        new_TestFixture(test_gcoap__block_opts_per_pdu),
+        new_TestFixture(test_gcoap__server_block1_incomplete),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
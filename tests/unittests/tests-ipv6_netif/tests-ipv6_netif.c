@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "embUnit/embUnit.h"
@@ -20,6 +21,7 @@
 #include "byteorder.h"
 #include "net/gnrc/netif.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "xtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-ipv6_netif.h"
@@ -254,6 +256,54 @@ static void test_ipv6_netif_reset_addr__success(void)
     TEST_ASSERT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
 }
 
+static void test_ipv6_netif_join__no_multicast(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface */
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_ipv6_netif_join(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_netif_join__no_iface(void)
+{
+    ipv6_addr_t addr = IPV6_ADDR_ALL_ROUTERS_LINK_LOCAL;
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_ipv6_netif_join(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_netif_join_leave__refcount(void)
+{
+    ipv6_addr_t addr = IPV6_ADDR_ALL_ROUTERS_LINK_LOCAL;
+    ipv6_addr_t *out = NULL;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface */
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_join(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_join(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL((out = gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr)));
+    TEST_ASSERT_EQUAL_INT(true, gnrc_ipv6_netif_addr_is_non_unicast(out));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_leave(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_leave(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_ipv6_netif_leave(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_netif_join_leave__added_addr(void)
+{
+    ipv6_addr_t addr = IPV6_ADDR_ALL_NODES_LINK_LOCAL;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface
+                                     * with IPV6_ADDR_ALL_NODES_LINK_LOCAL */
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_ipv6_netif_leave(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_join(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_netif_leave(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
+}
+
 static void test_ipv6_netif_find_by_addr__empty(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -322,6 +372,84 @@ static void test_ipv6_netif_find_addr__success(void)
     TEST_ASSERT_EQUAL_INT(true, ipv6_addr_equal(out, &addr));
 }
 
+static void test_ipv6_netif_find_by_addr__several_ifaces(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t sol_addr;
+    ipv6_addr_t *out = NULL;
+
+    gnrc_ipv6_netif_add(DEFAULT_TEST_NETIF);
+    gnrc_ipv6_netif_add(OTHER_TEST_NETIF);
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(OTHER_TEST_NETIF, &addr,
+                                                  DEFAULT_TEST_PREFIX_LEN, 0));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(DEFAULT_TEST_NETIF, &addr,
+                                                  DEFAULT_TEST_PREFIX_LEN, 0));
+
+    /* the first interface wins, regardless of the order of adding */
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(&out, &addr));
+    TEST_ASSERT(out == gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT(out != gnrc_ipv6_netif_find_addr(OTHER_TEST_NETIF, &addr));
+
+    /* solicited-nodes addresses are part of the index as well */
+    ipv6_addr_set_solicited_nodes(&sol_addr, &addr);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(NULL, &sol_addr));
+
+    gnrc_ipv6_netif_remove_addr(DEFAULT_TEST_NETIF, &addr);
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(&out, &addr));
+    TEST_ASSERT(out == gnrc_ipv6_netif_find_addr(OTHER_TEST_NETIF, &addr));
+
+    gnrc_ipv6_netif_reset_addr(OTHER_TEST_NETIF);
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF, gnrc_ipv6_netif_find_by_addr(&out, &addr));
+    TEST_ASSERT_NULL(out);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF, gnrc_ipv6_netif_find_by_addr(NULL, &sol_addr));
+
+    gnrc_ipv6_netif_remove(DEFAULT_TEST_NETIF);
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF, gnrc_ipv6_netif_find_by_addr(NULL, &sol_addr));
+}
+
+static uint32_t _ns_per_op(uint32_t start, unsigned ops)
+{
+    return ((xtimer_now_usec() - start) * 1000) / ops;
+}
+
+static void test_ipv6_netif_find_by_addr__bench(void)
+{
+    const kernel_pid_t ifaces[] = {
+        DEFAULT_TEST_NETIF, OTHER_TEST_NETIF, OTHER_TEST_NETIF + 1
+    };
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t other = OTHER_TEST_IPV6_ADDR;
+    uint32_t start, hit, miss;
+    unsigned found = 0;
+
+    /* a global address and its solicited-nodes address per interface, and
+     * the all-nodes address each interface has */
+    for (unsigned i = 0; i < sizeof(ifaces) / sizeof(ifaces[0]); i++) {
+        gnrc_ipv6_netif_add(ifaces[i]);
+        addr.u8[15] = i;
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(ifaces[i], &addr,
+                                                      DEFAULT_TEST_PREFIX_LEN, 0));
+    }
+
+    /* the address of the last interface is the worst case of a linear
+     * search */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < 1000; i++) {
+        found += (gnrc_ipv6_netif_find_by_addr(NULL, &addr) != KERNEL_PID_UNDEF);
+    }
+    hit = _ns_per_op(start, 1000);
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < 1000; i++) {
+        found += (gnrc_ipv6_netif_find_by_addr(NULL, &other) != KERNEL_PID_UNDEF);
+    }
+    miss = _ns_per_op(start, 1000);
+    TEST_ASSERT_EQUAL_INT(1000, found);
+
+    printf("ipv6_netif find_by_addr with %u interfaces: hit %lu ns, "
+           "miss %lu ns\n", (unsigned)(sizeof(ifaces) / sizeof(ifaces[0])),
+           (unsigned long)hit, (unsigned long)miss);
+}
+
 static void test_ipv6_netif_find_by_prefix__success1(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_PREFIX23;
@@ -549,8 +677,14 @@ Test *tests_ipv6_netif_tests(void)
         new_TestFixture(test_ipv6_netif_remove_addr__not_allocated),
         new_TestFixture(test_ipv6_netif_remove_addr__success),
         new_TestFixture(test_ipv6_netif_reset_addr__success),
+        new_TestFixture(test_ipv6_netif_join__no_multicast),
+        new_TestFixture(test_ipv6_netif_join__no_iface),
+        new_TestFixture(test_ipv6_netif_join_leave__refcount),
+        new_TestFixture(test_ipv6_netif_join_leave__added_addr),
         new_TestFixture(test_ipv6_netif_find_by_addr__empty),
         new_TestFixture(test_ipv6_netif_find_by_addr__success),
+        new_TestFixture(test_ipv6_netif_find_by_addr__several_ifaces),
+        new_TestFixture(test_ipv6_netif_find_by_addr__bench),
         new_TestFixture(test_ipv6_netif_find_addr__no_iface),
         new_TestFixture(test_ipv6_netif_find_addr__wrong_iface),
         new_TestFixture(test_ipv6_netif_find_addr__wrong_addr),
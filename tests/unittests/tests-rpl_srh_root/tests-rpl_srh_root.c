@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "xtimer.h"
+
+#include "net/ipv6/addr.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/gnrc/rpl/srh_root.h"
+
+#include "tests-rpl_srh_root.h"
+
+#define BENCH_NODES         (500U)
+#define BENCH_ROUNDS        (4U)
+
+/* 2001:db8::ff:fe00:<id> */
+static void _addr(ipv6_addr_t *addr, uint16_t id)
+{
+    memset(addr, 0, sizeof(ipv6_addr_t));
+    addr->u8[0] = 0x20;
+    addr->u8[1] = 0x01;
+    addr->u8[2] = 0x0d;
+    addr->u8[3] = 0xb8;
+    addr->u8[11] = 0xff;
+    addr->u8[12] = 0xfe;
+    addr->u8[14] = id >> 8;
+    addr->u8[15] = id & 0xff;
+}
+
+/* adds node id with parent pid, pid 0 being the root */
+static int _update(uint16_t id, uint16_t pid)
+{
+    ipv6_addr_t target, parent;
+
+    _addr(&target, id);
+    _addr(&parent, pid);
+    return gnrc_rpl_srh_root_update(&target, (pid == 0) ? NULL : &parent, 100);
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_rpl_srh_root_reset();
+}
+
+static void test_rpl_srh_root_get_path(void)
+{
+    ipv6_addr_t path[4], expected;
+
+    TEST_ASSERT_EQUAL_INT(0, _update(1, 0));
+    TEST_ASSERT_EQUAL_INT(0, _update(2, 1));
+    TEST_ASSERT_EQUAL_INT(0, _update(0x101, 2));
+
+    _addr(&expected, 0x101);
+    TEST_ASSERT_EQUAL_INT(3, gnrc_rpl_srh_root_get_path(&expected, path, 4));
+    for (unsigned i = 0; i < 3; i++) {
+        _addr(&expected, (i < 2) ? (i + 1) : 0x101);
+        TEST_ASSERT(ipv6_addr_equal(&expected, &path[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, gnrc_rpl_srh_root_get_path(&expected, path, 2));
+
+    _addr(&expected, 1);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_srh_root_get_path(&expected, path, 4));
+    _addr(&expected, 3);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_root_get_path(&expected, path, 4));
+}
+
+static void test_rpl_srh_root_parent_change(void)
+{
+    ipv6_addr_t path[4], dst;
+
+    _update(1, 0);
+    _update(2, 0);
+    _update(3, 1);
+    _addr(&dst, 3);
+    /* fill the cache */
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_srh_root_get_path(&dst, path, 4));
+
+    _update(3, 2);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_srh_root_get_path(&dst, path, 4));
+    _addr(&dst, 2);
+    TEST_ASSERT(ipv6_addr_equal(&dst, &path[0]));
+}
+
+static void test_rpl_srh_root_remove(void)
+{
+    ipv6_addr_t path[4], addr;
+
+    _update(1, 0);
+    _update(2, 1);
+    _addr(&addr, 2);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_srh_root_get_path(&addr, path, 4));
+
+    /* the child is orphaned until it reports a new parent */
+    _addr(&addr, 1);
+    gnrc_rpl_srh_root_remove(&addr);
+    _addr(&addr, 2);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_root_get_path(&addr, path, 4));
+    _update(2, 0);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_srh_root_get_path(&addr, path, 4));
+}
+
+static void test_rpl_srh_root_expire(void)
+{
+    ipv6_addr_t path[4], addr;
+
+    _update(1, 0);
+    _addr(&addr, 1);
+    gnrc_rpl_srh_root_expire(99);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_srh_root_get_path(&addr, path, 4));
+    gnrc_rpl_srh_root_expire(100);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_srh_root_get_path(&addr, path, 4));
+}
+
+static void test_rpl_srh_root_loop(void)
+{
+    ipv6_addr_t path[GNRC_RPL_SRH_ROOT_MAX_DEPTH], addr;
+
+    _update(1, 2);
+    _update(2, 1);
+    _addr(&addr, 1);
+    TEST_ASSERT_EQUAL_INT(-ENOSPC,
+                          gnrc_rpl_srh_root_get_path(&addr, path,
+                                                     GNRC_RPL_SRH_ROOT_MAX_DEPTH));
+}
+
+static void test_rpl_srh_root_full(void)
+{
+    for (uint16_t i = 1; i <= GNRC_RPL_SRH_ROOT_NODES_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _update(i, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _update(GNRC_RPL_SRH_ROOT_NODES_NUMOF + 1, 0));
+}
+
+static void test_rpl_srh_root_build_child(void)
+{
+    ipv6_addr_t dst, first;
+
+    _update(1, 0);
+    _addr(&dst, 1);
+    TEST_ASSERT_NULL(gnrc_rpl_srh_root_build(&dst, NULL, &first));
+}
+
+static void test_rpl_srh_root_build(void)
+{
+    ipv6_hdr_t hdr;
+    ipv6_addr_t dst, expected;
+    gnrc_pktsnip_t *snip;
+    gnrc_rpl_srh_t *srh;
+
+    _update(1, 0);
+    _update(2, 1);
+    _update(0x101, 2);
+    _addr(&dst, 0x101);
+
+    snip = gnrc_rpl_srh_root_build(&dst, NULL, &hdr.dst);
+    TEST_ASSERT_NOT_NULL(snip);
+    srh = snip->data;
+    /* 2 and 0x101 with 15 and 14 octets elided */
+    TEST_ASSERT_EQUAL_INT(16, snip->size);
+    TEST_ASSERT_EQUAL_INT(1, srh->len);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_SRH_TYPE, srh->type);
+    TEST_ASSERT_EQUAL_INT(2, srh->seg_left);
+    TEST_ASSERT_EQUAL_INT(0xfe, srh->compr);
+    TEST_ASSERT_EQUAL_INT(5, srh->pad_resv >> 4);
+    _addr(&expected, 1);
+    TEST_ASSERT(ipv6_addr_equal(&expected, &hdr.dst));
+
+    /* forwarding nodes reach the destination */
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    _addr(&expected, 2);
+    TEST_ASSERT(ipv6_addr_equal(&expected, &hdr.dst));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &hdr.dst));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_OK, gnrc_rpl_srh_process(&hdr, srh));
+
+    gnrc_pktbuf_release(snip);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Builds a synthetic DODAG of BENCH_NODES nodes, where the parent of node i
+ * is parent(i), and measures the source route computation to all nodes.
+ */
+static void _bench(const char *name, uint16_t (*parent)(uint16_t))
+{
+    ipv6_addr_t path[GNRC_RPL_SRH_ROOT_MAX_DEPTH], dst;
+    unsigned hops = 0;
+
+    gnrc_rpl_srh_root_reset();
+    for (uint16_t i = 1; i <= BENCH_NODES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _update(i, parent(i)));
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint16_t i = 1; i <= BENCH_NODES; i++) {
+            _addr(&dst, i);
+            int res = gnrc_rpl_srh_root_get_path(&dst, path,
+                                                 GNRC_RPL_SRH_ROOT_MAX_DEPTH);
+            TEST_ASSERT(res > 0);
+            hops += res;
+        }
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+
+    printf("%s: %u paths, %u hops in %lu us\n", name,
+           BENCH_NODES * BENCH_ROUNDS, hops, (unsigned long)usec);
+}
+
+/* 4-ary tree: depth 5 */
+static uint16_t _parent_quad(uint16_t i)
+{
+    return (i - 1) / 4;
+}
+
+/* binary tree: depth 9 */
+static uint16_t _parent_binary(uint16_t i)
+{
+    return i / 2;
+}
+
+/* 32 chains of up to 16 hops */
+static uint16_t _parent_chains(uint16_t i)
+{
+    return (i > 32) ? (i - 32) : 0;
+}
+
+static void test_rpl_srh_root_bench(void)
+{
+    puts("");
+    _bench("4-ary", _parent_quad);
+    _bench("binary", _parent_binary);
+    _bench("chains", _parent_chains);
+}
+
+Test *tests_rpl_srh_root_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rpl_srh_root_get_path),
+        new_TestFixture(test_rpl_srh_root_parent_change),
+        new_TestFixture(test_rpl_srh_root_remove),
+        new_TestFixture(test_rpl_srh_root_expire),
+        new_TestFixture(test_rpl_srh_root_loop),
+        new_TestFixture(test_rpl_srh_root_full),
+        new_TestFixture(test_rpl_srh_root_build_child),
+        new_TestFixture(test_rpl_srh_root_build),
+        new_TestFixture(test_rpl_srh_root_bench),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_srh_root_tests, set_up, NULL, fixtures);
+
+    return (Test *)&rpl_srh_root_tests;
+}
+
+void tests_rpl_srh_root(void)
+{
+    TESTS_RUN(tests_rpl_srh_root_tests());
+}
+/** @} */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "schema.h"
+
+#include "tests-schema.h"
+
+typedef struct {
+    uint16_t a;
+    int8_t b;
+    bool c;
+    uint8_t d[2];
+} test_t;
+
+#define TEST_FIELDS(FIELD)          \
+    FIELD(a, SCHEMA_U16)            \
+    FIELD(b, SCHEMA_I8)             \
+    FIELD(c, SCHEMA_BOOL)           \
+    FIELD(d, SCHEMA_BYTES(2))
+
+SCHEMA_DECLARE(test, test_t);
+SCHEMA_DEFINE(test, test_t, TEST_FIELDS)
+
+static const test_t sample = { 0x1234, -2, true, { 0xaa, 0xbb } };
+
+static const uint8_t sample_cbor[] = {
+    0xa4,
+    0x61, 'a', 0x19, 0x12, 0x34,
+    0x61, 'b', 0x38, 0x01,
+    0x61, 'c', 0xf5,
+    0x61, 'd', 0x42, 0xaa, 0xbb,
+};
+
+static const uint8_t sample_ubjson[] = {
+    '{', '#', 'U', 4,
+    'U', 1, 'a', 'l', 0x00, 0x00, 0x12, 0x34,
+    'U', 1, 'b', 'i', 0xfe,
+    'U', 1, 'c', 'T',
+    'U', 1, 'd', '[', '$', 'U', '#', 'U', 2, 0xaa, 0xbb,
+};
+
+static uint8_t buf[40];
+
+static int equal(const test_t *x, const test_t *y)
+{
+    return (x->a == y->a) && (x->b == y->b) && (x->c == y->c) &&
+           (memcmp(x->d, y->d, sizeof(x->d)) == 0);
+}
+
+static void test_schema_size(void)
+{
+    TEST_ASSERT_EQUAL_INT(4, SCHEMA_FIELDS(TEST_FIELDS));
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_cbor), SCHEMA_CBOR_SIZE(TEST_FIELDS));
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_ubjson), SCHEMA_UBJSON_SIZE(TEST_FIELDS));
+}
+
+static void test_schema_cbor(void)
+{
+    test_t t;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_cbor),
+                          test_cbor_encode(&sample, buf, sizeof(buf)));
+    TEST_ASSERT(memcmp(sample_cbor, buf, sizeof(sample_cbor)) == 0);
+    memset(&t, 0, sizeof(t));
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_cbor),
+                          test_cbor_decode(&t, buf, sizeof(buf)));
+    TEST_ASSERT(equal(&sample, &t));
+}
+
+static void test_schema_ubjson(void)
+{
+    test_t t;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_ubjson),
+                          test_ubjson_encode(&sample, buf, sizeof(buf)));
+    TEST_ASSERT(memcmp(sample_ubjson, buf, sizeof(sample_ubjson)) == 0);
+    memset(&t, 0, sizeof(t));
+    TEST_ASSERT_EQUAL_INT(sizeof(sample_ubjson),
+                          test_ubjson_decode(&t, buf, sizeof(buf)));
+    TEST_ASSERT(equal(&sample, &t));
+}
+
+static void test_schema_limits(void)
+{
+    const test_t limits[] = {
+        { 0, INT8_MIN, false, { 0, 0 } },
+        { UINT16_MAX, INT8_MAX, true, { 0xff, 0xff } },
+        { 0x8000, -1, false, { 0x5d, 0x00 } },
+    };
+    test_t t;
+
+    for (unsigned i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        test_cbor_encode(&limits[i], buf, sizeof(buf));
+        TEST_ASSERT(test_cbor_decode(&t, buf, sizeof(buf)) > 0);
+        TEST_ASSERT(equal(&limits[i], &t));
+        test_ubjson_encode(&limits[i], buf, sizeof(buf));
+        TEST_ASSERT(test_ubjson_decode(&t, buf, sizeof(buf)) > 0);
+        TEST_ASSERT(equal(&limits[i], &t));
+    }
+}
+
+static void test_schema_invalid(void)
+{
+    test_t t;
+
+    TEST_ASSERT_EQUAL_INT(0, test_cbor_encode(&sample, buf, sizeof(sample_cbor) - 1));
+    TEST_ASSERT_EQUAL_INT(0, test_ubjson_encode(&sample, buf, sizeof(sample_ubjson) - 1));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_cbor_decode(&t, sample_cbor,
+                                                     sizeof(sample_cbor) - 1));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_ubjson_decode(&t, sample_ubjson,
+                                                       sizeof(sample_ubjson) - 1));
+
+    /* another key */
+    memcpy(buf, sample_cbor, sizeof(sample_cbor));
+    buf[7] = 'x';
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_cbor_decode(&t, buf, sizeof(sample_cbor)));
+    memcpy(buf, sample_ubjson, sizeof(sample_ubjson));
+    buf[14] = 'x';
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_ubjson_decode(&t, buf, sizeof(sample_ubjson)));
+
+    /* -129 doesn't fit an int8_t */
+    memcpy(buf, sample_cbor, sizeof(sample_cbor));
+    buf[9] = 0x80;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_cbor_decode(&t, buf, sizeof(sample_cbor)));
+
+    /* 0x10000 doesn't fit an uint16_t */
+    memcpy(buf, sample_ubjson, sizeof(sample_ubjson));
+    buf[9] = 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_ubjson_decode(&t, buf, sizeof(sample_ubjson)));
+
+    /* byte string of another length */
+    memcpy(buf, sample_cbor, sizeof(sample_cbor));
+    buf[15] = 0x41;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, test_cbor_decode(&t, buf, sizeof(sample_cbor)));
+}
+
+Test *tests_schema_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_schema_size),
+        new_TestFixture(test_schema_cbor),
+        new_TestFixture(test_schema_ubjson),
+        new_TestFixture(test_schema_limits),
+        new_TestFixture(test_schema_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(schema_tests, NULL, NULL, fixtures);
+
+    return (Test *)&schema_tests;
+}
+
+void tests_schema(void)
+{
+    TESTS_RUN(tests_schema_tests());
+}
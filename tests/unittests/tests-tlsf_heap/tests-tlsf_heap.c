@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "tlsf_heap.h"
+
+#include "tests-tlsf_heap.h"
+
+#define POOL_SIZE       (2048U)
+#define SLOTS           (16U)
+#define ROUNDS          (2000U)
+
+static tlsf_heap_t heap;
+static uint8_t pool[POOL_SIZE + 1];
+static uint8_t pool2[POOL_SIZE / 2];
+static size_t capacity;
+
+static void set_up(void)
+{
+    tlsf_heap_stats_t stats;
+
+    tlsf_heap_init(&heap);
+    /* unaligned on purpose */
+    tlsf_heap_add_pool(&heap, pool + 1, POOL_SIZE);
+    tlsf_heap_stats(&heap, &stats);
+    capacity = stats.largest;
+}
+
+static void assert_empty(void)
+{
+    tlsf_heap_stats_t stats;
+
+    tlsf_heap_stats(&heap, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT_EQUAL_INT(0, stats.used_blocks);
+    TEST_ASSERT_EQUAL_INT(1, stats.free_blocks);
+    TEST_ASSERT_EQUAL_INT(capacity, stats.largest);
+    TEST_ASSERT_EQUAL_INT(0, tlsf_heap_fragmentation(&stats));
+}
+
+static void test_tlsf_heap_add_pool(void)
+{
+    tlsf_heap_t h;
+
+    tlsf_heap_init(&h);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, tlsf_heap_add_pool(&h, pool2, 3 * TLSF_HEAP_ALIGN));
+    TEST_ASSERT_NULL(tlsf_heap_alloc(&h, 1));
+    TEST_ASSERT_EQUAL_INT(0, tlsf_heap_add_pool(&h, pool2, sizeof(pool2)));
+    TEST_ASSERT(capacity < POOL_SIZE);
+    TEST_ASSERT(capacity >= POOL_SIZE - 4 * TLSF_HEAP_ALIGN);
+    assert_empty();
+}
+
+static void test_tlsf_heap_alloc_free(void)
+{
+    void *a, *b, *c;
+
+    TEST_ASSERT_NULL(tlsf_heap_alloc(&heap, 0));
+    TEST_ASSERT_NULL(tlsf_heap_alloc(&heap, capacity + 1));
+    a = tlsf_heap_alloc(&heap, 1);
+    b = tlsf_heap_alloc(&heap, 100);
+    c = tlsf_heap_alloc(&heap, 33);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)a % TLSF_HEAP_ALIGN);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)b % TLSF_HEAP_ALIGN);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)c % TLSF_HEAP_ALIGN);
+    TEST_ASSERT(tlsf_heap_size(b) >= 100);
+    TEST_ASSERT(tlsf_heap_contains(&heap, c));
+    TEST_ASSERT(!tlsf_heap_contains(&heap, pool2));
+    memset(a, 0xaa, 1);
+    memset(b, 0xbb, 100);
+    memset(c, 0xcc, 33);
+
+    /* free the middle one first, then merge it with both neighbours */
+    tlsf_heap_free(&heap, b);
+    tlsf_heap_free(&heap, a);
+    tlsf_heap_free(&heap, c);
+    tlsf_heap_free(&heap, NULL);
+    assert_empty();
+
+    a = tlsf_heap_alloc(&heap, capacity);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NULL(tlsf_heap_alloc(&heap, 1));
+    tlsf_heap_free(&heap, a);
+    assert_empty();
+}
+
+static void test_tlsf_heap_realloc(void)
+{
+    uint8_t *a, *b;
+
+    a = tlsf_heap_realloc(&heap, NULL, 40);
+    TEST_ASSERT_NOT_NULL(a);
+    for (unsigned i = 0; i < 40; i++) {
+        a[i] = i;
+    }
+    /* grows in place into the free space behind */
+    TEST_ASSERT(tlsf_heap_realloc(&heap, a, 400) == a);
+    TEST_ASSERT(tlsf_heap_size(a) >= 400);
+    /* shrinks in place */
+    TEST_ASSERT(tlsf_heap_realloc(&heap, a, 50) == a);
+    TEST_ASSERT(tlsf_heap_size(a) < 400);
+    /* must move, as b is in the way */
+    b = tlsf_heap_alloc(&heap, 16);
+    a = tlsf_heap_realloc(&heap, a, 800);
+    TEST_ASSERT_NOT_NULL(a);
+    for (unsigned i = 0; i < 40; i++) {
+        TEST_ASSERT_EQUAL_INT(i, a[i]);
+    }
+    /* fails and leaves a untouched */
+    TEST_ASSERT_NULL(tlsf_heap_realloc(&heap, a, capacity));
+    TEST_ASSERT_EQUAL_INT(39, a[39]);
+    TEST_ASSERT_NULL(tlsf_heap_realloc(&heap, a, 0));
+    tlsf_heap_free(&heap, b);
+    assert_empty();
+}
+
+static void test_tlsf_heap_stats(void)
+{
+    tlsf_heap_stats_t stats;
+    void *ptrs[4];
+
+    for (unsigned i = 0; i < 4; i++) {
+        ptrs[i] = tlsf_heap_alloc(&heap, 64);
+    }
+    tlsf_heap_free(&heap, ptrs[0]);
+    tlsf_heap_free(&heap, ptrs[2]);
+    tlsf_heap_stats(&heap, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.used_blocks);
+    TEST_ASSERT_EQUAL_INT(3, stats.free_blocks);
+    TEST_ASSERT_EQUAL_INT(2 * (64 + TLSF_HEAP_ALIGN), stats.used);
+    TEST_ASSERT_EQUAL_INT(4 * (64 + TLSF_HEAP_ALIGN), stats.peak);
+    TEST_ASSERT_EQUAL_INT(capacity - 2 * TLSF_HEAP_ALIGN - stats.used, stats.free);
+    TEST_ASSERT(stats.largest < stats.free);
+    TEST_ASSERT(tlsf_heap_fragmentation(&stats) > 0);
+    tlsf_heap_free(&heap, ptrs[1]);
+    tlsf_heap_free(&heap, ptrs[3]);
+    assert_empty();
+}
+
+static void test_tlsf_heap_random(void)
+{
+    uint8_t *ptrs[SLOTS];
+    size_t sizes[SLOTS];
+    uint32_t seed = 1;
+
+    memset(ptrs, 0, sizeof(ptrs));
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        unsigned i;
+
+        seed = (seed * 1103515245U) + 12345U;
+        i = (seed >> 16) % SLOTS;
+        if (ptrs[i]) {
+            for (size_t j = 0; j < sizes[i]; j++) {
+                TEST_ASSERT_EQUAL_INT((uint8_t)i, ptrs[i][j]);
+            }
+            if (seed & 1) {
+                tlsf_heap_free(&heap, ptrs[i]);
+                ptrs[i] = NULL;
+                continue;
+            }
+        }
+        sizes[i] = 1 + ((seed >> 4) % 64);
+        ptrs[i] = tlsf_heap_realloc(&heap, ptrs[i], sizes[i]);
+        TEST_ASSERT_NOT_NULL(ptrs[i]);
+        memset(ptrs[i], i, sizes[i]);
+    }
+    for (unsigned i = 0; i < SLOTS; i++) {
+        tlsf_heap_free(&heap, ptrs[i]);
+    }
+    assert_empty();
+}
+
+Test *tests_tlsf_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tlsf_heap_add_pool),
+        new_TestFixture(test_tlsf_heap_alloc_free),
+        new_TestFixture(test_tlsf_heap_realloc),
+        new_TestFixture(test_tlsf_heap_stats),
+        new_TestFixture(test_tlsf_heap_random),
+    };
+
+    EMB_UNIT_TESTCALLER(tlsf_heap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tlsf_heap_tests;
+}
+
+void tests_tlsf_heap(void)
+{
+    TESTS_RUN(tests_tlsf_heap_tests());
+}
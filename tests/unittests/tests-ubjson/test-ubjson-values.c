@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "tests-ubjson.h"
+
+#define VALUES_MAX  (4U)
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    unsigned count;
+    ubjson_type_t types[VALUES_MAX];
+    int64_t values[VALUES_MAX];
+} test_ubjson_values_receiver_cookie_t;
+
+static ubjson_read_callback_result_t test_ubjson_values_receiver_callback(
+        ubjson_cookie_t *restrict cookie,
+        ubjson_type_t type1, ssize_t content1,
+        ubjson_type_t type2, ssize_t content2)
+{
+    test_ubjson_values_receiver_cookie_t *state;
+    state = container_of(cookie, test_ubjson_values_receiver_cookie_t, cookie);
+
+    if (type1 == UBJSON_INDEX) {
+        ubjson_read_callback_result_t result;
+
+        type1 = type2;
+        content1 = content2;
+        result = ubjson_peek_value(cookie, &type1, &content1);
+        if (result != UBJSON_OKAY) {
+            return result;
+        }
+    }
+
+    if (type1 == UBJSON_ENTER_ARRAY) {
+        return ubjson_read_array(cookie);
+    }
+    if (state->count >= VALUES_MAX) {
+        return UBJSON_ABORTED;
+    }
+
+    int64_t *value = &state->values[state->count];
+    state->types[state->count++] = type1;
+
+    switch (type1) {
+        case UBJSON_TYPE_BOOL:
+            *value = content1;
+            break;
+
+        case UBJSON_TYPE_INT32: {
+            int32_t i32;
+            if (ubjson_get_i32(cookie, content1, &i32) <= 0) {
+                return UBJSON_ABORTED;
+            }
+            *value = i32;
+            break;
+        }
+
+        case UBJSON_TYPE_INT64:
+            if (ubjson_get_i64(cookie, content1, value) <= 0) {
+                return UBJSON_ABORTED;
+            }
+            break;
+
+        default:
+            return UBJSON_ABORTED;
+    }
+
+    return UBJSON_OKAY;
+}
+
+static void test_ubjson_values_read(test_ubjson_values_receiver_cookie_t *state,
+                                    unsigned count)
+{
+    state->count = 0;
+    for (unsigned i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_INT(UBJSON_OKAY,
+                              ubjson_read(&state->cookie, test_ubjson_read_fun,
+                                          test_ubjson_values_receiver_callback));
+    }
+}
+
+static void test_ubjson_bool_receiver(void)
+{
+    test_ubjson_values_receiver_cookie_t state;
+
+    test_ubjson_values_read(&state, 2);
+    TEST_ASSERT_EQUAL_INT(2, state.count);
+    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_BOOL, state.types[0]);
+    TEST_ASSERT_EQUAL_INT(true, state.values[0]);
+    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_BOOL, state.types[1]);
+    TEST_ASSERT_EQUAL_INT(false, state.values[1]);
+}
+
+static void test_ubjson_uint16_receiver(void)
+{
+    test_ubjson_values_receiver_cookie_t state;
+
+    test_ubjson_values_read(&state, 2);
+    TEST_ASSERT_EQUAL_INT(2, state.count);
+    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT32, state.types[0]);
+    TEST_ASSERT_EQUAL_INT(40000, state.values[0]);
+    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT32, state.types[1]);
+    TEST_ASSERT_EQUAL_INT(-30000, state.values[1]);
+}
+
+static void test_ubjson_int64_receiver(void)
+{
+    test_ubjson_values_receiver_cookie_t state;
+
+    test_ubjson_values_read(&state, 1);
+    TEST_ASSERT_EQUAL_INT(1, state.count);
+    TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT64, state.types[0]);
+    TEST_ASSERT(state.values[0] == (INT64_C(1) << 40));
+}
+
+static void test_ubjson_typed_array_receiver(void)
+{
+    test_ubjson_values_receiver_cookie_t state;
+
+    test_ubjson_values_read(&state, 1);
+    TEST_ASSERT_EQUAL_INT(3, state.count);
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(UBJSON_TYPE_INT32, state.types[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, state.values[0]);
+    TEST_ASSERT_EQUAL_INT(7, state.values[1]);
+    TEST_ASSERT_EQUAL_INT(0, state.values[2]);
+}
+
+#undef EMBUNIT_ERROR_RETURN
+#define EMBUNIT_ERROR_RETURN
+
+static void test_ubjson_bool_sender(void)
+{
+    ubjson_cookie_t cookie;
+    ubjson_write_init(&cookie, test_ubjson_write_fun);
+
+    TEST_ASSERT(ubjson_write_bool(&cookie, true) > 0);
+    TEST_ASSERT(ubjson_write_bool(&cookie, false) > 0);
+}
+
+static void test_ubjson_uint16_sender(void)
+{
+    ubjson_cookie_t cookie;
+    ubjson_write_init(&cookie, test_ubjson_write_fun);
+
+    /* does not fit into an int16 */
+    TEST_ASSERT(ubjson_write_i32(&cookie, 40000) > 0);
+    TEST_ASSERT(ubjson_write_i32(&cookie, -30000) > 0);
+}
+
+static void test_ubjson_int64_sender(void)
+{
+    ubjson_cookie_t cookie;
+    ubjson_write_init(&cookie, test_ubjson_write_fun);
+
+    TEST_ASSERT(ubjson_write_i64(&cookie, INT64_C(1) << 40) > 0);
+}
+
+static void test_ubjson_typed_array_sender(void)
+{
+    /* array of three uint8, the first one 0 */
+    static const char array[] = { '[', '$', 'U', '#', 'U', 3, 0, 7, 0 };
+    ubjson_cookie_t cookie;
+    ubjson_write_init(&cookie, test_ubjson_write_fun);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(array),
+                          test_ubjson_write_fun(&cookie, array, sizeof(array)));
+}
+
+void test_ubjson_bool(void)
+{
+    test_ubjson_test(test_ubjson_bool_sender,
+                     test_ubjson_bool_receiver);
+}
+
+void test_ubjson_uint16(void)
+{
+    test_ubjson_test(test_ubjson_uint16_sender,
+                     test_ubjson_uint16_receiver);
+}
+
+void test_ubjson_int64(void)
+{
+    test_ubjson_test(test_ubjson_int64_sender,
+                     test_ubjson_int64_receiver);
+}
+
+void test_ubjson_typed_array(void)
+{
+    test_ubjson_test(test_ubjson_typed_array_sender,
+                     test_ubjson_typed_array_receiver);
+}
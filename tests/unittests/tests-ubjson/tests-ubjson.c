@@ -103,6 +103,10 @@ static Test *tests_ubjson_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_ubjson_empty_array),
         new_TestFixture(test_ubjson_empty_object),
+        new_TestFixture(test_ubjson_bool),
+        new_TestFixture(test_ubjson_uint16),
+        new_TestFixture(test_ubjson_int64),
+        new_TestFixture(test_ubjson_typed_array),
     };
 
     EMB_UNIT_TESTCALLER(ubjson_tests, ubjson_set_up, NULL, fixtures);
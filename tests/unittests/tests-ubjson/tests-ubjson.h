@@ -45,6 +45,10 @@ void test_ubjson_test(void (*sender_fun)(void), void (*receiver_fun)(void));
 
 void test_ubjson_empty_array(void);
 void test_ubjson_empty_object(void);
+void test_ubjson_bool(void);
+void test_ubjson_uint16(void);
+void test_ubjson_int64(void);
+void test_ubjson_typed_array(void);
 
 #ifdef __cplusplus
 }
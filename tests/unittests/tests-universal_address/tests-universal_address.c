@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "universal_address.h"
+
+#include "tests-universal_address.h"
+
+#define ADDR_SIZE       (16U)
+
+static uint8_t addr[ADDR_SIZE];
+
+/* 2001:db8::<n>, all sharing the /64 prefix */
+static uint8_t *_addr(uint32_t n)
+{
+    memset(addr, 0, sizeof(addr));
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[12] = n >> 24;
+    addr[13] = n >> 16;
+    addr[14] = n >> 8;
+    addr[15] = n;
+    return addr;
+}
+
+static void set_up(void)
+{
+    universal_address_init();
+}
+
+static void test_universal_address_add_rem(void)
+{
+    universal_address_container_t *a, *b, *c;
+
+    a = universal_address_add(_addr(1), ADDR_SIZE);
+    b = universal_address_add(_addr(2), ADDR_SIZE);
+    c = universal_address_add(_addr(1), 4);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT(a != b);
+    /* same bytes, but of another size */
+    TEST_ASSERT(a != c);
+    TEST_ASSERT(universal_address_add(_addr(1), ADDR_SIZE) == a);
+    TEST_ASSERT_EQUAL_INT(2, a->use_count);
+    TEST_ASSERT_EQUAL_INT(3, universal_address_get_num_used_entries());
+
+    universal_address_rem(a);
+    TEST_ASSERT(universal_address_add(_addr(1), ADDR_SIZE) == a);
+    universal_address_rem(a);
+    universal_address_rem(a);
+    universal_address_rem(c);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+    /* b is still found after its neighbours are gone */
+    TEST_ASSERT(universal_address_add(_addr(2), ADDR_SIZE) == b);
+    TEST_ASSERT_EQUAL_INT(2, b->use_count);
+}
+
+static void test_universal_address_full(void)
+{
+    for (unsigned i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; i++) {
+        TEST_ASSERT_NOT_NULL(universal_address_add(_addr(i), ADDR_SIZE));
+    }
+    TEST_ASSERT_NULL(universal_address_add(_addr(UNIVERSAL_ADDRESS_MAX_ENTRIES),
+                                           ADDR_SIZE));
+    for (unsigned i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; i += 2) {
+        universal_address_container_t *entry = universal_address_add(_addr(i), ADDR_SIZE);
+
+        universal_address_rem(entry);
+        universal_address_rem(entry);
+    }
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MAX_ENTRIES / 2,
+                          universal_address_get_num_used_entries());
+    for (unsigned i = 1; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; i += 2) {
+        universal_address_container_t *entry = universal_address_add(_addr(i), ADDR_SIZE);
+
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_INT(2, entry->use_count);
+    }
+}
+
+static void test_universal_address_compare(void)
+{
+    universal_address_container_t *entry;
+    size_t bits = ADDR_SIZE << 3;
+
+    entry = universal_address_add(_addr(0x1234), ADDR_SIZE);
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare(entry, _addr(0x1234), &bits));
+    /* 0x12 and 0x10 differ in bit 6 of byte 14 */
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare(entry, _addr(0x1034), &bits));
+    TEST_ASSERT_EQUAL_INT(118, bits);
+    bits = 32;
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare(entry, _addr(0x1234), &bits));
+
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(entry, _addr(0x1200),
+                                                           ADDR_SIZE << 3));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare_prefix(entry, _addr(0x1234),
+                                                           ADDR_SIZE << 3));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(entry, _addr(0x1300),
+                                                           ADDR_SIZE << 3));
+    /* 2001:db8::/32 */
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(entry, _addr(0),
+                                                           ADDR_SIZE << 3));
+    _addr(0x1234);
+    addr[1] = 0x02;
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(entry, addr,
+                                                           ADDR_SIZE << 3));
+}
+
+Test *tests_universal_address_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_universal_address_add_rem),
+        new_TestFixture(test_universal_address_full),
+        new_TestFixture(test_universal_address_compare),
+    };
+
+    EMB_UNIT_TESTCALLER(universal_address_tests, set_up, NULL, fixtures);
+
+    return (Test *)&universal_address_tests;
+}
+
+void tests_universal_address(void)
+{
+    TESTS_RUN(tests_universal_address_tests());
+}
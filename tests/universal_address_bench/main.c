@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of adding, finding and comparing addresses
+ *              in the universal address table
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "universal_address.h"
+#include "xtimer.h"
+
+#define ADDR_SIZE       (16U)
+#define ADDR_STEP       (7919U)     /**< spreads the addresses over the
+                                     *   last 32 bits */
+
+static uint8_t _buf[ADDR_SIZE];
+
+/* 2001:db8::<n>, all sharing the /64 prefix */
+static uint8_t *_addr(uint32_t n)
+{
+    memset(_buf, 0, sizeof(_buf));
+    _buf[0] = 0x20;
+    _buf[1] = 0x01;
+    _buf[2] = 0x0d;
+    _buf[3] = 0xb8;
+    _buf[12] = n >> 24;
+    _buf[13] = n >> 16;
+    _buf[14] = n >> 8;
+    _buf[15] = n;
+    return _buf;
+}
+
+static uint32_t _ns_per_op(uint32_t start, unsigned ops)
+{
+    return ((xtimer_now_usec() - start) * 1000) / ops;
+}
+
+/* Fills the table with n addresses and returns the number of failed checks */
+static unsigned _bench(unsigned n)
+{
+    universal_address_container_t *entry;
+    uint32_t start, add, find, cmp;
+    unsigned matches = 0, failed = 0;
+
+    universal_address_init();
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < n; i++) {
+        universal_address_add(_addr(i * ADDR_STEP), ADDR_SIZE);
+    }
+    add = _ns_per_op(start, n);
+    failed += (universal_address_get_num_used_entries() != (int)n);
+
+    /* adding a known address only looks it up */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < n; i++) {
+        universal_address_rem(universal_address_add(_addr(i * ADDR_STEP),
+                                                    ADDR_SIZE));
+    }
+    find = _ns_per_op(start, n);
+    failed += (universal_address_get_num_used_entries() != (int)n);
+
+    /* one of the addresses in the table, as it may be full */
+    entry = universal_address_add(_addr((n / 2) * ADDR_STEP), ADDR_SIZE);
+    if (entry == NULL) {
+        return failed + 1;
+    }
+    /* 2001:db8::/32 of i == 0 would match all */
+    start = xtimer_now_usec();
+    for (unsigned i = 1; i <= n; i++) {
+        if (universal_address_compare_prefix(entry, _addr(i * ADDR_STEP),
+                                             ADDR_SIZE << 3) >= 0) {
+            matches++;
+        }
+    }
+    cmp = _ns_per_op(start, n);
+    failed += (matches != 1);
+
+    printf("%4u entries: add %lu ns, find %lu ns, compare %lu ns\n", n,
+           (unsigned long)add, (unsigned long)find, (unsigned long)cmp);
+    return failed;
+}
+
+int main(void)
+{
+    unsigned failed = 0;
+
+    puts("universal_address benchmark\n");
+    failed += _bench(64);
+    failed += _bench(256);
+    failed += _bench(UNIVERSAL_ADDRESS_MAX_ENTRIES);
+
+    puts((failed == 0) ? "[SUCCESS]" : "[FAILED]");
+    return 0;
+}